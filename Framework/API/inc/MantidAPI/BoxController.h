@@ -14,6 +14,7 @@
 
 namespace Mantid {
 namespace API {
+class IMDNode;
 
 /** This class is used by MDBox and MDGridBox in order to intelligently
  * determine optimal behavior. It informs:
@@ -369,6 +370,8 @@ public:
   void setFileBacked(boost::shared_ptr<IBoxControllerIO> newFileIO,
                      const std::string &fileName = "");
   void clearFileBacked();
+  size_t prefetchBoxes(const std::vector<IMDNode *> &boxes);
+  void cancelPrefetch(const size_t prefetch);
   //-----------------------------------------------------------------------------------
   // BoxCtrlChangesInterface *getChangesList(){return m_ChangesList;}
   // void setChangesList(BoxCtrlChangesInterface *pl){m_ChangesList=pl;}
@@ -70,6 +70,21 @@ public:
 
   /** flush the IO buffers */
   virtual void flushData() const = 0;
+  /** flush the IO buffers, without waiting if the writes are done in the
+   * background */
+  virtual void queueFlushData() const { this->flushData(); }
+  /** hint at data blocks which are about to be loaded, in the order they will
+   * be, so that they may be read ahead. Does nothing by default
+   * @param blocks -- the positions and sizes of the blocks
+   * @return the id of the read-ahead to cancel when done with, 0 if none */
+  virtual size_t prefetchBlocks(
+      const std::vector<std::pair<uint64_t, uint64_t>> & /*blocks*/) const {
+    return 0;
+  }
+  /** drop the blocks of a read-ahead which were not loaded. Does nothing by
+   * default
+   * @param prefetch -- the id returned by prefetchBlocks */
+  virtual void cancelPrefetch(const size_t /*prefetch*/) const {}
   /** Close the file */
   virtual void closeFile() = 0;
 
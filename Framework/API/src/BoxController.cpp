@@ -4,6 +4,8 @@
 #include "MantidKernel/System.h"
 #include "MantidKernel/VectorHelper.h"
 #include "MantidAPI/BoxController.h"
+#include "MantidAPI/IMDNode.h"
+#include "MantidKernel/ISaveable.h"
 
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
@@ -303,6 +305,36 @@ void BoxController::setFileBacked(boost::shared_ptr<IBoxControllerIO> newFileIO,
   this->m_fileIO = newFileIO;
 }
 
+/** Hints the file-based IO at the boxes which are about to be used, so that
+ * the events of those which are on file only may be read ahead.
+ *@param boxes -- the boxes, in the order they will be used
+ *@return the id of the read-ahead, to give to cancelPrefetch once the boxes
+ * are used, or 0 if nothing is read ahead
+*/
+size_t BoxController::prefetchBoxes(const std::vector<IMDNode *> &boxes) {
+  if (!m_fileIO)
+    return 0;
+  std::vector<std::pair<uint64_t, uint64_t>> blocks;
+  for (const auto box : boxes) {
+    const Kernel::ISaveable *saveable = box->getISaveable();
+    if (saveable && saveable->wasSaved() && !saveable->isLoaded() &&
+        saveable->getFileSize() > 0)
+      blocks.emplace_back(saveable->getFilePosition(),
+                          saveable->getFileSize());
+  }
+  if (blocks.empty())
+    return 0;
+  return m_fileIO->prefetchBlocks(blocks);
+}
+
+/** Drops what is left of a read-ahead started by prefetchBoxes
+ *@param prefetch -- the id returned by prefetchBoxes
+*/
+void BoxController::cancelPrefetch(const size_t prefetch) {
+  if (m_fileIO && prefetch != 0)
+    m_fileIO->cancelPrefetch(prefetch);
+}
+
 } // namespace Mantid
 
 } // namespace API
@@ -25,6 +25,12 @@ class IBeamProfile;
   The error on all points is defined to be \f$\frac{1}{\sqrt{N}}\f$, where N is
   the number of events generated.
 
+  The scatter points, and the paths of the neutrons to them, do not depend on
+  where the neutrons are detected. They can be generated once for many
+  simulated points, and then used for every detector. The paths from them to
+  a detector do not depend on the wavelengths, and can be traced once for all
+  the points of the detector.
+
   Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
   National Laboratory & European Spallation Source
 
@@ -55,6 +61,21 @@ public:
                                        const Kernel::V3D &finalPos,
                                        double lambdaBefore,
                                        double lambdaAfter) const;
+  void generateEvents(Kernel::PseudoRandomNumberGenerator &rng,
+                      const size_t npoints, MCScatterEvents &events) const;
+  std::tuple<double, double> calculate(const MCScatterEvents &events,
+                                       const size_t point,
+                                       const Kernel::V3D &finalPos,
+                                       double lambdaBefore,
+                                       double lambdaAfter) const;
+  void traceScattered(const MCScatterEvents &events, const size_t point,
+                      const Kernel::V3D &finalPos,
+                      MCTrackSegments &afterScatter) const;
+  std::tuple<double, double> calculate(const MCScatterEvents &events,
+                                       const size_t point,
+                                       const MCTrackSegments &afterScatter,
+                                       double lambdaBefore,
+                                       double lambdaAfter) const;
 
 private:
   const IBeamProfile &m_beamProfile;
@@ -3,6 +3,9 @@
 
 #include "MantidAlgorithms/DllConfig.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
+#include "MantidKernel/V3D.h"
+
+#include <vector>
 
 namespace Mantid {
 namespace API {
@@ -11,19 +14,54 @@ class Sample;
 namespace Geometry {
 class IObject;
 class SampleEnvironment;
+class Track;
 }
 
 namespace Kernel {
 class PseudoRandomNumberGenerator;
-class V3D;
 }
 namespace Algorithms {
 class IBeamProfile;
 
+/**
+  The segments of the objects crossed by a number of tracks, one track after
+  the other, which is all the absorption along the tracks depends on.
+*/
+struct MANTID_ALGORITHMS_DLL MCTrackSegments {
+  void clear();
+  void add(const Geometry::Track &track);
+
+  /// Index after the last segment of each track
+  std::vector<size_t> ends;
+  /// Length of each segment
+  std::vector<double> lengths;
+  /// Object of each segment
+  std::vector<const Geometry::IObject *> objects;
+};
+
+/**
+  Neutrons scattered within an MCInteractionVolume: the scatter points and the
+  segments of the objects crossed on the way to them, which do not depend on
+  where the neutrons are detected.
+*/
+struct MANTID_ALGORITHMS_DLL MCScatterEvents {
+  /// @return The number of events
+  size_t size() const { return scatterPoints.size(); }
+  void clear();
+
+  /// Scatter point of each event
+  std::vector<Kernel::V3D> scatterPoints;
+  /// The segments of the track of each event before scattering
+  MCTrackSegments beforeScatter;
+};
+
 /**
   Defines a volume where interactions of Tracks and Objects can take place.
   Given an initial Track, end point & wavelengths it calculates the absorption
   correction factor.
+  The events of many neutrons can be generated first, and their factors
+  calculated later for any end point, tracing their final paths together.
+  Once traced, the final paths give the factors at any wavelengths.
 
   Copyright &copy; 2016 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
   National Laboratory & European Spallation Source
@@ -61,6 +99,19 @@ public:
                              const Kernel::V3D &startPos,
                              const Kernel::V3D &endPos, double lambdaBefore,
                              double lambdaAfter) const;
+  bool generateEvent(Kernel::PseudoRandomNumberGenerator &rng,
+                     const Kernel::V3D &startPos,
+                     MCScatterEvents &events) const;
+  double calculateAbsorption(const MCScatterEvents &events, const size_t first,
+                             const size_t count, const Kernel::V3D &endPos,
+                             double lambdaBefore, double lambdaAfter) const;
+  void traceScattered(const MCScatterEvents &events, const size_t first,
+                      const size_t count, const Kernel::V3D &endPos,
+                      MCTrackSegments &afterScatter) const;
+  double calculateAbsorption(const MCScatterEvents &events, const size_t first,
+                             const size_t count,
+                             const MCTrackSegments &afterScatter,
+                             double lambdaBefore, double lambdaAfter) const;
 
 private:
   const boost::shared_ptr<Geometry::IObject> m_sample;
@@ -1578,21 +1578,19 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
   g_log.debug() << "Number of spectra in input/source EventWorkspace = "
                 << numberOfSpectra << ".\n";
 
-  // FIXME - Turn on parallel:
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
     PARALLEL_START_INTERUPT_REGION
 
     // Filter the non-skipped
     if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
+      // Get the output event lists (should be empty) to be a map. Each
+      // spectrum only touches its own output lists, so no lock is needed.
       std::map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
+      for (auto &ws : m_outputWorkspacesMap) {
+        int index = ws.first;
+        auto &output_el = ws.second->getSpectrum(iws);
+        outputs.emplace(index, &output_el);
       }
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
@@ -1655,14 +1653,13 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
 
     // Filter the non-skipped spectrum
     if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
+      // Get the output event lists (should be empty) to be a map. Each
+      // spectrum only touches its own output lists, so no lock is needed.
       map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
+      for (auto &ws : m_outputWorkspacesMap) {
+        int index = ws.first;
+        auto &output_el = ws.second->getSpectrum(iws);
+        outputs.emplace(index, &output_el);
       }
 
       // Get a holder on input workspace's event list of this spectrum
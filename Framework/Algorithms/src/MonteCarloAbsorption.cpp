@@ -239,6 +239,14 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
 
   const auto &spectrumInfo = simulationWS.spectrumInfo();
 
+  // Every spectrum uses the same seed, and so the same scatter points and
+  // paths to them. Each thread generates them once from its own generator,
+  // so the results do not depend on the number of threads. The paths to a
+  // detector are then traced once for all of its wavelength points.
+  const auto nthreads = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+  std::vector<MCScatterEvents> threadEvents(nthreads);
+  std::vector<MCTrackSegments> threadAfterScatter(nthreads);
+
   PARALLEL_FOR_IF(Kernel::threadSafe(simulationWS))
   for (int64_t i = 0; i < nhists; ++i) {
     PARALLEL_START_INTERUPT_REGION
@@ -254,7 +262,14 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
     const auto &detPos = spectrumInfo.position(i);
     const double lambdaFixed =
         toWavelength(efixed.value(spectrumInfo.detector(i).getID()));
-    MersenneTwister rng(seed);
+    const auto thread = static_cast<size_t>(PARALLEL_THREAD_NUMBER);
+    auto &events = threadEvents[thread];
+    if (events.size() == 0) {
+      MersenneTwister rng(seed);
+      strategy.generateEvents(rng, 1, events);
+    }
+    auto &afterScatter = threadAfterScatter[thread];
+    strategy.traceScattered(events, 0, detPos, afterScatter);
 
     auto &outY = simulationWS.mutableY(i);
     const auto lambdas = simulationWS.points(i);
@@ -271,7 +286,7 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(
         // elastic case already initialized
       }
       std::tie(outY[j], std::ignore) =
-          strategy.calculate(rng, detPos, lambdaIn, lambdaOut);
+          strategy.calculate(events, 0, afterScatter, lambdaIn, lambdaOut);
 
       // Ensure we have the last point for the interpolation
       if (lambdaStepSize > 1 && j + lambdaStepSize >= nbins && j + 1 != nbins) {
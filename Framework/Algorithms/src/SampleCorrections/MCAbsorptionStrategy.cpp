@@ -43,21 +43,30 @@ std::tuple<double, double>
 MCAbsorptionStrategy::calculate(Kernel::PseudoRandomNumberGenerator &rng,
                                 const Kernel::V3D &finalPos,
                                 double lambdaBefore, double lambdaAfter) const {
+  MCScatterEvents events;
+  generateEvents(rng, 1, events);
+  return calculate(events, 0, finalPos, lambdaBefore, lambdaAfter);
+}
+
+/**
+ * Generate the scatter points and the paths leading to them for a number of
+ * simulated points, drawing the random numbers as calculate does for each
+ * @param rng A reference to a PseudoRandomNumberGenerator
+ * @param npoints The number of simulated points
+ * @param events The events to add to, nevents for each point
+ */
+void MCAbsorptionStrategy::generateEvents(
+    Kernel::PseudoRandomNumberGenerator &rng, const size_t npoints,
+    MCScatterEvents &events) const {
   const auto scatterBounds = m_scatterVol.getBoundingBox();
-  double factor(0.0);
-  for (size_t i = 0; i < m_nevents; ++i) {
+  for (size_t i = 0; i < npoints * m_nevents; ++i) {
     size_t attempts(0);
     do {
       const auto neutron = m_beamProfile.generatePoint(rng, scatterBounds);
-
-      const double wgt = m_scatterVol.calculateAbsorption(
-          rng, neutron.startPos, finalPos, lambdaBefore, lambdaAfter);
-      if (wgt < 0.0) {
-        ++attempts;
-      } else {
-        factor += wgt;
+      if (m_scatterVol.generateEvent(rng, neutron.startPos, events)) {
         break;
       }
+      ++attempts;
       if (attempts == m_maxScatterAttempts) {
         throw std::runtime_error("Unable to generate valid track through "
                                  "sample interaction volume after " +
@@ -68,6 +77,64 @@ MCAbsorptionStrategy::calculate(Kernel::PseudoRandomNumberGenerator &rng,
       }
     } while (true);
   }
+}
+
+/**
+ * Compute the correction for a simulated point from events generated by
+ * generateEvents
+ * @param events The events of all the simulated points
+ * @param point The index of the simulated point
+ * @param finalPos Defines the final position of the neutron, assumed to be
+ * where it is detected
+ * @param lambdaBefore Wavelength, in \f$\\A^-1\f$, before scattering
+ * @param lambdaAfter Wavelength, in \f$\\A^-1\f$, after scattering
+ * @return A tuple of the <correction factor, associated error>.
+ */
+std::tuple<double, double>
+MCAbsorptionStrategy::calculate(const MCScatterEvents &events,
+                                const size_t point, const Kernel::V3D &finalPos,
+                                double lambdaBefore, double lambdaAfter) const {
+  const double factor =
+      m_scatterVol.calculateAbsorption(events, point * m_nevents, m_nevents,
+                                       finalPos, lambdaBefore, lambdaAfter);
+  using std::make_tuple;
+  return make_tuple(factor / static_cast<double>(m_nevents), m_error);
+}
+
+/**
+ * Trace the paths of the events of a simulated point from their scatter
+ * points to where the neutrons are detected, for use at any wavelengths
+ * @param events The events of all the simulated points
+ * @param point The index of the simulated point
+ * @param finalPos Defines the final position of the neutron, assumed to be
+ * where it is detected
+ * @param afterScatter The segments of the traced paths
+ */
+void MCAbsorptionStrategy::traceScattered(const MCScatterEvents &events,
+                                          const size_t point,
+                                          const Kernel::V3D &finalPos,
+                                          MCTrackSegments &afterScatter) const {
+  m_scatterVol.traceScattered(events, point * m_nevents, m_nevents, finalPos,
+                              afterScatter);
+}
+
+/**
+ * Compute the correction for a simulated point from the paths traced by
+ * traceScattered
+ * @param events The events of all the simulated points
+ * @param point The index of the simulated point
+ * @param afterScatter The segments of the paths traced for the point
+ * @param lambdaBefore Wavelength, in \f$\\A^-1\f$, before scattering
+ * @param lambdaAfter Wavelength, in \f$\\A^-1\f$, after scattering
+ * @return A tuple of the <correction factor, associated error>.
+ */
+std::tuple<double, double> MCAbsorptionStrategy::calculate(
+    const MCScatterEvents &events, const size_t point,
+    const MCTrackSegments &afterScatter, double lambdaBefore,
+    double lambdaAfter) const {
+  const double factor =
+      m_scatterVol.calculateAbsorption(events, point * m_nevents, m_nevents,
+                                       afterScatter, lambdaBefore, lambdaAfter);
   using std::make_tuple;
   return make_tuple(factor / static_cast<double>(m_nevents), m_error);
 }
@@ -6,6 +6,8 @@
 #include "MantidKernel/Material.h"
 #include "MantidKernel/PseudoRandomNumberGenerator.h"
 
+#include <cmath>
+
 namespace Mantid {
 using Geometry::Track;
 using Kernel::V3D;
@@ -15,16 +17,66 @@ namespace Algorithms {
 namespace {
 
 /**
- * Compute the attenuation factor for the given coefficients
- * @param rho Number density of the sample in \f$\\A^{-3}\f$
- * @param sigma Cross-section in barns
- * @param length Path length in metres
- * @return The dimensionless attenuated fraction
+ * The attenuation coefficients of objects at a wavelength, found once for
+ * each object
  */
-double attenuation(double rho, double sigma, double length) {
-  using std::exp;
-  return exp(-100 * rho * sigma * length);
+class AttenuationCoefficients {
+public:
+  /// @param lambda Wavelength, in \f$\\A^-1\f$
+  explicit AttenuationCoefficients(double lambda) : m_lambda(lambda) {}
+
+  /**
+   * @param object An object crossed by a track
+   * @return The coefficient which, multiplied by a path length in metres,
+   * gives the exponent of the attenuated fraction
+   */
+  double operator()(const Geometry::IObject *object) {
+    for (const auto &known : m_coefficients) {
+      if (known.first == object)
+        return known.second;
+    }
+    const auto material = object->material();
+    // Number density in \f$\\A^{-3}\f$ and cross-section in barns
+    const double coefficient = -100 * material.numberDensity() *
+                               (material.totalScatterXSection(m_lambda) +
+                                material.absorbXSection(m_lambda));
+    m_coefficients.emplace_back(object, coefficient);
+    return coefficient;
+  }
+
+private:
+  const double m_lambda;
+  std::vector<std::pair<const Geometry::IObject *, double>> m_coefficients;
+};
 }
+
+/**
+ * Remove all the tracks, keeping the memory
+ */
+void MCTrackSegments::clear() {
+  ends.clear();
+  lengths.clear();
+  objects.clear();
+}
+
+/**
+ * Add the segments of a track
+ * @param track A track whose surfaces have been intercepted
+ */
+void MCTrackSegments::add(const Track &track) {
+  for (const auto &segment : track) {
+    lengths.emplace_back(segment.distInsideObject);
+    objects.emplace_back(segment.object);
+  }
+  ends.emplace_back(lengths.size());
+}
+
+/**
+ * Remove all the events, keeping the memory
+ */
+void MCScatterEvents::clear() {
+  scatterPoints.clear();
+  beforeScatter.clear();
 }
 
 /**
@@ -81,6 +133,28 @@ const Geometry::BoundingBox &MCInteractionVolume::getBoundingBox() const {
 double MCInteractionVolume::calculateAbsorption(
     Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &startPos,
     const Kernel::V3D &endPos, double lambdaBefore, double lambdaAfter) const {
+  MCScatterEvents event;
+  // This should not happen but numerical precision means that it can
+  // occasionally occur with tracks that are very close to the surface
+  if (!generateEvent(rng, startPos, event)) {
+    return -1.0;
+  }
+  return calculateAbsorption(event, 0, 1, endPos, lambdaBefore, lambdaAfter);
+}
+
+/**
+ * Generate a scatter point and the segments of the path leading to it, as
+ * calculateAbsorption does, and add them to a set of events.
+ * @param rng A reference to a PseudoRandomNumberGenerator producing
+ * random number between [0,1]
+ * @param startPos Origin of the initial track
+ * @param events The events to add to
+ * @return False if the path to the scatter point was not valid, in which case
+ * no event is added
+ */
+bool MCInteractionVolume::generateEvent(
+    Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &startPos,
+    MCScatterEvents &events) const {
   // Generate scatter point. If there is an environment present then
   // first select whether the scattering occurs on the sample or the
   // environment. The attenuation for the path leading to the scatter point
@@ -102,37 +176,104 @@ double MCInteractionVolume::calculateAbsorption(
   if (m_env) {
     nlinks += m_env->interceptSurfaces(beforeScatter);
   }
-  // This should not happen but numerical precision means that it can
-  // occasionally occur with tracks that are very close to the surface
   if (nlinks == 0) {
-    return -1.0;
+    return false;
   }
 
-  // Function to calculate total attenuation for a track
-  auto calculateAttenuation = [](const Track &path, double lambda) {
-    double factor(1.0);
-    for (const auto &segment : path) {
-      const double length = segment.distInsideObject;
-      const auto &segObj = *(segment.object);
-      const auto &segMat = segObj.material();
-      factor *= attenuation(segMat.numberDensity(),
-                            segMat.totalScatterXSection(lambda) +
-                                segMat.absorbXSection(lambda),
-                            length);
-    }
-    return factor;
-  };
-
-  // Now track to final destination
-  V3D scatteredDirec = endPos - scatterPos;
-  scatteredDirec.normalize();
-  Track afterScatter(scatterPos, scatteredDirec);
-  m_sample->interceptSurface(afterScatter);
+  events.scatterPoints.emplace_back(scatterPos);
+  events.beforeScatter.add(beforeScatter);
+  return true;
+}
+
+/**
+ * Calculate the attenuation correction factors of a range of events for a
+ * final position of the neutrons. The tracks from the scatter points to the
+ * final position are traced together.
+ * @param events The events
+ * @param first Index of the first event
+ * @param count Number of events
+ * @param endPos Final position of neutron after scattering (assumed to be
+ * outside of the "volume")
+ * @param lambdaBefore Wavelength, in \f$\\A^-1\f$, before scattering
+ * @param lambdaAfter Wavelength, in \f$\\A^-1\f$, after scattering
+ * @return The sum of the fractions of the beam that have been attenuated
+ */
+double MCInteractionVolume::calculateAbsorption(
+    const MCScatterEvents &events, const size_t first, const size_t count,
+    const Kernel::V3D &endPos, double lambdaBefore, double lambdaAfter) const {
+  MCTrackSegments afterScatter;
+  traceScattered(events, first, count, endPos, afterScatter);
+  return calculateAbsorption(events, first, count, afterScatter, lambdaBefore,
+                             lambdaAfter);
+}
+
+/**
+ * Trace the tracks of a range of events from the scatter points to a final
+ * position of the neutrons, which do not depend on the wavelength.
+ * @param events The events
+ * @param first Index of the first event
+ * @param count Number of events
+ * @param endPos Final position of neutron after scattering (assumed to be
+ * outside of the "volume")
+ * @param afterScatter The segments of the tracks, one for each event,
+ * replacing any there were
+ */
+void MCInteractionVolume::traceScattered(const MCScatterEvents &events,
+                                         const size_t first, const size_t count,
+                                         const Kernel::V3D &endPos,
+                                         MCTrackSegments &afterScatter) const {
+  std::vector<Track> tracks;
+  tracks.reserve(count);
+  for (size_t i = first; i < first + count; ++i) {
+    V3D scatteredDirec = endPos - events.scatterPoints[i];
+    scatteredDirec.normalize();
+    tracks.emplace_back(events.scatterPoints[i], scatteredDirec);
+  }
+  m_sample->interceptSurfaces(tracks);
   if (m_env) {
-    m_env->interceptSurfaces(afterScatter);
+    m_env->interceptSurfaces(tracks);
+  }
+  afterScatter.clear();
+  for (const auto &track : tracks)
+    afterScatter.add(track);
+}
+
+/**
+ * Calculate the attenuation correction factors of a range of events from
+ * the tracks traced from their scatter points by traceScattered.
+ * @param events The events
+ * @param first Index of the first event
+ * @param count Number of events
+ * @param afterScatter The segments of the tracks after scattering
+ * @param lambdaBefore Wavelength, in \f$\\A^-1\f$, before scattering
+ * @param lambdaAfter Wavelength, in \f$\\A^-1\f$, after scattering
+ * @return The sum of the fractions of the beam that have been attenuated
+ */
+double MCInteractionVolume::calculateAbsorption(
+    const MCScatterEvents &events, const size_t first, const size_t count,
+    const MCTrackSegments &afterScatter, double lambdaBefore,
+    double lambdaAfter) const {
+  const auto &before = events.beforeScatter;
+  AttenuationCoefficients coefficientBefore(lambdaBefore),
+      coefficientAfter(lambdaAfter);
+  double total(0.0);
+  for (size_t i = 0; i < count; ++i) {
+    const size_t event = first + i;
+    double factorBefore(1.0);
+    for (size_t j = event > 0 ? before.ends[event - 1] : 0;
+         j < before.ends[event]; ++j) {
+      factorBefore *=
+          std::exp(coefficientBefore(before.objects[j]) * before.lengths[j]);
+    }
+    double factorAfter(1.0);
+    for (size_t j = i > 0 ? afterScatter.ends[i - 1] : 0;
+         j < afterScatter.ends[i]; ++j) {
+      factorAfter *= std::exp(coefficientAfter(afterScatter.objects[j]) *
+                              afterScatter.lengths[j]);
+    }
+    total += factorBefore * factorAfter;
   }
-  return calculateAttenuation(beforeScatter, lambdaBefore) *
-         calculateAttenuation(afterScatter, lambdaAfter);
+  return total;
 }
 
 } // namespace Algorithms
@@ -58,6 +58,50 @@ public:
     TS_ASSERT_DELTA(1.0 / std::sqrt(nevents), error, 1e-08);
   }
 
+  void test_Events_Generated_Together_Match_Single_Calculations() {
+    using Mantid::Algorithms::MCScatterEvents;
+    using Mantid::Algorithms::MCTrackSegments;
+    using Mantid::Algorithms::RectangularBeamProfile;
+    using namespace Mantid::Geometry;
+    using namespace Mantid::Kernel;
+
+    auto testSampleSphere = MonteCarloTesting::createTestSample(
+        MonteCarloTesting::TestSampleType::SolidSphere);
+    RectangularBeamProfile testBeamProfile(
+        ReferenceFrame(Y, Z, Right, "source"), V3D(0, 0, -2), 0.2, 0.2);
+    const size_t nevents(10), maxTries(100), npoints(3);
+    MCAbsorptionStrategy mcabsorb(testBeamProfile, testSampleSphere, nevents,
+                                  maxTries);
+    MersenneTwister eventsRng(1), singleRng(1);
+    MCScatterEvents events;
+    mcabsorb.generateEvents(eventsRng, npoints, events);
+    TS_ASSERT_EQUALS(npoints * nevents, events.size());
+
+    const V3D endPos(0.7, 0.7, 1.4);
+    for (size_t i = 0; i < npoints; ++i) {
+      const double lambdaBefore(2.5 + i), lambdaAfter(3.5 + i);
+      double factor(0.0), singleFactor(0.0);
+      std::tie(factor, std::ignore) =
+          mcabsorb.calculate(events, i, endPos, lambdaBefore, lambdaAfter);
+      std::tie(singleFactor, std::ignore) =
+          mcabsorb.calculate(singleRng, endPos, lambdaBefore, lambdaAfter);
+      TS_ASSERT_EQUALS(singleFactor, factor);
+    }
+
+    // Paths traced once give the same factors at any wavelengths
+    MCTrackSegments afterScatter;
+    mcabsorb.traceScattered(events, 1, endPos, afterScatter);
+    for (size_t i = 0; i < npoints; ++i) {
+      const double lambdaBefore(2.5 + i), lambdaAfter(3.5 + i);
+      double factor(0.0), tracedFactor(0.0);
+      std::tie(factor, std::ignore) =
+          mcabsorb.calculate(events, 1, endPos, lambdaBefore, lambdaAfter);
+      std::tie(tracedFactor, std::ignore) = mcabsorb.calculate(
+          events, 1, afterScatter, lambdaBefore, lambdaAfter);
+      TS_ASSERT_EQUALS(factor, tracedFactor);
+    }
+  }
+
   //----------------------------------------------------------------------------
   // Failure cases
   //----------------------------------------------------------------------------
@@ -125,6 +125,44 @@ public:
     Mock::VerifyAndClearExpectations(&rng);
   }
 
+  void test_Events_Give_The_Same_Factors_As_Single_Calculations() {
+    using Mantid::Algorithms::MCScatterEvents;
+    using Mantid::Kernel::MersenneTwister;
+    using Mantid::Kernel::V3D;
+    using namespace MonteCarloTesting;
+
+    const V3D startPos(-2.0, 0.0, 0.0), endPos(0.7, 0.7, 1.4);
+    const double lambdaBefore(2.5), lambdaAfter(3.5);
+    auto sample = createTestSample(TestSampleType::SamplePlusContainer);
+    MCInteractionVolume interactor(sample,
+                                   sample.getEnvironment().boundingBox());
+    MersenneTwister eventsRng(1), singleRng(1);
+    MCScatterEvents events;
+    std::vector<double> singleFactors;
+    for (size_t i = 0; i < 20; ++i) {
+      const bool generated =
+          interactor.generateEvent(eventsRng, startPos, events);
+      const double factor = interactor.calculateAbsorption(
+          singleRng, startPos, endPos, lambdaBefore, lambdaAfter);
+      TS_ASSERT_EQUALS(generated, factor >= 0.0);
+      if (generated)
+        singleFactors.emplace_back(factor);
+    }
+    TS_ASSERT_EQUALS(singleFactors.size(), events.size());
+
+    double total(0.0);
+    for (size_t i = 0; i < events.size(); ++i) {
+      TS_ASSERT_EQUALS(singleFactors[i],
+                       interactor.calculateAbsorption(
+                           events, i, 1, endPos, lambdaBefore, lambdaAfter));
+      total += singleFactors[i];
+    }
+    TS_ASSERT_EQUALS(total,
+                     interactor.calculateAbsorption(events, 0, events.size(),
+                                                    endPos, lambdaBefore,
+                                                    lambdaAfter));
+  }
+
   //----------------------------------------------------------------------------
   // Failure cases
   //----------------------------------------------------------------------------
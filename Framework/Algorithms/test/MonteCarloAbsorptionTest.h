@@ -113,14 +113,14 @@ public:
     const size_t middle_index(4);
 
     TS_ASSERT_DELTA(0.0074366635, outputWS->y(0).front(), delta);
-    TS_ASSERT_DELTA(0.00014222815, outputWS->y(0)[middle_index], delta);
-    TS_ASSERT_DELTA(1.64562e-05, outputWS->y(0).back(), delta);
+    TS_ASSERT_DELTA(0.00051616164, outputWS->y(0)[middle_index], delta);
+    TS_ASSERT_DELTA(7.2656971e-05, outputWS->y(0).back(), delta);
     TS_ASSERT_DELTA(0.0073977126, outputWS->y(2).front(), delta);
-    TS_ASSERT_DELTA(0.0001373456, outputWS->y(2)[middle_index], delta);
-    TS_ASSERT_DELTA(1.3673737e-05, outputWS->y(2).back(), delta);
+    TS_ASSERT_DELTA(0.00053299928, outputWS->y(2)[middle_index], delta);
+    TS_ASSERT_DELTA(8.2228814e-05, outputWS->y(2).back(), delta);
     TS_ASSERT_DELTA(0.0074180214, outputWS->y(4).front(), delta);
-    TS_ASSERT_DELTA(0.00013650999, outputWS->y(4)[middle_index], delta);
-    TS_ASSERT_DELTA(1.2496885e-05, outputWS->y(4).back(), delta);
+    TS_ASSERT_DELTA(0.00055374131, outputWS->y(4)[middle_index], delta);
+    TS_ASSERT_DELTA(9.162567e-05, outputWS->y(4).back(), delta);
   }
 
   void test_Workspace_With_Just_Sample_For_Direct() {
@@ -134,8 +134,8 @@ public:
     const size_t middle_index(4);
 
     TS_ASSERT_DELTA(0.0032600806, outputWS->y(0).front(), delta);
-    TS_ASSERT_DELTA(0.00040160571, outputWS->y(0)[middle_index], delta);
-    TS_ASSERT_DELTA(0.00027626768, outputWS->y(0).back(), delta);
+    TS_ASSERT_DELTA(0.00089466897, outputWS->y(0)[middle_index], delta);
+    TS_ASSERT_DELTA(0.00043927925, outputWS->y(0).back(), delta);
   }
 
   void test_Workspace_With_Just_Sample_For_Indirect() {
@@ -149,8 +149,8 @@ public:
     const size_t middle_index(4);
 
     TS_ASSERT_DELTA(0.0014451101, outputWS->y(0).front(), delta);
-    TS_ASSERT_DELTA(9.4166161e-05, outputWS->y(0)[middle_index], delta);
-    TS_ASSERT_DELTA(4.0118175e-05, outputWS->y(0).back(), delta);
+    TS_ASSERT_DELTA(0.00036952955, outputWS->y(0)[middle_index], delta);
+    TS_ASSERT_DELTA(0.00010265929, outputWS->y(0).back(), delta);
   }
 
   void test_Workspace_With_Sample_And_Container() {
@@ -164,8 +164,8 @@ public:
     const size_t middle_index(4);
 
     TS_ASSERT_DELTA(0.0035900048, outputWS->y(0).front(), delta);
-    TS_ASSERT_DELTA(4.5651813e-05, outputWS->y(0)[middle_index], delta);
-    TS_ASSERT_DELTA(1.2391338e-06, outputWS->y(0).back(), delta);
+    TS_ASSERT_DELTA(0.00014720541, outputWS->y(0)[middle_index], delta);
+    TS_ASSERT_DELTA(1.2619462e-05, outputWS->y(0).back(), delta);
   }
 
   void test_Workspace_Beam_Size_Set() {
@@ -178,9 +178,9 @@ public:
     const double delta(1e-05);
     const size_t middle_index(4);
     TS_ASSERT_DELTA(0.004365258, outputWS->y(0).front(), delta);
-    TS_ASSERT_DELTA(9.8703289e-05, outputWS->y(0)[middle_index], delta);
+    TS_ASSERT_DELTA(9.9127886e-05, outputWS->y(0)[middle_index], delta);
     const double delta2(1e-08);
-    TS_ASSERT_DELTA(1.7373459e-08, outputWS->y(0).back(), delta2);
+    TS_ASSERT_DELTA(4.0110395e-06, outputWS->y(0).back(), delta2);
   }
 
   void test_Linear_Interpolation() {
@@ -194,9 +194,9 @@ public:
     verifyDimensions(wsProps, outputWS);
     const double delta(1e-05);
     TS_ASSERT_DELTA(0.0074366635, outputWS->y(0).front(), delta);
-    TS_ASSERT_DELTA(0.00041446262, outputWS->y(0)[3], delta);
-    TS_ASSERT_DELTA(0.00048307523, outputWS->y(0)[4], delta);
-    TS_ASSERT_DELTA(2.8600668e-05, outputWS->y(0).back(), delta);
+    TS_ASSERT_DELTA(0.00098665933, outputWS->y(0)[3], delta);
+    TS_ASSERT_DELTA(0.00051616164, outputWS->y(0)[4], delta);
+    TS_ASSERT_DELTA(7.2656971e-05, outputWS->y(0).back(), delta);
   }
 
   void test_CSpline_Interpolation() {
@@ -210,10 +210,9 @@ public:
     verifyDimensions(wsProps, outputWS);
     const double delta(1e-05);
     TS_ASSERT_DELTA(0.0074366635, outputWS->y(0).front(), delta);
-    // Interpolation gives negative value due to test setup
-    TS_ASSERT_DELTA(-7.0992356e-05, outputWS->y(0)[3], delta);
-    TS_ASSERT_DELTA(0.00048307523, outputWS->y(0)[4], delta);
-    TS_ASSERT_DELTA(2.8600668e-05, outputWS->y(0).back(), delta);
+    TS_ASSERT_DELTA(0.00056585631, outputWS->y(0)[3], delta);
+    TS_ASSERT_DELTA(0.00051616164, outputWS->y(0)[4], delta);
+    TS_ASSERT_DELTA(7.2656971e-05, outputWS->y(0).back(), delta);
   }
 
   //---------------------------------------------------------------------------
@@ -279,14 +278,14 @@ public:
     const double delta{1e-04};
     const size_t middle_index{4};
     TS_ASSERT_DELTA(0.00411903, outputWS->y(0).front(), delta);
-    TS_ASSERT_DELTA(3.11845e-05, outputWS->y(0)[middle_index], delta);
-    TS_ASSERT_DELTA(3.8547e-07, outputWS->y(0).back(), delta);
+    TS_ASSERT_DELTA(7.98505e-05, outputWS->y(0)[middle_index], delta);
+    TS_ASSERT_DELTA(5.76288e-07, outputWS->y(0).back(), delta);
     TS_ASSERT_DELTA(0.00408066, outputWS->y(2).front(), delta);
-    TS_ASSERT_DELTA(3.30326e-05, outputWS->y(2)[middle_index], delta);
-    TS_ASSERT_DELTA(3.84174e-07, outputWS->y(2).back(), delta);
+    TS_ASSERT_DELTA(7.62727e-05, outputWS->y(2)[middle_index], delta);
+    TS_ASSERT_DELTA(5.01046e-07, outputWS->y(2).back(), delta);
     TS_ASSERT_DELTA(0.00408664, outputWS->y(4).front(), delta);
-    TS_ASSERT_DELTA(3.67267e-05, outputWS->y(4)[middle_index], delta);
-    TS_ASSERT_DELTA(4.21291e-07, outputWS->y(4).back(), delta);
+    TS_ASSERT_DELTA(7.57667e-05, outputWS->y(4)[middle_index], delta);
+    TS_ASSERT_DELTA(4.84563e-07, outputWS->y(4).back(), delta);
   }
 
   void test_Sparse_Instrument_For_Direct() {
@@ -300,8 +299,8 @@ public:
     const size_t middle_index(4);
 
     TS_ASSERT_DELTA(0.00134398, outputWS->y(0).front(), delta);
-    TS_ASSERT_DELTA(6.37626e-05, outputWS->y(0)[middle_index], delta);
-    TS_ASSERT_DELTA(6.97537e-05, outputWS->y(0).back(), delta);
+    TS_ASSERT_DELTA(0.000141724, outputWS->y(0)[middle_index], delta);
+    TS_ASSERT_DELTA(2.24676e-05, outputWS->y(0).back(), delta);
   }
 
   void test_Sparse_Instrument_For_Indirect() {
@@ -315,8 +314,8 @@ public:
     const size_t middle_index(4);
 
     TS_ASSERT_DELTA(0.000333585, outputWS->y(0).front(), delta);
-    TS_ASSERT_DELTA(9.85491e-06, outputWS->y(0)[middle_index], delta);
-    TS_ASSERT_DELTA(9.16794e-07, outputWS->y(0).back(), delta);
+    TS_ASSERT_DELTA(2.31487e-05, outputWS->y(0)[middle_index], delta);
+    TS_ASSERT_DELTA(1.84407e-06, outputWS->y(0).back(), delta);
   }
 
 private:
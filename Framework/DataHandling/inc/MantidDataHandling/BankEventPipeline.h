@@ -0,0 +1,126 @@
+#ifndef MANTID_DATAHANDLING_BANKEVENTPIPELINE_H_
+#define MANTID_DATAHANDLING_BANKEVENTPIPELINE_H_
+
+#include "MantidDataHandling/DllConfig.h"
+#include "MantidGeometry/IDTypes.h"
+
+#include <boost/shared_ptr.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** A contiguous range of the events of one bank, as read from the file. The
+ * buffers are reused from one block to the next by BankEventPipeline. */
+struct EventBlock {
+  /// Pixel ID of each event
+  std::vector<uint32_t> eventId;
+  /// Time-of-flight of each event
+  std::vector<float> timeOfFlight;
+  /// Weight of each event; empty unless the file has weights
+  std::vector<float> weight;
+  /// Index in the bank of the first event of the block
+  size_t startAt{0};
+  /// Smallest pixel ID in the block
+  detid_t minId{0};
+  /// Largest pixel ID in the block
+  detid_t maxId{0};
+  /// True for the first block of the bank
+  bool firstBlock{false};
+  /// True for the last block of the bank
+  bool lastBlock{false};
+  /// Index in the block of the events of each pixel range, in file order;
+  /// empty when the bank is a single range
+  std::vector<std::vector<uint32_t>> rangeEvents;
+  /// Number of events in the block
+  size_t size() const { return eventId.size(); }
+};
+
+/** BankEventPipeline : A bounded queue of blocks of events between the task
+  reading a bank from disk and the tasks turning the events into event lists.
+
+  The reader takes a free block with tryAcquire(), fills it and push()es it.
+  Each block is processed once for every pixel range of the bank. Blocks of a
+  range are handed out in the order they were pushed, and the tasks of a range
+  share rangeMutex() so the events of a pixel are always appended by one
+  thread and in file order. Once every range has released a block its buffers
+  go back on the free list, so no more than maxBlocks blocks are allocated.
+  When none is free the reader can either process queued blocks itself or
+  waitForRelease().
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAHANDLING_DLL BankEventPipeline {
+public:
+  explicit BankEventPipeline(const size_t maxBlocks);
+
+  void setNumberOfRanges(const size_t numRanges);
+  /// Number of pixel ranges each block is processed for
+  size_t numberOfRanges() const { return m_queues.size(); }
+  /// Mutex held while a block of the given range is processed
+  boost::shared_ptr<std::mutex> rangeMutex(const size_t range) const {
+    return m_rangeMutexes[range];
+  }
+  size_t blocksAllocated() const;
+
+  boost::shared_ptr<EventBlock> tryAcquire();
+  void push(boost::shared_ptr<EventBlock> block);
+  void recycle(boost::shared_ptr<EventBlock> block);
+  bool hasQueued(const size_t range) const;
+  boost::shared_ptr<EventBlock> pop(const size_t range);
+  void release(const boost::shared_ptr<EventBlock> &block);
+  void waitForRelease();
+
+private:
+  /// A queued block and the number of ranges yet to release it
+  struct Pending {
+    boost::shared_ptr<EventBlock> block;
+    size_t remaining;
+  };
+
+  /// Largest number of blocks allocated at once
+  const size_t m_maxBlocks;
+  /// Number of blocks allocated
+  size_t m_allocated;
+  /// Blocks ready to be filled
+  std::vector<boost::shared_ptr<EventBlock>> m_free;
+  /// Blocks being processed, with their outstanding range count
+  std::vector<Pending> m_pending;
+  /// Blocks waiting to be processed, for each range
+  std::vector<std::deque<boost::shared_ptr<EventBlock>>> m_queues;
+  /// Mutex serialising the processing of each range
+  std::vector<boost::shared_ptr<std::mutex>> m_rangeMutexes;
+  /// Guards the free list, pending blocks and queues
+  mutable std::mutex m_lock;
+  /// Signalled when a block goes back on the free list
+  std::condition_variable m_released;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
+
+#endif /* MANTID_DATAHANDLING_BANKEVENTPIPELINE_H_ */
@@ -51,9 +51,6 @@ public:
   /// True if the event_id is spectrum no not pixel ID
   bool event_id_is_spec;
 
-  /// whether or not to launch multiple ProcessBankData jobs per bank
-  bool splitProcessing;
-
   /// Do we pre-count the # of events in each pixel ID?
   bool precount;
 
@@ -75,6 +72,9 @@ public:
   LoadEventNexus *alg;
   EventWorkspaceCollection &m_ws;
 
+  /// File the events of each bank are paged out to once loaded, if any
+  boost::shared_ptr<DataObjects::FileBackedEventStore> eventStore;
+
   /// Vector where index = event_id; value = ptr to std::vector<TofEvent> in the
   /// event list.
   std::vector<std::vector<std::vector<Mantid::Types::Event::TofEvent> *>>
@@ -95,8 +95,8 @@ public:
 private:
   DefaultEventLoader(LoadEventNexus *alg, EventWorkspaceCollection &ws,
                      bool haveWeights, bool event_id_is_spec,
-                     const size_t numBanks, const bool precount,
-                     const int chunk, const int totalChunks);
+                     const bool precount, const int chunk,
+                     const int totalChunks);
   std::pair<size_t, size_t>
   setupChunking(std::vector<std::string> &bankNames,
                 std::vector<std::size_t> &bankNumEvents);
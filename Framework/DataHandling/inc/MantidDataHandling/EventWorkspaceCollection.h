@@ -99,6 +99,13 @@ public:
   Types::Core::DateAndTime getFirstPulseTime() const;
   void setAllX(const HistogramData::BinEdges &x);
   size_t getNumberEvents() const;
+  void setEventStore(
+      const boost::shared_ptr<DataObjects::FileBackedEventStore> &store);
+  void pageOutEvents();
+  void pageOutSpectrum(const size_t workspace_index);
+  void switchToColumns();
+  void switchToCompressed(DataObjects::CompressedEventList::TofEncoding encoding,
+                          double tofResolution);
   void setIndexInfo(const Indexing::IndexInfo &indexInfo);
   void setInstrument(const Geometry::Instrument_const_sptr &inst);
   void
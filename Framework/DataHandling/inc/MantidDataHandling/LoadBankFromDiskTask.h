@@ -2,6 +2,7 @@
 #define MANTID_DATAHANDLING_LOADBANKFROMDISKTASK_H_
 
 #include "MantidDataHandling/DllConfig.h"
+#include "MantidDataHandling/BankEventPipeline.h"
 #include "MantidAPI/Progress.h"
 #include "MantidKernel/Task.h"
 #include "MantidKernel/ThreadScheduler.h"
@@ -13,9 +14,20 @@ class BankPulseTimes;
 namespace Mantid {
 namespace DataHandling {
 class DefaultEventLoader;
+struct UsedDetIds;
 
-/** This task does the disk IO from loading the NXS file, and so will be on a
-  disk IO mutex
+/** This task does the disk IO from loading the NXS file. The disk IO mutex
+  shared by all the tasks is only held while the file is read, not while the
+  events are processed.
+
+  The events of a bank are read in blocks of at most EVENTS_PER_BLOCK events.
+  Each block is handed to ProcessBankData tasks through a BankEventPipeline as
+  soon as it is read, so the events are added to the event lists while the
+  rest of the bank is being read. At most MAX_BLOCKS_IN_FLIGHT blocks of a
+  bank are held in memory and their buffers are reused; when they are all in
+  use the reader processes queued blocks itself. The pixel IDs of a large bank
+  are split into ranges holding about EVENTS_PER_RANGE events each, whose
+  events are added by separate tasks.
 
   Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
   National Laboratory & European Spallation Source
@@ -52,15 +64,31 @@ public:
 
   void run() override;
 
+  /// Largest number of events read from the file at once
+  static const size_t EVENTS_PER_BLOCK;
+  /// Largest number of blocks of a bank held in memory at once
+  static const size_t MAX_BLOCKS_IN_FLIGHT;
+  /// Number of events of a bank per range of pixel IDs
+  static const size_t EVENTS_PER_RANGE;
+  /// Largest number of ranges of pixel IDs a bank is split into
+  static const size_t MAX_RANGES;
+  static size_t numberOfBlocks(const size_t numEvents);
+  static size_t numberOfRanges(const size_t numEvents);
+
 private:
   void loadPulseTimes(::NeXus::File &file);
   void loadEventIndex(::NeXus::File &file, std::vector<uint64_t> &event_index);
   void prepareEventId(::NeXus::File &file, size_t &start_event,
                       size_t &stop_event, std::vector<uint64_t> &event_index);
-  void loadEventId(::NeXus::File &file);
-  void loadTof(::NeXus::File &file);
-  void loadEventWeights(::NeXus::File &file);
+  bool loadEventId(::NeXus::File &file, EventBlock &block);
+  void loadTof(::NeXus::File &file, EventBlock &block);
+  void loadEventWeights(::NeXus::File &file, EventBlock &block);
   int64_t recalculateDataSize(const int64_t &size);
+  bool setIdLimits();
+  void setupRanges(const EventBlock &firstBlock, const size_t numEvents);
+  void bucketByRange(EventBlock &block) const;
+  boost::shared_ptr<EventBlock> acquireBlock();
+  Kernel::Task *createProcessTask(const size_t range, const size_t numEvents);
 
   /// Algorithm being run
   DefaultEventLoader &m_loader;
@@ -82,18 +110,24 @@ private:
   std::vector<int> m_loadStart;
   /// How much to load in the file
   std::vector<int> m_loadSize;
-  /// Event pixel ID data
-  uint32_t *m_event_id;
-  /// Minimum pixel ID in this data
-  uint32_t m_min_id;
-  /// Maximum pixel ID in this data
-  uint32_t m_max_id;
-  /// TOF data
-  float *m_event_time_of_flight;
+  /// Minimum pixel ID that can be loaded
+  detid_t m_min_id;
+  /// Maximum pixel ID that can be loaded
+  detid_t m_max_id;
   /// Flag for simulated data
   bool m_have_weight;
-  /// Event weights
-  float *m_event_weight;
+  /// Blocks of events read from the bank
+  boost::shared_ptr<BankEventPipeline> m_pipeline;
+  /// event_index of the bank
+  boost::shared_ptr<std::vector<uint64_t>> m_eventIndex;
+  /// Minimum pixel ID of each range
+  std::vector<detid_t> m_rangeMin;
+  /// Maximum pixel ID of each range
+  std::vector<detid_t> m_rangeMax;
+  /// Pixel IDs touched in each range, when compressing or paging out events
+  std::vector<boost::shared_ptr<UsedDetIds>> m_usedDetIds;
+  /// Mutex shared by all the tasks reading the file
+  boost::shared_ptr<std::mutex> m_ioMutex;
   /// Frame period numbers
   const std::vector<int> m_framePeriodNumbers;
 }; // END-DEF-CLASS LoadBankFromDiskTask
@@ -4,16 +4,26 @@
 #include "MantidGeometry/IDTypes.h"
 #include "MantidKernel/Task.h"
 #include "MantidKernel/Timer.h"
+#include "MantidDataHandling/BankEventPipeline.h"
 #include "MantidDataHandling/BankPulseTimes.h"
 
-#include <boost/shared_array.hpp>
-
 namespace Mantid {
 namespace DataHandling {
 class DefaultEventLoader;
 
-/** This task does the disk IO from loading the NXS file,
-* and so will be on a disk IO mutex */
+/** The pixel IDs of a range of a bank that events were added to. The flags
+* cover only the pixel IDs seen in the blocks processed so far. */
+struct UsedDetIds {
+  /// Pixel ID of the first flag
+  detid_t firstId{0};
+  /// A flag for each pixel ID from firstId
+  std::vector<bool> used;
+  void cover(const detid_t minId, const detid_t maxId);
+};
+
+/** This task turns the next block of events of a bank into events in the
+* event lists, for one range of pixel IDs. The tasks of a range share the
+* range's mutex so they run one after the other. */
 class ProcessBankData : public Mantid::Kernel::Task {
 public:
   /** Constructor
@@ -21,32 +31,38 @@ public:
   * @param loader :: DefaultEventLoader
   * @param entry_name :: name of the bank
   * @param prog :: Progress reporter
-  * @param event_id :: array with event IDs
-  * @param event_time_of_flight :: array with event TOFS
-  * @param numEvents :: how many events in the arrays
-  * @param startAt :: index of the first event from event_index
+  * @param pipeline :: the blocks of events read from the bank
+  * @param range :: index of the pixel range processed by this task
+  * @param numEvents :: number of events in the block, used as the cost
   * @param event_index :: vector of event index (length of # of pulses)
   * @param thisBankPulseTimes :: ptr to the pulse times for this particular
   *bank.
   * @param have_weight :: flag for handling simulated files
-  * @param event_weight :: array with weights for events
+  * @param usedDetIds :: the pixel IDs of the range touched so far, shared
+  *by all the tasks of the range
   * @param min_event_id ;: minimum detector ID to load
   * @param max_event_id :: maximum detector ID to load
   * @return
   */ // API::IFileLoader<Kernel::NexusDescriptor>
   ProcessBankData(DefaultEventLoader &loader, std::string entry_name,
-                  API::Progress *prog, boost::shared_array<uint32_t> event_id,
-                  boost::shared_array<float> event_time_of_flight,
-                  size_t numEvents, size_t startAt,
+                  API::Progress *prog,
+                  boost::shared_ptr<BankEventPipeline> pipeline, size_t range,
+                  size_t numEvents,
                   boost::shared_ptr<std::vector<uint64_t>> event_index,
                   boost::shared_ptr<BankPulseTimes> thisBankPulseTimes,
-                  bool have_weight, boost::shared_array<float> event_weight,
+                  bool have_weight,
+                  boost::shared_ptr<UsedDetIds> usedDetIds,
                   detid_t min_event_id, detid_t max_event_id);
 
   void run() override;
 
 private:
+  void processBlock(const EventBlock &block);
+  int findFirstPulse(const size_t startAt) const;
+  void reserveEvents(const EventBlock &block, const detid_t minId,
+                     const detid_t maxId);
   size_t getWorkspaceIndexFromPixelID(const detid_t pixID);
+  void pageOutEvents();
 
   /// Algorithm being run
   DefaultEventLoader &m_loader;
@@ -59,22 +75,18 @@ private:
   detid_t pixelID_to_wi_offset;
   /// Progress reporting
   API::Progress *prog;
-  /// event pixel ID array
-  boost::shared_array<uint32_t> event_id;
-  /// event TOF array
-  boost::shared_array<float> event_time_of_flight;
-  /// # of events in arrays
-  size_t numEvents;
-  /// index of the first event from event_index
-  size_t startAt;
+  /// Blocks of events read from the bank
+  boost::shared_ptr<BankEventPipeline> m_pipeline;
+  /// Pixel range processed
+  size_t m_range;
   /// vector of event index (length of # of pulses)
   boost::shared_ptr<std::vector<uint64_t>> event_index;
   /// Pulse times for this bank
   boost::shared_ptr<BankPulseTimes> thisBankPulseTimes;
   /// Flag for simulated data
   bool have_weight;
-  /// event weights array
-  boost::shared_array<float> event_weight;
+  /// Pixel IDs touched in the range
+  boost::shared_ptr<UsedDetIds> m_usedDetIds;
   /// Minimum pixel id
   detid_t m_min_id;
   /// Maximum pixel id
@@ -0,0 +1,132 @@
+#include "MantidDataHandling/BankEventPipeline.h"
+
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** Constructor
+ * @param maxBlocks :: the largest number of blocks allocated at once
+ */
+BankEventPipeline::BankEventPipeline(const size_t maxBlocks)
+    : m_maxBlocks(std::max(maxBlocks, size_t(1))), m_allocated(0) {
+  setNumberOfRanges(1);
+}
+
+/** Set the number of pixel ranges each block is processed for. This must be
+ * done before the first block is pushed.
+ * @param numRanges :: the number of ranges, at least one
+ * @throw std::logic_error if blocks have already been pushed
+ */
+void BankEventPipeline::setNumberOfRanges(const size_t numRanges) {
+  std::lock_guard<std::mutex> lock(m_lock);
+  if (!m_pending.empty())
+    throw std::logic_error("BankEventPipeline: cannot change the number of "
+                           "ranges while blocks are queued");
+  m_queues.resize(std::max(numRanges, size_t(1)));
+  m_rangeMutexes.resize(m_queues.size());
+  for (auto &mutex : m_rangeMutexes) {
+    if (!mutex)
+      mutex = boost::make_shared<std::mutex>();
+  }
+}
+
+/// @return the number of blocks allocated so far
+size_t BankEventPipeline::blocksAllocated() const {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_allocated;
+}
+
+/** Get an empty block to fill, reusing the buffers of a released block if
+ * there is one.
+ * @return the block, or a null pointer if maxBlocks are already in use
+ */
+boost::shared_ptr<EventBlock> BankEventPipeline::tryAcquire() {
+  std::lock_guard<std::mutex> lock(m_lock);
+  if (!m_free.empty()) {
+    auto block = m_free.back();
+    m_free.pop_back();
+    return block;
+  }
+  if (m_allocated == m_maxBlocks)
+    return boost::shared_ptr<EventBlock>();
+  ++m_allocated;
+  return boost::make_shared<EventBlock>();
+}
+
+/** Queue a filled block for every range.
+ * @param block :: a block obtained from tryAcquire()
+ */
+void BankEventPipeline::push(boost::shared_ptr<EventBlock> block) {
+  std::lock_guard<std::mutex> lock(m_lock);
+  m_pending.push_back({block, m_queues.size()});
+  for (auto &queue : m_queues)
+    queue.push_back(block);
+}
+
+/** Give back a block obtained from tryAcquire() without pushing it.
+ * @param block :: the unused block
+ */
+void BankEventPipeline::recycle(boost::shared_ptr<EventBlock> block) {
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_free.push_back(block);
+  }
+  m_released.notify_all();
+}
+
+/** @param range :: the pixel range
+ * @return true if a block is waiting to be processed for the range
+ */
+bool BankEventPipeline::hasQueued(const size_t range) const {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return !m_queues[range].empty();
+}
+
+/** Take the oldest block waiting for a range. The caller should hold
+ * rangeMutex(range) until the block is released.
+ * @param range :: the pixel range
+ * @return the block, or a null pointer if none is waiting
+ */
+boost::shared_ptr<EventBlock> BankEventPipeline::pop(const size_t range) {
+  std::lock_guard<std::mutex> lock(m_lock);
+  auto &queue = m_queues[range];
+  if (queue.empty())
+    return boost::shared_ptr<EventBlock>();
+  auto block = queue.front();
+  queue.pop_front();
+  return block;
+}
+
+/** Signal that a range has finished with a block. The block is recycled once
+ * every range has released it.
+ * @param block :: a block obtained from pop()
+ */
+void BankEventPipeline::release(const boost::shared_ptr<EventBlock> &block) {
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    auto pending = std::find_if(
+        m_pending.begin(), m_pending.end(),
+        [&block](const Pending &item) { return item.block == block; });
+    if (pending == m_pending.end() || --pending->remaining > 0)
+      return;
+    m_pending.erase(pending);
+    m_free.push_back(block);
+  }
+  m_released.notify_all();
+}
+
+/** Wait until a block is released, or a short timeout expires. */
+void BankEventPipeline::waitForRelease() {
+  std::unique_lock<std::mutex> lock(m_lock);
+  if (!m_free.empty() || m_allocated < m_maxBlocks)
+    return;
+  m_released.wait_for(lock, std::chrono::milliseconds(10));
+}
+
+} // namespace DataHandling
+} // namespace Mantid
@@ -19,8 +19,8 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
                               std::vector<std::size_t> bankNumEvents,
                               const bool oldNeXusFileNames, const bool precount,
                               const int chunk, const int totalChunks) {
-  DefaultEventLoader loader(alg, ws, haveWeights, event_id_is_spec,
-                            bankNames.size(), precount, chunk, totalChunks);
+  DefaultEventLoader loader(alg, ws, haveWeights, event_id_is_spec, precount,
+                            chunk, totalChunks);
 
   auto bankRange = loader.setupChunking(bankNames, bankNumEvents);
 
@@ -29,10 +29,13 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
   ThreadPool pool(scheduler);
   auto diskIOMutex = boost::make_shared<std::mutex>();
 
-  // set up progress bar for the rest of the (multi-threaded) process
-  size_t numProg = bankNames.size() * (1 + 3); // 1 = disktask, 3 = proc task
-  if (loader.splitProcessing)
-    numProg += bankNames.size() * 3; // 3 = second proc task
+  // set up progress bar for the rest of the (multi-threaded) process: 1 for
+  // the disk task and 3 for each processing task, one per block of events and
+  // pixel range
+  size_t numProg = 0;
+  for (size_t i = bankRange.first; i < bankRange.second; i++)
+    numProg += 1 + 3 * LoadBankFromDiskTask::numberOfRanges(bankNumEvents[i]) *
+                       LoadBankFromDiskTask::numberOfBlocks(bankNumEvents[i]);
   auto prog = Kernel::make_unique<API::Progress>(loader.alg, 0.3, 1.0, numProg);
 
   for (size_t i = bankRange.first; i < bankRange.second; i++) {
@@ -49,12 +52,11 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
 DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg,
                                        EventWorkspaceCollection &ws,
                                        bool haveWeights, bool event_id_is_spec,
-                                       const size_t numBanks,
                                        const bool precount, const int chunk,
                                        const int totalChunks)
     : m_haveWeights(haveWeights), event_id_is_spec(event_id_is_spec),
       precount(precount), chunk(chunk), totalChunks(totalChunks), alg(alg),
-      m_ws(ws) {
+      m_ws(ws), eventStore(ws.getSingleHeldWorkspace()->eventStore()) {
   // This map will be used to find the workspace index
   if (event_id_is_spec)
     pixelID_to_wi_vector =
@@ -73,10 +75,6 @@ DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg,
     }
     makeMapToEventLists(weightedEventVectors);
   }
-
-  // split banks up if the number of cores is more than twice the number of
-  // banks
-  splitProcessing = bool(numBanks * 2 < ThreadPool::getNumPhysicalCores());
 }
 
 std::pair<size_t, size_t>
@@ -226,6 +226,41 @@ size_t EventWorkspaceCollection::getNumberEvents() const {
   return m_WsVec[0]->getNumberEvents(); // Should be the sum across all periods?
 }
 
+/** Set the file the events of all periods can be paged out to
+ * @param store :: the file, or a null pointer to keep all events in memory
+ */
+void EventWorkspaceCollection::setEventStore(
+    const boost::shared_ptr<DataObjects::FileBackedEventStore> &store) {
+  for (auto &ws : m_WsVec)
+    ws->setEventStore(store);
+}
+
+/// Page the events of all periods out to their event store
+void EventWorkspaceCollection::pageOutEvents() {
+  for (auto &ws : m_WsVec)
+    ws->pageOutEvents();
+}
+
+/// Page the events of a spectrum of all periods out to their event store
+void EventWorkspaceCollection::pageOutSpectrum(const size_t workspace_index) {
+  for (auto &ws : m_WsVec)
+    ws->pageOutSpectrum(workspace_index);
+}
+
+/// Hold the events of all periods in columns
+void EventWorkspaceCollection::switchToColumns() {
+  for (auto &ws : m_WsVec)
+    ws->switchToColumns();
+}
+
+/// Compress the events of all periods
+void EventWorkspaceCollection::switchToCompressed(
+    DataObjects::CompressedEventList::TofEncoding encoding,
+    double tofResolution) {
+  for (auto &ws : m_WsVec)
+    ws->switchToCompressed(encoding, tofResolution);
+}
+
 void EventWorkspaceCollection::setIndexInfo(
     const Indexing::IndexInfo &indexInfo) {
   for (auto &ws : m_WsVec)
@@ -4,9 +4,19 @@
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
 
+#include <algorithm>
+#include <memory>
+
 namespace Mantid {
 namespace DataHandling {
 
+const size_t LoadBankFromDiskTask::EVENTS_PER_BLOCK = size_t(1) << 22;
+const size_t LoadBankFromDiskTask::MAX_BLOCKS_IN_FLIGHT = 3;
+const size_t LoadBankFromDiskTask::EVENTS_PER_RANGE = size_t(1) << 22;
+// The events of each block are sorted by range once, so this only bounds the
+// number of tasks queued per block
+const size_t LoadBankFromDiskTask::MAX_RANGES = 16;
+
 /** Constructor
 *
 * @param loader :: Handle to the main loader
@@ -15,7 +25,8 @@ namespace DataHandling {
 * @param numEvents :: The number of events in the bank.
 * @param oldNeXusFileNames :: Identify if file is of old variety.
 * @param prog :: an optional Progress object
-* @param ioMutex :: a mutex shared for all Disk I-O tasks
+* @param ioMutex :: a mutex shared for all Disk I-O tasks, held while the file
+* is read
 * @param scheduler :: the ThreadScheduler that runs this task.
 * @param framePeriodNumbers :: Period numbers corresponding to each frame
 */
@@ -27,13 +38,29 @@ LoadBankFromDiskTask::LoadBankFromDiskTask(
     const std::vector<int> &framePeriodNumbers)
     : m_loader(loader), entry_name(entry_name), entry_type(entry_type),
       prog(prog), scheduler(scheduler), m_loadError(false),
-      m_oldNexusFileNames(oldNeXusFileNames), m_event_id(nullptr),
-      m_event_time_of_flight(nullptr), m_have_weight(false),
-      m_event_weight(nullptr), m_framePeriodNumbers(framePeriodNumbers) {
-  setMutex(ioMutex);
+      m_oldNexusFileNames(oldNeXusFileNames), m_min_id(0), m_max_id(0),
+      m_have_weight(false), m_ioMutex(ioMutex),
+      m_framePeriodNumbers(framePeriodNumbers) {
   m_cost = static_cast<double>(numEvents);
-  m_min_id = std::numeric_limits<uint32_t>::max();
-  m_max_id = 0;
+}
+
+/** @param numEvents :: the number of events in a bank
+ * @return the number of blocks the bank is read in
+ */
+size_t LoadBankFromDiskTask::numberOfBlocks(const size_t numEvents) {
+  return std::max(size_t(1),
+                  (numEvents + EVENTS_PER_BLOCK - 1) / EVENTS_PER_BLOCK);
+}
+
+/** @param numEvents :: the number of events in a bank
+ * @return the number of ranges the pixel IDs of the bank are split into, at
+ * most
+ */
+size_t LoadBankFromDiskTask::numberOfRanges(const size_t numEvents) {
+  return std::max(
+      size_t(1),
+      std::min(MAX_RANGES,
+               (numEvents + EVENTS_PER_RANGE - 1) / EVENTS_PER_RANGE));
 }
 
 /** Load the pulse times, if needed. This sets
@@ -105,7 +132,7 @@ void LoadBankFromDiskTask::loadEventIndex(::NeXus::File &file,
   }
 }
 
-/** Open the event_id field and validate the contents
+/** Work out the range of events to load from the event_id field
 *
 * @param file :: File handle for the NeXus file
 * @param start_event :: set to the index of the first event
@@ -175,17 +202,30 @@ void LoadBankFromDiskTask::prepareEventId(::NeXus::File &file,
   m_loader.alg->getLogger().debug() << entry_name << ": start_event "
                                     << start_event << " stop_event "
                                     << stop_event << "\n";
+
+  file.closeData();
 }
 
-/** Load the event_id field, which has been open
+/** Load the event_id field of a block of events and find the range of pixel
+* IDs in the block
+* @param file :: File handle for the NeXus file
+* @param block :: the block to fill
+* @return true if some of the pixel IDs are within [m_min_id, m_max_id]
 */
-void LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
+bool LoadBankFromDiskTask::loadEventId(::NeXus::File &file,
+                                       EventBlock &block) {
+  // Get the list of pixel ID's
+  if (m_oldNexusFileNames)
+    file.openData("event_pixel_id");
+  else
+    file.openData("event_id");
+
   // This is the data size
   ::NeXus::Info id_info = file.getInfo();
   int64_t dim0 = recalculateDataSize(id_info.dims[0]);
 
-  // Now we allocate the required arrays
-  m_event_id = new uint32_t[m_loadSize[0]];
+  // Now we size the buffer, reusing its memory if possible
+  block.eventId.resize(m_loadSize[0]);
 
   // Check that the required space is there in the file.
   if (dim0 < m_loadSize[0] + m_loadStart[0]) {
@@ -199,55 +239,49 @@ void LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
   if (m_loader.alg->getCancel())
     m_loadError = true; // To allow cancelling the algorithm
 
-  if (!m_loadError) {
-    // Must be uint32
-    if (id_info.type == ::NeXus::UINT32)
-      file.getSlab(m_event_id, m_loadStart, m_loadSize);
-    else {
-      m_loader.alg->getLogger().warning()
-          << "Entry " << entry_name
-          << "'s event_id field is not UINT32! It will be skipped.\n";
-      m_loadError = true;
-    }
-    file.closeData();
+  if (m_loadError)
+    return false;
 
-    // determine the range of pixel ids
-    for (auto i = 0; i < m_loadSize[0]; ++i) {
-      uint32_t temp = m_event_id[i];
-      if (temp < m_min_id)
-        m_min_id = temp;
-      if (temp > m_max_id)
-        m_max_id = temp;
-    }
+  // Must be uint32
+  if (id_info.type == ::NeXus::UINT32)
+    file.getSlab(block.eventId.data(), m_loadStart, m_loadSize);
+  else {
+    m_loader.alg->getLogger().warning()
+        << "Entry " << entry_name
+        << "'s event_id field is not UINT32! It will be skipped.\n";
+    m_loadError = true;
+    return false;
+  }
+  file.closeData();
 
-    if (m_min_id > static_cast<uint32_t>(m_loader.eventid_max)) {
-      // All the detector IDs in the bank are higher than the highest 'known'
-      // (from the IDF)
-      // ID. Setting this will abort the loading of the bank.
-      m_loadError = true;
-    }
-    // fixup the minimum pixel id in the case that it's lower than the lowest
-    // 'known' id. We test this by checking that when we add the offset we
-    // would not get a negative index into the vector. Note that m_min_id is
-    // a uint so we have to be cautious about adding it to an int which may be
-    // negative.
-    if (static_cast<int32_t>(m_min_id) + m_loader.pixelID_to_wi_offset < 0) {
-      m_min_id = static_cast<uint32_t>(abs(m_loader.pixelID_to_wi_offset));
-    }
-    // fixup the maximum pixel id in the case that it's higher than the
-    // highest 'known' id
-    if (m_max_id > static_cast<uint32_t>(m_loader.eventid_max))
-      m_max_id = static_cast<uint32_t>(m_loader.eventid_max);
+  // determine the range of pixel ids
+  uint32_t min_id = std::numeric_limits<uint32_t>::max();
+  uint32_t max_id = 0;
+  for (const auto id : block.eventId) {
+    if (id < min_id)
+      min_id = id;
+    if (id > max_id)
+      max_id = id;
   }
+
+  // Restrict it to the IDs that can be loaded. Note that m_min_id and
+  // m_max_id are not negative.
+  if (min_id > static_cast<uint32_t>(m_max_id) ||
+      max_id < static_cast<uint32_t>(m_min_id))
+    return false;
+  block.minId = std::max(m_min_id, static_cast<detid_t>(min_id));
+  block.maxId = static_cast<detid_t>(
+      std::min(max_id, static_cast<uint32_t>(m_max_id)));
+  return true;
 }
 
-/** Open and load the times-of-flight data
+/** Open and load the times-of-flight data of a block of events
+* @param file :: File handle for the NeXus file
+* @param block :: the block to fill
 */
-void LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
-  // Allocate the array
-  auto temp = new float[m_loadSize[0]];
-  delete[] m_event_time_of_flight;
-  m_event_time_of_flight = temp;
+void LoadBankFromDiskTask::loadTof(::NeXus::File &file, EventBlock &block) {
+  // Size the buffer
+  block.timeOfFlight.resize(m_loadSize[0]);
 
   // Get the list of event_time_of_flight's
   if (!m_oldNexusFileNames)
@@ -267,7 +301,7 @@ void LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
 
   // Check that the type is what it is supposed to be
   if (tof_info.type == ::NeXus::FLOAT32)
-    file.getSlab(m_event_time_of_flight, m_loadStart, m_loadSize);
+    file.getSlab(block.timeOfFlight.data(), m_loadStart, m_loadSize);
   else {
     m_loader.alg->getLogger().warning()
         << "Entry " << entry_name
@@ -288,24 +322,26 @@ void LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
   } // no error
 }
 
-/** Load weight of weigthed events
+/** Load weight of weigthed events of a block of events
+* @param file :: File handle for the NeXus file
+* @param block :: the block to fill
 */
-void LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
+void LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file,
+                                            EventBlock &block) {
   try {
     // First, get info about the event_weight field in this bank
     file.openData("event_weight");
   } catch (::NeXus::Exception &) {
     // Field not found error is most likely.
     m_have_weight = false;
+    block.weight.clear();
     return;
   }
   // OK, we've got them
   m_have_weight = true;
 
-  // Allocate the array
-  auto temp = new float[m_loadSize[0]];
-  delete[] m_event_weight;
-  m_event_weight = temp;
+  // Size the buffer
+  block.weight.resize(m_loadSize[0]);
 
   ::NeXus::Info weight_info = file.getInfo();
   int64_t weight_dim0 = recalculateDataSize(weight_info.dims[0]);
@@ -318,7 +354,7 @@ void LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
 
   // Check that the type is what it is supposed to be
   if (weight_info.type == ::NeXus::FLOAT32)
-    file.getSlab(m_event_weight, m_loadStart, m_loadSize);
+    file.getSlab(block.weight.data(), m_loadStart, m_loadSize);
   else {
     m_loader.alg->getLogger().warning()
         << "Entry " << entry_name
@@ -331,26 +367,150 @@ void LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
   }
 }
 
+/** Set the limits of the pixel IDs that can be loaded from the bank
+* @return false if no pixel ID can be loaded
+*/
+bool LoadBankFromDiskTask::setIdLimits() {
+  // IDs below this would give a negative index into the pixelID_to_wi_vector
+  m_min_id = std::max(0, -m_loader.pixelID_to_wi_offset);
+  // IDs above the highest 'known' ID cannot be placed
+  m_max_id = m_loader.eventid_max;
+  // Restrict to the range of spectra requested, if any
+  const int32_t minSpectraToLoad = m_loader.alg->m_specMin;
+  const int32_t maxSpectraToLoad = m_loader.alg->m_specMax;
+  if (minSpectraToLoad != EMPTY_INT() && minSpectraToLoad > m_min_id)
+    m_min_id = minSpectraToLoad;
+  if (maxSpectraToLoad != EMPTY_INT() && maxSpectraToLoad < m_max_id)
+    m_max_id = maxSpectraToLoad;
+  return m_min_id <= m_max_id;
+}
+
+/** Split the pixel IDs of the bank into the ranges processed by separate
+* tasks, so that each range holds about as many events. The number of events
+* per pixel ID is estimated from the first block of events.
+* @param firstBlock :: the first block of events read
+* @param numEvents :: the number of events to load from the bank
+*/
+void LoadBankFromDiskTask::setupRanges(const EventBlock &firstBlock,
+                                       const size_t numEvents) {
+  m_rangeMin.assign(1, m_min_id);
+  m_rangeMax.assign(1, m_max_id);
+  const size_t numRanges = numberOfRanges(numEvents);
+  if (numRanges > 1 && firstBlock.maxId > firstBlock.minId) {
+    std::vector<uint32_t> ids;
+    ids.reserve(firstBlock.size());
+    for (const auto id : firstBlock.eventId)
+      if (static_cast<detid_t>(id) >= firstBlock.minId &&
+          static_cast<detid_t>(id) <= firstBlock.maxId)
+        ids.push_back(id);
+    std::sort(ids.begin(), ids.end());
+    // Each range starts at the pixel ID of a quantile of the events. A pixel
+    // holding more events than a range makes for fewer ranges.
+    for (size_t range = 1; range < numRanges; ++range) {
+      const auto first =
+          static_cast<detid_t>(ids[range * ids.size() / numRanges]);
+      if (first <= m_rangeMin.back())
+        continue;
+      m_rangeMax.back() = first - 1;
+      m_rangeMin.push_back(first);
+      m_rangeMax.push_back(m_max_id);
+    }
+  }
+  m_pipeline->setNumberOfRanges(m_rangeMin.size());
+  m_usedDetIds.clear();
+  for (size_t range = 0; range < m_rangeMin.size(); ++range)
+    m_usedDetIds.push_back(boost::make_shared<UsedDetIds>());
+}
+
+/** Sort the events of a block by pixel range, so that the tasks of each range
+* only go through their own events rather than the whole block. Nothing is
+* done for a bank with a single range.
+* @param block :: the events read from the file
+*/
+void LoadBankFromDiskTask::bucketByRange(EventBlock &block) const {
+  const size_t numRanges = m_rangeMin.size();
+  if (numRanges < 2) {
+    block.rangeEvents.clear();
+    return;
+  }
+  block.rangeEvents.resize(numRanges);
+  for (auto &events : block.rangeEvents)
+    events.clear();
+  const auto rangesBegin = m_rangeMin.cbegin();
+  const auto rangesEnd = m_rangeMin.cend();
+  const detid_t minId = std::max(m_rangeMin.front(), block.minId);
+  const detid_t maxId = std::min(m_rangeMax.back(), block.maxId);
+  const size_t numEvents = block.size();
+  for (size_t i = 0; i < numEvents; ++i) {
+    const auto id = static_cast<detid_t>(block.eventId[i]);
+    if (id < minId || id > maxId)
+      continue;
+    // The ranges are contiguous: find the last one starting at or below id
+    const auto range = std::upper_bound(rangesBegin, rangesEnd, id) - 1;
+    block.rangeEvents[range - rangesBegin].push_back(static_cast<uint32_t>(i));
+  }
+}
+
+/** Get an empty block to read events into. When all blocks are in use, the
+* queued blocks are processed here rather than waiting for other threads.
+* @return the block
+*/
+boost::shared_ptr<EventBlock> LoadBankFromDiskTask::acquireBlock() {
+  while (true) {
+    auto block = m_pipeline->tryAcquire();
+    if (block)
+      return block;
+    bool processed = false;
+    for (size_t range = 0; range < m_pipeline->numberOfRanges(); ++range) {
+      std::unique_lock<std::mutex> lock(*m_pipeline->rangeMutex(range),
+                                        std::try_to_lock);
+      if (lock.owns_lock() && m_pipeline->hasQueued(range)) {
+        std::unique_ptr<Kernel::Task> task(createProcessTask(range, 0));
+        task->run();
+        processed = true;
+      }
+    }
+    // Another thread is busy with the blocks of every range
+    if (!processed)
+      m_pipeline->waitForRelease();
+  }
+}
+
+/** Create a task processing the next block of a range
+* @param range :: the pixel range
+* @param numEvents :: the number of events in the block, used as the cost
+* @return the new task
+*/
+Kernel::Task *LoadBankFromDiskTask::createProcessTask(const size_t range,
+                                                      const size_t numEvents) {
+  return new ProcessBankData(m_loader, entry_name, prog, m_pipeline, range,
+                             numEvents, m_eventIndex, thisBankPulseTimes,
+                             m_have_weight, m_usedDetIds[range],
+                             m_rangeMin[range], m_rangeMax[range]);
+}
+
 void LoadBankFromDiskTask::run() {
   // The vectors we will be filling
-  auto event_index_ptr = new std::vector<uint64_t>();
-  std::vector<uint64_t> &event_index = *event_index_ptr;
+  m_eventIndex = boost::make_shared<std::vector<uint64_t>>();
+  std::vector<uint64_t> &event_index = *m_eventIndex;
 
   // These give the limits in each file as to which events we actually load
   // (when filtering by time).
   m_loadStart.resize(1, 0);
   m_loadSize.resize(1, 0);
 
-  // Data arrays
-  m_event_id = nullptr;
-  m_event_time_of_flight = nullptr;
-  m_event_weight = nullptr;
-
   m_loadError = false;
   m_have_weight = m_loader.m_haveWeights;
+  m_pipeline = boost::make_shared<BankEventPipeline>(MAX_BLOCKS_IN_FLIGHT);
+  m_rangeMin.clear();
+  m_rangeMax.clear();
 
   prog->report(entry_name + ": load from disk");
 
+  // The disk I/O mutex is only held while the file is read, so that other
+  // banks can be read while the events of this one are processed
+  std::unique_lock<std::mutex> ioLock(*m_ioMutex);
+
   // Open the file
   ::NeXus::File file(m_loader.alg->m_filename);
   try {
@@ -374,34 +534,68 @@ void LoadBankFromDiskTask::run() {
             << " has a mismatch between the number of event_index entries "
                "and the number of pulse times in event_time_zero.\n";
 
-      // Open and validate event_id field.
+      // Find the range of events to load
       size_t start_event = 0;
       size_t stop_event = 0;
       this->prepareEventId(file, start_event, stop_event, event_index);
 
-      // These are the arguments to getSlab()
-      m_loadStart[0] = static_cast<int>(start_event);
-      m_loadSize[0] = static_cast<int>(stop_event - start_event);
+      // Found a size that was 0 or less, or no pixel ID can be loaded: stop
+      // processing
+      if (stop_event <= start_event || !setIdLimits())
+        m_loadError = true;
+      ioLock.unlock();
+
+      // Read the events a block at a time, handing each block over to be
+      // processed while the next one is read.
+      for (size_t blockStart = start_event;
+           blockStart < stop_event && !m_loadError;
+           blockStart += EVENTS_PER_BLOCK) {
+        // These are the arguments to getSlab()
+        m_loadStart[0] = static_cast<int>(blockStart);
+        m_loadSize[0] = static_cast<int>(
+            std::min(EVENTS_PER_BLOCK, stop_event - blockStart));
+
+        auto block = acquireBlock();
+        block->startAt = blockStart;
+        block->firstBlock = m_rangeMin.empty();
+        block->lastBlock = blockStart + EVENTS_PER_BLOCK >= stop_event;
 
-      if ((m_loadSize[0] > 0) && (m_loadStart[0] >= 0)) {
         // Load pixel IDs
-        this->loadEventId(file);
+        ioLock.lock();
+        bool inRange = this->loadEventId(file, *block);
         if (m_loader.alg->getCancel())
           m_loadError = true; // To allow cancelling the algorithm
 
         // And TOF.
-        if (!m_loadError) {
-          this->loadTof(file);
+        if (!m_loadError && inRange) {
+          this->loadTof(file, *block);
           if (m_have_weight) {
-            this->loadEventWeights(file);
+            this->loadEventWeights(file, *block);
           }
         }
-      } // Size is at least 1
-      else {
-        // Found a size that was 0 or less; stop processing
-        m_loadError = true;
-      }
+        ioLock.unlock();
+        if (!m_loadError && !inRange && block->lastBlock &&
+            !m_rangeMin.empty()) {
+          // Nothing to add, but the tasks still need to see the last block
+          block->eventId.clear();
+          block->timeOfFlight.clear();
+          block->weight.clear();
+        } else if (m_loadError || !inRange) {
+          m_pipeline->recycle(block);
+          continue;
+        }
 
+        // The first block decides how the pixel IDs are split between tasks
+        if (m_rangeMin.empty())
+          setupRanges(*block, stop_event - start_event);
+        bucketByRange(*block);
+        m_pipeline->push(block);
+        for (size_t range = 0; range < m_pipeline->numberOfRanges(); ++range)
+          scheduler.push(createProcessTask(
+              range, block->rangeEvents.empty()
+                         ? block->size()
+                         : block->rangeEvents[range].size()));
+      }
     } // no error
 
   } // try block
@@ -417,80 +611,10 @@ void LoadBankFromDiskTask::run() {
   }
 
   // Close up the file even if errors occured.
+  if (!ioLock.owns_lock())
+    ioLock.lock();
   file.closeGroup();
   file.close();
-
-  // Abort if anything failed
-  if (m_loadError) {
-    delete[] m_event_id;
-    delete[] m_event_time_of_flight;
-    if (m_have_weight) {
-      delete[] m_event_weight;
-    }
-    delete event_index_ptr;
-
-    return;
-  }
-
-  const auto bank_size = m_max_id - m_min_id;
-  const uint32_t minSpectraToLoad =
-      static_cast<uint32_t>(m_loader.alg->m_specMin);
-  const uint32_t maxSpectraToLoad =
-      static_cast<uint32_t>(m_loader.alg->m_specMax);
-  const uint32_t emptyInt = static_cast<uint32_t>(EMPTY_INT());
-  // check that if a range of spectra were requested that these fit within
-  // this bank
-  if (minSpectraToLoad != emptyInt && m_min_id < minSpectraToLoad) {
-    if (minSpectraToLoad > m_max_id) { // the minimum spectra to load is more
-                                       // than the max of this bank
-      return;
-    }
-    // the min spectra to load is higher than the min for this bank
-    m_min_id = minSpectraToLoad;
-  }
-  if (maxSpectraToLoad != emptyInt && m_max_id > maxSpectraToLoad) {
-    if (maxSpectraToLoad < m_min_id) {
-      // the maximum spectra to load is less than the minimum of this bank
-      return;
-    }
-    // the max spectra to load is lower than the max for this bank
-    m_max_id = maxSpectraToLoad;
-  }
-  if (m_min_id > m_max_id) {
-    // the min is now larger than the max, this means the entire block of
-    // spectra to load is outside this bank
-    return;
-  }
-
-  // schedule the job to generate the event lists
-  auto mid_id = m_max_id;
-  if (m_loader.splitProcessing && m_max_id > (m_min_id + (bank_size / 4)))
-    // only split if told to and the section to load is at least 1/4 the size
-    // of the whole bank
-    mid_id = (m_max_id + m_min_id) / 2;
-
-  // No error? Launch a new task to process that data.
-  size_t numEvents = m_loadSize[0];
-  size_t startAt = m_loadStart[0];
-
-  // convert things to shared_arrays
-  boost::shared_array<uint32_t> event_id_shrd(m_event_id);
-  boost::shared_array<float> event_time_of_flight_shrd(m_event_time_of_flight);
-  boost::shared_array<float> event_weight_shrd(m_event_weight);
-  boost::shared_ptr<std::vector<uint64_t>> event_index_shrd(event_index_ptr);
-
-  ProcessBankData *newTask1 = new ProcessBankData(
-      m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
-      numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-      event_weight_shrd, m_min_id, mid_id);
-  scheduler.push(newTask1);
-  if (m_loader.splitProcessing && (mid_id < m_max_id)) {
-    ProcessBankData *newTask2 = new ProcessBankData(
-        m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd,
-        numEvents, startAt, event_index_shrd, thisBankPulseTimes, m_have_weight,
-        event_weight_shrd, (mid_id + 1), m_max_id);
-    scheduler.push(newTask2);
-  }
 }
 
 /**
@@ -8,6 +8,7 @@
 #include "MantidAPI/RegisterFileLoader.h"
 #include "MantidAPI/Run.h"
 #include "MantidAPI/Sample.h"
+#include "MantidDataObjects/FileBackedEventStore.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/Goniometer.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
@@ -180,6 +181,33 @@ void LoadEventNexus::init() {
       "This can significantly reduce memory use and memory fragmentation; it "
       "may also speed up loading.");
 
+  declareProperty(
+      make_unique<PropertyWithValue<bool>>("PageOutEvents", false,
+                                           Direction::Input),
+      "Keep the events in a scratch file in the temporary directory rather "
+      "than in memory (optional, default False). Each bank is paged out as "
+      "soon as it is loaded, so that files with more events than fit in "
+      "memory can be loaded. The events of a spectrum are read back when an "
+      "algorithm modifies it.");
+
+  declareProperty(
+      make_unique<PropertyWithValue<bool>>("ColumnarEvents", false,
+                                           Direction::Input),
+      "Hold the events of each spectrum as separate arrays of times of "
+      "flight, pulse times and weights (optional, default False). This "
+      "speeds up rebinning and unit conversion. It has no effect when "
+      "PageOutEvents is set.");
+
+  declareProperty(
+      make_unique<PropertyWithValue<double>>("CompressedStorageTofResolution",
+                                             -1.0, Direction::Input),
+      "Hold the events compressed in memory (optional, leave blank or "
+      "negative to not do). Zero keeps the times-of-flight exactly; a "
+      "positive value rounds them to multiples of this resolution (in "
+      "microseconds) to use less memory. Only events without weights can "
+      "be compressed. It has no effect when PageOutEvents or ColumnarEvents "
+      "is set.");
+
   declareProperty(make_unique<PropertyWithValue<double>>(
                       "CompressTolerance", -1.0, Direction::Input),
                   "Run CompressEvents while loading (optional, leave blank or "
@@ -856,6 +884,20 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
       static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
   longest_tof = 0.;
 
+  // Page the events out to a scratch file as the banks are loaded
+  const bool pageOut = getProperty("PageOutEvents");
+  if (pageOut) {
+    const size_t eventSize =
+        haveWeights ? sizeof(WeightedEvent) : sizeof(TofEvent);
+    const size_t totalEvents = std::accumulate(
+        bankNumEvents.cbegin(), bankNumEvents.cend(), static_cast<size_t>(0));
+    // Leave room for the lists that are paged in, modified and paged out
+    // again before the space of their old page can be reused
+    const size_t capacity = 2 * totalEvents * eventSize + (64 << 20);
+    m_ws->setEventStore(boost::make_shared<FileBackedEventStore>(
+        ConfigService::Instance().getTempDir(), capacity));
+  }
+
   bool loaded{false};
   if (canUseParallelLoader(haveWeights, oldNeXusFileNames, classType)) {
     auto ws = m_ws->getSingleHeldWorkspace();
@@ -929,6 +971,20 @@ void LoadEventNexus::loadEvents(API::Progress *const prog,
 
   // if there is time_of_flight load it
   loadTimeOfFlight(m_ws, m_top_entry_name, classType);
+
+  // Page out the lists brought back into memory since they were loaded
+  const bool columnar = getProperty("ColumnarEvents");
+  const double compressedTofResolution =
+      getProperty("CompressedStorageTofResolution");
+  if (pageOut)
+    m_ws->pageOutEvents();
+  else if (columnar)
+    m_ws->switchToColumns();
+  else if (compressedTofResolution == 0.)
+    m_ws->switchToCompressed(CompressedEventList::TofEncoding::Double, 0.);
+  else if (compressedTofResolution > 0.)
+    m_ws->switchToCompressed(CompressedEventList::TofEncoding::Quantised,
+                             compressedTofResolution);
 }
 
 //-----------------------------------------------------------------------------
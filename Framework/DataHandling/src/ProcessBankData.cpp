@@ -1,36 +1,90 @@
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
+#include "MantidDataObjects/FileBackedEventStore.h"
+
+#include <algorithm>
 
 using namespace Mantid::DataObjects;
 
 namespace Mantid {
 namespace DataHandling {
 
+/** Extend the flags to cover a span of pixel IDs. Flags already set are kept.
+ * @param minId :: the smallest pixel ID to cover
+ * @param maxId :: the largest pixel ID to cover
+ */
+void UsedDetIds::cover(const detid_t minId, const detid_t maxId) {
+  if (used.empty()) {
+    firstId = minId;
+    used.assign(static_cast<size_t>(maxId - minId) + 1, false);
+    return;
+  }
+  if (minId < firstId) {
+    used.insert(used.begin(), static_cast<size_t>(firstId - minId), false);
+    firstId = minId;
+  }
+  const size_t size = static_cast<size_t>(maxId - firstId) + 1;
+  if (size > used.size())
+    used.resize(size, false);
+}
+
 ProcessBankData::ProcessBankData(
     DefaultEventLoader &m_loader, std::string entry_name, API::Progress *prog,
-    boost::shared_array<uint32_t> event_id,
-    boost::shared_array<float> event_time_of_flight, size_t numEvents,
-    size_t startAt, boost::shared_ptr<std::vector<uint64_t>> event_index,
+    boost::shared_ptr<BankEventPipeline> pipeline, size_t range,
+    size_t numEvents, boost::shared_ptr<std::vector<uint64_t>> event_index,
     boost::shared_ptr<BankPulseTimes> thisBankPulseTimes, bool have_weight,
-    boost::shared_array<float> event_weight, detid_t min_event_id,
+    boost::shared_ptr<UsedDetIds> usedDetIds, detid_t min_event_id,
     detid_t max_event_id)
     : Task(), m_loader(m_loader), entry_name(entry_name),
       pixelID_to_wi_vector(m_loader.pixelID_to_wi_vector),
       pixelID_to_wi_offset(m_loader.pixelID_to_wi_offset), prog(prog),
-      event_id(event_id), event_time_of_flight(event_time_of_flight),
-      numEvents(numEvents), startAt(startAt), event_index(event_index),
+      m_pipeline(pipeline), m_range(range), event_index(event_index),
       thisBankPulseTimes(thisBankPulseTimes), have_weight(have_weight),
-      event_weight(event_weight), m_min_id(min_event_id),
+      m_usedDetIds(usedDetIds), m_min_id(min_event_id),
       m_max_id(max_event_id) {
   // Cost is approximately proportional to the number of events to process.
   m_cost = static_cast<double>(numEvents);
+  // Blocks of one range must not be processed concurrently
+  auto rangeMutex = pipeline->rangeMutex(range);
+  setMutex(rangeMutex);
 }
 
-/** Run the data processing
- * FIXME/TODO - split run() into readable methods
+/** Process the oldest block waiting for this task's range. The tasks of a
+ * range are interchangeable: the reader may already have processed the block
+ * this task was created for, in which case there is nothing to do.
  */
-void ProcessBankData::run() { // override {
+void ProcessBankData::run() {
+  auto block = m_pipeline->pop(m_range);
+  if (!block)
+    return;
+  try {
+    processBlock(*block);
+  } catch (...) {
+    m_pipeline->release(block);
+    throw;
+  }
+  m_pipeline->release(block);
+}
+
+/** Add the events of a block that fall in this task's pixel range to the
+ * event lists
+ * @param block :: the events read from the file
+ */
+void ProcessBankData::processBlock(const EventBlock &block) {
+  // Only the events of this range, if the reader sorted them by range
+  const uint32_t *rangeEvents =
+      block.rangeEvents.empty() ? nullptr : block.rangeEvents[m_range].data();
+  const size_t numEvents = rangeEvents ? block.rangeEvents[m_range].size()
+                                       : block.size();
+  const size_t startAt = block.startAt;
+  const uint32_t *event_id = block.eventId.data();
+  const float *event_time_of_flight = block.timeOfFlight.data();
+  const float *event_weight = block.weight.data();
+  // Only the pixel IDs present in the block need to be looked at
+  const detid_t minId = std::max(m_min_id, block.minId);
+  const detid_t maxId = std::min(m_max_id, block.maxId);
+
   // Local tof limits
   double my_shortest_tof =
       static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
@@ -43,31 +97,8 @@ void ProcessBankData::run() { // override {
   // ---- Pre-counting events per pixel ID ----
   auto &outputWS = m_loader.m_ws;
   auto *alg = m_loader.alg;
-  if (m_loader.precount) {
-
-    std::vector<size_t> counts(m_max_id - m_min_id + 1, 0);
-    for (size_t i = 0; i < numEvents; i++) {
-      detid_t thisId = detid_t(event_id[i]);
-      if (thisId >= m_min_id && thisId <= m_max_id)
-        counts[thisId - m_min_id]++;
-    }
-
-    // Now we pre-allocate (reserve) the vectors of events in each pixel
-    // counted
-    const size_t numEventLists = outputWS.getNumberHistograms();
-    for (detid_t pixID = m_min_id; pixID <= m_max_id; pixID++) {
-      if (counts[pixID - m_min_id] > 0) {
-        size_t wi = getWorkspaceIndexFromPixelID(pixID);
-        // Find the the workspace index corresponding to that pixel ID
-        // Allocate it
-        if (wi < numEventLists) {
-          outputWS.reserveEventListAt(wi, counts[pixID - m_min_id]);
-        }
-        if (alg->getCancel())
-          break; // User cancellation
-      }
-    }
-  }
+  if (m_loader.precount && minId <= maxId)
+    reserveEvents(block, minId, maxId);
 
   // Check for canceled algorithm
   if (alg->getCancel()) {
@@ -83,32 +114,36 @@ void ProcessBankData::run() { // override {
   bool pulsetimesincreasing = true;
 
   // Index into the pulse array
-  int pulse_i = 0;
+  int pulse_i = findFirstPulse(startAt);
 
   // And there are this many pulses
   int numPulses = static_cast<int>(thisBankPulseTimes->numPulses);
-  if (numPulses > static_cast<int>(event_index->size())) {
+  if (pulse_i > numPulses && block.firstBlock)
     alg->getLogger().warning()
         << "Entry " << entry_name
-        << "'s event_index vector is smaller than the event_time_zero field. "
-           "This is inconsistent, so we cannot find pulse times for this "
-           "entry.\n";
-    // This'll make the code skip looking for any pulse times.
-    pulse_i = numPulses + 1;
-  }
+        << "'s event_index vector is smaller than the event_time_zero "
+           "field. This is inconsistent, so we cannot find pulse times for "
+           "this entry.\n";
 
   prog->report(entry_name + ": filling events");
 
   // Will we need to compress?
   bool compress = (alg->compressTolerance >= 0);
 
-  // Which detector IDs were touched? - only matters if compress is on
-  std::vector<bool> usedDetIds;
-  if (compress)
-    usedDetIds.assign(m_max_id - m_min_id + 1, false);
+  // Will the events be paged out once the bank is loaded?
+  const bool pageOut = static_cast<bool>(m_loader.eventStore);
+
+  // Which detector IDs were touched? - only matters if compress or paging
+  // out is on. This is shared by all the blocks of the range, and covers
+  // the pixel IDs of the blocks rather than all those of the range.
+  const bool trackIds = compress || pageOut;
+  UsedDetIds &usedDetIds = *m_usedDetIds;
+  if (trackIds && minId <= maxId)
+    usedDetIds.cover(minId, maxId);
 
   // Go through all events in the list
-  for (std::size_t i = 0; i < numEvents; i++) {
+  for (std::size_t n = 0; n < numEvents; n++) {
+    const std::size_t i = rangeEvents ? rangeEvents[n] : n;
     //------ Find the pulse time for this event index ---------
     if (pulse_i < numPulses - 1) {
       bool breakOut = false;
@@ -187,20 +222,21 @@ void ProcessBankData::run() { // override {
         } else
           badTofs++;
 
-        // Track all the touched wi (only necessary when compressing events,
-        // for thread safety)
-        if (compress)
-          usedDetIds[detId - m_min_id] = true;
+        // Track all the touched wi (only necessary when compressing or
+        // paging out events, for thread safety)
+        if (trackIds)
+          usedDetIds.used[detId - usedDetIds.firstId] = true;
       } // valid time-of-flight
 
     } // valid detector IDs
   }   //(for each event)
 
   //------------ Compress Events (or set sort order) ------------------
-  // Do it on all the detector IDs we touched
-  if (compress) {
-    for (detid_t pixID = m_min_id; pixID <= m_max_id; pixID++) {
-      if (usedDetIds[pixID - m_min_id]) {
+  // Do it on all the detector IDs we touched, once all blocks are in
+  if (compress && block.lastBlock) {
+    for (size_t i = 0; i < usedDetIds.used.size(); i++) {
+      if (usedDetIds.used[i]) {
+        const detid_t pixID = usedDetIds.firstId + static_cast<detid_t>(i);
         // Find the the workspace index corresponding to that pixel ID
         size_t wi = getWorkspaceIndexFromPixelID(pixID);
         auto &el = outputWS.getSpectrum(wi);
@@ -215,6 +251,9 @@ void ProcessBankData::run() { // override {
       }
     }
   }
+  // The events of the range are all in: free their memory
+  if (pageOut && block.lastBlock)
+    pageOutEvents();
   prog->report(entry_name + ": filled events");
 
   alg->getLogger().debug() << entry_name
@@ -240,7 +279,146 @@ void ProcessBankData::run() { // override {
   alg->getLogger().debug() << "Time to process " << entry_name << " " << m_timer
                            << "\n";
 #endif
-} // END-OF-RUN()
+} // END-OF-PROCESSBLOCK()
+
+/** Find the pulse the events of a block start from
+ * @param startAt :: index in the bank of the first event of the block
+ * @return the index of the last pulse beginning at or before the block, or a
+ * value past the last pulse if the pulse times cannot be used
+ */
+int ProcessBankData::findFirstPulse(const size_t startAt) const {
+  const int numPulses = static_cast<int>(thisBankPulseTimes->numPulses);
+  // This'll make the code skip looking for any pulse times.
+  if (numPulses > static_cast<int>(event_index->size()))
+    return numPulses + 1;
+  if (numPulses == 0)
+    return 0;
+  const auto firstIndex = event_index->cbegin();
+  const auto pulse =
+      std::upper_bound(firstIndex, firstIndex + numPulses, startAt);
+  return pulse == firstIndex ? 0 : static_cast<int>(pulse - firstIndex) - 1;
+}
+
+namespace {
+/** Reserve the event vectors for the events counted in a block. Several pixel
+ * IDs may share a vector, so the counts are summed per vector first.
+ * @param pending :: the vectors and the number of events counted for each
+ */
+template <typename T>
+void reserveCounted(std::vector<std::pair<std::vector<T> *, size_t>> &pending) {
+  std::sort(pending.begin(), pending.end());
+  for (auto it = pending.begin(); it != pending.end();) {
+    auto *events = it->first;
+    size_t count = 0;
+    for (; it != pending.end() && it->first == events; ++it)
+      count += it->second;
+    // Only grow vectors that would otherwise reallocate. An empty vector gets
+    // exactly the events of the block, so a bank read as a single block uses
+    // no more memory than needed; after that the capacity at least doubles,
+    // so a bank read in many blocks is not copied once per block.
+    const size_t needed = events->size() + count;
+    if (needed > events->capacity())
+      events->reserve(std::max(needed, 2 * events->capacity()));
+  }
+}
+
+/// Queue the reservation of a vector, unless the pixel has no event list
+template <typename T>
+void addPending(std::vector<std::pair<std::vector<T> *, size_t>> &pending,
+                std::vector<T> *events, const size_t count) {
+  if (events)
+    pending.emplace_back(events, count);
+}
+} // namespace
+
+/** Count the events of a block going into each event list of the range and
+ * reserve the event vectors, so that the events are then copied straight
+ * into place. The counts follow the period of each pulse and apply the
+ * time-of-flight filter, so a bank read as a single block gets exactly the
+ * memory it needs.
+ * @param block :: the events read from the file
+ * @param minId :: the smallest pixel ID to count
+ * @param maxId :: the largest pixel ID to count
+ */
+void ProcessBankData::reserveEvents(const EventBlock &block,
+                                    const detid_t minId, const detid_t maxId) {
+  auto *alg = m_loader.alg;
+  const size_t numIds = static_cast<size_t>(maxId - minId) + 1;
+  const size_t numPeriods = have_weight ? m_loader.weightedEventVectors.size()
+                                        : m_loader.eventVectors.size();
+  std::vector<size_t> counts(numPeriods * numIds, 0);
+
+  const uint32_t *rangeEvents =
+      block.rangeEvents.empty() ? nullptr : block.rangeEvents[m_range].data();
+  const size_t numEvents = rangeEvents ? block.rangeEvents[m_range].size()
+                                       : block.size();
+  const uint32_t *event_id = block.eventId.data();
+  const float *event_time_of_flight = block.timeOfFlight.data();
+  // The period only needs following from pulse to pulse if there are several
+  const int numPulses =
+      numPeriods > 1 ? static_cast<int>(thisBankPulseTimes->numPulses) : 0;
+  int pulse_i = findFirstPulse(block.startAt);
+  int periodNumber = 1;
+  size_t offset = 0;
+  for (size_t n = 0; n < numEvents; ++n) {
+    const size_t i = rangeEvents ? rangeEvents[n] : n;
+    if (pulse_i < numPulses - 1) {
+      const size_t index = i + block.startAt;
+      while (index < (*event_index)[pulse_i] ||
+             index >= (*event_index)[pulse_i + 1]) {
+        if (++pulse_i >= numPulses - 1)
+          break;
+      }
+      const int logPeriodNumber = thisBankPulseTimes->periodNumbers[pulse_i];
+      if (logPeriodNumber > 0)
+        periodNumber = logPeriodNumber;
+      offset = static_cast<size_t>(periodNumber - 1) * numIds;
+    }
+    const detid_t detId = event_id[i];
+    if (detId >= minId && detId <= maxId) {
+      const double tof = static_cast<double>(event_time_of_flight[i]);
+      if (tof >= alg->filter_tof_min && tof <= alg->filter_tof_max)
+        ++counts[offset + static_cast<size_t>(detId - minId)];
+    }
+  }
+
+  std::vector<std::pair<std::vector<WeightedEvent> *, size_t>> weighted;
+  std::vector<std::pair<std::vector<Types::Event::TofEvent> *, size_t>> tofs;
+  for (size_t period = 0; period < numPeriods; ++period) {
+    const size_t *periodCounts = counts.data() + period * numIds;
+    for (detid_t pixID = minId; pixID <= maxId; ++pixID) {
+      const size_t count = periodCounts[pixID - minId];
+      if (count == 0)
+        continue;
+      if (have_weight)
+        addPending(weighted, m_loader.weightedEventVectors[period][pixID],
+                   count);
+      else
+        addPending(tofs, m_loader.eventVectors[period][pixID], count);
+    }
+    if (alg->getCancel())
+      return; // User cancellation
+  }
+  reserveCounted(weighted);
+  reserveCounted(tofs);
+}
+
+/** Page the event lists the range added events to out to the event store,
+ * once the last block of the bank has been processed
+ */
+void ProcessBankData::pageOutEvents() {
+  const UsedDetIds &usedDetIds = *m_usedDetIds;
+  auto &outputWS = m_loader.m_ws;
+  for (size_t i = 0; i < usedDetIds.used.size(); i++) {
+    if (!usedDetIds.used[i])
+      continue;
+    const detid_t pixID = usedDetIds.firstId + static_cast<detid_t>(i);
+    const size_t wi = getWorkspaceIndexFromPixelID(pixID);
+    if (wi >= outputWS.getNumberHistograms())
+      continue;
+    outputWS.pageOutSpectrum(wi);
+  }
+}
 
 /**
  * Get the workspace index for a given pixel ID. Throws if the pixel ID is
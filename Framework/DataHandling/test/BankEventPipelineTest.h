@@ -0,0 +1,102 @@
+#ifndef MANTID_DATAHANDLING_BANKEVENTPIPELINETEST_H_
+#define MANTID_DATAHANDLING_BANKEVENTPIPELINETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/BankEventPipeline.h"
+
+#include <thread>
+
+using Mantid::DataHandling::BankEventPipeline;
+using Mantid::DataHandling::EventBlock;
+
+class BankEventPipelineTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BankEventPipelineTest *createSuite() {
+    return new BankEventPipelineTest();
+  }
+  static void destroySuite(BankEventPipelineTest *suite) { delete suite; }
+
+  void test_number_of_blocks_is_bounded() {
+    BankEventPipeline pipeline(2);
+    auto first = pipeline.tryAcquire();
+    auto second = pipeline.tryAcquire();
+    TS_ASSERT(first);
+    TS_ASSERT(second);
+    TS_ASSERT(!pipeline.tryAcquire());
+    TS_ASSERT_EQUALS(pipeline.blocksAllocated(), 2);
+
+    // A block given back unused is handed out again
+    pipeline.recycle(first);
+    TS_ASSERT_EQUALS(pipeline.tryAcquire(), first);
+  }
+
+  void test_blocks_are_popped_in_order_for_every_range() {
+    BankEventPipeline pipeline(3);
+    pipeline.setNumberOfRanges(2);
+    TS_ASSERT_EQUALS(pipeline.numberOfRanges(), 2);
+    auto first = pipeline.tryAcquire();
+    auto second = pipeline.tryAcquire();
+    pipeline.push(first);
+    pipeline.push(second);
+
+    TS_ASSERT(pipeline.hasQueued(1));
+    TS_ASSERT_EQUALS(pipeline.pop(1), first);
+    TS_ASSERT_EQUALS(pipeline.pop(1), second);
+    TS_ASSERT(!pipeline.pop(1));
+    TS_ASSERT_EQUALS(pipeline.pop(0), first);
+  }
+
+  void test_block_is_reused_once_every_range_released_it() {
+    BankEventPipeline pipeline(1);
+    pipeline.setNumberOfRanges(2);
+    auto block = pipeline.tryAcquire();
+    block->eventId.assign(1000, 5);
+    pipeline.push(block);
+    TS_ASSERT_THROWS(pipeline.setNumberOfRanges(1), const std::logic_error &);
+
+    pipeline.release(pipeline.pop(0));
+    TS_ASSERT(!pipeline.tryAcquire());
+    pipeline.release(pipeline.pop(1));
+    auto reused = pipeline.tryAcquire();
+    TS_ASSERT_EQUALS(reused, block);
+    // The buffers keep their memory
+    TS_ASSERT_LESS_THAN_EQUALS(1000, reused->eventId.capacity());
+    TS_ASSERT_EQUALS(pipeline.blocksAllocated(), 1);
+  }
+
+  void test_producer_and_consumer_threads() {
+    BankEventPipeline pipeline(2);
+    const size_t numBlocks = 200;
+    std::vector<size_t> seen;
+    std::thread consumer([&pipeline, &seen, numBlocks]() {
+      while (seen.size() < numBlocks) {
+        std::lock_guard<std::mutex> lock(*pipeline.rangeMutex(0));
+        auto block = pipeline.pop(0);
+        if (!block)
+          continue;
+        seen.push_back(block->startAt);
+        pipeline.release(block);
+      }
+    });
+    for (size_t i = 0; i < numBlocks; ++i) {
+      auto block = pipeline.tryAcquire();
+      while (!block) {
+        pipeline.waitForRelease();
+        block = pipeline.tryAcquire();
+      }
+      block->startAt = i;
+      pipeline.push(block);
+    }
+    consumer.join();
+
+    TS_ASSERT_EQUALS(seen.size(), numBlocks);
+    for (size_t i = 0; i < seen.size(); ++i)
+      TS_ASSERT_EQUALS(seen[i], i);
+    TS_ASSERT_LESS_THAN_EQUALS(pipeline.blocksAllocated(), 2);
+  }
+};
+
+#endif /* MANTID_DATAHANDLING_BANKEVENTPIPELINETEST_H_ */
@@ -0,0 +1,222 @@
+#ifndef MANTID_DATAOBJECTS_BINEDGELOOKUP_H_
+#define MANTID_DATAOBJECTS_BINEDGELOOKUP_H_
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidKernel/cow_ptr.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** BinEdgeLookup : Finds the histogram bin of many X values at once.
+
+  Histogramming events against a set of bin edges is dominated by finding the
+  bin of each event. For the common linear and logarithmic binnings the bin
+  index can be computed directly from the value instead of being searched for.
+  BinEdgeLookup classifies the bin edges once and then processes values in
+  fixed size blocks:
+
+   1. a first guess of the bin of every value in the block is computed in a
+      branch-free loop that the compiler can vectorize;
+   2. each guess is refined against the real bin edges (normally not moving
+      at all) and the value is accumulated into its bin.
+
+  The refinement step compares against the actual edges, so the result is
+  identical to a search of the edges: a value x lands in bin i when
+  X[i] <= x < X[i+1], and values outside [X[0], X[n]) or NaN are dropped.
+  Irregular binning falls back to a binary search for the first guess.
+  The bin edges are referenced, not copied, and must outlive the lookup.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL BinEdgeLookup {
+public:
+  /// How the bin edges are spaced
+  enum class Spacing { Linear, Logarithmic, Irregular };
+
+  explicit BinEdgeLookup(const MantidVec &X);
+
+  /// @return the detected spacing of the bin edges
+  Spacing spacing() const { return m_spacing; }
+  /// @return the number of bins, i.e. one less than the number of edges
+  size_t numberOfBins() const { return m_numBins; }
+
+  size_t findBin(const double x) const;
+
+  /** Add one count per event to the bin it falls into.
+   * @param events :: the events to histogram, in any order
+   * @param Y :: the counts, of size numberOfBins()
+   */
+  template <class T>
+  void addCounts(const std::vector<T> &events, MantidVec &Y) const {
+    forEachBin(events.size(),
+               [&events](const size_t i) { return events[i].tof(); },
+               [&Y](const size_t, const size_t bin) { Y[bin] += 1.0; });
+  }
+
+  /** Add the weight and the squared error of each event to its bin.
+   * @param events :: the weighted events to histogram, in any order
+   * @param Y :: the summed weights, of size numberOfBins()
+   * @param E2 :: the summed squared errors, of size numberOfBins()
+   */
+  template <class T>
+  void addWeights(const std::vector<T> &events, MantidVec &Y,
+                  MantidVec &E2) const {
+    forEachBin(events.size(),
+               [&events](const size_t i) { return events[i].tof(); },
+               [&events, &Y, &E2](const size_t i, const size_t bin) {
+                 Y[bin] += static_cast<double>(events[i].m_weight);
+                 E2[bin] += static_cast<double>(events[i].m_errorSquared);
+               });
+  }
+
+  /** Add one count per value to the bin it falls into.
+   * @param x :: the values to histogram
+   * @param n :: the number of values
+   * @param Y :: the counts, of size numberOfBins()
+   */
+  void addCounts(const double *x, const size_t n, MantidVec &Y) const {
+    forEachBin(n, [x](const size_t i) { return x[i]; },
+               [&Y](const size_t, const size_t bin) { Y[bin] += 1.0; });
+  }
+
+  /** Add the weight and the squared error of each value to its bin.
+   * @param x :: the values to histogram
+   * @param weight :: the weight of each value
+   * @param errorSquared :: the squared error of each value
+   * @param n :: the number of values
+   * @param Y :: the summed weights, of size numberOfBins()
+   * @param E2 :: the summed squared errors, of size numberOfBins()
+   */
+  void addWeights(const double *x, const float *weight,
+                  const float *errorSquared, const size_t n, MantidVec &Y,
+                  MantidVec &E2) const {
+    forEachBin(n, [x](const size_t i) { return x[i]; },
+               [weight, errorSquared, &Y, &E2](const size_t i,
+                                               const size_t bin) {
+                 Y[bin] += static_cast<double>(weight[i]);
+                 E2[bin] += static_cast<double>(errorSquared[i]);
+               });
+  }
+
+private:
+  /// Number of values whose bins are guessed in one pass
+  static constexpr size_t BLOCK_SIZE = 256;
+
+  /// Clamp a fractional bin position to a valid bin index
+  inline size_t clampToBin(double position) const {
+    // Written so NaN and -inf end up in bin 0 without branching on them
+    position = position >= 0. ? position : 0.;
+    position = position < m_lastBin ? position : m_lastBin;
+    return static_cast<size_t>(position);
+  }
+
+  /** Guess the bins of a block of values. Each guess is in
+   * [0, numberOfBins()-1]. The loops for the regular spacings have no
+   * dependencies between iterations so they can be vectorized.
+   * @param start :: index of the first value of the block
+   * @param count :: number of values in the block
+   * @param valueAt :: callable returning the i-th value
+   * @param bins :: the guesses returned
+   */
+  template <class ValueAt>
+  void guessBins(const size_t start, const size_t count, ValueAt valueAt,
+                 size_t *bins) const {
+    switch (m_spacing) {
+    case Spacing::Linear:
+      for (size_t k = 0; k < count; ++k)
+        bins[k] =
+            clampToBin((valueAt(start + k) - m_origin) * m_inverseStep);
+      break;
+    case Spacing::Logarithmic:
+      for (size_t k = 0; k < count; ++k)
+        bins[k] = clampToBin((std::log(valueAt(start + k)) - m_origin) *
+                             m_inverseStep);
+      break;
+    case Spacing::Irregular:
+      for (size_t k = 0; k < count; ++k)
+        bins[k] = irregularGuess(valueAt(start + k));
+      break;
+    }
+  }
+
+  /** Move a guessed bin to the one that really holds x.
+   * @param x :: the value, known to be within [X[0], X[n])
+   * @param bin :: the first guess
+   * @return the bin index
+   */
+  inline size_t refineBin(const double x, size_t bin) const {
+    while (x < m_edges[bin])
+      --bin;
+    while (x >= m_edges[bin + 1])
+      ++bin;
+    return bin;
+  }
+
+  /** Find the bin of every value and hand it to an accumulator.
+   * @param n :: the number of values
+   * @param valueAt :: callable returning the i-th value
+   * @param accumulate :: callable taking (i, bin) for every value in range
+   */
+  template <class ValueAt, class Accumulate>
+  void forEachBin(const size_t n, ValueAt valueAt,
+                  Accumulate accumulate) const {
+    if (m_numBins == 0)
+      return;
+    const double xMin = m_edges.front();
+    const double xMax = m_edges.back();
+    size_t bins[BLOCK_SIZE];
+    for (size_t start = 0; start < n; start += BLOCK_SIZE) {
+      const size_t count = std::min(BLOCK_SIZE, n - start);
+      guessBins(start, count, valueAt, bins);
+      for (size_t k = 0; k < count; ++k) {
+        const double x = valueAt(start + k);
+        if (x >= xMin && x < xMax)
+          accumulate(start + k, refineBin(x, bins[k]));
+      }
+    }
+  }
+
+  size_t irregularGuess(const double x) const;
+
+  /// The bin edges
+  const MantidVec &m_edges;
+  /// Number of bins
+  size_t m_numBins;
+  /// Detected spacing
+  Spacing m_spacing;
+  /// X[0] for linear binning, log(X[0]) for logarithmic binning
+  double m_origin;
+  /// Inverse of the (log) step between edges
+  double m_inverseStep;
+  /// Index of the last bin, as a double
+  double m_lastBin;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_BINEDGELOOKUP_H_ */
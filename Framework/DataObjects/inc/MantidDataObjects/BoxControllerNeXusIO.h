@@ -3,9 +3,11 @@
 
 #include "MantidAPI/IBoxControllerIO.h"
 #include "MantidAPI/BoxController.h"
+#include "MantidKernel/AsyncBlockIO.h"
 #include "MantidKernel/DiskBuffer.h"
 #include <nexus/NeXusFile.hpp>
 
+#include <memory>
 #include <mutex>
 
 namespace Mantid {
@@ -15,6 +17,7 @@ namespace DataObjects {
 /** The class responsible for saving events into nexus file using generic box
   controller interface
   * Expected to provide thread-safe file access.
+  * Blocks are written, and hinted blocks read ahead, on a background thread.
 
     @date March 15, 2013
 
@@ -64,6 +67,11 @@ public:
                  const size_t /*BlockSize*/) const override;
 
   void flushData() const override;
+  void queueFlushData() const override;
+  size_t
+  prefetchBlocks(const std::vector<std::pair<uint64_t, uint64_t>> &blocks)
+      const override;
+  void cancelPrefetch(const size_t prefetch) const override;
   void closeFile() override;
 
   ~BoxControllerNeXusIO() override;
@@ -105,6 +113,9 @@ private:
   std::vector<int64_t> m_BlockSize;
   /// lock Nexus file operations as Nexus is not thread safe
   mutable std::mutex m_fileMutex;
+  /// the background reads and writes of the events data, while the file is
+  /// opened
+  std::unique_ptr<Kernel::AsyncBlockIO> m_asyncIO;
 
   // Mainly static information which may be split into different IO classes
   // selected through chein of responsibility.
@@ -142,6 +153,7 @@ private:
   void getDiskBufferFileData();
   void prepareNxSToWrite_CurVersion();
   void prepareNxSdata_CurVersion();
+  void startAsyncIO();
   // get the event type from event name
   static EventType
   TypeFromString(const std::vector<std::string> &typesSupported,
@@ -0,0 +1,131 @@
+#ifndef MANTID_DATAOBJECTS_COMPRESSEDEVENTLIST_H_
+#define MANTID_DATAOBJECTS_COMPRESSEDEVENTLIST_H_
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidKernel/cow_ptr.h"
+#include "MantidTypes/Core/DateAndTime.h"
+#include "MantidTypes/Event/TofEvent.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+class EventList;
+
+/** CompressedEventList : A compact in-memory encoding of a list of TofEvents.
+
+  A TofEvent takes 16 bytes, but in a list of events as loaded from file the
+  pulse time changes only once every few hundred or thousand events, and the
+  time-of-flight rarely needs the full precision of a double. The compressed
+  list stores:
+
+   - the pulse times run-length encoded: one pulse time and the index of the
+     end of the run for each run of consecutive events sharing a pulse time.
+     The encoding is lossless and does not reorder the events; it is most
+     effective on lists in load order or sorted by pulse time.
+   - the times-of-flight in one of three encodings:
+       - Double: lossless, 8 bytes per event;
+       - Float: 4 bytes per event, with a relative error below 2^-24;
+       - Quantised: 4 bytes per event, rounded to a multiple of a given
+         resolution above the smallest tof, an absolute error of at most half
+         the resolution.
+     The largest error introduced by the encoding is measured on construction
+     and reported by maxTofError(). Both lossy encodings keep the tof order.
+
+  Histogramming and filtering by pulse time decode the events on the fly, in
+  blocks, without expanding the whole list. Only TOF events can be compressed.
+  An EventList holds its events this way after EventList::switchToCompressed().
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL CompressedEventList {
+public:
+  /// How the times-of-flight are stored
+  enum class TofEncoding { Double, Float, Quantised };
+
+  CompressedEventList();
+  explicit CompressedEventList(
+      const std::vector<Types::Event::TofEvent> &events,
+      TofEncoding encoding = TofEncoding::Double, double tofResolution = 0.);
+  explicit CompressedEventList(const EventList &eventList,
+                               TofEncoding encoding = TofEncoding::Double,
+                               double tofResolution = 0.);
+
+  /// Number of events held
+  size_t size() const { return m_size; }
+  /// True if there are no events
+  bool empty() const { return m_size == 0; }
+  /// The encoding of the times-of-flight
+  TofEncoding tofEncoding() const { return m_encoding; }
+  /// Number of runs of events sharing a pulse time
+  size_t numberOfPulseRuns() const { return m_pulseTime.size(); }
+  /// Largest absolute difference between a decoded and an original tof
+  double maxTofError() const { return m_maxTofError; }
+  /// True if the events are known to be sorted by time-of-flight
+  bool isSortedByTof() const { return m_sortedByTof; }
+  size_t getMemorySize() const;
+
+  void toEvents(std::vector<Types::Event::TofEvent> &events) const;
+  void copyInto(EventList &eventList) const;
+
+  void generateHistogram(const MantidVec &X, MantidVec &Y, MantidVec &E,
+                         bool skipError = false) const;
+  void filterByPulseTime(const Types::Core::DateAndTime &start,
+                         const Types::Core::DateAndTime &stop,
+                         std::vector<Types::Event::TofEvent> &output) const;
+
+private:
+  void encodeTofs(const std::vector<Types::Event::TofEvent> &events,
+                  double tofResolution);
+  void decodeTofs(const size_t begin, const size_t end, double *tofs) const;
+
+  /// Number of events held
+  size_t m_size;
+  /// Encoding of the times-of-flight
+  TofEncoding m_encoding;
+  /// Pulse time of each run, in nanoseconds since the GPS epoch
+  std::vector<int64_t> m_pulseTime;
+  /// Index one past the last event of each run
+  std::vector<size_t> m_runEnd;
+  /// Times-of-flight for the Double encoding
+  std::vector<double> m_tofDouble;
+  /// Times-of-flight for the Float encoding
+  std::vector<float> m_tofFloat;
+  /// Multiples of the resolution above the origin for the Quantised encoding
+  std::vector<uint32_t> m_tofQuantised;
+  /// Smallest tof, for the Quantised encoding
+  double m_tofOrigin;
+  /// Quantisation step, for the Quantised encoding
+  double m_tofResolution;
+  /// Largest error introduced by the tof encoding
+  double m_maxTofError;
+  /// Set when the events are known to be in ascending tof order
+  bool m_sortedByTof;
+  /// Set when the events are known to be in ascending pulse time order
+  bool m_sortedByPulseTime;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_COMPRESSEDEVENTLIST_H_ */
@@ -68,6 +68,13 @@ public:
   void apply(const coord_t *inputVector, coord_t *outVector) const override;
   Mantid::Kernel::Matrix<coord_t> makeAffineMatrix() const override;
 
+  /// @return for each output dimension, the input dimension it comes from
+  const size_t *getDimensionToBinFrom() const { return m_dimensionToBinFrom; }
+  /// @return the origin of each output dimension, sized [outD]
+  const coord_t *getOrigin() const { return m_origin; }
+  /// @return the scaling of each output dimension, sized [outD]
+  const coord_t *getScaling() const { return m_scaling; }
+
 protected:
   /// For each dimension in the output, index in the input workspace of which
   /// dimension it is
@@ -0,0 +1,128 @@
+#ifndef MANTID_DATAOBJECTS_EVENTCOLUMNS_H_
+#define MANTID_DATAOBJECTS_EVENTCOLUMNS_H_
+
+#include "MantidAPI/IEventList.h"
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/Events.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+class Unit;
+}
+namespace DataObjects {
+class EventList;
+
+/** EventColumns : A structure-of-arrays (columnar) store for neutron events.
+
+  The events held by an EventList are packed records (TofEvent, WeightedEvent
+  or WeightedEventNoTime), so any operation that only needs the time-of-flight
+  still has to stream the pulse time and weights through the cache.
+  EventColumns keeps each field in its own contiguous column:
+
+   - tof: always present
+   - pulse time (in nanoseconds): present for TOF and WEIGHTED events
+   - weight and squared error: present for WEIGHTED and WEIGHTED_NOTIME events
+
+  The event type follows the same rules as EventList, so a column store can be
+  built from any EventList (or raw event vector) and converted back without
+  loss. The tof-only operations (histogramming, tof conversion, masking,
+  sorting) touch only the columns they need.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL EventColumns {
+public:
+  EventColumns();
+  explicit EventColumns(const std::vector<Types::Event::TofEvent> &events);
+  explicit EventColumns(const std::vector<WeightedEvent> &events);
+  explicit EventColumns(const std::vector<WeightedEventNoTime> &events);
+  explicit EventColumns(const EventList &eventList);
+
+  /// The type of event that is represented by the columns
+  API::EventType getEventType() const { return m_eventType; }
+  /// Number of events held
+  size_t size() const { return m_tof.size(); }
+  /// True if there are no events
+  bool empty() const { return m_tof.empty(); }
+  /// True if the columns are known to be sorted by time-of-flight
+  bool isSortedByTof() const { return m_sortedByTof; }
+  size_t getMemorySize() const;
+
+  void clear();
+  void reserve(size_t num);
+  void addEvent(const Types::Event::TofEvent &event);
+  void addEvent(const WeightedEvent &event);
+  void addEvent(const WeightedEventNoTime &event);
+
+  /// Time-of-flight column
+  const std::vector<double> &tofs() const { return m_tof; }
+  /// Pulse time column, in nanoseconds. Empty for WEIGHTED_NOTIME.
+  const std::vector<int64_t> &pulseTimes() const { return m_pulseTime; }
+  /// Weight column. Empty for TOF events (implied weight of 1).
+  const std::vector<float> &weights() const { return m_weight; }
+  /// Squared error column. Empty for TOF events (implied error of 1).
+  const std::vector<float> &errorSquareds() const { return m_errorSquared; }
+
+  void toEvents(std::vector<Types::Event::TofEvent> &events) const;
+  void toEvents(std::vector<WeightedEvent> &events) const;
+  void toEvents(std::vector<WeightedEventNoTime> &events) const;
+  void copyInto(EventList &eventList) const;
+
+  void sortTof();
+  void generateHistogram(const MantidVec &X, MantidVec &Y, MantidVec &E,
+                         bool skipError = false) const;
+  double integrate(const double minX, const double maxX,
+                   const bool entireRange) const;
+  void convertTof(const double factor, const double offset = 0.);
+  void convertUnitsViaTof(const Kernel::Unit &fromUnit,
+                          const Kernel::Unit &toUnit);
+  void maskTof(const double tofMin, const double tofMax);
+  void reverse();
+
+private:
+  bool hasPulseTimes() const { return m_eventType != API::WEIGHTED_NOTIME; }
+  bool hasWeights() const { return m_eventType != API::TOF; }
+  template <class T> void appendColumns(const std::vector<T> &events);
+  void generateHistogramUnsorted(const MantidVec &X, MantidVec &Y,
+                                 MantidVec &E) const;
+
+  /// Time-of-flight (or whatever unit the X axis is in)
+  std::vector<double> m_tof;
+  /// Pulse times in nanoseconds since the GPS epoch
+  std::vector<int64_t> m_pulseTime;
+  /// Event weights
+  std::vector<float> m_weight;
+  /// Squared event errors
+  std::vector<float> m_errorSquared;
+  /// What type of event is in the columns
+  API::EventType m_eventType;
+  /// Set when the tof column is known to be in ascending order
+  bool m_sortedByTof;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_EVENTCOLUMNS_H_ */
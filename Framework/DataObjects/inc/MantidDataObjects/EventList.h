@@ -2,11 +2,15 @@
 #define MANTID_DATAOBJECTS_EVENTLIST_H_ 1
 
 #include "MantidAPI/IEventList.h"
+#include "MantidDataObjects/CompressedEventList.h"
 #include "MantidDataObjects/Events.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/cow_ptr.h"
+#include <boost/shared_ptr.hpp>
+#include <atomic>
 #include <iosfwd>
+#include <memory>
 #include <vector>
 
 namespace Mantid {
@@ -21,7 +25,10 @@ using TimeSplitterType = std::vector<SplittingInterval>;
 class Unit;
 } // namespace Kernel
 namespace DataObjects {
+class EventColumns;
 class EventWorkspaceMRU;
+class FileBackedEventStore;
+struct EventPage;
 
 /// How the event list is sorted.
 enum EventSortType {
@@ -70,6 +77,11 @@ enum EventSortType {
 */
 
 class DLLExport EventList : public Mantid::API::IEventList {
+  /// EventColumns converts directly into the event vectors
+  friend class EventColumns;
+  /// CompressedEventList decodes directly into the event vector
+  friend class CompressedEventList;
+
 public:
   EventList();
 
@@ -119,6 +131,7 @@ public:
    * @param event :: TofEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const Types::Event::TofEvent &event) {
+    unpackEvents();
     this->events.push_back(event);
     this->order = UNSORTED;
   }
@@ -129,6 +142,7 @@ public:
    * @param event :: WeightedEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEvent &event) {
+    unpackEvents();
     this->weightedEvents.push_back(event);
     this->order = UNSORTED;
   }
@@ -139,6 +153,7 @@ public:
    * @param event :: WeightedEventNoTime to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEventNoTime &event) {
+    unpackEvents();
     this->weightedEventsNoTime.push_back(event);
     this->order = UNSORTED;
   }
@@ -161,6 +176,18 @@ public:
   void clear(const bool removeDetIDs = true) override;
   void clearUnused();
 
+  void pageOut(FileBackedEventStore &store);
+  void pageIn() const;
+  bool isPagedOut() const;
+
+  void switchToColumns();
+  bool hasColumns() const;
+
+  void switchToCompressed(CompressedEventList::TofEncoding encoding =
+                              CompressedEventList::TofEncoding::Double,
+                          double tofResolution = 0.);
+  bool isCompressed() const;
+
   void setMRU(EventWorkspaceMRU *newMRU);
 
   void clearData() override;
@@ -305,20 +332,20 @@ public:
                    std::vector<EventList *> outputs) const;
 
   void splitByFullTime(Kernel::TimeSplitterType &splitter,
-                       std::map<int, EventList *> outputs, bool docorrection,
-                       double toffactor, double tofshift) const;
+                       const std::map<int, EventList *> &outputs,
+                       bool docorrection, double toffactor,
+                       double tofshift) const;
 
   /// Split ...
-  std::string
-  splitByFullTimeMatrixSplitter(const std::vector<int64_t> &vec_splitters_time,
-                                const std::vector<int> &vecgroups,
-                                std::map<int, EventList *> vec_outputEventList,
-                                bool docorrection, double toffactor,
-                                double tofshift) const;
+  std::string splitByFullTimeMatrixSplitter(
+      const std::vector<int64_t> &vec_splitters_time,
+      const std::vector<int> &vecgroups,
+      const std::map<int, EventList *> &vec_outputEventList, bool docorrection,
+      double toffactor, double tofshift) const;
 
   /// Split events by pulse time
   void splitByPulseTime(Kernel::TimeSplitterType &splitter,
-                        std::map<int, EventList *> outputs) const;
+                        const std::map<int, EventList *> &outputs) const;
 
   /// Split events by pulse time with Matrix splitters
   void splitByPulseTimeWithMatrix(const std::vector<int64_t> &vec_times,
@@ -398,9 +425,22 @@ private:
   /// MRU lists of the parent EventWorkspace
   mutable EventWorkspaceMRU *mru;
 
-  /// Mutex that is locked while sorting an event list
+  /// Mutex that is locked while sorting or paging in an event list
   mutable std::mutex m_sortMutex;
 
+  /// The events, while they are paged out to a FileBackedEventStore
+  mutable boost::shared_ptr<const EventPage> m_page;
+
+  /// The events, while they are held in columns (see switchToColumns())
+  mutable std::unique_ptr<EventColumns> m_columns;
+
+  /// The events, while they are compressed (see switchToCompressed())
+  mutable std::unique_ptr<CompressedEventList> m_compressed;
+
+  /// True while m_columns or m_compressed hold the events, so that
+  /// unpackEvents() only takes m_sortMutex when there is something to do
+  mutable std::atomic<bool> m_packed{false};
+
   template <class T>
   static typename std::vector<T>::const_iterator
   findFirstEvent(const std::vector<T> &events, const double seek_tof);
@@ -432,6 +472,16 @@ private:
 
   void switchToWeightedEvents();
   void switchToWeightedEventsNoTime();
+  size_t numberOfEventsInMemory() const;
+  void readPage() const;
+  /// Move the events back into the event vectors, if they are packed. This
+  /// is safe to call from several threads at once.
+  void unpackEvents() const {
+    if (m_packed.load(std::memory_order_acquire))
+      lockAndUnpackEvents();
+  }
+  void lockAndUnpackEvents() const;
+  void readPackedEvents() const;
   // should not be called externally
   void sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
                              const double seconds) const;
@@ -513,13 +563,13 @@ private:
                          typename std::vector<T> &events) const;
   template <class T>
   void splitByFullTimeHelper(Kernel::TimeSplitterType &splitter,
-                             std::map<int, EventList *> outputs,
+                             const std::map<int, EventList *> &outputs,
                              typename std::vector<T> &events, bool docorrection,
                              double toffactor, double tofshift) const;
   /// Split events by pulse time
   template <class T>
   void splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
-                              std::map<int, EventList *> outputs,
+                              const std::map<int, EventList *> &outputs,
                               typename std::vector<T> &events) const;
 
   /// Split events (template) by pulse time with matrix splitters
@@ -533,14 +583,16 @@ private:
   template <class T>
   std::string splitByFullTimeVectorSplitterHelper(
       const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-      std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
-      bool docorrection, double toffactor, double tofshift) const;
+      const std::map<int, EventList *> &outputs,
+      typename std::vector<T> &vecEvents, bool docorrection, double toffactor,
+      double tofshift) const;
 
   template <class T>
   std::string splitByFullTimeSparseVectorSplitterHelper(
       const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-      std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
-      bool docorrection, double toffactor, double tofshift) const;
+      const std::map<int, EventList *> &outputs,
+      typename std::vector<T> &vecEvents, bool docorrection, double toffactor,
+      double tofshift) const;
 
   template <class T>
   static void multiplyHelper(std::vector<T> &events, const double value,
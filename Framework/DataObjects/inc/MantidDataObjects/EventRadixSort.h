@@ -0,0 +1,76 @@
+#ifndef MANTID_DATAOBJECTS_EVENTRADIXSORT_H_
+#define MANTID_DATAOBJECTS_EVENTRADIXSORT_H_
+
+#include "MantidDataObjects/DllConfig.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** EventRadixSort : Sorts vectors of events with a least-significant-digit
+  radix sort instead of a comparison sort.
+
+  The sort keys of events have a fixed width: the tof is a double and the pulse
+  time an int64 count of nanoseconds. Both are mapped to unsigned 64-bit
+  integers that order the same way, and sorted 8 bits at a time. A histogram
+  of all 8 digits is built in a single pass over the keys and digits that are
+  identical for every event (typically the high bytes of the pulse time and
+  the sign/exponent of the tof) are skipped, so a sort usually needs far fewer
+  than 8 passes per key. The sort is stable.
+
+  Two modes are available:
+   - Records: the events themselves are moved on every pass, together with
+     their keys.
+   - KeysOnly: only the keys and a 32-bit index are moved on each pass and the
+     events are gathered into place once at the end. This is cheaper when
+     several passes are needed, or when the list is nearly sorted (as it is
+     after loading) and the final gather is almost sequential.
+  Auto chooses between the two by counting the out-of-order neighbours.
+
+  Lists that are already sorted are detected and left untouched; very short
+  lists are sorted with std::stable_sort.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL EventRadixSort {
+public:
+  /// What is moved on each pass of the sort
+  enum class Mode { Auto, Records, KeysOnly };
+
+  template <class T>
+  static void sortTof(std::vector<T> &events, Mode mode = Mode::Auto);
+  template <class T>
+  static void sortPulseTime(std::vector<T> &events, Mode mode = Mode::Auto);
+  template <class T>
+  static void sortPulseTimeTOF(std::vector<T> &events,
+                               Mode mode = Mode::Auto);
+
+  static uint64_t tofKey(const double tof);
+  static uint64_t pulseTimeKey(const int64_t nanoseconds);
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_EVENTRADIXSORT_H_ */
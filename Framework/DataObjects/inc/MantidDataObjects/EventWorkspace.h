@@ -140,6 +140,18 @@ public:
   void getIntegratedSpectra(std::vector<double> &out, const double minX,
                             const double maxX,
                             const bool entireRange) const override;
+
+  void setEventStore(boost::shared_ptr<FileBackedEventStore> store);
+  /// @return the file the events can be paged out to, if there is one
+  const boost::shared_ptr<FileBackedEventStore> &eventStore() const {
+    return m_eventStore;
+  }
+  void pageOutEvents();
+  void pageOutSpectrum(const size_t index);
+  void switchToColumns();
+  void switchToCompressed(CompressedEventList::TofEncoding encoding =
+                              CompressedEventList::TofEncoding::Double,
+                          double tofResolution = 0.);
   EventWorkspace &operator=(const EventWorkspace &other) = delete;
 
 protected:
@@ -151,7 +163,6 @@ private:
   EventWorkspace *doCloneEmpty() const override {
     return new EventWorkspace(storageMode());
   }
-
   /** A vector that holds the event list for each spectrum; the key is
    * the workspace index, which is not necessarily the pixelid.
    */
@@ -159,6 +170,9 @@ private:
 
   /// Container for the MRU lists of the event lists contained.
   mutable EventWorkspaceMRU *mru;
+
+  /// File the events are paged out to, if any
+  boost::shared_ptr<FileBackedEventStore> m_eventStore;
 };
 
 /// shared pointer to the EventWorkspace class
@@ -0,0 +1,97 @@
+#ifndef MANTID_DATAOBJECTS_FILEBACKEDEVENTSTORE_H_
+#define MANTID_DATAOBJECTS_FILEBACKEDEVENTSTORE_H_
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidKernel/MemoryMappedFile.h"
+
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <map>
+#include <mutex>
+
+namespace Mantid {
+namespace DataObjects {
+
+class FileBackedEventStore;
+
+/// The events of one EventList held in a FileBackedEventStore
+struct EventPage {
+  /// The store holding the events
+  const FileBackedEventStore *store;
+  /// Start of the events in the file, in bytes
+  size_t offset;
+  /// Space taken in the file, in bytes
+  size_t bytes;
+  /// Number of events
+  size_t numEvents;
+};
+
+/** FileBackedEventStore : A scratch file the events of EventLists can be paged
+  out to, so that an EventWorkspace can hold more events than fit in memory.
+
+  The file is memory-mapped (see Kernel::MemoryMappedFile). Pages are written
+  once and never modified: an EventList that changes after being paged in is
+  written to a new page when paged out again. A page's space is given back
+  when the last EventList referring to it lets go of it, so copies of an
+  EventList can share a page. Reads are done with sequential read-ahead and the
+  pages are dropped from memory afterwards, which leaves it to the kernel to
+  write them back and reclaim them.
+
+  The store must be created with boost::make_shared: the pages keep it alive.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_DATAOBJECTS_DLL FileBackedEventStore
+    : public boost::enable_shared_from_this<FileBackedEventStore> {
+public:
+  FileBackedEventStore(const std::string &directory, const size_t capacity);
+
+  boost::shared_ptr<const EventPage> write(const void *events,
+                                           const size_t numEvents,
+                                           const size_t eventSize);
+  void read(const EventPage &page, void *events) const;
+
+  /// @return the size of the scratch file in bytes
+  size_t capacity() const { return m_file.capacity(); }
+  size_t bytesInUse() const;
+
+private:
+  size_t allocate(const size_t bytes);
+  void release(size_t offset, const size_t bytes);
+
+  /// The scratch file
+  Kernel::MemoryMappedFile m_file;
+  /// Free space below m_end, by offset
+  std::map<size_t, size_t> m_free;
+  /// End of the space handed out so far
+  size_t m_end;
+  /// Bytes taken by pages
+  size_t m_inUse;
+  /// Guards the free space
+  mutable std::mutex m_mutex;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_FILEBACKEDEVENTSTORE_H_ */
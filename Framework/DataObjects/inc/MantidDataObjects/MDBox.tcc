@@ -605,6 +605,68 @@ TMDE(void MDBox)::integrateSphere(Mantid::API::CoordTransform &radiusTransform,
   }
 }
 
+/** Integrate the signal within many spheres in one pass over the events,
+ * giving each sphere the same sums as integrateSphere().
+ *
+ * @param spheres :: the spheres, whose outputs are added to
+ * @param indices :: the indices of the spheres to integrate
+ */
+TMDE(void MDBox)::integrateSpheres(std::vector<MDIntegrationSphere> &spheres,
+                                   const std::vector<size_t> &indices) const {
+  if (indices.empty())
+    return;
+  // If the box is cached to disk, you need to retrieve it
+  const std::vector<MDE> &events = this->getConstEvents();
+  // The signals within each shell, which are summed once sorted
+  using valAndErrorPair = std::pair<signal_t, signal_t>;
+  std::vector<std::vector<valAndErrorPair>> shellVals(indices.size());
+  for (const auto &evnt : events) {
+    const coord_t *eventCenter = evnt.getCenter();
+    for (size_t k = 0; k < indices.size(); ++k) {
+      MDIntegrationSphere &sphere = spheres[indices[k]];
+      coord_t distanceSquared = 0;
+      for (size_t d = 0; d < nd; d++) {
+        coord_t dist = eventCenter[d] - sphere.center[d];
+        distanceSquared += (dist * dist);
+      }
+      if (!(distanceSquared < sphere.radiusSquared))
+        continue;
+      if (sphere.innerRadiusSquared == 0.0) {
+        sphere.signal += static_cast<signal_t>(evnt.getSignal());
+        sphere.errorSquared += static_cast<signal_t>(evnt.getErrorSquared());
+      } else if (distanceSquared > sphere.innerRadiusSquared) {
+        const auto signal = static_cast<signal_t>(evnt.getSignal());
+        const auto errSquared = static_cast<signal_t>(evnt.getErrorSquared());
+        shellVals[k].emplace_back(signal, errSquared);
+      }
+    }
+  }
+
+  for (size_t k = 0; k < indices.size(); ++k) {
+    MDIntegrationSphere &sphere = spheres[indices[k]];
+    if (sphere.innerRadiusSquared == 0.0)
+      continue;
+    std::vector<valAndErrorPair> &vals = shellVals[k];
+    // Sort based on signal values
+    std::sort(vals.begin(), vals.end(),
+              [](const valAndErrorPair &a, const valAndErrorPair &b) {
+                return a.first < b.first;
+              });
+    // Remove top 1% of background
+    const size_t endIndex =
+        sphere.useOnePercentBackgroundCorrection
+            ? static_cast<size_t>(0.99 * static_cast<double>(vals.size()))
+            : vals.size();
+    for (size_t j = 0; j < endIndex; j++) {
+      sphere.signal += vals[j].first;
+      sphere.errorSquared += vals[j].second;
+    }
+  }
+  if (m_Saveable) {
+    m_Saveable->setBusy(false);
+  }
+}
+
 /** Integrate the signal within a sphere; for example, to perform single-crystal
  * peak integration.
  * The CoordTransform object could be used for more complex shapes, e.g.
@@ -734,9 +796,8 @@ TMDE(size_t MDBox)::buildAndAddEvents(const std::vector<signal_t> &sigErrSq,
                                       const std::vector<uint32_t> &detectorId) {
 
   size_t nEvents = sigErrSq.size() / 2;
-  size_t nExisiting = data.size();
-  data.reserve(nExisiting + nEvents);
   std::lock_guard<std::mutex> _lock(this->m_dataMutex);
+  data.reserve(data.size() + nEvents);
   IF<MDE, nd>::EXEC(this->data, sigErrSq, Coord, runIndex, detectorId, nEvents);
 
   return 0;
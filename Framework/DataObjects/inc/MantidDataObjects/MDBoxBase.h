@@ -21,6 +21,26 @@
 namespace Mantid {
 namespace DataObjects {
 
+//===============================================================================================
+/** A sphere, or spherical shell, integrated by MDBoxBase::integrateSpheres().
+ * The distance to the centre is measured along all the dimensions, as by a
+ * CoordTransformDistance using them all.
+ */
+struct MDIntegrationSphere {
+  /// The centre, with a coordinate for each dimension
+  std::vector<coord_t> center;
+  /// radius^2 below which to integrate
+  coord_t radiusSquared;
+  /// radius^2 above which to integrate
+  coord_t innerRadiusSquared;
+  /// Whether to drop the top 1% of the signals within a shell
+  bool useOnePercentBackgroundCorrection;
+  /// The integrated signal is added to this
+  signal_t signal;
+  /// The integrated squared error is added to this
+  signal_t errorSquared;
+};
+
 #ifndef __INTEL_COMPILER // As of July 13, the packing has no effect for the
                          // Intel compiler and produces a warning
 #pragma pack(push, 4)    // Ensure the structure is no larger than it needs to
@@ -133,6 +153,14 @@ public:
       const coord_t innerRadiusSquared = 0.0,
       const bool useOnePercentBackgroundCorrection = true) const override = 0;
 
+  /** Integrate many spheres in one pass over the boxes, giving each the same
+   * sums as integrateSphere().
+   * @param spheres :: the spheres, whose outputs are added to
+   * @param indices :: the indices of the spheres to integrate within this box
+   */
+  virtual void integrateSpheres(std::vector<MDIntegrationSphere> &spheres,
+                                const std::vector<size_t> &indices) const = 0;
+
   /** Find the centroid around a sphere */
   void centroidSphere(Mantid::API::CoordTransform &radiusTransform,
                       const coord_t radiusSquared, coord_t *centroid,
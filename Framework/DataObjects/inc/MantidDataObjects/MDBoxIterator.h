@@ -97,6 +97,10 @@ private:
 
   void releaseEvents() const;
 
+  void prefetchEvents() const;
+
+  void cancelPrefetch() const;
+
   /// Current position in the vector of boxes
   size_t m_pos;
 
@@ -117,6 +121,15 @@ private:
 
   // Skipping policy, controlls recursive calls to next().
   SkippingPolicy_scptr m_skippingPolicy;
+
+  /// Box controller of the boxes read ahead
+  mutable API::BoxController *m_bc;
+
+  /// Id of the read-ahead of the events of the boxes, 0 if none
+  mutable size_t m_prefetch;
+
+  /// Whether the events of the boxes left were asked to be read ahead
+  mutable bool m_prefetched;
 };
 
 } // namespace Mantid
@@ -23,7 +23,8 @@ TMDE(MDBoxIterator)::MDBoxIterator(
     API::IMDNode *topBox, size_t maxDepth, bool leafOnly,
     Mantid::Geometry::MDImplicitFunction *function)
     : m_pos(0), m_current(nullptr), m_currentMDBox(nullptr), m_events(nullptr),
-      m_skippingPolicy(new SkipMaskedBins(this)) {
+      m_skippingPolicy(new SkipMaskedBins(this)), m_bc(nullptr),
+      m_prefetch(0), m_prefetched(false) {
   commonConstruct(topBox, maxDepth, leafOnly, function);
 }
 
@@ -46,7 +47,8 @@ TMDE(MDBoxIterator)::MDBoxIterator(
     SkippingPolicy *skippingPolicy,
     Mantid::Geometry::MDImplicitFunction *function)
     : m_pos(0), m_current(nullptr), m_currentMDBox(nullptr), m_events(nullptr),
-      m_skippingPolicy(skippingPolicy) {
+      m_skippingPolicy(skippingPolicy), m_bc(nullptr), m_prefetch(0),
+      m_prefetched(false) {
   commonConstruct(topBox, maxDepth, leafOnly, function);
 }
 
@@ -98,9 +100,8 @@ TMDE(void MDBoxIterator)::commonConstruct(
 TMDE(MDBoxIterator)::MDBoxIterator(std::vector<API::IMDNode *> &boxes,
                                    size_t begin, size_t end)
     : m_pos(0), m_current(nullptr), m_currentMDBox(nullptr), m_events(nullptr),
-      m_skippingPolicy(new SkipMaskedBins(this))
-
-{
+      m_skippingPolicy(new SkipMaskedBins(this)), m_bc(nullptr),
+      m_prefetch(0), m_prefetched(false) {
   this->init(boxes, begin, end);
 }
 
@@ -136,7 +137,7 @@ TMDE(void MDBoxIterator)::init(std::vector<API::IMDNode *> &boxes, size_t begin,
 //----------------------------------------------------------------------------------------------
 /** Destructor
  */
-TMDE(MDBoxIterator)::~MDBoxIterator() {}
+TMDE(MDBoxIterator)::~MDBoxIterator() { cancelPrefetch(); }
 
 //----------------------------------------------------------------------------------------------
 /** Jump to the index^th cell.
@@ -145,6 +146,9 @@ TMDE(MDBoxIterator)::~MDBoxIterator() {}
  */
 TMDE(void MDBoxIterator)::jumpTo(size_t index) {
   releaseEvents();
+  // The boxes read ahead may no longer be the next ones
+  cancelPrefetch();
+  m_prefetched = false;
   m_pos = index;
   if (m_pos < m_max) {
     m_current = dynamic_cast<MDBoxBase<MDE, nd> *>(m_boxes[m_pos]);
@@ -193,6 +197,8 @@ TMDE(inline bool MDBoxIterator)::next(size_t skip) {
  */
 TMDE(void MDBoxIterator)::getEvents() const {
   if (!m_events) {
+    if (!m_prefetched)
+      prefetchEvents();
     if (!m_currentMDBox)
       m_currentMDBox = dynamic_cast<MDBox<MDE, nd> *>(m_current);
     if (m_currentMDBox) {
@@ -204,6 +210,31 @@ TMDE(void MDBoxIterator)::getEvents() const {
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Start reading ahead the events of the boxes left to iterate which are on
+ * file, the first time events are asked for, so that iterating over the
+ * signal alone reads nothing.
+ */
+TMDE(void MDBoxIterator)::prefetchEvents() const {
+  m_prefetched = true;
+  if (m_pos >= m_max)
+    return;
+  API::BoxController *bc = m_current->getBoxController();
+  if (!bc || !bc->isFileBacked())
+    return;
+  const std::vector<API::IMDNode *> boxesLeft(m_boxes.begin() + m_pos,
+                                              m_boxes.end());
+  m_prefetch = bc->prefetchBoxes(boxesLeft);
+  m_bc = bc;
+}
+
+/// Drop what is left of the events read ahead
+TMDE(void MDBoxIterator)::cancelPrefetch() const {
+  if (m_prefetch != 0)
+    m_bc->cancelPrefetch(m_prefetch);
+  m_prefetch = 0;
+}
+
 //----------------------------------------------------------------------------------------------
 /** After you're done with a given box, release the events list
  * (if it was retrieved)
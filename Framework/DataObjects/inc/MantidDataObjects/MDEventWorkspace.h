@@ -11,9 +11,12 @@
 #include "MantidDataObjects/MDLeanEvent.h"
 #include "MantidDataObjects/MDGridBox.h"
 #include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidDataObjects/MDMortonLayout.h"
 #include "MantidAPI/ITableWorkspace_fwd.h"
 #include "MantidAPI/IMDIterator.h"
 
+#include <mutex>
+
 namespace Mantid {
 namespace DataObjects {
 
@@ -163,6 +166,12 @@ public:
 
   size_t addEvents(const std::vector<MDE> &events);
 
+  void addEventsConcurrently(const std::vector<MDE> &events);
+
+  void appendEvents(const std::vector<MDE> &events);
+
+  void integrateSpheres(std::vector<MDIntegrationSphere> &spheres) const;
+
   std::vector<Mantid::Geometry::MDDimensionExtents<coord_t>>
   getMinimumExtents(size_t depth = 2) const override;
 
@@ -182,8 +191,13 @@ public:
    * Used in file loading */
   void setBox(API::IMDNode *box) {
     data = dynamic_cast<MDBoxBase<MDE, nd> *>(box);
+    clearMortonLayout();
   }
 
+  boost::shared_ptr<const MDMortonLayout<MDE, nd>> getMortonLayout();
+
+  void clearMortonLayout();
+
   /// Apply masking
   void
   setMDMasking(Mantid::Geometry::MDImplicitFunction *maskingRegion) override;
@@ -248,6 +262,10 @@ private:
   }
 
   Kernel::SpecialCoordinateSystem m_coordSystem;
+  /// All the events sorted along the Morton curve, built on first use
+  boost::shared_ptr<const MDMortonLayout<MDE, nd>> m_mortonLayout;
+  /// Mutex guarding m_mortonLayout
+  mutable std::mutex m_mortonLayoutMutex;
 };
 
 } // namespace DataObjects
@@ -3,6 +3,7 @@
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/ProgressBase.h"
 #include "MantidKernel/Task.h"
 #include "MantidKernel/ThreadPool.h"
@@ -26,6 +27,8 @@
 #include "MantidKernel/Memory.h"
 #include "MantidKernel/Exception.h"
 
+#include <boost/make_shared.hpp>
+
 // Test for gcc 4.4
 #if __GNUC__ > 4 ||                                                            \
     (__GNUC__ == 4 &&                                                          \
@@ -93,6 +96,7 @@ TMDE(void MDEventWorkspace)::setFileBacked(const std::string & /*fileName*/) {
  * Set filebacked on the contained box
  */
 TMDE(void MDEventWorkspace)::setFileBacked() {
+  clearMortonLayout();
   this->getBox()->setFileBacked();
 }
 /** If the workspace was filebacked, this would clear file-backed information
@@ -105,6 +109,7 @@ TMDE(void MDEventWorkspace)::setFileBacked() {
  *                              (used in destructor)
  */
 TMDE(void MDEventWorkspace)::clearFileBacked(bool LoadFileBackedData) {
+  clearMortonLayout();
   if (m_BoxController->isFileBacked()) {
     data->clearFileBacked(LoadFileBackedData);
     m_BoxController->clearFileBacked();
@@ -567,6 +572,9 @@ TMDE(size_t MDEventWorkspace)::getMemorySize() const {
   total += this->m_BoxController->getTotalNumMDBoxes() * sizeof(MDBox<MDE, nd>);
   total += this->m_BoxController->getTotalNumMDGridBoxes() *
            sizeof(MDGridBox<MDE, nd>);
+  std::lock_guard<std::mutex> lock(m_mortonLayoutMutex);
+  if (m_mortonLayout)
+    total += m_mortonLayout->getMemorySize();
   return total;
 }
 
@@ -578,6 +586,7 @@ TMDE(size_t MDEventWorkspace)::getMemorySize() const {
  * @param event :: event to add.
  */
 TMDE(size_t MDEventWorkspace)::addEvent(const MDE &event) {
+  clearMortonLayout();
   return data->addEvent(event);
 }
 
@@ -589,9 +598,108 @@ TMDE(size_t MDEventWorkspace)::addEvent(const MDE &event) {
  *        MDBox'es contained within.
  */
 TMDE(size_t MDEventWorkspace)::addEvents(const std::vector<MDE> &events) {
+  clearMortonLayout();
   return data->addEvents(events);
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Add a vector of MDEvents to the workspace from one of several threads
+ * adding events at the same time. Boxes are split as the events take them
+ * over the split threshold, so splitAllIfNeeded() is not needed afterwards.
+ * See MDGridBox::addEventsConcurrently().
+ *
+ * @param events :: const ref. to a vector of events; they will be copied into
+ *        the MDBox'es contained within.
+ * @throw std::runtime_error if the workspace is file-backed or not split into
+ *        a MDGridBox (call splitBox() first)
+ */
+TMDE(void MDEventWorkspace)::addEventsConcurrently(
+    const std::vector<MDE> &events) {
+  MDGridBox<MDE, nd> *gridBox = dynamic_cast<MDGridBox<MDE, nd> *>(data);
+  if (!gridBox || this->isFileBacked())
+    throw std::runtime_error("MDEventWorkspace::addEventsConcurrently() needs "
+                             "a workspace in memory split into a MDGridBox.");
+  clearMortonLayout();
+  gridBox->addEventsConcurrently(events);
+}
+
+//-----------------------------------------------------------------------------------------------
+/** Append a vector of MDEvents to the workspace, updating the cached totals of
+ * only the boxes that receive them, so refreshCache() is not needed
+ * afterwards. A file-backed workspace keeps its file and only the boxes that
+ * change are written to it. See MDGridBox::appendEvents().
+ *
+ * @param events :: const ref. to a vector of events within the extents of the
+ *        workspace; they will be copied into the MDBox'es contained within.
+ */
+TMDE(void MDEventWorkspace)::appendEvents(const std::vector<MDE> &events) {
+  if (events.empty())
+    return;
+  clearMortonLayout();
+  if (MDGridBox<MDE, nd> *gridBox = dynamic_cast<MDGridBox<MDE, nd> *>(data))
+    gridBox->appendEvents(events);
+  else {
+    // A single box is as quick to refresh as to update
+    data->addEvents(events);
+    data->refreshCache();
+  }
+  this->setFileNeedsUpdating(true);
+}
+
+//-----------------------------------------------------------------------------------------------
+/** Integrate the signal within many spheres, e.g. around all the peaks of a
+ * crystal, giving each the same sums as MDBoxBase::integrateSphere().
+ *
+ * The spheres are sorted along a Z-order curve through the extents and split
+ * into runs of neighbours, each integrated in one pass over the boxes, so a
+ * box partly within several spheres of a run is read once for all of them.
+ * The runs are integrated in parallel unless the workspace is file-backed,
+ * when all the spheres are integrated in a single pass.
+ *
+ * @param spheres :: the spheres, whose outputs are added to
+ */
+TMDE(void MDEventWorkspace)::integrateSpheres(
+    std::vector<MDIntegrationSphere> &spheres) const {
+  // Number of bits of the position along each dimension in a key
+  const size_t bitsPerDim = std::min(size_t(16), size_t(64) / nd);
+  const double cellsPerDim = static_cast<double>(uint64_t(1) << bitsPerDim);
+  std::vector<std::pair<uint64_t, size_t>> keys(spheres.size());
+  for (size_t i = 0; i < spheres.size(); ++i) {
+    uint64_t cell[nd];
+    for (size_t d = 0; d < nd; ++d) {
+      const double position =
+          std::floor((spheres[i].center[d] - data->getExtents(d).getMin()) /
+                     data->getExtents(d).getSize() * cellsPerDim);
+      // Spheres outside the extents go into the cells on their edges
+      cell[d] = position > 0. ? static_cast<uint64_t>(
+                                    std::min(position, cellsPerDim - 1.))
+                              : 0;
+    }
+    uint64_t key = 0;
+    for (size_t bit = bitsPerDim; bit-- > 0;)
+      for (size_t d = 0; d < nd; ++d)
+        key = (key << 1) | ((cell[d] >> bit) & 1);
+    keys[i] = std::make_pair(key, i);
+  }
+  std::sort(keys.begin(), keys.end());
+
+  const bool fileBacked = this->isFileBacked();
+  const size_t runSize =
+      fileBacked ? std::max(spheres.size(), size_t(1)) : size_t(64);
+  const auto numRuns =
+      static_cast<int>((spheres.size() + runSize - 1) / runSize);
+  PRAGMA_OMP(parallel for schedule(dynamic, 1) if (!fileBacked))
+  for (int run = 0; run < numRuns; ++run) {
+    const size_t begin = static_cast<size_t>(run) * runSize;
+    const size_t end = std::min(begin + runSize, spheres.size());
+    std::vector<size_t> indices;
+    indices.reserve(end - begin);
+    for (size_t j = begin; j < end; ++j)
+      indices.push_back(keys[j].second);
+    data->integrateSpheres(spheres, indices);
+  }
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Split the contained MDBox into a MDGridBox or MDSplitBox, if it is not
  * that already.
@@ -609,6 +717,7 @@ TMDE(void MDEventWorkspace)::splitBox() {
     gridBox = new MDGridBox<MDE, nd>(box);
     delete data;
     data = gridBox;
+    clearMortonLayout();
   }
 }
 
@@ -620,6 +729,7 @@ TMDE(void MDEventWorkspace)::splitBox() {
  *        recursive splitting. Set to NULL to do it serially.
  */
 TMDE(void MDEventWorkspace)::splitAllIfNeeded(Kernel::ThreadScheduler *ts) {
+  clearMortonLayout();
   data->splitAllIfNeeded(ts);
 }
 
@@ -656,11 +766,42 @@ TMDE(void MDEventWorkspace)::splitTrackedBoxes(Kernel::ThreadScheduler *ts) {
  * NOTE: This is performed in parallel using a threadpool.
  *  */
 TMDE(void MDEventWorkspace)::refreshCache() {
+  // The events may have been changed through the boxes
+  clearMortonLayout();
   // Function is overloaded and recursive; will check all sub-boxes
   data->refreshCache();
   // TODO ThreadPool
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Get all the events of the workspace in one array sorted along the Morton
+ * curve through its extents, for queries that would otherwise walk many
+ * boxes. The layout is built the first time it is asked for, and then kept
+ * with the workspace, taking as much memory again as the events, until the
+ * events change: it is dropped by the methods adding events or splitting
+ * boxes and by refreshCache(), which must be called after changing the
+ * events through the boxes. File-backed events are loaded.
+ *
+ * @return the layout, which is not changed once built
+ */
+template <typename MDE, size_t nd>
+boost::shared_ptr<const MDMortonLayout<MDE, nd>>
+MDEventWorkspace<MDE, nd>::getMortonLayout() {
+  std::lock_guard<std::mutex> lock(m_mortonLayoutMutex);
+  if (!m_mortonLayout)
+    m_mortonLayout = boost::make_shared<MDMortonLayout<MDE, nd>>(*data);
+  return m_mortonLayout;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** Drop the Morton layout of the events, if one was built, freeing its memory
+ * once nothing else holds it. See getMortonLayout().
+ */
+TMDE(void MDEventWorkspace)::clearMortonLayout() {
+  std::lock_guard<std::mutex> lock(m_mortonLayoutMutex);
+  m_mortonLayout.reset();
+}
+
 //  //-----------------------------------------------------------------------------------------------
 //  /** Add a large number of events to this MDEventWorkspace.
 //   * This will use a ThreadPool/OpenMP to allocate events in parallel.
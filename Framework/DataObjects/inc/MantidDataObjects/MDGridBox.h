@@ -142,6 +142,8 @@ public:
                            const std::vector<coord_t> &Coord,
                            const std::vector<uint16_t> &runIndex,
                            const std::vector<uint32_t> &detectorId) override;
+  void addEventsConcurrently(const std::vector<MDE> &events);
+  void appendEvents(const std::vector<MDE> &events);
   //----------------------------------------------------------------------------------------------------------------------
 
   void centerpointBin(MDBin<MDE, nd> &bin, bool *fullyContained) const override;
@@ -155,6 +157,8 @@ public:
       signal_t &signal, signal_t &errorSquared,
       const coord_t innerRadiusSquared = 0.0,
       const bool useOnePercentBackgroundCorrection = true) const override;
+  void integrateSpheres(std::vector<MDIntegrationSphere> &spheres,
+                        const std::vector<size_t> &indices) const override;
 
   void centroidSphere(Mantid::API::CoordTransform &radiusTransform,
                       const coord_t radiusSquared, coord_t *centroid,
@@ -214,6 +218,14 @@ private:
   /// Compute the index of the child box for the given event
   size_t calculateChildIndex(const MDE &event) const;
 
+  void groupEventsByChild(const MDE *first, const MDE *last,
+                          std::vector<MDE> &sorted,
+                          std::vector<size_t> &childStart) const;
+
+  void addEventRangeConcurrently(const MDE *first, const MDE *last);
+
+  void appendEventRange(const MDE *first, const MDE *last);
+
   /// Each dimension is split into this many equally-sized boxes
   size_t split[nd];
   /** Cumulative dimension splitting: split[n] = 1*split[0]*split[..]*split[n-1]
@@ -11,6 +11,7 @@
 #include "MantidDataObjects/MDGridBox.h"
 #include <boost/math/special_functions/round.hpp>
 #include <boost/optional.hpp>
+#include <numeric>
 #include <ostream>
 #include "MantidKernel/Strings.h"
 
@@ -1249,6 +1250,171 @@ TMDE(void MDGridBox)::integrateSphere(API::CoordTransform &radiusTransform,
   delete[] boxMightTouch;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Integrate the signal within many spheres in one pass over the boxes, giving
+ * each sphere the same sums as integrateSphere().
+ *
+ * The boxes are classified against each sphere as in integrateSphere(), but
+ * only the vertices and boxes near enough to the sphere to touch it are
+ * looked at. Each box partly within some spheres is then visited once for all
+ * of them, so its events are read once.
+ *
+ * @param spheres :: the spheres, whose outputs are added to
+ * @param indices :: the indices of the spheres to integrate
+ */
+TMDE(void MDGridBox)::integrateSpheres(
+    std::vector<MDIntegrationSphere> &spheres,
+    const std::vector<size_t> &indices) const {
+  // How many vertices does one box have? 2^nd, or bitwise shift left 1 by nd
+  // bits
+  const size_t maxVertices = 1 << nd;
+
+  // set up caches for box sizes and min box values
+  coord_t boxSize[nd];
+  coord_t minBoxVal[nd];
+  for (size_t d = 0; d < nd; ++d) {
+    boxSize[d] = static_cast<coord_t>(m_SubBoxSize[d]);
+    minBoxVal[d] = static_cast<coord_t>(this->extents[d].getMin());
+  }
+
+  /// A box within a sphere
+  struct Touch {
+    size_t box;
+    size_t sphere;
+    bool fullyContained;
+  };
+  std::vector<Touch> touches;
+  std::vector<size_t> verticesContained;
+
+  for (const size_t k : indices) {
+    const MDIntegrationSphere &sphere = spheres[k];
+    const coord_t *center = sphere.center.data();
+
+    // The range of boxes whose centres are near enough to the sphere to pass
+    // the tests below, with one more box either side for rounding
+    const double reach =
+        std::sqrt(diagonalSquared * 0.72 +
+                  std::max(sphere.radiusSquared, sphere.innerRadiusSquared));
+    size_t first[nd];
+    size_t count[nd];
+    bool anyBox = true;
+    for (size_t d = 0; d < nd; ++d) {
+      const double lo =
+          std::floor((center[d] - reach - minBoxVal[d]) / boxSize[d] - 0.5) -
+          1.;
+      const double hi =
+          std::ceil((center[d] + reach - minBoxVal[d]) / boxSize[d] - 0.5) +
+          1.;
+      const auto lastBox = static_cast<double>(split[d] - 1);
+      if (!(lo <= hi) || hi < 0. || lo > lastBox) {
+        anyBox = false;
+        break;
+      }
+      first[d] = lo < 0. ? 0 : static_cast<size_t>(lo);
+      const size_t last = hi > lastBox ? split[d] - 1 : static_cast<size_t>(hi);
+      count[d] = last - first[d] + 1;
+    }
+    if (!anyBox)
+      continue;
+
+    // Count the vertices of each box in the range within the sphere
+    size_t rangeIndexMaker[nd];
+    Kernel::Utils::NestedForLoop::SetUpIndexMaker(nd, rangeIndexMaker, count);
+    verticesContained.assign(rangeIndexMaker[nd - 1] * count[nd - 1], 0);
+    size_t vertices_max[nd];
+    for (size_t d = 0; d < nd; ++d)
+      vertices_max[d] = count[d] + 1;
+    size_t vertexIndex[nd];
+    Kernel::Utils::NestedForLoop::SetUp(nd, vertexIndex, 0);
+    size_t boxIndex[nd];
+    bool allDone = false;
+    while (!allDone) {
+      coord_t distanceSquared = 0;
+      for (size_t d = 0; d < nd; ++d) {
+        const coord_t vertexCoord =
+            static_cast<coord_t>(first[d] + vertexIndex[d]) * boxSize[d] +
+            minBoxVal[d];
+        coord_t dist = vertexCoord - center[d];
+        distanceSquared += (dist * dist);
+      }
+      if (distanceSquared < sphere.radiusSquared &&
+          distanceSquared > sphere.innerRadiusSquared) {
+        for (size_t neighb = 0; neighb < maxVertices; ++neighb) {
+          bool badIndex = false;
+          for (size_t d = 0; d < nd; d++) {
+            boxIndex[d] = vertexIndex[d] - ((neighb & ((size_t)1 << d)) >> d);
+            if (boxIndex[d] >= count[d]) {
+              badIndex = true;
+              break;
+            }
+          }
+          if (!badIndex)
+            verticesContained[Kernel::Utils::NestedForLoop::GetLinearIndex(
+                nd, boxIndex, rangeIndexMaker)]++;
+        }
+      }
+      allDone = Kernel::Utils::NestedForLoop::Increment(nd, vertexIndex,
+                                                        vertices_max);
+    }
+
+    // Classify the boxes in the range
+    Kernel::Utils::NestedForLoop::SetUp(nd, boxIndex, 0);
+    allDone = false;
+    while (!allDone) {
+      size_t childIndex[nd];
+      for (size_t d = 0; d < nd; ++d)
+        childIndex[d] = first[d] + boxIndex[d];
+      const size_t i = getLinearIndex(childIndex);
+      const size_t contained =
+          verticesContained[Kernel::Utils::NestedForLoop::GetLinearIndex(
+              nd, boxIndex, rangeIndexMaker)];
+      if (contained >= maxVertices) {
+        touches.push_back(Touch{i, k, true});
+      } else if (contained > 0) {
+        touches.push_back(Touch{i, k, false});
+      } else {
+        // There is a chance that this part of the box is within integration
+        // volume, even if no vertex of it is.
+        coord_t boxCenter[nd];
+        m_Children[i]->getCenter(boxCenter);
+        coord_t distanceSquared = 0;
+        for (size_t d = 0; d < nd; ++d) {
+          coord_t dist = boxCenter[d] - center[d];
+          distanceSquared += (dist * dist);
+        }
+        if (distanceSquared < diagonalSquared * 0.72 + sphere.radiusSquared ||
+            distanceSquared <
+                diagonalSquared * 0.72 + sphere.innerRadiusSquared)
+          touches.push_back(Touch{i, k, false});
+      }
+      allDone = Kernel::Utils::NestedForLoop::Increment(nd, boxIndex, count);
+    }
+  }
+
+  // Go through the boxes in order, so each sphere adds up its parts in the
+  // same order as integrateSphere() does
+  std::sort(touches.begin(), touches.end(),
+            [](const Touch &a, const Touch &b) { return a.box < b.box; });
+  std::vector<size_t> partial;
+  for (auto touch = touches.begin(); touch != touches.end();) {
+    const size_t i = touch->box;
+    API::IMDNode *box = m_Children[i];
+    partial.clear();
+    for (; touch != touches.end() && touch->box == i; ++touch) {
+      if (touch->fullyContained) {
+        // Use the integrated sum of signal in the box
+        spheres[touch->sphere].signal += box->getSignal();
+        spheres[touch->sphere].errorSquared += box->getErrorSquared();
+      } else {
+        partial.push_back(touch->sphere);
+      }
+    }
+    if (!partial.empty())
+      static_cast<MDBoxBase<MDE, nd> *>(box)->integrateSpheres(spheres,
+                                                               partial);
+  }
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Find the centroid of all events contained within by doing a weighted average
  * of their coordinates.
@@ -1683,6 +1849,192 @@ TMDE(inline size_t MDGridBox)::addEventUnsafe(const MDE &event) {
     return 0;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Group a range of events by the child box they fall in, with a counting
+ * sort. Events on the upper boundary of the last child box go to that box and
+ * events further out are dropped, as in addEvent().
+ *
+ * @param first :: the first event
+ * @param last :: one past the last event
+ * @param sorted :: set to the events of child 0, then of child 1, etc.
+ * @param childStart :: set to the numBoxes + 1 offsets into sorted of the
+ *        events of each child
+ */
+TMDE(void MDGridBox)::groupEventsByChild(
+    const MDE *first, const MDE *last, std::vector<MDE> &sorted,
+    std::vector<size_t> &childStart) const {
+  const size_t numEvents = static_cast<size_t>(last - first);
+  std::vector<size_t> childIndices(numEvents);
+  childStart.assign(numBoxes + 1, 0);
+  for (size_t i = 0; i < numEvents; ++i) {
+    size_t cindex = calculateChildIndex(first[i]);
+    if (cindex == numBoxes)
+      cindex = numBoxes - 1;
+    childIndices[i] = cindex;
+    if (cindex < numBoxes)
+      ++childStart[cindex + 1];
+  }
+  std::partial_sum(childStart.begin(), childStart.end(), childStart.begin());
+  sorted.resize(childStart[numBoxes]);
+  std::vector<size_t> next(childStart.begin(), childStart.end() - 1);
+  for (size_t i = 0; i < numEvents; ++i) {
+    if (childIndices[i] < numBoxes)
+      sorted[next[childIndices[i]]++] = first[i];
+  }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** Add a batch of events to the grid box, pushing them down to the deepest
+ * level. A child MDBox that the events take over the split threshold is split
+ * straight away, so no splitAllIfNeeded() is needed afterwards.
+ *
+ * Several threads may add events this way to the same tree at once. Each grid
+ * box is locked once per batch while its MDBox children are filled or split,
+ * instead of each MDBox once per event. Nothing else may modify the tree at
+ * the same time, and the tree must not be file-backed.
+ *
+ * Warning! No bounds checking is done (for performance). It must
+ * be known that the events are within the bounds of the grid box before adding.
+ *
+ * Note! nPoints, signal and error must be re-calculated using refreshCache()
+ * after all events have been added.
+ *
+ * @param events :: the events to add
+ */
+TMDE(void MDGridBox)::addEventsConcurrently(const std::vector<MDE> &events) {
+  if (!events.empty())
+    addEventRangeConcurrently(events.data(), events.data() + events.size());
+}
+
+/** Add a range of events to the grid box. See addEventsConcurrently().
+ *
+ * @param first :: the first event to add
+ * @param last :: one past the last event to add
+ */
+TMDE(void MDGridBox)::addEventRangeConcurrently(const MDE *first,
+                                                const MDE *last) {
+  std::vector<MDE> sorted;
+  std::vector<size_t> childStart;
+  groupEventsByChild(first, last, sorted, childStart);
+
+  // Fill, and if needed split, the MDBox children while this box is locked.
+  // MDGridBox children are never replaced, so they can be filled after.
+  std::vector<std::pair<MDGridBox<MDE, nd> *, size_t>> gridChildren;
+  {
+    std::lock_guard<std::mutex> _lock(this->m_dataMutex);
+    for (size_t i = 0; i < numBoxes; ++i) {
+      if (childStart[i] == childStart[i + 1])
+        continue;
+      MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(m_Children[i]);
+      if (!box) {
+        gridChildren.emplace_back(
+            static_cast<MDGridBox<MDE, nd> *>(m_Children[i]), i);
+        continue;
+      }
+      std::vector<MDE> &boxEvents = box->getEvents();
+      boxEvents.insert(boxEvents.end(), sorted.begin() + childStart[i],
+                       sorted.begin() + childStart[i + 1]);
+      box->releaseEvents();
+      if (this->m_BoxController->willSplit(box->getNPoints(),
+                                           box->getDepth())) {
+        auto gridBox = new MDGridBox<MDE, nd>(box);
+        // Track how many MDBoxes there are in the overall workspace
+        this->m_BoxController->trackNumBoxes(box->getDepth());
+        m_Children[i] = gridBox;
+        delete box;
+        // The events may all be in one of the new boxes
+        gridBox->splitAllIfNeeded(nullptr);
+      }
+    }
+  }
+  for (const auto &child : gridChildren)
+    child.first->addEventRangeConcurrently(
+        sorted.data() + childStart[child.second],
+        sorted.data() + childStart[child.second + 1]);
+}
+
+//-----------------------------------------------------------------------------------------------
+/** Append a batch of events to the grid box, pushing them down to the deepest
+ * level, and update the cached nPoints, signal, error and weight of only the
+ * boxes the events went through. This lets new events be added to a large
+ * workspace without the refreshCache() of the whole tree.
+ *
+ * The tree may be file-backed. Events are added to the boxes without loading
+ * what is on disk, and the boxes are marked to be written by the DiskBuffer,
+ * which loads and rewrites only them. A box that the events take over the
+ * split threshold is split straight away.
+ *
+ * Nothing else may modify the tree at the same time.
+ *
+ * Warning! No bounds checking is done (for performance). It must
+ * be known that the events are within the bounds of the grid box before adding.
+ *
+ * @param events :: the events to add
+ */
+TMDE(void MDGridBox)::appendEvents(const std::vector<MDE> &events) {
+  if (!events.empty())
+    appendEventRange(events.data(), events.data() + events.size());
+}
+
+/** Append a range of events to the grid box. See appendEvents().
+ *
+ * @param first :: the first event to add
+ * @param last :: one past the last event to add
+ */
+TMDE(void MDGridBox)::appendEventRange(const MDE *first, const MDE *last) {
+  std::vector<MDE> sorted;
+  std::vector<size_t> childStart;
+  groupEventsByChild(first, last, sorted, childStart);
+
+  for (size_t i = 0; i < numBoxes; ++i) {
+    if (childStart[i] == childStart[i + 1])
+      continue;
+    const MDE *childFirst = sorted.data() + childStart[i];
+    const MDE *childLast = sorted.data() + childStart[i + 1];
+
+    // Convert floats to doubles to preserve precision when adding them.
+    double signal(0), errorSquared(0);
+    for (const MDE *event = childFirst; event != childLast; ++event) {
+      signal += event->getSignal();
+      errorSquared += event->getErrorSquared();
+    }
+    const size_t numEvents = childStart[i + 1] - childStart[i];
+    nPoints += numEvents;
+    this->m_signal += signal_t(signal);
+    this->m_errorSquared += signal_t(errorSquared);
+    this->m_totalWeight += static_cast<signal_t>(numEvents);
+
+    MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(m_Children[i]);
+    if (!box) {
+      static_cast<MDGridBox<MDE, nd> *>(m_Children[i])
+          ->appendEventRange(childFirst, childLast);
+      continue;
+    }
+
+    // The cache of a box on disk holds the totals of what is on disk, so the
+    // new events are added to it as they are to what is in memory
+    for (const MDE *event = childFirst; event != childLast; ++event)
+      box->addEventUnsafe(*event);
+    box->setSignal(box->getSignal() + signal_t(signal));
+    box->setErrorSquared(box->getErrorSquared() + signal_t(errorSquared));
+    box->setTotalWeight(static_cast<signal_t>(box->getNPoints()));
+
+    if (this->m_BoxController->willSplit(box->getNPoints(),
+                                         box->getDepth())) {
+      // Loads the events on disk, if any, into the new boxes
+      auto gridBox = new MDGridBox<MDE, nd>(box);
+      this->m_BoxController->trackNumBoxes(box->getDepth());
+      m_Children[i] = gridBox;
+      delete box;
+      // Boxes written out while splitting keep the totals of what they saved
+      gridBox->splitAllIfNeeded(nullptr);
+      gridBox->refreshCache();
+    } else if (Kernel::ISaveable *const saver = box->getISaveable()) {
+      this->m_BoxController->getFileIO()->toWrite(saver);
+    }
+  }
+}
+
 /**Sets particular child MDgridBox at the index, specified by the input
 *parameters
 *@param index     -- the position of the new child in the list of GridBox
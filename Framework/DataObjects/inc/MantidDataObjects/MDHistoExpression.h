@@ -0,0 +1,114 @@
+#ifndef MANTID_DATAOBJECTS_MDHISTOEXPRESSION_H_
+#define MANTID_DATAOBJECTS_MDHISTOEXPRESSION_H_
+
+#include "MantidGeometry/MDGeometry/MDTypes.h"
+#include "MantidKernel/System.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+class MDHistoWorkspace;
+
+/** MDHistoExpression : An element-by-element arithmetic expression over
+  MDHistoWorkspaces and scalars, evaluated in a single pass.
+
+  Building an expression only records the operations, e.g.
+
+    (MDHistoExpression(a) - b) / c
+
+  and evaluateInto() then runs them over blocks of bins small enough to stay
+  in cache, in parallel, without a temporary workspace for each step. Signal,
+  error squared and number of events are propagated exactly as by the in-place
+  operations of MDHistoWorkspace, which are themselves evaluated this way.
+  Masks are left alone, as by those operations.
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport MDHistoExpression {
+public:
+  MDHistoExpression(const MDHistoWorkspace &workspace);
+  static MDHistoExpression scalar(const signal_t signal,
+                                  const signal_t error = 0.0);
+
+  MDHistoExpression &operator+=(const MDHistoExpression &rhs);
+  MDHistoExpression &operator-=(const MDHistoExpression &rhs);
+  MDHistoExpression &operator*=(const MDHistoExpression &rhs);
+  MDHistoExpression &operator/=(const MDHistoExpression &rhs);
+
+  MDHistoExpression log(double filler = 0.0) const;
+  MDHistoExpression log10(double filler = 0.0) const;
+  MDHistoExpression exp() const;
+  MDHistoExpression power(double exponent) const;
+
+  void evaluateInto(MDHistoWorkspace &out) const;
+
+private:
+  /// What a step of the expression does
+  enum class Operation {
+    Workspace,
+    Scalar,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Log,
+    Log10,
+    Exp,
+    Power
+  };
+
+  /// One step of the expression, in postfix order
+  struct Step {
+    Operation operation;
+    /// The operand of a Workspace step
+    const MDHistoWorkspace *workspace;
+    /// The signal of a Scalar step, or the filler or exponent of a function
+    signal_t value;
+    /// The error squared of a Scalar step
+    signal_t errorSquared;
+  };
+
+  MDHistoExpression() = default;
+  MDHistoExpression &append(const MDHistoExpression &rhs,
+                            const Operation operation);
+  MDHistoExpression apply(const Operation operation,
+                          const signal_t value) const;
+  uint64_t evaluateNEventsContributed() const;
+
+  /// The steps, operands before the operation using them
+  std::vector<Step> m_steps;
+};
+
+DLLExport MDHistoExpression operator+(MDHistoExpression lhs,
+                                      const MDHistoExpression &rhs);
+DLLExport MDHistoExpression operator-(MDHistoExpression lhs,
+                                      const MDHistoExpression &rhs);
+DLLExport MDHistoExpression operator*(MDHistoExpression lhs,
+                                      const MDHistoExpression &rhs);
+DLLExport MDHistoExpression operator/(MDHistoExpression lhs,
+                                      const MDHistoExpression &rhs);
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDHISTOEXPRESSION_H_ */
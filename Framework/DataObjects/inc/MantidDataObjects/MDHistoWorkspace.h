@@ -422,6 +422,8 @@ public:
   bool isMDHistoWorkspace() const override { return true; }
 
 private:
+  friend class MDHistoExpression;
+
   MDHistoWorkspace *doClone() const override {
     return new MDHistoWorkspace(*this);
   }
@@ -0,0 +1,273 @@
+#ifndef MANTID_DATAOBJECTS_MDMORTONLAYOUT_H_
+#define MANTID_DATAOBJECTS_MDMORTONLAYOUT_H_
+
+#include "MantidAPI/IMDNode.h"
+#include "MantidDataObjects/MDBin.h"
+#include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDBoxBase.h"
+#include "MantidKernel/System.h"
+
+#include "tbb/parallel_sort.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** MDMortonLayout : All the events of a MD box tree in one contiguous array,
+  sorted along the Morton (Z-order) curve through the extents of the tree.
+
+  The key of an event interleaves the bits of its cell index along each
+  dimension, most significant bits first, so every cell of a regular grid that
+  halves the extents along the dimensions in turn holds a contiguous run of
+  the array. Those cells form an implicit binary tree: a query visits the runs
+  of the cells it fully contains in one sequential pass each, checks the events
+  of the cells it crosses one by one, and never touches the rest. Nothing
+  but the sorted keys is stored to find the runs.
+
+  The layout is a read-only snapshot: the box tree it is built from is not
+  changed and later changes to it are not seen. MDEventWorkspace keeps one
+  until its events change, see MDEventWorkspace::getMortonLayout().
+
+  Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <typename MDE, size_t nd> class DLLExport MDMortonLayout {
+public:
+  /// Number of bits of the cell index along each dimension in a key
+  static const size_t BITS_PER_DIM = 64 / nd < 32 ? 64 / nd : 32;
+
+  /**
+  Constructor
+  @param box : the box tree to take the events and extents from. File-backed
+  events are loaded.
+  */
+  explicit MDMortonLayout(MDBoxBase<MDE, nd> &box) {
+    coord_t min[nd], max[nd];
+    for (size_t d = 0; d < nd; ++d) {
+      min[d] = box.getExtents(d).getMin();
+      max[d] = box.getExtents(d).getMax();
+    }
+    std::vector<API::IMDNode *> leaves;
+    box.getBoxes(leaves, 1000, true);
+    std::vector<MDE> events;
+    events.reserve(box.getNPoints());
+    for (auto leaf : leaves) {
+      auto mdBox = dynamic_cast<MDBox<MDE, nd> *>(leaf);
+      if (!mdBox)
+        continue;
+      const std::vector<MDE> &boxEvents = mdBox->getConstEvents();
+      events.insert(events.end(), boxEvents.begin(), boxEvents.end());
+      mdBox->releaseEvents();
+    }
+    initialize(std::move(events), min, max);
+  }
+
+  /**
+  Constructor
+  @param events : the events, which must lie within the extents
+  @param min : the lower extents along each dimension
+  @param max : the upper extents along each dimension
+  */
+  MDMortonLayout(std::vector<MDE> events, const coord_t *min,
+                 const coord_t *max) {
+    initialize(std::move(events), min, max);
+  }
+
+  /// @return the number of events
+  size_t getNPoints() const { return m_events.size(); }
+
+  /// @return the number of bytes of memory used by the events and keys
+  size_t getMemorySize() const {
+    return m_events.capacity() * sizeof(MDE) +
+           m_keys.capacity() * sizeof(uint64_t);
+  }
+
+  /// @return the events, in the order of their keys
+  const std::vector<MDE> &getEvents() const { return m_events; }
+
+  /**
+  @param center : coordinates of a point within the extents
+  @return the key of the point along the Morton curve
+  */
+  uint64_t getKey(const coord_t *center) const {
+    const double cellsPerDim = static_cast<double>(uint64_t(1) << BITS_PER_DIM);
+    uint64_t cell[nd];
+    for (size_t d = 0; d < nd; ++d) {
+      const double position =
+          std::floor((center[d] - m_min[d]) / m_size[d] * cellsPerDim);
+      // Points on the upper edge of the extents go into the last cell
+      cell[d] = position <= 0. ? 0 : std::min(static_cast<uint64_t>(position),
+                                             (uint64_t(1) << BITS_PER_DIM) - 1);
+    }
+    uint64_t key = 0;
+    for (size_t bit = BITS_PER_DIM; bit-- > 0;)
+      for (size_t d = 0; d < nd; ++d)
+        key = (key << 1) | ((cell[d] >> bit) & 1);
+    return key;
+  }
+
+  /**
+  Call a function on every event in a box, which includes its lower bounds and
+  excludes its upper bounds
+  @param min : the lower bounds of the box along each dimension
+  @param max : the upper bounds of the box along each dimension
+  @param func : the function, called with a const reference to each event
+  */
+  template <class Func>
+  void forEachEventInBox(const coord_t *min, const coord_t *max,
+                         Func func) const {
+    double lo[nd], hi[nd];
+    for (size_t d = 0; d < nd; ++d) {
+      lo[d] = m_min[d];
+      hi[d] = static_cast<double>(m_min[d]) + m_size[d];
+    }
+    visit(0, 0, m_keys.size(), lo, hi, min, max, func);
+  }
+
+  /**
+  Add up the signal and error squared of the events within a bin, like
+  MDBoxBase::centerpointBin()
+  @param bin : the bin, whose signal and error squared are added to
+  */
+  void centerpointBin(MDBin<MDE, nd> &bin) const {
+    forEachEventInBox(bin.m_min, bin.m_max, [&bin](const MDE &event) {
+      // Accumulate error and signal (as doubles, to preserve precision)
+      bin.m_signal += static_cast<signal_t>(event.getSignal());
+      bin.m_errorSquared += static_cast<signal_t>(event.getErrorSquared());
+    });
+  }
+
+private:
+  /// Number of bits of a key in use
+  static const size_t KEY_BITS = BITS_PER_DIM * nd;
+  /// A cell holding no more events than this is checked event by event
+  /// rather than split further
+  static const size_t MAX_EVENTS_TO_CHECK = 64;
+
+  /// Sort the events by key
+  void initialize(std::vector<MDE> events, const coord_t *min,
+                  const coord_t *max) {
+    for (size_t d = 0; d < nd; ++d) {
+      if (!(max[d] > min[d]))
+        throw std::invalid_argument(
+            "MDMortonLayout: the extents must not be empty");
+      m_min[d] = min[d];
+      m_size[d] = static_cast<double>(max[d]) - static_cast<double>(min[d]);
+    }
+    std::vector<std::pair<uint64_t, size_t>> order(events.size());
+    for (size_t i = 0; i < events.size(); ++i)
+      order[i] = std::make_pair(getKey(events[i].getCenter()), i);
+    tbb::parallel_sort(order.begin(), order.end());
+
+    m_keys.resize(order.size());
+    m_events.reserve(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      m_keys[i] = order[i].first;
+      m_events.push_back(events[order[i].second]);
+    }
+  }
+
+  /// @return true if an event lies within a box
+  static bool isInBox(const MDE &event, const coord_t *min,
+                      const coord_t *max) {
+    for (size_t d = 0; d < nd; ++d) {
+      const coord_t x = event.getCenter(d);
+      if (x < min[d] || x >= max[d])
+        return false;
+    }
+    return true;
+  }
+
+  /** Visit the events of a cell within a box
+  @param depth : the number of halvings of the extents giving the cell
+  @param first : index of the first event in the cell
+  @param last : one past the index of the last event in the cell
+  @param lo : the lower bounds of the cell, changed during the call
+  @param hi : the upper bounds of the cell, changed during the call
+  @param min : the lower bounds of the box
+  @param max : the upper bounds of the box
+  @param func : the function to call on each event in the box
+  */
+  template <class Func>
+  void visit(size_t depth, size_t first, size_t last, double *lo, double *hi,
+             const coord_t *min, const coord_t *max, Func &func) const {
+    if (first == last)
+      return;
+    // Events on the upper edge of the extents are in the cells below them, and
+    // cells and box may round differently, so only bounds strictly inside the
+    // box are trusted
+    bool inside = true;
+    for (size_t d = 0; d < nd; ++d) {
+      if (hi[d] < min[d] || lo[d] >= max[d])
+        return;
+      inside = inside && min[d] < lo[d] && hi[d] < max[d];
+    }
+    if (inside) {
+      for (size_t i = first; i < last; ++i)
+        func(m_events[i]);
+      return;
+    }
+    if (depth == KEY_BITS || last - first <= MAX_EVENTS_TO_CHECK) {
+      for (size_t i = first; i < last; ++i)
+        if (isInBox(m_events[i], min, max))
+          func(m_events[i]);
+      return;
+    }
+
+    // Halve the cell along the next dimension. The keys of the upper half
+    // have the next bit set.
+    const size_t d = depth % nd;
+    const uint64_t halfBit = uint64_t(1) << (KEY_BITS - depth - 1);
+    const uint64_t upperStart = (m_keys[first] & ~(2 * halfBit - 1)) | halfBit;
+    const size_t split = static_cast<size_t>(
+        std::lower_bound(m_keys.begin() + first, m_keys.begin() + last,
+                         upperStart) -
+        m_keys.begin());
+    const double cellLo = lo[d], cellHi = hi[d];
+    const double middle = 0.5 * (cellLo + cellHi);
+    hi[d] = middle;
+    visit(depth + 1, first, split, lo, hi, min, max, func);
+    hi[d] = cellHi;
+    lo[d] = middle;
+    visit(depth + 1, split, last, lo, hi, min, max, func);
+    lo[d] = cellLo;
+  }
+
+  /// Lower extents along each dimension
+  coord_t m_min[nd];
+  /// Size of the extents along each dimension
+  double m_size[nd];
+  /// Keys of the events, in order
+  std::vector<uint64_t> m_keys;
+  /// Events, in the order of their keys
+  std::vector<MDE> m_events;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_MDMORTONLAYOUT_H_ */
@@ -0,0 +1,117 @@
+#include "MantidDataObjects/BinEdgeLookup.h"
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Largest deviation of an edge from the model, as a fraction of a bin
+const double MAX_DEVIATION = 0.25;
+
+/**
+ * Check that every edge but the last lies within a fraction of a bin of
+ * origin + i * step.
+ * @param X :: the bin edges
+ * @param origin :: the first edge
+ * @param step :: the step between edges
+ * @return true if the edges are linearly spaced
+ */
+bool isLinear(const MantidVec &X, const double origin, const double step) {
+  if (!std::isfinite(step) || !(step > 0.))
+    return false;
+  const double tolerance = MAX_DEVIATION * step;
+  for (size_t i = 0; i + 1 < X.size(); ++i) {
+    const double expected = origin + static_cast<double>(i) * step;
+    if (!(std::abs(X[i] - expected) <= tolerance))
+      return false;
+  }
+  return true;
+}
+
+/**
+ * Check that every edge but the last lies within a fraction of a bin of
+ * origin * ratio^i.
+ * The expected edges are built by repeated multiplication to avoid evaluating
+ * a logarithm per edge.
+ * @param X :: the bin edges
+ * @param origin :: the first edge, > 0
+ * @param ratio :: the ratio between consecutive edges
+ * @return true if the edges are logarithmically spaced
+ */
+bool isLogarithmic(const MantidVec &X, const double origin,
+                   const double ratio) {
+  if (!std::isfinite(ratio) || !(ratio > 1.))
+    return false;
+  const double relativeTolerance = MAX_DEVIATION * (ratio - 1.);
+  double expected = origin;
+  for (size_t i = 0; i + 1 < X.size(); ++i) {
+    if (!(std::abs(X[i] - expected) <= relativeTolerance * expected))
+      return false;
+    expected *= ratio;
+  }
+  return true;
+}
+} // namespace
+
+/** Classify the bin edges. Linear spacing is tried first, then logarithmic
+ * spacing for positive edges. Edges that follow neither are Irregular.
+ *
+ * The last edge is not required to follow the model, as Rebin truncates (or
+ * extends) the last bin to the requested end of the range. Values in the last
+ * bin are still found exactly by the refinement against the edges.
+ *
+ * @param X :: the bin edges, sorted in ascending order
+ */
+BinEdgeLookup::BinEdgeLookup(const MantidVec &X)
+    : m_edges(X), m_numBins(X.size() > 1 ? X.size() - 1 : 0),
+      m_spacing(Spacing::Irregular), m_origin(0.), m_inverseStep(0.),
+      m_lastBin(m_numBins > 0 ? static_cast<double>(m_numBins - 1) : 0.) {
+  if (m_numBins == 0 || !(X.back() > X[m_numBins - 1]))
+    return;
+  // Fit the model to the edges that are expected to follow it
+  const size_t lastRegular = m_numBins > 1 ? m_numBins - 1 : 1;
+  const double steps = static_cast<double>(lastRegular);
+  const double step = (X[lastRegular] - X.front()) / steps;
+  if (isLinear(X, X.front(), step)) {
+    m_spacing = Spacing::Linear;
+    m_origin = X.front();
+    m_inverseStep = 1. / step;
+    return;
+  }
+  if (X.front() > 0.) {
+    const double logOrigin = std::log(X.front());
+    const double logStep = (std::log(X[lastRegular]) - logOrigin) / steps;
+    if (isLogarithmic(X, X.front(), std::exp(logStep))) {
+      m_spacing = Spacing::Logarithmic;
+      m_origin = logOrigin;
+      m_inverseStep = 1. / logStep;
+    }
+  }
+}
+
+/** Find the bin holding a single value.
+ * @param x :: the value to look up
+ * @return the index of the bin with X[i] <= x < X[i+1], or numberOfBins() if x
+ * is outside the edges
+ */
+size_t BinEdgeLookup::findBin(const double x) const {
+  if (m_numBins == 0 || !(x >= m_edges.front() && x < m_edges.back()))
+    return m_numBins;
+  size_t bin[1];
+  guessBins(0, 1, [x](const size_t) { return x; }, bin);
+  return refineBin(x, bin[0]);
+}
+
+/** Binary search for the bin of x, used as the guess for irregular edges.
+ * @param x :: the value to look up
+ * @return a bin index in [0, numberOfBins()-1]
+ */
+size_t BinEdgeLookup::irregularGuess(const double x) const {
+  const auto upper = std::upper_bound(m_edges.cbegin(), m_edges.cend(), x);
+  if (upper == m_edges.cbegin())
+    return 0;
+  return std::min(static_cast<size_t>(upper - m_edges.cbegin() - 1),
+                  m_numBins - 1);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -8,6 +8,7 @@
 #include "MantidAPI/FileFinder.h"
 #include "MantidDataObjects/MDEvent.h"
 
+#include <algorithm>
 #include <string>
 
 namespace Mantid {
@@ -163,8 +164,48 @@ bool BoxControllerNeXusIO::openFile(const std::string &fileName,
   else
     prepareNxSToWrite_CurVersion();
 
+  startAsyncIO();
   return true;
 }
+
+/** Start the thread doing the reads ahead and the writes of the events data.
+ * Its blocks are in events, each of which is a row of the data array. The
+ * memory it may hold is set in megabytes by MDWorkspace.FileIOBufferSize. */
+void BoxControllerNeXusIO::startAsyncIO() {
+  size_t fileCoordSize = m_CoordSize;
+  if (m_ReadConversion == floatToDouble)
+    fileCoordSize = sizeof(float);
+  else if (m_ReadConversion == doubleToFolat)
+    fileCoordSize = sizeof(double);
+  const size_t eventSize = static_cast<size_t>(m_BlockSize[1]) * fileCoordSize;
+
+  auto reader = [this](uint64_t position, uint64_t nPoints, char *data) {
+    std::vector<int64_t> start(2, 0);
+    std::vector<int64_t> size(m_BlockSize);
+    start[0] = static_cast<int64_t>(position);
+    size[0] = static_cast<int64_t>(nPoints);
+    std::lock_guard<std::mutex> _lock(m_fileMutex);
+    m_File->getSlab(static_cast<void *>(data), start, size);
+  };
+  auto writer = [this](uint64_t position, uint64_t nPoints, char *data) {
+    std::vector<int64_t> start(2, 0);
+    std::vector<int64_t> size(m_BlockSize);
+    start[0] = static_cast<int64_t>(position);
+    size[0] = static_cast<int64_t>(nPoints);
+    std::lock_guard<std::mutex> _lock(m_fileMutex);
+    m_File->putSlab(static_cast<void *>(data), start, size);
+  };
+  auto flusher = [this]() {
+    std::lock_guard<std::mutex> _lock(m_fileMutex);
+    m_File->flush();
+  };
+  int bufferSize(256);
+  Kernel::ConfigService::Instance().getValue("MDWorkspace.FileIOBufferSize",
+                                             bufferSize);
+  m_asyncIO.reset(new Kernel::AsyncBlockIO(
+      eventSize, reader, writer, flusher,
+      static_cast<size_t>(std::max(bufferSize, 1)) * 1024 * 1024));
+}
 /**Create group responsible for keeping events and add necessary attributes to
  * it*/
 void BoxControllerNeXusIO::CreateEventGroup() {
@@ -329,24 +370,19 @@ void BoxControllerNeXusIO::getDiskBufferFileData() {
 template <typename Type>
 void BoxControllerNeXusIO::saveGenericBlock(
     const std::vector<Type> &DataBlock, const uint64_t blockPosition) const {
-  std::vector<int64_t> start(2, 0);
-  // Specify the dimensions
-  std::vector<int64_t> dims(m_BlockSize);
-
-  std::lock_guard<std::mutex> _lock(m_fileMutex);
-  start[0] = int64_t(blockPosition);
-  dims[0] = int64_t(DataBlock.size() / this->getNDataColums());
-
-  // ugly cast but why would putSlab change the data?. This is NeXus bug which
-  // makes putSlab method non-constant
-  std::vector<Type> &mData = const_cast<std::vector<Type> &>(DataBlock);
-
+  const uint64_t nPoints = DataBlock.size() / this->getNDataColums();
   {
-    m_File->putSlab<Type>(mData, start, dims);
-
-    if (blockPosition + dims[0] > this->getFileLength())
-      this->setFileLength(blockPosition + dims[0]);
+    std::lock_guard<std::mutex> _lock(m_fileMutex);
+    if (blockPosition + nPoints > this->getFileLength())
+      this->setFileLength(blockPosition + nPoints);
   }
+
+  // the data are written in the background from a copy, so the caller may
+  // release the events straight away
+  const char *bytes = reinterpret_cast<const char *>(DataBlock.data());
+  m_asyncIO->write(blockPosition, nPoints,
+                   std::vector<char>(bytes, bytes + DataBlock.size() *
+                                                        sizeof(Type)));
 }
 
 /** Save float data block on specific position within properly opened NeXus data
@@ -382,6 +418,13 @@ void BoxControllerNeXusIO::loadGenericBlock(std::vector<Type> &Block,
     throw Kernel::Exception::FileError("Attemtp to read behind the file end",
                                        m_fileName);
 
+  // the block may have been read ahead; if not, read it here
+  Block.resize(nPoints * m_BlockSize[1]);
+  if (nPoints == 0 ||
+      m_asyncIO->takeReadAhead(blockPosition, nPoints,
+                               reinterpret_cast<char *>(Block.data())))
+    return;
+
   std::vector<int64_t> start(2, 0);
   std::vector<int64_t> size(m_BlockSize);
 
@@ -389,7 +432,6 @@ void BoxControllerNeXusIO::loadGenericBlock(std::vector<Type> &Block,
 
   start[0] = static_cast<int64_t>(blockPosition);
   size[0] = static_cast<int64_t>(nPoints);
-  Block.resize(size[0] * size[1]);
 
   m_File->getSlab(&Block[0], start, size);
 }
@@ -456,16 +498,41 @@ void BoxControllerNeXusIO::loadBlock(std::vector<double> &Block,
 
 //-------------------------------------------------------------------------------------------------------------------------------------
 
-/// Clear NeXus internal cache
+/// Write the queued blocks and clear NeXus internal cache
 void BoxControllerNeXusIO::flushData() const {
-  std::lock_guard<std::mutex> _lock(m_fileMutex);
-  m_File->flush();
+  m_asyncIO->flush();
+  m_asyncIO->wait();
+}
+
+/// Queue clearing NeXus internal cache after the queued blocks are written
+void BoxControllerNeXusIO::queueFlushData() const { m_asyncIO->flush(); }
+
+/** Start reading ahead data blocks which are about to be loaded
+ * @param blocks -- the positions and sizes (in events) of the blocks, in the
+ * order they will be loaded
+ * @return the stream of the read-ahead, to cancel when done with */
+size_t BoxControllerNeXusIO::prefetchBlocks(
+    const std::vector<std::pair<uint64_t, uint64_t>> &blocks) const {
+  if (!m_asyncIO)
+    return 0;
+  return m_asyncIO->readAhead(blocks);
+}
+
+/** Drop the blocks of a read-ahead which were not loaded
+ * @param prefetch -- the stream returned by prefetchBlocks */
+void BoxControllerNeXusIO::cancelPrefetch(const size_t prefetch) const {
+  if (m_asyncIO)
+    m_asyncIO->clearReadAhead(prefetch);
 }
 /** flush disk buffer data from memory and close underlying NeXus file*/
 void BoxControllerNeXusIO::closeFile() {
   if (m_File) {
     // write all file-backed data still stack in the data buffer into the file.
     this->flushCache();
+    // finish the queued writes and stop the background thread
+    m_asyncIO->flush();
+    m_asyncIO->wait();
+    m_asyncIO.reset();
     // lock file
     std::lock_guard<std::mutex> _lock(m_fileMutex);
 
@@ -0,0 +1,282 @@
+#include "MantidDataObjects/CompressedEventList.h"
+#include "MantidDataObjects/BinEdgeLookup.h"
+#include "MantidDataObjects/EventList.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Number of events decoded at a time by histogramming and filtering
+const size_t DECODE_BLOCK_SIZE = 1024;
+
+/// @return the difference between an original and a decoded tof
+double encodingError(const double original, const double decoded) {
+  if (decoded == original)
+    return 0.;
+  return std::abs(decoded - original);
+}
+
+/// @return the events of a list of TOF events
+const std::vector<TofEvent> &tofEventsOf(const EventList &eventList) {
+  if (eventList.getEventType() != API::TOF)
+    throw std::invalid_argument(
+        "CompressedEventList: only TOF events can be compressed");
+  return eventList.getEvents();
+}
+} // namespace
+
+/// Constructor of an empty list
+CompressedEventList::CompressedEventList()
+    : m_size(0), m_encoding(TofEncoding::Double), m_tofOrigin(0.),
+      m_tofResolution(0.), m_maxTofError(0.), m_sortedByTof(true),
+      m_sortedByPulseTime(true) {}
+
+/** Compress a vector of events. The order of the events is kept.
+ * @param events :: the events to compress
+ * @param encoding :: how to store the times-of-flight
+ * @param tofResolution :: the quantisation step, used by the Quantised
+ * encoding only
+ * @throw std::invalid_argument if the Quantised encoding is requested with a
+ * resolution that is not positive, or that is too fine to cover the range of
+ * tofs in 32 bits
+ */
+CompressedEventList::CompressedEventList(const std::vector<TofEvent> &events,
+                                         TofEncoding encoding,
+                                         double tofResolution)
+    : m_size(events.size()), m_encoding(encoding), m_tofOrigin(0.),
+      m_tofResolution(0.), m_maxTofError(0.), m_sortedByTof(false),
+      m_sortedByPulseTime(true) {
+  encodeTofs(events, tofResolution);
+  m_sortedByTof = std::is_sorted(events.cbegin(), events.cend(),
+                                 [](const TofEvent &lhs, const TofEvent &rhs) {
+                                   return lhs.tof() < rhs.tof();
+                                 });
+
+  for (size_t i = 0; i < events.size(); ++i) {
+    const int64_t pulseTime = events[i].pulseTime().totalNanoseconds();
+    if (!m_pulseTime.empty() && m_pulseTime.back() == pulseTime) {
+      ++m_runEnd.back();
+      continue;
+    }
+    if (!m_pulseTime.empty() && pulseTime < m_pulseTime.back())
+      m_sortedByPulseTime = false;
+    m_pulseTime.push_back(pulseTime);
+    m_runEnd.push_back(i + 1);
+  }
+  m_pulseTime.shrink_to_fit();
+  m_runEnd.shrink_to_fit();
+}
+
+/** Compress the events of an EventList.
+ * @param eventList :: the list to compress, holding TOF events
+ * @param encoding :: how to store the times-of-flight
+ * @param tofResolution :: the quantisation step, used by the Quantised
+ * encoding only
+ * @throw std::invalid_argument if the list holds weighted events, or the
+ * resolution is invalid for the Quantised encoding
+ */
+CompressedEventList::CompressedEventList(const EventList &eventList,
+                                         TofEncoding encoding,
+                                         double tofResolution)
+    : CompressedEventList(tofEventsOf(eventList), encoding, tofResolution) {}
+
+/** Fill the tof column for the requested encoding.
+ * @param events :: the events to encode
+ * @param tofResolution :: the quantisation step for the Quantised encoding
+ */
+void CompressedEventList::encodeTofs(const std::vector<TofEvent> &events,
+                                     double tofResolution) {
+  switch (m_encoding) {
+  case TofEncoding::Double:
+    m_tofDouble.reserve(events.size());
+    for (const auto &event : events)
+      m_tofDouble.push_back(event.tof());
+    break;
+  case TofEncoding::Float:
+    m_tofFloat.reserve(events.size());
+    for (const auto &event : events) {
+      m_tofFloat.push_back(static_cast<float>(event.tof()));
+      m_maxTofError = std::max(
+          m_maxTofError,
+          encodingError(event.tof(), static_cast<double>(m_tofFloat.back())));
+    }
+    break;
+  case TofEncoding::Quantised: {
+    if (!(tofResolution > 0.) || !std::isfinite(tofResolution))
+      throw std::invalid_argument(
+          "CompressedEventList: the tof resolution must be positive");
+    m_tofResolution = tofResolution;
+    if (events.empty())
+      break;
+    const auto range = std::minmax_element(
+        events.cbegin(), events.cend(),
+        [](const TofEvent &lhs, const TofEvent &rhs) {
+          return lhs.tof() < rhs.tof();
+        });
+    m_tofOrigin = range.first->tof();
+    const double maxCode =
+        std::round((range.second->tof() - m_tofOrigin) / m_tofResolution);
+    const double codeLimit =
+        static_cast<double>(std::numeric_limits<uint32_t>::max());
+    if (!std::isfinite(m_tofOrigin) || !(maxCode <= codeLimit))
+      throw std::invalid_argument("CompressedEventList: the range of tofs is "
+                                  "too large for the tof resolution");
+    m_tofQuantised.reserve(events.size());
+    for (const auto &event : events) {
+      const double code =
+          std::round((event.tof() - m_tofOrigin) / m_tofResolution);
+      m_tofQuantised.push_back(static_cast<uint32_t>(code));
+      m_maxTofError = std::max(
+          m_maxTofError,
+          encodingError(event.tof(), m_tofOrigin + code * m_tofResolution));
+    }
+  } break;
+  }
+}
+
+/** Decode a range of times-of-flight.
+ * @param begin :: index of the first event
+ * @param end :: index one past the last event
+ * @param tofs :: buffer of at least end - begin values for the decoded tofs
+ */
+void CompressedEventList::decodeTofs(const size_t begin, const size_t end,
+                                     double *tofs) const {
+  switch (m_encoding) {
+  case TofEncoding::Double:
+    std::copy(m_tofDouble.cbegin() + begin, m_tofDouble.cbegin() + end, tofs);
+    break;
+  case TofEncoding::Float:
+    for (size_t i = begin; i < end; ++i)
+      *tofs++ = static_cast<double>(m_tofFloat[i]);
+    break;
+  case TofEncoding::Quantised:
+    for (size_t i = begin; i < end; ++i)
+      *tofs++ = m_tofOrigin + static_cast<double>(m_tofQuantised[i]) *
+                                  m_tofResolution;
+    break;
+  }
+}
+
+/// @return the memory used by the list, in bytes
+size_t CompressedEventList::getMemorySize() const {
+  return sizeof(*this) + m_pulseTime.capacity() * sizeof(int64_t) +
+         m_runEnd.capacity() * sizeof(size_t) +
+         m_tofDouble.capacity() * sizeof(double) +
+         m_tofFloat.capacity() * sizeof(float) +
+         m_tofQuantised.capacity() * sizeof(uint32_t);
+}
+
+/** Decode all of the events.
+ * @param events :: replaced by the decoded events, in the original order
+ */
+void CompressedEventList::toEvents(std::vector<TofEvent> &events) const {
+  events.clear();
+  events.reserve(m_size);
+  std::vector<double> tofs(m_size);
+  decodeTofs(0, m_size, tofs.data());
+  size_t begin(0);
+  for (size_t run = 0; run < m_pulseTime.size(); ++run) {
+    const DateAndTime pulseTime(m_pulseTime[run]);
+    for (size_t i = begin; i < m_runEnd[run]; ++i)
+      events.emplace_back(tofs[i], pulseTime);
+    begin = m_runEnd[run];
+  }
+}
+
+/** Decode the events into an EventList, replacing its events. The detector
+ * IDs and spectrum number of the list are left unchanged.
+ * @param eventList :: the list to fill
+ */
+void CompressedEventList::copyInto(EventList &eventList) const {
+  eventList.clear(false);
+  eventList.eventType = API::TOF;
+  toEvents(eventList.events);
+  if (m_sortedByTof)
+    eventList.order = TOF_SORT;
+  else if (m_sortedByPulseTime)
+    eventList.order = PULSETIME_SORT;
+  else
+    eventList.order = UNSORTED;
+}
+
+/** Histogram the events, decoding them a block at a time. Events with
+ * X[i] <= tof < X[i+1] fall in bin i, as in EventList::generateHistogram.
+ * @param X :: the bin boundaries
+ * @param Y :: the counts returned
+ * @param E :: the errors returned
+ * @param skipError :: skip calculating the error
+ */
+void CompressedEventList::generateHistogram(const MantidVec &X, MantidVec &Y,
+                                            MantidVec &E,
+                                            bool skipError) const {
+  if (X.size() <= 1) {
+    Y.clear();
+    E.clear();
+    return;
+  }
+  Y.assign(X.size() - 1, 0.0);
+  E.assign(X.size() - 1, 0.0);
+
+  const BinEdgeLookup lookup(X);
+  if (m_encoding == TofEncoding::Double) {
+    lookup.addCounts(m_tofDouble.data(), m_size, Y);
+  } else {
+    double tofs[DECODE_BLOCK_SIZE];
+    for (size_t begin = 0; begin < m_size; begin += DECODE_BLOCK_SIZE) {
+      const size_t end = std::min(begin + DECODE_BLOCK_SIZE, m_size);
+      decodeTofs(begin, end, tofs);
+      lookup.addCounts(tofs, end - begin, Y);
+    }
+  }
+
+  if (!skipError)
+    std::transform(Y.begin(), Y.end(), E.begin(),
+                   static_cast<double (*)(double)>(sqrt));
+}
+
+/** Decode the events with start <= pulse time < stop. Only the runs of
+ * matching pulse times are decoded.
+ * @param start :: start time (absolute)
+ * @param stop :: end time (absolute), excluded
+ * @param output :: the decoded events are appended to this vector
+ */
+void CompressedEventList::filterByPulseTime(
+    const DateAndTime &start, const DateAndTime &stop,
+    std::vector<TofEvent> &output) const {
+  const int64_t startNs = start.totalNanoseconds();
+  const int64_t stopNs = stop.totalNanoseconds();
+  size_t firstRun(0);
+  if (m_sortedByPulseTime)
+    firstRun = std::lower_bound(m_pulseTime.cbegin(), m_pulseTime.cend(),
+                                startNs) -
+               m_pulseTime.cbegin();
+
+  double tofs[DECODE_BLOCK_SIZE];
+  for (size_t run = firstRun; run < m_pulseTime.size(); ++run) {
+    const int64_t pulseTime = m_pulseTime[run];
+    if (pulseTime >= stopNs && m_sortedByPulseTime)
+      break;
+    if (pulseTime < startNs || pulseTime >= stopNs)
+      continue;
+    const DateAndTime pulse(pulseTime);
+    const size_t runEnd = m_runEnd[run];
+    for (size_t begin = run > 0 ? m_runEnd[run - 1] : 0; begin < runEnd;
+         begin += DECODE_BLOCK_SIZE) {
+      const size_t end = std::min(begin + DECODE_BLOCK_SIZE, runEnd);
+      decodeTofs(begin, end, tofs);
+      for (size_t i = 0; i < end - begin; ++i)
+        output.emplace_back(tofs[i], pulse);
+    }
+  }
+}
+
+} // namespace DataObjects
+} // namespace Mantid
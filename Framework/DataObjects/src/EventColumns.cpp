@@ -0,0 +1,456 @@
+#include "MantidDataObjects/EventColumns.h"
+#include "MantidDataObjects/BinEdgeLookup.h"
+#include "MantidDataObjects/EventList.h"
+#include "MantidKernel/Unit.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+namespace Mantid {
+namespace DataObjects {
+using namespace Mantid::API;
+
+namespace {
+/**
+ * Reorder a column in place following the given permutation, i.e.
+ * column'[i] = column[permutation[i]].
+ * @param permutation :: the source index of each output element
+ * @param column :: the column to reorder. Ignored if empty.
+ */
+template <typename T>
+void applyPermutation(const std::vector<size_t> &permutation,
+                      std::vector<T> &column) {
+  if (column.empty())
+    return;
+  std::vector<T> sorted;
+  sorted.reserve(column.size());
+  for (const auto index : permutation)
+    sorted.push_back(column[index]);
+  column.swap(sorted);
+}
+
+/**
+ * Sum the elements of a float column in double precision.
+ * @param first :: first element to add
+ * @param last :: one past the last element to add
+ */
+double sumAsDouble(std::vector<float>::const_iterator first,
+                   std::vector<float>::const_iterator last) {
+  double sum(0.);
+  for (; first != last; ++first)
+    sum += static_cast<double>(*first);
+  return sum;
+}
+} // namespace
+
+/// Default constructor: an empty set of TOF events
+EventColumns::EventColumns() : m_eventType(TOF), m_sortedByTof(true) {}
+
+/** Build the columns from a vector of TofEvent
+ * @param events :: the events to copy
+ */
+EventColumns::EventColumns(const std::vector<TofEvent> &events)
+    : m_eventType(TOF), m_sortedByTof(false) {
+  appendColumns(events);
+}
+
+/** Build the columns from a vector of WeightedEvent
+ * @param events :: the events to copy
+ */
+EventColumns::EventColumns(const std::vector<WeightedEvent> &events)
+    : m_eventType(WEIGHTED), m_sortedByTof(false) {
+  appendColumns(events);
+}
+
+/** Build the columns from a vector of WeightedEventNoTime
+ * @param events :: the events to copy
+ */
+EventColumns::EventColumns(const std::vector<WeightedEventNoTime> &events)
+    : m_eventType(WEIGHTED_NOTIME), m_sortedByTof(false) {
+  appendColumns(events);
+}
+
+/** Build the columns from the events held in an EventList. The tof sorting
+ * of the list is preserved.
+ * @param eventList :: the list to copy
+ */
+EventColumns::EventColumns(const EventList &eventList)
+    : m_eventType(eventList.getEventType()),
+      m_sortedByTof(eventList.isSortedByTof()) {
+  switch (m_eventType) {
+  case TOF:
+    appendColumns(eventList.getEvents());
+    break;
+  case WEIGHTED:
+    appendColumns(eventList.getWeightedEvents());
+    break;
+  case WEIGHTED_NOTIME:
+    appendColumns(eventList.getWeightedEventsNoTime());
+    break;
+  }
+}
+
+/// @return the memory used by the columns, in bytes
+size_t EventColumns::getMemorySize() const {
+  return m_tof.capacity() * sizeof(double) +
+         m_pulseTime.capacity() * sizeof(int64_t) +
+         (m_weight.capacity() + m_errorSquared.capacity()) * sizeof(float) +
+         sizeof(EventColumns);
+}
+
+/// Remove all events and release the memory. The event type is unchanged.
+void EventColumns::clear() {
+  std::vector<double>().swap(m_tof);
+  std::vector<int64_t>().swap(m_pulseTime);
+  std::vector<float>().swap(m_weight);
+  std::vector<float>().swap(m_errorSquared);
+  m_sortedByTof = true;
+}
+
+/** Pre-allocate space for the given number of events in the columns that are
+ * used by the current event type.
+ * @param num :: number of events that will be held
+ */
+void EventColumns::reserve(size_t num) {
+  m_tof.reserve(num);
+  if (hasPulseTimes())
+    m_pulseTime.reserve(num);
+  if (hasWeights()) {
+    m_weight.reserve(num);
+    m_errorSquared.reserve(num);
+  }
+}
+
+/** Append a TofEvent. Pulse time and weights are dropped if the columns do not
+ * hold them.
+ * @param event :: event to add
+ */
+void EventColumns::addEvent(const TofEvent &event) {
+  m_sortedByTof &= (m_tof.empty() || m_tof.back() <= event.tof());
+  m_tof.push_back(event.tof());
+  if (hasPulseTimes())
+    m_pulseTime.push_back(event.pulseTime().totalNanoseconds());
+  if (hasWeights()) {
+    m_weight.push_back(1.f);
+    m_errorSquared.push_back(1.f);
+  }
+}
+
+/** Append a WeightedEvent.
+ * @param event :: event to add
+ * @throw std::runtime_error if the columns hold unweighted events
+ */
+void EventColumns::addEvent(const WeightedEvent &event) {
+  if (!hasWeights())
+    throw std::runtime_error("EventColumns::addEvent() cannot add a "
+                             "WeightedEvent to unweighted columns.");
+  m_sortedByTof &= (m_tof.empty() || m_tof.back() <= event.tof());
+  m_tof.push_back(event.tof());
+  if (hasPulseTimes())
+    m_pulseTime.push_back(event.pulseTime().totalNanoseconds());
+  m_weight.push_back(event.m_weight);
+  m_errorSquared.push_back(event.m_errorSquared);
+}
+
+/** Append a WeightedEventNoTime.
+ * @param event :: event to add
+ * @throw std::runtime_error if the columns are not of type WEIGHTED_NOTIME
+ */
+void EventColumns::addEvent(const WeightedEventNoTime &event) {
+  if (m_eventType != WEIGHTED_NOTIME)
+    throw std::runtime_error("EventColumns::addEvent() can only add a "
+                             "WeightedEventNoTime to WEIGHTED_NOTIME columns.");
+  m_sortedByTof &= (m_tof.empty() || m_tof.back() <= event.tof());
+  m_tof.push_back(event.tof());
+  m_weight.push_back(event.m_weight);
+  m_errorSquared.push_back(event.m_errorSquared);
+}
+
+/** Copy the events from a vector of records into the columns
+ * @param events :: the records to split into columns
+ */
+template <class T>
+void EventColumns::appendColumns(const std::vector<T> &events) {
+  reserve(m_tof.size() + events.size());
+  for (const auto &event : events)
+    m_tof.push_back(event.tof());
+  if (hasPulseTimes()) {
+    for (const auto &event : events)
+      m_pulseTime.push_back(event.pulseTime().totalNanoseconds());
+  }
+  if (hasWeights()) {
+    for (const auto &event : events) {
+      m_weight.push_back(static_cast<float>(event.weight()));
+      m_errorSquared.push_back(static_cast<float>(event.errorSquared()));
+    }
+  }
+}
+
+/** Rebuild TofEvent records from the columns
+ * @param events :: vector to fill; previous contents are discarded
+ * @throw std::runtime_error if the columns hold weighted events
+ */
+void EventColumns::toEvents(std::vector<TofEvent> &events) const {
+  if (m_eventType != TOF)
+    throw std::runtime_error("EventColumns::toEvents() cannot convert weighted "
+                             "events to TofEvent's.");
+  events.clear();
+  events.reserve(size());
+  for (size_t i = 0; i < size(); ++i)
+    events.emplace_back(m_tof[i], DateAndTime(m_pulseTime[i]));
+}
+
+/** Rebuild WeightedEvent records from the columns
+ * @param events :: vector to fill; previous contents are discarded
+ * @throw std::runtime_error if the columns have no pulse times
+ */
+void EventColumns::toEvents(std::vector<WeightedEvent> &events) const {
+  if (!hasPulseTimes())
+    throw std::runtime_error("EventColumns::toEvents() cannot convert "
+                             "WeightedEventNoTime's to WeightedEvent's.");
+  events.clear();
+  events.reserve(size());
+  if (hasWeights()) {
+    for (size_t i = 0; i < size(); ++i)
+      events.emplace_back(m_tof[i], DateAndTime(m_pulseTime[i]), m_weight[i],
+                          m_errorSquared[i]);
+  } else {
+    for (size_t i = 0; i < size(); ++i)
+      events.emplace_back(m_tof[i], DateAndTime(m_pulseTime[i]), 1.f, 1.f);
+  }
+}
+
+/** Rebuild WeightedEventNoTime records from the columns
+ * @param events :: vector to fill; previous contents are discarded
+ */
+void EventColumns::toEvents(std::vector<WeightedEventNoTime> &events) const {
+  events.clear();
+  events.reserve(size());
+  if (hasWeights()) {
+    for (size_t i = 0; i < size(); ++i)
+      events.emplace_back(m_tof[i], m_weight[i], m_errorSquared[i]);
+  } else {
+    for (size_t i = 0; i < size(); ++i)
+      events.emplace_back(m_tof[i], 1.f, 1.f);
+  }
+}
+
+/** Replace the events of an EventList with the contents of the columns. The
+ * event type of the list is set to that of the columns; the X values and
+ * detector IDs of the list are kept.
+ * @param eventList :: the list to fill
+ */
+void EventColumns::copyInto(EventList &eventList) const {
+  eventList.clear(false);
+  eventList.eventType = m_eventType;
+  switch (m_eventType) {
+  case TOF:
+    toEvents(eventList.events);
+    break;
+  case WEIGHTED:
+    toEvents(eventList.weightedEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    toEvents(eventList.weightedEventsNoTime);
+    break;
+  }
+  eventList.order = m_sortedByTof ? TOF_SORT : UNSORTED;
+}
+
+/** Sort all columns by time-of-flight. The tof column is sorted through an
+ * index permutation that is then applied to the other columns, so each
+ * column is only moved once.
+ */
+void EventColumns::sortTof() {
+  if (m_sortedByTof)
+    return;
+  if (std::is_sorted(m_tof.cbegin(), m_tof.cend())) {
+    m_sortedByTof = true;
+    return;
+  }
+  std::vector<size_t> permutation(size());
+  std::iota(permutation.begin(), permutation.end(), size_t(0));
+  const auto &tof = m_tof;
+  std::stable_sort(permutation.begin(), permutation.end(),
+                   [&tof](const size_t lhs, const size_t rhs) {
+                     return tof[lhs] < tof[rhs];
+                   });
+  applyPermutation(permutation, m_tof);
+  applyPermutation(permutation, m_pulseTime);
+  applyPermutation(permutation, m_weight);
+  applyPermutation(permutation, m_errorSquared);
+  m_sortedByTof = true;
+}
+
+/** Generate the Y and E histograms for the given bin boundaries. Events with
+ * X[i] <= tof < X[i+1] fall in bin i, as in EventList::generateHistogram.
+ *
+ * When the columns are sorted the bin edges are located in the tof column by
+ * binary search, and only the weight columns within each bin are read.
+ *
+ * @param X :: the bin boundaries
+ * @param Y :: the counts (or summed weights) returned
+ * @param E :: the errors returned
+ * @param skipError :: skip calculating the error for unweighted events
+ */
+void EventColumns::generateHistogram(const MantidVec &X, MantidVec &Y,
+                                     MantidVec &E, bool skipError) const {
+  if (X.size() <= 1) {
+    Y.clear();
+    E.clear();
+    return;
+  }
+  const size_t numBins = X.size() - 1;
+  Y.assign(numBins, 0.0);
+  E.assign(numBins, 0.0);
+
+  if (!m_sortedByTof) {
+    generateHistogramUnsorted(X, Y, E);
+  } else {
+    auto first = std::lower_bound(m_tof.cbegin(), m_tof.cend(), X.front());
+    for (size_t bin = 0; bin < numBins && first != m_tof.cend(); ++bin) {
+      const auto last = std::lower_bound(first, m_tof.cend(), X[bin + 1]);
+      if (hasWeights()) {
+        const auto begin = first - m_tof.cbegin();
+        const auto end = last - m_tof.cbegin();
+        Y[bin] =
+            sumAsDouble(m_weight.cbegin() + begin, m_weight.cbegin() + end);
+        E[bin] = sumAsDouble(m_errorSquared.cbegin() + begin,
+                             m_errorSquared.cbegin() + end);
+      } else {
+        Y[bin] = static_cast<double>(last - first);
+      }
+      first = last;
+    }
+  }
+
+  if (hasWeights()) {
+    std::transform(E.begin(), E.end(), E.begin(),
+                   static_cast<double (*)(double)>(sqrt));
+  } else if (!skipError) {
+    std::transform(Y.begin(), Y.end(), E.begin(),
+                   static_cast<double (*)(double)>(sqrt));
+  }
+}
+
+/** Histogram unsorted columns by looking up the bin of every event. E is
+ * filled with the squared errors of weighted events.
+ * @param X :: the bin boundaries
+ * @param Y :: the zeroed counts histogram
+ * @param E :: the zeroed errors histogram
+ */
+void EventColumns::generateHistogramUnsorted(const MantidVec &X, MantidVec &Y,
+                                             MantidVec &E) const {
+  const BinEdgeLookup lookup(X);
+  if (hasWeights())
+    lookup.addWeights(m_tof.data(), m_weight.data(), m_errorSquared.data(),
+                      size(), Y, E);
+  else
+    lookup.addCounts(m_tof.data(), size(), Y);
+}
+
+/** Integrate the events between a range of X values, or all events.
+ * @param minX :: minimum X value to include
+ * @param maxX :: maximum X value to include
+ * @param entireRange :: set to true to use all events; minX and maxX are then
+ * ignored
+ * @return the integrated number of events (sum of weights)
+ */
+double EventColumns::integrate(const double minX, const double maxX,
+                               const bool entireRange) const {
+  size_t begin(0), end(size());
+  if (!entireRange) {
+    if (maxX < minX)
+      return 0.;
+    if (!m_sortedByTof) {
+      double sum(0.);
+      for (size_t i = 0; i < size(); ++i) {
+        if (m_tof[i] >= minX && m_tof[i] <= maxX)
+          sum += hasWeights() ? static_cast<double>(m_weight[i]) : 1.0;
+      }
+      return sum;
+    }
+    begin = std::lower_bound(m_tof.cbegin(), m_tof.cend(), minX) -
+            m_tof.cbegin();
+    end = std::upper_bound(m_tof.cbegin() + begin, m_tof.cend(), maxX) -
+          m_tof.cbegin();
+  }
+  if (!hasWeights())
+    return static_cast<double>(end - begin);
+  return sumAsDouble(m_weight.cbegin() + begin, m_weight.cbegin() + end);
+}
+
+/** Convert the time of flight by tof'=tof*factor+offset. Only the tof column
+ * is touched. A negative factor reverses the order of all columns so that
+ * sorted columns stay sorted.
+ * @param factor :: The value to scale the time-of-flight by
+ * @param offset :: The value to shift the time-of-flight by
+ */
+void EventColumns::convertTof(const double factor, const double offset) {
+  for (auto &tof : m_tof)
+    tof = tof * factor + offset;
+  if (factor < 0.)
+    reverse();
+}
+
+/** Convert the X values from one unit to another by going through TOF. The
+ * whole tof column is converted by one call of each unit. The order is kept:
+ * if the conversion reverses it, reverse() flips it back.
+ * @param fromUnit :: the unit of the X values. Must be initialized.
+ * @param toUnit :: the unit to convert to. Must be initialized.
+ */
+void EventColumns::convertUnitsViaTof(const Kernel::Unit &fromUnit,
+                                      const Kernel::Unit &toUnit) {
+  if (m_tof.empty())
+    return;
+  const double *first = m_tof.data();
+  const double *last = first + m_tof.size();
+  fromUnit.batchToTOF(first, last, m_tof.data());
+  toUnit.batchFromTOF(first, last, m_tof.data());
+}
+
+/// Reverse the order of the events, if they are sorted by time-of-flight
+void EventColumns::reverse() {
+  if (!m_sortedByTof)
+    return;
+  std::reverse(m_tof.begin(), m_tof.end());
+  std::reverse(m_pulseTime.begin(), m_pulseTime.end());
+  std::reverse(m_weight.begin(), m_weight.end());
+  std::reverse(m_errorSquared.begin(), m_errorSquared.end());
+}
+
+/** Remove the events that have tofMin <= tof <= tofMax. The columns are sorted
+ * first, as in EventList::maskTof.
+ * @param tofMin :: lower bound of TOF to filter out
+ * @param tofMax :: upper bound of TOF to filter out
+ */
+void EventColumns::maskTof(const double tofMin, const double tofMax) {
+  if (tofMax <= tofMin)
+    throw std::runtime_error("EventColumns::maskTof: tofMax must be > tofMin");
+  if (empty())
+    return;
+  sortTof();
+  const auto first =
+      std::lower_bound(m_tof.cbegin(), m_tof.cend(), tofMin) - m_tof.cbegin();
+  const auto last =
+      std::upper_bound(m_tof.cbegin() + first, m_tof.cend(), tofMax) -
+      m_tof.cbegin();
+  if (first >= last)
+    return;
+  m_tof.erase(m_tof.begin() + first, m_tof.begin() + last);
+  if (hasPulseTimes())
+    m_pulseTime.erase(m_pulseTime.begin() + first, m_pulseTime.begin() + last);
+  if (hasWeights()) {
+    m_weight.erase(m_weight.begin() + first, m_weight.begin() + last);
+    m_errorSquared.erase(m_errorSquared.begin() + first,
+                         m_errorSquared.begin() + last);
+  }
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -1,12 +1,17 @@
 #include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/Histogram1D.h"
 #include "MantidAPI/MatrixWorkspace.h"
+#include "MantidDataObjects/BinEdgeLookup.h"
+#include "MantidDataObjects/EventColumns.h"
+#include "MantidDataObjects/EventRadixSort.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
+#include "MantidDataObjects/FileBackedEventStore.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/Unit.h"
+#include "MantidKernel/make_unique.h"
 
 #ifdef _MSC_VER
 // qualifier applied to function type has no meaning; ignored
@@ -17,10 +22,12 @@
 #pragma warning(default : 4180)
 #endif
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <functional>
 #include <limits>
+#include <set>
 #include <stdexcept>
 
 using std::ostream;
@@ -54,6 +61,107 @@ int64_t calculateCorrectedFullTime(const EventType &event,
                               (tofShift * 1.0E9));
 }
 
+/// The slot of an event that goes to no output of a split
+const uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max();
+
+/**
+ * Copies the events of a list to the output lists of a split in two passes.
+ * The group of each event is recorded first; the events going to each output
+ * are then counted so that every output is reserved exactly once before the
+ * events are copied, and the outputs are looked up once per run of events
+ * rather than once per event.
+ */
+template <class T> class SplitTargets {
+public:
+  /**
+   * @param outputs :: the output event list of each group
+   * @param numEvents :: the number of events to split
+   */
+  SplitTargets(const std::map<int, EventList *> &outputs,
+               const size_t numEvents)
+      : m_outputs(outputs), m_slots(numEvents, NO_SLOT),
+        m_lastGroup(std::numeric_limits<int>::min()), m_lastSlot(NO_SLOT) {}
+
+  /// Send an event to the output of a group
+  void assign(const size_t event, const int group) {
+    if (group != m_lastGroup) {
+      m_lastGroup = group;
+      m_lastSlot = slotOf(group);
+    }
+    m_slots[event] = m_lastSlot;
+  }
+
+  /// Send a range of events to the output of a group
+  void assign(const size_t first, const size_t last, const int group) {
+    for (size_t event = first; event < last; ++event)
+      assign(event, group);
+  }
+
+  /// @return the groups that events were sent to but have no output
+  const std::set<int> &missingGroups() const { return m_missing; }
+
+  /** Copy the events to their outputs
+   * @param events :: the events that were assigned
+   */
+  void copy(const std::vector<T> &events) const {
+    std::vector<size_t> counts(m_lists.size(), 0);
+    for (const auto slot : m_slots) {
+      if (slot != NO_SLOT)
+        ++counts[slot];
+    }
+    std::vector<std::vector<T> *> outputs(m_lists.size(), nullptr);
+    for (size_t slot = 0; slot < m_lists.size(); ++slot) {
+      getEventsFrom(*m_lists[slot], outputs[slot]);
+      outputs[slot]->reserve(outputs[slot]->size() + counts[slot]);
+    }
+    for (size_t event = 0; event < events.size(); ++event) {
+      const auto slot = m_slots[event];
+      if (slot != NO_SLOT)
+        outputs[slot]->push_back(events[event]);
+    }
+  }
+
+private:
+  uint32_t slotOf(const int group) {
+    const auto slot = m_slotOfGroup.find(group);
+    if (slot != m_slotOfGroup.end())
+      return slot->second;
+    const auto output = m_outputs.find(group);
+    if (output == m_outputs.end() || !output->second) {
+      m_missing.insert(group);
+      m_slotOfGroup.emplace(group, NO_SLOT);
+      return NO_SLOT;
+    }
+    const auto newSlot = static_cast<uint32_t>(m_lists.size());
+    m_lists.push_back(output->second);
+    m_slotOfGroup.emplace(group, newSlot);
+    return newSlot;
+  }
+
+  const std::map<int, EventList *> &m_outputs;
+  /// The output of each slot
+  std::vector<EventList *> m_lists;
+  /// The slot of each group seen so far
+  std::map<int, uint32_t> m_slotOfGroup;
+  /// The slot of each event
+  std::vector<uint32_t> m_slots;
+  std::set<int> m_missing;
+  int m_lastGroup;
+  uint32_t m_lastSlot;
+};
+
+/** Copy a list to the output of group -1, which takes the unfiltered events
+ * @param list :: the list being split
+ * @param outputs :: the output event list of each group
+ */
+void copyToUnfiltered(const EventList &list,
+                      const std::map<int, EventList *> &outputs) {
+  const auto unfiltered = outputs.find(-1);
+  if (unfiltered == outputs.end() || !unfiltered->second)
+    throw std::runtime_error("Group -1 has a NULL output EventList.");
+  *unfiltered->second = list;
+}
+
 /**
  * Type for comparing events in terms of time at sample
  */
@@ -98,30 +206,21 @@ template <typename T> bool compareEventTof(const T &e1, const T &e2) {
   return (e1.tof() < e2.tof());
 }
 
-/** Compare two events' FRAME id, return true if e1 should be before e2.
- * @param e1 :: first event
- * @param e2 :: second event
- *  */
-bool compareEventPulseTime(const TofEvent &e1, const TofEvent &e2) {
-  return (e1.pulseTime() < e2.pulseTime());
-}
-
-/** Compare two events' FRAME id, return true if e1 should be before e2.
- *  Assuming that if e1's pulse time is earlier than e2's, then e1 must be
- * earlier regardless TOF value
- * @param e1 :: first event
- * @param e2 :: second event
- *  */
-bool compareEventPulseTimeTOF(const TofEvent &e1, const TofEvent &e2) {
-
-  if (e1.pulseTime() < e2.pulseTime()) {
-    return true;
-  } else if ((e1.pulseTime() == e2.pulseTime()) && (e1.tof() < e2.tof())) {
-    return true;
-  }
+namespace {
+/// Lists of at least this many events are sorted by TOF with a parallel
+/// comparison sort, which then beats the radix sort running in one thread
+const size_t PARALLEL_SORT_MIN_EVENTS = size_t(1) << 22;
 
-  return false;
+/** Sort a vector of events by TOF
+ * @param events :: the events to sort
+ */
+template <typename T> void sortEventsByTof(std::vector<T> &events) {
+  if (events.size() >= PARALLEL_SORT_MIN_EVENTS)
+    tbb::parallel_sort(events.begin(), events.end(), compareEventTof<T>);
+  else
+    EventRadixSort::sortTof(events);
 }
+} // namespace
 
 // comparator for pulse time with tolerance
 struct comparePulseTimeTOFDelta {
@@ -228,6 +327,10 @@ void EventList::copyDataFrom(const ISpectrum &source) {
 
 /// Used by copyDataFrom for dynamic dispatch for its `source`.
 void EventList::copyDataInto(EventList &sink) const {
+  unpackEvents();
+  sink.m_columns.reset();
+  sink.m_compressed.reset();
+  sink.m_packed.store(false, std::memory_order_release);
   sink.m_histogram = m_histogram;
   sink.events = events;
   sink.weightedEvents = weightedEvents;
@@ -336,14 +439,27 @@ void EventList::createFromHistogram(const ISpectrum *inSpec, bool GenerateZeros,
  * @return reference to this
  * */
 EventList &EventList::operator=(const EventList &rhs) {
+  if (this == &rhs)
+    return *this;
   // Note that we are NOT copying the MRU pointer.
   IEventList::operator=(rhs);
   m_histogram = rhs.m_histogram;
+  // rhs may be paged in by another thread while it is copied
+  std::lock_guard<std::mutex> lock(rhs.m_sortMutex);
   events = rhs.events;
   weightedEvents = rhs.weightedEvents;
   weightedEventsNoTime = rhs.weightedEventsNoTime;
   eventType = rhs.eventType;
   order = rhs.order;
+  // A paged out list shares the page, which is never modified
+  m_page = rhs.m_page;
+  m_columns = rhs.m_columns ? Kernel::make_unique<EventColumns>(*rhs.m_columns)
+                            : nullptr;
+  m_compressed =
+      rhs.m_compressed
+          ? Kernel::make_unique<CompressedEventList>(*rhs.m_compressed)
+          : nullptr;
+  m_packed.store(m_columns || m_compressed, std::memory_order_release);
   return *this;
 }
 
@@ -353,6 +469,7 @@ EventList &EventList::operator=(const EventList &rhs) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const TofEvent &event) {
+  unpackEvents();
 
   switch (this->eventType) {
   case TOF:
@@ -381,6 +498,7 @@ EventList &EventList::operator+=(const TofEvent &event) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
+  unpackEvents();
   switch (this->eventType) {
   case TOF:
     // Simply push the events
@@ -421,6 +539,7 @@ EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const WeightedEvent &event) {
+  unpackEvents();
   this->switchTo(WEIGHTED);
   this->weightedEvents.push_back(event);
   this->order = UNSORTED;
@@ -502,6 +621,8 @@ operator+=(const std::vector<WeightedEventNoTime> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const EventList &more_events) {
+  unpackEvents();
+  more_events.unpackEvents();
   // We'll let the += operator for the given vector of event lists handle it
   switch (more_events.getEventType()) {
   case TOF:
@@ -563,6 +684,8 @@ void EventList::minusHelper(std::vector<T1> &events,
  * @return reference to this
  * */
 EventList &EventList::operator-=(const EventList &more_events) {
+  unpackEvents();
+  more_events.unpackEvents();
   if (this == &more_events) {
     // Special case, ticket #3844 part 2.
     // When doing this = this - this,
@@ -620,6 +743,8 @@ EventList &EventList::operator-=(const EventList &more_events) {
  * @return :: true if equal.
  */
 bool EventList::operator==(const EventList &rhs) const {
+  unpackEvents();
+  rhs.unpackEvents();
   if (this->getNumberEvents() != rhs.getNumberEvents())
     return false;
   if (this->eventType != rhs.eventType)
@@ -644,6 +769,8 @@ bool EventList::operator!=(const EventList &rhs) const {
 
 bool EventList::equals(const EventList &rhs, const double tolTof,
                        const double tolWeight, const int64_t tolPulse) const {
+  unpackEvents();
+  rhs.unpackEvents();
   // generic checks
   if (this->getNumberEvents() != rhs.getNumberEvents())
     return false;
@@ -692,6 +819,8 @@ EventType EventList::getEventType() const { return eventType; }
  * WEIGHTED_NOTIME)
  */
 void EventList::switchTo(EventType newType) {
+  unpackEvents();
+  pageIn();
   switch (newType) {
   case TOF:
     if (eventType != TOF)
@@ -784,6 +913,7 @@ void EventList::switchToWeightedEventsNoTime() {
  * @return a WeightedEvent
  */
 WeightedEvent EventList::getEvent(size_t event_number) {
+  unpackEvents();
   switch (eventType) {
   case TOF:
     return WeightedEvent(events[event_number]);
@@ -810,6 +940,7 @@ WeightedEvent EventList::getEvent(size_t event_number) {
  * @return a const reference to the list of non-weighted events
  * */
 const std::vector<TofEvent> &EventList::getEvents() const {
+  unpackEvents();
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -825,6 +956,7 @@ const std::vector<TofEvent> &EventList::getEvents() const {
  * @return a reference to the list of non-weighted events
  * */
 std::vector<TofEvent> &EventList::getEvents() {
+  unpackEvents();
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -840,6 +972,7 @@ std::vector<TofEvent> &EventList::getEvents() {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEvent> &EventList::getWeightedEvents() {
+  unpackEvents();
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -855,6 +988,7 @@ std::vector<WeightedEvent> &EventList::getWeightedEvents() {
  * @return a const reference to the list of weighted events
  * */
 const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
+  unpackEvents();
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -868,6 +1002,7 @@ const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
+  unpackEvents();
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEventNoTime. Use "
@@ -882,6 +1017,7 @@ std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
  * */
 const std::vector<WeightedEventNoTime> &
 EventList::getWeightedEventsNoTime() const {
+  unpackEvents();
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEventsNoTime() called for "
                              "an EventList not of type WeightedEventNoTime. "
@@ -903,6 +1039,10 @@ void EventList::clear(const bool removeDetIDs) {
   this->weightedEventsNoTime.clear();
   std::vector<WeightedEventNoTime>().swap(
       this->weightedEventsNoTime); // STL Trick to release memory
+  m_page.reset();
+  m_columns.reset();
+  m_compressed.reset();
+  m_packed.store(false, std::memory_order_release);
   if (removeDetIDs)
     this->clearDetectorIDs();
 }
@@ -931,6 +1071,191 @@ void EventList::clearUnused() {
 /// Mask the spectrum to this value. Removes all events.
 void EventList::clearData() { this->clear(false); }
 
+/** Move the events to a file, freeing their memory. They are read back by
+ * pageIn(). Events added since the list was last paged out are written to a
+ * new page along with the others.
+ * @param store :: the file to write the events to
+ * @throw std::runtime_error if the file is full
+ */
+void EventList::pageOut(FileBackedEventStore &store) {
+  unpackEvents();
+  std::lock_guard<std::mutex> lock(m_sortMutex);
+  if (m_page) {
+    if (numberOfEventsInMemory() == 0)
+      return;
+    readPage();
+  }
+  switch (eventType) {
+  case TOF:
+    m_page = store.write(events.data(), events.size(), sizeof(TofEvent));
+    break;
+  case WEIGHTED:
+    m_page = store.write(weightedEvents.data(), weightedEvents.size(),
+                         sizeof(WeightedEvent));
+    break;
+  case WEIGHTED_NOTIME:
+    m_page = store.write(weightedEventsNoTime.data(),
+                         weightedEventsNoTime.size(),
+                         sizeof(WeightedEventNoTime));
+    break;
+  }
+  std::vector<TofEvent>().swap(this->events);
+  std::vector<WeightedEvent>().swap(this->weightedEvents);
+  std::vector<WeightedEventNoTime>().swap(this->weightedEventsNoTime);
+}
+
+/** Read the events back into memory if they were paged out. This is safe to
+ * call from several threads at once. The sort order is that of the events
+ * when they were paged out, unless events were added since.
+ */
+void EventList::pageIn() const {
+  std::lock_guard<std::mutex> lock(m_sortMutex);
+  if (m_page)
+    readPage();
+}
+
+namespace {
+/** Read the events of a page in front of the events added to a vector since
+ * the page was written
+ * @param page :: the page to read
+ * @param events :: the vector to read the events into
+ */
+template <typename T>
+void readPageInto(const EventPage &page, std::vector<T> &events) {
+  std::vector<T> added;
+  added.swap(events);
+  events.reserve(page.numEvents + added.size());
+  events.resize(page.numEvents);
+  page.store->read(page, events.data());
+  events.insert(events.end(), added.cbegin(), added.cend());
+}
+} // namespace
+
+/// Read the paged out events back into memory. m_sortMutex must be held by
+/// the caller.
+void EventList::readPage() const {
+  if (numberOfEventsInMemory() > 0)
+    order = UNSORTED;
+  const auto &page = *m_page;
+  switch (eventType) {
+  case TOF:
+    readPageInto(page, events);
+    break;
+  case WEIGHTED:
+    readPageInto(page, weightedEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    readPageInto(page, weightedEventsNoTime);
+    break;
+  }
+  m_page.reset();
+}
+
+/// @return true if the events are paged out to a FileBackedEventStore
+bool EventList::isPagedOut() const {
+  std::lock_guard<std::mutex> lock(m_sortMutex);
+  return static_cast<bool>(m_page);
+}
+
+/** Hold the events in columns (see EventColumns) rather than as records.
+ * Histogramming, integration, time-of-flight and unit conversion, masking
+ * and sorting by time-of-flight then read and write only the columns they
+ * need. Any other method moves the events back into the event vectors first.
+ * Nothing is done if the events are paged out.
+ */
+void EventList::switchToColumns() {
+  std::lock_guard<std::mutex> lock(m_sortMutex);
+  if (m_columns || m_compressed || m_page)
+    return;
+  switch (eventType) {
+  case TOF:
+    m_columns = Kernel::make_unique<EventColumns>(events);
+    break;
+  case WEIGHTED:
+    m_columns = Kernel::make_unique<EventColumns>(weightedEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    m_columns = Kernel::make_unique<EventColumns>(weightedEventsNoTime);
+    break;
+  }
+  if (order == TOF_SORT)
+    m_columns->sortTof();
+  m_packed.store(true, std::memory_order_release);
+  std::vector<TofEvent>().swap(this->events);
+  std::vector<WeightedEvent>().swap(this->weightedEvents);
+  std::vector<WeightedEventNoTime>().swap(this->weightedEventsNoTime);
+}
+
+/// @return true if the events are held in columns
+bool EventList::hasColumns() const {
+  std::lock_guard<std::mutex> lock(m_sortMutex);
+  return static_cast<bool>(m_columns);
+}
+
+/** Compress the events (see CompressedEventList). Histogramming and filtering
+ * by pulse time then decode the events a block at a time; any other method
+ * decodes all of the events into the event vector first. Nothing is done if
+ * the events are paged out.
+ * @param encoding :: how to store the times-of-flight
+ * @param tofResolution :: the quantisation step, for the Quantised encoding
+ * @throw std::invalid_argument if the list holds weighted events
+ */
+void EventList::switchToCompressed(
+    CompressedEventList::TofEncoding encoding, double tofResolution) {
+  if (eventType != TOF)
+    throw std::invalid_argument("EventList::switchToCompressed() called for "
+                                "an EventList of weighted events. Only TOF "
+                                "events can be compressed.");
+  std::lock_guard<std::mutex> lock(m_sortMutex);
+  if (m_page)
+    return;
+  readPackedEvents();
+  m_compressed =
+      Kernel::make_unique<CompressedEventList>(events, encoding, tofResolution);
+  m_packed.store(true, std::memory_order_release);
+  std::vector<TofEvent>().swap(this->events);
+}
+
+/// @return true if the events are compressed
+bool EventList::isCompressed() const {
+  std::lock_guard<std::mutex> lock(m_sortMutex);
+  return static_cast<bool>(m_compressed);
+}
+
+/** Move the events held in columns or compressed back into the event
+ * vectors under m_sortMutex, for unpackEvents(). The sort order is kept.
+ */
+void EventList::lockAndUnpackEvents() const {
+  std::lock_guard<std::mutex> lock(m_sortMutex);
+  readPackedEvents();
+}
+
+/** Move the events held in columns or compressed back into the event
+ * vectors. m_sortMutex must be held by the caller.
+ */
+void EventList::readPackedEvents() const {
+  if (m_compressed) {
+    m_compressed->toEvents(events);
+    m_compressed.reset();
+  }
+  if (m_columns) {
+    switch (eventType) {
+    case TOF:
+      m_columns->toEvents(events);
+      break;
+    case WEIGHTED:
+      m_columns->toEvents(weightedEvents);
+      break;
+    case WEIGHTED_NOTIME:
+      m_columns->toEvents(weightedEventsNoTime);
+      break;
+    }
+    m_columns.reset();
+  }
+  // Readers seeing the flag cleared also see the events
+  m_packed.store(false, std::memory_order_release);
+}
+
 /** Sets the MRU list for this event list
  *
  * @param newMRU :: new MRU for the workspace containing this EventList
@@ -946,7 +1271,10 @@ void EventList::setMRU(EventWorkspaceMRU *newMRU) { mru = newMRU; }
  *
  * @param num :: number of events that will be in this EventList
  */
-void EventList::reserve(size_t num) { this->events.reserve(num); }
+void EventList::reserve(size_t num) {
+  unpackEvents();
+  this->events.reserve(num);
+}
 
 // ==============================================================================================
 // --- Sorting functions -----------------------------------------------------
@@ -983,6 +1311,7 @@ void EventList::sort(const EventSortType order) const {
  * @param order :: sort order to set.
  */
 void EventList::setSortOrder(const EventSortType order) const {
+  unpackEvents();
   this->order = order;
 }
 
@@ -1023,7 +1352,7 @@ void EventList::setSortOrder(const EventSortType order) const {
 //  }
 
 // --------------------------------------------------------------------------
-/** Sort events by TOF in one thread */
+/** Sort events by TOF. Large lists are sorted on several threads. */
 void EventList::sortTof() const {
   if (this->order == TOF_SORT)
     return; // nothing to do
@@ -1034,17 +1363,22 @@ void EventList::sortTof() const {
   if (this->order == TOF_SORT)
     return;
 
+  if (m_columns) {
+    m_columns->sortTof();
+    this->order = TOF_SORT;
+    return;
+  }
+  readPackedEvents();
+
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventTof<TofEvent>);
+    sortEventsByTof(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventTof<WeightedEvent>);
+    sortEventsByTof(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
-    tbb::parallel_sort(weightedEventsNoTime.begin(), weightedEventsNoTime.end(),
-                       compareEventTof<WeightedEventNoTime>);
+    sortEventsByTof(weightedEventsNoTime);
     break;
   }
   // Save the order to avoid unnecessary re-sorting.
@@ -1063,6 +1397,7 @@ void EventList::sortTof() const {
 void EventList::sortTimeAtSample(const double &tofFactor,
                                  const double &tofShift,
                                  bool forceResort) const {
+  unpackEvents();
   // Check pre-cached sort flag.
   if (this->order == TIMEATSAMPLE_SORT && !forceResort)
     return;
@@ -1097,6 +1432,7 @@ void EventList::sortTimeAtSample(const double &tofFactor,
 // --------------------------------------------------------------------------
 /** Sort events by Frame */
 void EventList::sortPulseTime() const {
+  unpackEvents();
   if (this->order == PULSETIME_SORT)
     return; // nothing to do
 
@@ -1109,11 +1445,10 @@ void EventList::sortPulseTime() const {
   // Perform sort.
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTime);
+    EventRadixSort::sortPulseTime(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTime);
+    EventRadixSort::sortPulseTime(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1128,6 +1463,7 @@ void EventList::sortPulseTime() const {
  * (the absolute time)
  */
 void EventList::sortPulseTimeTOF() const {
+  unpackEvents();
   if (this->order == PULSETIMETOF_SORT)
     return; // already ordered.
 
@@ -1139,11 +1475,10 @@ void EventList::sortPulseTimeTOF() const {
 
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTimeTOF);
+    EventRadixSort::sortPulseTimeTOF(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTimeTOF);
+    EventRadixSort::sortPulseTimeTOF(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1163,6 +1498,7 @@ void EventList::sortPulseTimeTOF() const {
  */
 void EventList::sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start,
                                       const double seconds) const {
+  unpackEvents();
   // Avoid sorting from multiple threads
   std::lock_guard<std::mutex> _lock(m_sortMutex);
 
@@ -1204,6 +1540,12 @@ void EventList::reverse() {
   MantidVec &x = dataX();
   std::reverse(x.begin(), x.end());
 
+  if (m_columns) {
+    m_columns->reverse();
+    return;
+  }
+  unpackEvents();
+
   // flip the events if they are tof sorted
   if (this->isSortedByTof()) {
     switch (eventType) {
@@ -1232,6 +1574,17 @@ void EventList::reverse() {
  * @return the number of events in the list.
  *  */
 size_t EventList::getNumberEvents() const {
+  std::lock_guard<std::mutex> lock(m_sortMutex);
+  return numberOfEventsInMemory() + (m_page ? m_page->numEvents : 0);
+}
+
+/// @return the number of events held in the vectors or columns. m_sortMutex
+/// must be held by the caller.
+size_t EventList::numberOfEventsInMemory() const {
+  if (m_columns)
+    return m_columns->size();
+  if (m_compressed)
+    return m_compressed->size();
   switch (eventType) {
   case TOF:
     return this->events.size();
@@ -1246,17 +1599,7 @@ size_t EventList::getNumberEvents() const {
 /**
  * Much like stl containers, returns true if there is nothing in the event list.
  */
-bool EventList::empty() const {
-  switch (eventType) {
-  case TOF:
-    return this->events.empty();
-  case WEIGHTED:
-    return this->weightedEvents.empty();
-  case WEIGHTED_NOTIME:
-    return this->weightedEventsNoTime.empty();
-  }
-  throw std::runtime_error("EventList: invalid event type value was found.");
-}
+bool EventList::empty() const { return getNumberEvents() == 0; }
 
 // --------------------------------------------------------------------------
 /** Memory used by this event list. Note: It reports the CAPACITY of the
@@ -1266,6 +1609,11 @@ bool EventList::empty() const {
  * @return :: the memory used by the EventList, in bytes.
  * */
 size_t EventList::getMemorySize() const {
+  std::lock_guard<std::mutex> lock(m_sortMutex);
+  if (m_columns)
+    return m_columns->getMemorySize() + sizeof(EventList);
+  if (m_compressed)
+    return m_compressed->getMemorySize() + sizeof(EventList);
   switch (eventType) {
   case TOF:
     return this->events.capacity() * sizeof(TofEvent) + sizeof(EventList);
@@ -1748,6 +2096,8 @@ inline void EventList::compressFatEventsHelper(
  *be == this.
  */
 void EventList::compressEvents(double tolerance, EventList *destination) {
+  unpackEvents();
+  destination->unpackEvents();
   if (!this->empty()) {
     this->sortTof();
     switch (eventType) {
@@ -1804,6 +2154,8 @@ void EventList::compressEvents(double tolerance, EventList *destination) {
 void EventList::compressFatEvents(
     const double tolerance, const Mantid::Types::Core::DateAndTime &timeStart,
     const double seconds, EventList *destination) {
+  unpackEvents();
+  destination->unpackEvents();
 
   // only worry about non-empty EventLists
   if (!this->empty()) {
@@ -1986,8 +2338,12 @@ void EventList::histogramForWeightsHelper(const std::vector<T> &events,
   //---------------------- Histogram without weights
   //---------------------------------
 
-  // Do we even have any events to do?
-  if (!events.empty()) {
+  // Linear and logarithmic binning compute the bin of each event directly
+  const BinEdgeLookup lookup(X);
+  if (!events.empty() &&
+      lookup.spacing() != BinEdgeLookup::Spacing::Irregular) {
+    lookup.addWeights(events, Y, E);
+  } else if (!events.empty()) {
     // Iterate through all events (sorted by tof)
     auto itev = findFirstEvent(events, X[0]);
     auto itev_end = events.cend();
@@ -2052,6 +2408,7 @@ void EventList::histogramForWeightsHelper(const std::vector<T> &events,
  */
 void EventList::generateHistogramPulseTime(const MantidVec &X, MantidVec &Y,
                                            MantidVec &E, bool skipError) const {
+  unpackEvents();
   // All types of weights need to be sorted by Pulse Time
   this->sortPulseTime();
 
@@ -2089,6 +2446,7 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
                                               const double &tofFactor,
                                               const double &tofOffset,
                                               bool skipError) const {
+  unpackEvents();
   // All types of weights need to be sorted by time at sample
   this->sortTimeAtSample(tofFactor, tofOffset);
 
@@ -2122,6 +2480,19 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
  */
 void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
                                   MantidVec &E, bool skipError) const {
+  {
+    // Columns and compressed events are histogrammed without sorting
+    std::lock_guard<std::mutex> lock(m_sortMutex);
+    if (m_columns) {
+      m_columns->generateHistogram(X, Y, E, skipError);
+      return;
+    }
+    if (m_compressed) {
+      m_compressed->generateHistogram(X, Y, E, skipError);
+      return;
+    }
+  }
+
   // All types of weights need to be sorted by TOF
 
   this->sortTof();
@@ -2153,6 +2524,7 @@ void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
  */
 void EventList::generateCountsHistogramPulseTime(const MantidVec &X,
                                                  MantidVec &Y) const {
+  unpackEvents();
   // For slight speed=up.
   size_t x_size = X.size();
 
@@ -2232,6 +2604,7 @@ void EventList::generateCountsHistogramPulseTime(const double &xMin,
                                                  MantidVec &Y,
                                                  const double TOF_min,
                                                  const double TOF_max) const {
+  unpackEvents();
 
   if (this->events.empty())
     return;
@@ -2267,6 +2640,7 @@ void EventList::generateCountsHistogramPulseTime(const double &xMin,
 void EventList::generateCountsHistogramTimeAtSample(
     const MantidVec &X, MantidVec &Y, const double &tofFactor,
     const double &tofOffset) const {
+  unpackEvents();
   // For slight speed=up.
   const size_t x_size = X.size();
 
@@ -2353,8 +2727,12 @@ void EventList::generateCountsHistogram(const MantidVec &X,
   //---------------------- Histogram without weights
   //---------------------------------
 
-  // Do we even have any events to do?
-  if (!this->events.empty()) {
+  // Linear and logarithmic binning compute the bin of each event directly
+  const BinEdgeLookup lookup(X);
+  if (!this->events.empty() &&
+      lookup.spacing() != BinEdgeLookup::Spacing::Irregular) {
+    lookup.addCounts(this->events, Y);
+  } else if (!this->events.empty()) {
     // Iterate through all events (sorted by tof)
     std::vector<TofEvent>::const_iterator itev =
         findFirstEvent(this->events, X[0]);
@@ -2493,6 +2871,11 @@ void EventList::integrateHelper(std::vector<T> &events, const double minX,
  */
 double EventList::integrate(const double minX, const double maxX,
                             const bool entireRange) const {
+  {
+    std::lock_guard<std::mutex> lock(m_sortMutex);
+    if (m_columns)
+      return m_columns->integrate(minX, maxX, entireRange);
+  }
   double sum(0), error(0);
   integrate(minX, maxX, entireRange, sum, error);
   return sum;
@@ -2511,6 +2894,7 @@ double EventList::integrate(const double minX, const double maxX,
 void EventList::integrate(const double minX, const double maxX,
                           const bool entireRange, double &sum,
                           double &error) const {
+  unpackEvents();
   sum = 0;
   error = 0;
   if (!entireRange) {
@@ -2548,6 +2932,7 @@ void EventList::integrate(const double minX, const double maxX,
  */
 void EventList::convertTof(std::function<double(double)> func,
                            const int sorting) {
+  unpackEvents();
   // fix the histogram parameter
   MantidVec &x = dataX();
   transform(x.begin(), x.end(), x.begin(), func);
@@ -2600,6 +2985,12 @@ void EventList::convertTof(const double factor, const double offset) {
   for (double &iter : x)
     iter = iter * factor + offset;
 
+  if (m_columns) {
+    m_columns->convertTof(factor, offset);
+    return;
+  }
+  unpackEvents();
+
   if ((factor < 0.) && (this->getSortType() == TOF_SORT))
     this->reverse();
 
@@ -2675,6 +3066,7 @@ void EventList::addPulsetimeHelper(std::vector<T> &events,
  * @param seconds :: The value to shift the pulsetime by, in seconds
  */
 void EventList::addPulsetime(const double seconds) {
+  unpackEvents();
   if (this->getNumberEvents() <= 0)
     return;
 
@@ -2754,6 +3146,14 @@ void EventList::maskTof(const double tofMin, const double tofMax) {
   // Start by sorting by tof
   this->sortTof();
 
+  if (m_columns) {
+    m_columns->maskTof(tofMin, tofMax);
+    if (m_columns->empty())
+      this->clear(false);
+    return;
+  }
+  unpackEvents();
+
   // Convert the list
   size_t numOrig = 0;
   size_t numDel = 0;
@@ -2794,6 +3194,14 @@ void EventList::getTofsHelper(const std::vector<T> &events,
  *  @param tofs :: A reference to the vector to be filled
  */
 void EventList::getTofs(std::vector<double> &tofs) const {
+  {
+    std::lock_guard<std::mutex> lock(m_sortMutex);
+    if (m_columns) {
+      tofs.assign(m_columns->tofs().cbegin(), m_columns->tofs().cend());
+      return;
+    }
+    readPackedEvents();
+  }
   // Set the capacity of the vector to avoid multiple resizes
   tofs.reserve(this->getNumberEvents());
 
@@ -2840,6 +3248,7 @@ void EventList::getWeightsHelper(const std::vector<T> &events,
  *  @param weights :: A reference to the vector to be filled
  */
 void EventList::getWeights(std::vector<double> &weights) const {
+  unpackEvents();
   // Set the capacity of the vector to avoid multiple resizes
   weights.reserve(this->getNumberEvents());
 
@@ -2887,6 +3296,7 @@ void EventList::getWeightErrorsHelper(const std::vector<T> &events,
  *  @param weightErrors :: A reference to the vector to be filled
  */
 void EventList::getWeightErrors(std::vector<double> &weightErrors) const {
+  unpackEvents();
   // Set the capacity of the vector to avoid multiple resizes
   weightErrors.reserve(this->getNumberEvents());
 
@@ -2936,6 +3346,7 @@ void EventList::getPulseTimesHelper(
  * @return by copy a vector of DateAndTime times
  */
 std::vector<Mantid::Types::Core::DateAndTime> EventList::getPulseTimes() const {
+  unpackEvents();
   std::vector<Mantid::Types::Core::DateAndTime> times;
   // Set the capacity of the vector to avoid multiple resizes
   times.reserve(this->getNumberEvents());
@@ -2963,6 +3374,16 @@ double EventList::getTofMin() const {
   // set up as the maximum available double
   double tMin = std::numeric_limits<double>::max();
 
+  {
+    std::lock_guard<std::mutex> lock(m_sortMutex);
+    if (m_columns) {
+      const auto &tofs = m_columns->tofs();
+      return tofs.empty() ? tMin
+                          : *std::min_element(tofs.cbegin(), tofs.cend());
+    }
+    readPackedEvents();
+  }
+
   // no events is a soft error
   if (this->empty())
     return tMin;
@@ -3009,6 +3430,16 @@ double EventList::getTofMax() const {
       -1. *
       std::numeric_limits<double>::max(); // min is a small number, not negative
 
+  {
+    std::lock_guard<std::mutex> lock(m_sortMutex);
+    if (m_columns) {
+      const auto &tofs = m_columns->tofs();
+      return tofs.empty() ? tMax
+                          : *std::max_element(tofs.cbegin(), tofs.cend());
+    }
+    readPackedEvents();
+  }
+
   // no events is a soft error
   if (this->empty())
     return tMax;
@@ -3051,6 +3482,7 @@ double EventList::getTofMax() const {
  * @return The minimum tof value for the list of the events.
  */
 DateAndTime EventList::getPulseTimeMin() const {
+  unpackEvents();
   // set up as the maximum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -3095,6 +3527,7 @@ DateAndTime EventList::getPulseTimeMin() const {
  * @return The maximum tof value for the list of events.
  */
 DateAndTime EventList::getPulseTimeMax() const {
+  unpackEvents();
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -3138,6 +3571,7 @@ DateAndTime EventList::getPulseTimeMax() const {
 void EventList::getPulseTimeMinMax(
     Mantid::Types::Core::DateAndTime &tMin,
     Mantid::Types::Core::DateAndTime &tMax) const {
+  unpackEvents();
   // set up as the minimum available date time.
   tMax = DateAndTime::minimum();
   tMin = DateAndTime::maximum();
@@ -3188,6 +3622,7 @@ void EventList::getPulseTimeMinMax(
 
 DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
                                           const double &tofOffset) const {
+  unpackEvents();
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -3235,6 +3670,7 @@ DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor,
 
 DateAndTime EventList::getTimeAtSampleMin(const double &tofFactor,
                                           const double &tofOffset) const {
+  unpackEvents();
   // set up as the minimum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -3307,6 +3743,7 @@ void EventList::setTofsHelper(std::vector<T> &events,
  * @param tofs :: The vector of doubles to set the tofs to.
  */
 void EventList::setTofs(const MantidVec &tofs) {
+  unpackEvents();
   this->order = UNSORTED;
 
   // Convert the list
@@ -3409,6 +3846,7 @@ EventList &EventList::operator*=(const double value) {
  * @param error: error on 'value'. Can be 0.
  */
 void EventList::multiply(const double value, const double error) {
+  unpackEvents();
   // Do nothing if multiplying by exactly one and there is no error
   if ((value == 1.0) && (error == 0.0))
     return;
@@ -3532,6 +3970,7 @@ void EventList::multiplyHistogramHelper(std::vector<T> &events,
  */
 void EventList::multiply(const MantidVec &X, const MantidVec &Y,
                          const MantidVec &E) {
+  unpackEvents();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3669,6 +4108,7 @@ void EventList::divideHistogramHelper(std::vector<T> &events,
  */
 void EventList::divide(const MantidVec &X, const MantidVec &Y,
                        const MantidVec &E) {
+  unpackEvents();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3717,6 +4157,7 @@ EventList &EventList::operator/=(const double value) {
  * @throw std::invalid_argument if value == 0; cannot divide by zero.
  */
 void EventList::divide(const double value, const double error) {
+  unpackEvents();
   if (value == 0.0)
     throw std::invalid_argument(
         "EventList::divide() called with value of 0.0. Cannot divide by zero.");
@@ -3806,6 +4247,22 @@ void EventList::filterByPulseTime(DateAndTime start, DateAndTime stop,
     throw std::invalid_argument("In-place filtering is not allowed");
   }
 
+  {
+    // Compressed events are decoded only for the pulses in the range. They
+    // keep their order, so the output is sorted as this list is.
+    std::lock_guard<std::mutex> lock(m_sortMutex);
+    if (m_compressed) {
+      output.clear();
+      output.switchTo(TOF);
+      output.setDetectorIDs(this->getDetectorIDs());
+      output.setHistogram(m_histogram);
+      m_compressed->filterByPulseTime(start, stop, output.events);
+      output.setSortOrder(this->order);
+      return;
+    }
+  }
+  unpackEvents();
+
   // Start by sorting the event list by pulse time.
   this->sortPulseTime();
   // Clear the output
@@ -3836,6 +4293,7 @@ void EventList::filterByTimeAtSample(Types::Core::DateAndTime start,
                                      Types::Core::DateAndTime stop,
                                      double tofFactor, double tofOffset,
                                      EventList &output) const {
+  unpackEvents();
   if (this == &output) {
     throw std::invalid_argument("In-place filtering is not allowed");
   }
@@ -3951,6 +4409,7 @@ void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
  *     that will be kept. Any other events will be deleted.
  */
 void EventList::filterInPlace(Kernel::TimeSplitterType &splitter) {
+  unpackEvents();
   // Start by sorting the event list by pulse time.
   this->sortPulseTime();
 
@@ -4042,6 +4501,7 @@ void EventList::splitByTimeHelper(Kernel::TimeSplitterType &splitter,
  */
 void EventList::splitByTime(Kernel::TimeSplitterType &splitter,
                             std::vector<EventList *> outputs) const {
+  unpackEvents();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -4093,77 +4553,40 @@ void EventList::splitByTime(Kernel::TimeSplitterType &splitter,
  */
 template <class T>
 void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter,
-                                      std::map<int, EventList *> outputs,
+                                      const std::map<int, EventList *> &outputs,
                                       typename std::vector<T> &events,
                                       bool docorrection, double toffactor,
                                       double tofshift) const {
-  // 1. Prepare to Iterate through the splitter at the same time
-  auto itspl = splitter.begin();
-  auto itspl_end = splitter.end();
-
-  // 2. Prepare to Iterate through all events (sorted by tof)
-  auto itev = events.begin();
-  auto itev_end = events.end();
-
-  // 3. This is the time of the first section. Anything before is thrown out.
-  while (itspl != itspl_end) {
+  SplitTargets<T> targets(outputs, events.size());
+  const size_t numEvents = events.size();
+  auto fullTime = [&](const T &event) {
+    if (docorrection)
+      return calculateCorrectedFullTime(event, toffactor, tofshift);
+    return event.m_pulsetime.totalNanoseconds() +
+           static_cast<int64_t>(event.m_tof * 1000);
+  };
+
+  // Iterate through the splitter and the events (sorted by full time) at the
+  // same time
+  size_t ev = 0;
+  for (auto itspl = splitter.begin(); itspl != splitter.end(); ++itspl) {
     // Get the splitting interval times and destination
-    int64_t start = itspl->start().totalNanoseconds();
-    int64_t stop = itspl->stop().totalNanoseconds();
-    const int index = itspl->index();
+    const int64_t start = itspl->start().totalNanoseconds();
+    const int64_t stop = itspl->stop().totalNanoseconds();
 
-    // a) Skip the events before the start of the time
-    // TODO This step can be
-    EventList *myOutput = outputs[-1];
-    while (itev != itev_end) {
-      int64_t fulltime;
-      if (docorrection)
-        fulltime = calculateCorrectedFullTime(*itev, toffactor, tofshift);
-      else
-        fulltime = itev->m_pulsetime.totalNanoseconds() +
-                   static_cast<int64_t>(itev->m_tof * 1000);
-      if (fulltime < start) {
-        // a1) Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
-        itev++;
-      } else {
-        break;
-      }
-    }
+    // a) The events before the start of the interval go to index = -1
+    for (; ev < numEvents && fullTime(events[ev]) < start; ++ev)
+      targets.assign(ev, -1);
 
     // b) Go through all the events that are in the interval (if any)
-    while (itev != itev_end) {
-      int64_t fulltime;
-      if (docorrection)
-        fulltime = itev->m_pulsetime.totalNanoseconds() +
-                   static_cast<int64_t>(toffactor * itev->m_tof * 1000 +
-                                        tofshift * 1.0E9);
-      else
-        fulltime = itev->m_pulsetime.totalNanoseconds() +
-                   static_cast<int64_t>(itev->m_tof * 1000);
-      if (fulltime < stop) {
-        // b1) Copy the event into another
-        const T eventCopy(*itev);
-        EventList *myOutput = outputs[index];
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        break;
-      }
-    }
-
-    // Go to the next interval
-    ++itspl;
-    // But if we reached the end, then we are done.
-    if (itspl == itspl_end)
-      break;
+    for (; ev < numEvents && fullTime(events[ev]) < stop; ++ev)
+      targets.assign(ev, itspl->index());
 
     // No need to keep looping through the filter if we are out of events
-    if (itev == itev_end)
+    if (ev == numEvents)
       break;
-  } // END-WHILE Splitter
+  }
+  targets.copy(events);
 }
 
 //------------------------------------------------------------------------------------------------
@@ -4179,9 +4602,10 @@ void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter,
  * @param tofshift:  a correction shift for each TOF to add with
  */
 void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
-                                std::map<int, EventList *> outputs,
+                                const std::map<int, EventList *> &outputs,
                                 bool docorrection, double toffactor,
                                 double tofshift) const {
+  unpackEvents();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -4190,8 +4614,7 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
   this->sortPulseTimeTOF();
 
   // 2. Initialize all the outputs
-  std::map<int, EventList *>::iterator outiter;
-  for (outiter = outputs.begin(); outiter != outputs.end(); ++outiter) {
+  for (auto outiter = outputs.begin(); outiter != outputs.end(); ++outiter) {
     EventList *opeventlist = outiter->second;
     opeventlist->clear();
     opeventlist->setDetectorIDs(this->getDetectorIDs());
@@ -4203,7 +4626,7 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
   // Do nothing if there are no entries
   if (splitter.empty()) {
     // 3A. Copy all events to group workspace = -1
-    (*outputs[-1]) = (*this);
+    copyToUnfiltered(*this, outputs);
     // this->duplicate(outputs[-1]);
   } else {
     // 3B. Split
@@ -4245,24 +4668,23 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
 template <class T>
 std::string EventList::splitByFullTimeVectorSplitterHelper(
     const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-    std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
-    bool docorrection, double toffactor, double tofshift) const {
-  // Define variables for events
-  // size_t numevents = events.size();
-  typename std::vector<T>::iterator eviter;
-  std::stringstream msgss;
+    const std::map<int, EventList *> &outputs,
+    typename std::vector<T> &vecEvents, bool docorrection, double toffactor,
+    double tofshift) const {
+  SplitTargets<T> targets(outputs, vecEvents.size());
 
   // Loop through events
-  for (eviter = vecEvents.begin(); eviter != vecEvents.end(); ++eviter) {
+  for (size_t ev = 0; ev < vecEvents.size(); ++ev) {
+    const T &event = vecEvents[ev];
     // Obtain time of event
     int64_t evabstimens;
     if (docorrection)
-      evabstimens = eviter->m_pulsetime.totalNanoseconds() +
-                    static_cast<int64_t>(toffactor * eviter->m_tof * 1000 +
+      evabstimens = event.m_pulsetime.totalNanoseconds() +
+                    static_cast<int64_t>(toffactor * event.m_tof * 1000 +
                                          tofshift * 1.0E9);
     else
-      evabstimens = eviter->m_pulsetime.totalNanoseconds() +
-                    static_cast<int64_t>(eviter->m_tof * 1000);
+      evabstimens = event.m_pulsetime.totalNanoseconds() +
+                    static_cast<int64_t>(event.m_tof * 1000);
 
     // Search in vector
     int index = static_cast<int>(
@@ -4279,18 +4701,14 @@ std::string EventList::splitByFullTimeVectorSplitterHelper(
     }
 
     // Copy event to the proper group
-    EventList *myOutput = outputs[group];
-    if (!myOutput) {
-      std::stringstream errss;
-      errss << "Group " << group << " has a NULL output EventList. "
-            << "\n";
-      msgss << errss.str();
-    } else {
-      const T eventCopy(*eviter);
-      myOutput->addEventQuickly(eventCopy);
-    }
+    targets.assign(ev, group);
   }
+  targets.copy(vecEvents);
 
+  std::stringstream msgss;
+  for (const int group : targets.missingGroups())
+    msgss << "Group " << group << " has a NULL output EventList. "
+          << "\n";
   return (msgss.str());
 }
 
@@ -4317,67 +4735,45 @@ std::string EventList::splitByFullTimeVectorSplitterHelper(
 template <class T>
 std::string EventList::splitByFullTimeSparseVectorSplitterHelper(
     const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-    std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
-    bool docorrection, double toffactor, double tofshift) const {
-  // Define variables for events
-  // size_t numevents = events.size();
-  // typename std::vector<T>::iterator eviter;
-  std::stringstream msgss;
-
-  size_t num_splitters = vecgroups.size();
-  // prepare to Iterate through all events (sorted by tof)
-  auto iter_events = vecEvents.begin();
-  auto iter_events_end = vecEvents.end();
-
-  // std::stringstream debug_ss;
-  // debug_ss << "\nFilter events...:\n";
-
+    const std::map<int, EventList *> &outputs,
+    typename std::vector<T> &vecEvents, bool docorrection, double toffactor,
+    double tofshift) const {
+  SplitTargets<T> targets(outputs, vecEvents.size());
+  const size_t num_splitters = vecgroups.size();
+  const size_t numEvents = vecEvents.size();
+
+  // prepare to Iterate through all events (sorted by full time)
+  size_t ev = 0;
   for (size_t i = 0; i < num_splitters; ++i) {
     // get one splitter
     int64_t start_i64 = vectimes[i];
     int64_t stop_i64 = vectimes[i + 1];
     int group = vecgroups[i];
-    // debug_ss << "working on splitter: " << i << " from " << start_i64 << " to
-    // " << stop_i64 << "\n";
 
     // go over events
-    while (iter_events != iter_events_end) {
+    while (ev < numEvents) {
+      const T &event = vecEvents[ev];
       int64_t absolute_time;
       if (docorrection)
         absolute_time =
-            iter_events->m_pulsetime.totalNanoseconds() +
-            static_cast<int64_t>(toffactor * iter_events->m_tof * 1000 +
+            event.m_pulsetime.totalNanoseconds() +
+            static_cast<int64_t>(toffactor * event.m_tof * 1000 +
                                  tofshift * 1.0E9);
       else
-        absolute_time = iter_events->m_pulsetime.totalNanoseconds() +
-                        static_cast<int64_t>(iter_events->m_tof * 1000);
-
-      // debug_ss << "  event " << iter_events - vecEvents.begin() << " abs.time
-      // = " << absolute_time << "\n";
+        absolute_time = event.m_pulsetime.totalNanoseconds() +
+                        static_cast<int64_t>(event.m_tof * 1000);
 
       if (absolute_time < start_i64) {
         // event occurs before the splitter. only can happen with first
         // splitter. Then ignore and move to next
-        ++iter_events;
+        ++ev;
         continue;
       }
 
       if (absolute_time < stop_i64) {
-        // in the splitter, then copy the event into another
-        const T eventCopy(*iter_events);
-        // Copy event to the proper group
-        EventList *myOutput = outputs[group];
-        if (!myOutput) {
-          // there is no such group defined. quit for this group
-          std::stringstream errss;
-          errss << "Group " << group << " has a NULL output EventList. "
-                << "\n";
-          msgss << errss.str();
-          throw std::runtime_error(errss.str());
-        }
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
-        ++iter_events;
+        // in the splitter, then copy the event into the proper group
+        targets.assign(ev, group);
+        ++ev;
       } else {
         // event occurs after the stop time, it should belonged to the next
         // splitter
@@ -4386,13 +4782,21 @@ std::string EventList::splitByFullTimeSparseVectorSplitterHelper(
     } // while
 
     // quit the loop if there is no more event left
-    if (iter_events == iter_events_end)
+    if (ev == numEvents)
       break;
   } // for splitter
 
-  // std::cout << debug_ss.str();
+  if (!targets.missingGroups().empty()) {
+    // there is no such group defined
+    std::stringstream errss;
+    errss << "Group " << *targets.missingGroups().begin()
+          << " has a NULL output EventList. "
+          << "\n";
+    throw std::runtime_error(errss.str());
+  }
+  targets.copy(vecEvents);
 
-  return (msgss.str());
+  return "";
 }
 
 //----------------------------------------------------------------------------------------------
@@ -4411,8 +4815,9 @@ std::string EventList::splitByFullTimeSparseVectorSplitterHelper(
 std::string EventList::splitByFullTimeMatrixSplitter(
     const std::vector<int64_t> &vec_splitters_time,
     const std::vector<int> &vecgroups,
-    std::map<int, EventList *> vec_outputEventList, bool docorrection,
+    const std::map<int, EventList *> &vec_outputEventList, bool docorrection,
     double toffactor, double tofshift) const {
+  unpackEvents();
   // Check validity
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4423,8 +4828,7 @@ std::string EventList::splitByFullTimeMatrixSplitter(
   sortPulseTimeTOF();
 
   // Initialize all the output event list
-  std::map<int, EventList *>::iterator outiter;
-  for (outiter = vec_outputEventList.begin();
+  for (auto outiter = vec_outputEventList.begin();
        outiter != vec_outputEventList.end(); ++outiter) {
     EventList *opeventlist = outiter->second;
     opeventlist->clear();
@@ -4439,7 +4843,7 @@ std::string EventList::splitByFullTimeMatrixSplitter(
   // Do nothing if there are no entries
   if (vecgroups.empty()) {
     // Copy all events to group workspace = -1
-    (*vec_outputEventList[-1]) = (*this);
+    copyToUnfiltered(*this, vec_outputEventList);
     // this->duplicate(outputs[-1]);
   } else {
     // Split
@@ -4483,73 +4887,43 @@ std::string EventList::splitByFullTimeMatrixSplitter(
 /** Split the event list into n outputs by each event's pulse time only
  */
 template <class T>
-void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter,
-                                       std::map<int, EventList *> outputs,
-                                       typename std::vector<T> &events) const {
-  // Prepare to TimeSplitter Iterate through the splitter at the same time
-  auto itspl = splitter.begin();
-  auto itspl_end = splitter.end();
-  Types::Core::DateAndTime start, stop;
-
-  // Prepare to Events Iterate through all events (sorted by tof)
-  auto itev = events.begin();
-  auto itev_end = events.end();
-
-  // Iterate (loop) on all splitters
-  while (itspl != itspl_end) {
+void EventList::splitByPulseTimeHelper(
+    Kernel::TimeSplitterType &splitter,
+    const std::map<int, EventList *> &outputs,
+    typename std::vector<T> &events) const {
+  SplitTargets<T> targets(outputs, events.size());
+  const size_t numEvents = events.size();
+
+  // Iterate (loop) on all splitters and the events (sorted by pulse time)
+  size_t ev = 0;
+  for (auto itspl = splitter.begin(); itspl != splitter.end(); ++itspl) {
     // Get the splitting interval times and destination group
-    start = itspl->start().totalNanoseconds();
-    stop = itspl->stop().totalNanoseconds();
-    const int index = itspl->index();
+    const DateAndTime start = itspl->start();
+    const DateAndTime stop = itspl->stop();
 
     // Skip the events before the start of the time and put to 'unfiltered'
     // EventList
-    EventList *myOutput = outputs[-1];
-    while (itev != itev_end) {
-      if (itev->m_pulsetime < start) {
-        // Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        // Event within a splitter interval
-        break;
-      }
-    }
+    for (; ev < numEvents && events[ev].m_pulsetime < start; ++ev)
+      targets.assign(ev, -1);
 
     // Go through all the events that are in the interval (if any)
-    while (itev != itev_end) {
-
-      if (itev->m_pulsetime < stop) {
-        // Duplicate event
-        const T eventCopy(*itev);
-        EventList *myOutput = outputs[index];
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        // Out of interval
-        break;
-      }
-    }
-
-    // Go to the next interval
-    ++itspl;
-    // But if we reached the end, then we are done.
-    if (itspl == itspl_end)
-      break;
+    for (; ev < numEvents && events[ev].m_pulsetime < stop; ++ev)
+      targets.assign(ev, itspl->index());
 
     // No need to keep looping through the filter if we are out of events
-    if (itev == itev_end)
+    if (ev == numEvents)
       break;
-  } // END-WHILE Splitter
+  }
+  targets.copy(events);
 }
 
 //----------------------------------------------------------------------------------------------
 /** Split the event list by pulse time
  */
-void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
-                                 std::map<int, EventList *> outputs) const {
+void EventList::splitByPulseTime(
+    Kernel::TimeSplitterType &splitter,
+    const std::map<int, EventList *> &outputs) const {
+  unpackEvents();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4559,8 +4933,7 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
   this->sortPulseTimeTOF();
 
   // Initialize all the output event lists
-  std::map<int, EventList *>::iterator outiter;
-  for (outiter = outputs.begin(); outiter != outputs.end(); ++outiter) {
+  for (auto outiter = outputs.begin(); outiter != outputs.end(); ++outiter) {
     EventList *opeventlist = outiter->second;
     opeventlist->clear();
     opeventlist->setDetectorIDs(this->getDetectorIDs());
@@ -4572,7 +4945,7 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
   // Split
   if (splitter.empty()) {
     // No splitter: copy all events to group workspace = -1
-    (*outputs[-1]) = (*this);
+    copyToUnfiltered(*this, outputs);
   } else {
     // Split
     switch (eventType) {
@@ -4595,6 +4968,7 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter,
 void EventList::splitByPulseTimeWithMatrix(
     const std::vector<int64_t> &vec_times, const std::vector<int> &vec_target,
     std::map<int, EventList *> outputs) const {
+  unpackEvents();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4758,13 +5132,19 @@ template <class T>
 void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events,
                                          Mantid::Kernel::Unit *fromUnit,
                                          Mantid::Kernel::Unit *toUnit) {
-  auto itev = events.begin();
-  auto itev_end = events.end();
-  for (; itev != itev_end; itev++) {
-    // Conver to TOF
-    double tof = fromUnit->singleToTOF(itev->m_tof);
-    // And back from TOF to whatever
-    itev->m_tof = toUnit->singleFromTOF(tof);
+  // Convert in chunks small enough to stay in cache, one virtual call per
+  // chunk and unit rather than per event
+  const size_t chunkSize = 1024;
+  double tofs[chunkSize];
+  for (size_t first = 0; first < events.size(); first += chunkSize) {
+    const size_t count = std::min(chunkSize, events.size() - first);
+    for (size_t i = 0; i < count; ++i)
+      tofs[i] = events[first + i].m_tof;
+    // Convert to TOF and back from TOF to whatever
+    fromUnit->batchToTOF(tofs, tofs + count, tofs);
+    toUnit->batchFromTOF(tofs, tofs + count, tofs);
+    for (size_t i = 0; i < count; ++i)
+      events[first + i].m_tof = tofs[i];
   }
 }
 
@@ -4789,6 +5169,12 @@ void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit,
     throw std::runtime_error(
         "EventList::convertUnitsViaTof(): toUnit is not initialized!");
 
+  if (m_columns) {
+    m_columns->convertUnitsViaTof(*fromUnit, *toUnit);
+    return;
+  }
+  unpackEvents();
+
   switch (eventType) {
   case TOF:
     convertUnitsViaTofHelper(this->events, fromUnit, toUnit);
@@ -4826,6 +5212,7 @@ void EventList::convertUnitsQuicklyHelper(typename std::vector<T> &events,
  *  @param power :: the Power b to apply to the conversion
  */
 void EventList::convertUnitsQuickly(const double &factor, const double &power) {
+  unpackEvents();
   switch (eventType) {
   case TOF:
     convertUnitsQuicklyHelper(this->events, factor, power);
@@ -0,0 +1,270 @@
+#include "MantidDataObjects/EventRadixSort.h"
+#include "MantidDataObjects/Events.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+using Mantid::Types::Event::TofEvent;
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Lists shorter than this are sorted with std::stable_sort
+const size_t MIN_RADIX_SORT_SIZE = 256;
+/// Auto mode moves keys only when fewer than 1 in this many neighbours are
+/// out of order
+const size_t NEARLY_SORTED_RATIO = 16;
+/// Bits sorted per pass
+const unsigned int DIGIT_BITS = 8;
+/// Number of buckets per pass
+const size_t NUM_BUCKETS = size_t(1) << DIGIT_BITS;
+/// Number of passes needed for a 64-bit key
+const size_t NUM_DIGITS = 64 / DIGIT_BITS;
+/// Sign bit of a 64-bit key
+const uint64_t SIGN_BIT = uint64_t(1) << 63;
+
+using DigitCounts = std::array<std::array<size_t, NUM_BUCKETS>, NUM_DIGITS>;
+
+/// @return the digit of the key sorted on the given pass
+inline size_t digitOf(const uint64_t key, const size_t pass) {
+  return static_cast<size_t>((key >> (pass * DIGIT_BITS)) & (NUM_BUCKETS - 1));
+}
+
+/**
+ * Stable LSD radix sort of 64-bit keys, moving a payload along with the keys.
+ * The counts for every digit are gathered in one pass over the keys, and
+ * passes where all keys share the same digit are skipped.
+ * @param keys :: the keys to sort
+ * @param payload :: values reordered in the same way as the keys
+ */
+template <class Payload>
+void radixSort(std::vector<uint64_t> &keys, std::vector<Payload> &payload) {
+  const size_t n = keys.size();
+  DigitCounts counts;
+  for (auto &count : counts)
+    count.fill(0);
+  for (const auto key : keys) {
+    for (size_t pass = 0; pass < NUM_DIGITS; ++pass)
+      ++counts[pass][digitOf(key, pass)];
+  }
+
+  std::vector<uint64_t> keyBuffer;
+  std::vector<Payload> payloadBuffer;
+  for (size_t pass = 0; pass < NUM_DIGITS; ++pass) {
+    const auto &count = counts[pass];
+    // Every key has the same digit: this pass would not move anything
+    if (count[digitOf(keys.front(), pass)] == n)
+      continue;
+    if (keyBuffer.empty()) {
+      keyBuffer.resize(n);
+      payloadBuffer.resize(n);
+    }
+    std::array<size_t, NUM_BUCKETS> offsets;
+    size_t total(0);
+    for (size_t bucket = 0; bucket < NUM_BUCKETS; ++bucket) {
+      offsets[bucket] = total;
+      total += count[bucket];
+    }
+    for (size_t i = 0; i < n; ++i) {
+      const size_t destination = offsets[digitOf(keys[i], pass)]++;
+      keyBuffer[destination] = keys[i];
+      payloadBuffer[destination] = payload[i];
+    }
+    keys.swap(keyBuffer);
+    payload.swap(payloadBuffer);
+  }
+}
+
+/**
+ * Reorder the events following a list of source indices.
+ * @param index :: the source index of each output event
+ * @param events :: the events to reorder
+ */
+template <class T>
+void gather(const std::vector<uint32_t> &index, std::vector<T> &events) {
+  std::vector<T> sorted;
+  sorted.reserve(events.size());
+  for (const auto i : index)
+    sorted.push_back(events[i]);
+  events.swap(sorted);
+}
+
+/// Choose the mode to use from the number of out-of-order neighbours
+EventRadixSort::Mode resolveMode(EventRadixSort::Mode mode, const size_t size,
+                                 const size_t descents) {
+  // The indices moved in KeysOnly mode are 32-bit
+  if (size > std::numeric_limits<uint32_t>::max())
+    return EventRadixSort::Mode::Records;
+  if (mode != EventRadixSort::Mode::Auto)
+    return mode;
+  return descents * NEARLY_SORTED_RATIO < size
+             ? EventRadixSort::Mode::KeysOnly
+             : EventRadixSort::Mode::Records;
+}
+
+/**
+ * Sort events by a single 64-bit key.
+ * @param events :: the events to sort
+ * @param keyOf :: callable returning the key of an event
+ * @param mode :: what to move on each pass
+ */
+template <class T, class KeyOf>
+void sortByKey(std::vector<T> &events, KeyOf keyOf,
+               const EventRadixSort::Mode mode) {
+  const size_t n = events.size();
+  if (n < 2)
+    return;
+  if (n < MIN_RADIX_SORT_SIZE) {
+    std::stable_sort(events.begin(), events.end(),
+                     [&keyOf](const T &lhs, const T &rhs) {
+                       return keyOf(lhs) < keyOf(rhs);
+                     });
+    return;
+  }
+
+  std::vector<uint64_t> keys;
+  keys.reserve(n);
+  size_t descents(0);
+  for (const auto &event : events) {
+    const uint64_t key = keyOf(event);
+    if (!keys.empty() && key < keys.back())
+      ++descents;
+    keys.push_back(key);
+  }
+  if (descents == 0)
+    return;
+
+  if (resolveMode(mode, n, descents) == EventRadixSort::Mode::KeysOnly) {
+    std::vector<uint32_t> index(n);
+    std::iota(index.begin(), index.end(), uint32_t(0));
+    radixSort(keys, index);
+    gather(index, events);
+  } else {
+    radixSort(keys, events);
+  }
+}
+
+/// @return the sort key of the tof of an event
+template <class T> uint64_t tofKeyOf(const T &event) {
+  return EventRadixSort::tofKey(event.tof());
+}
+
+/// @return the sort key of the pulse time of an event
+template <class T> uint64_t pulseTimeKeyOf(const T &event) {
+  return EventRadixSort::pulseTimeKey(event.pulseTime().totalNanoseconds());
+}
+} // namespace
+
+/** Map a double to an unsigned integer with the same ordering. Positive
+ * values get their sign bit set; negative values have all bits flipped so
+ * that larger magnitudes sort first. -0.0 sorts just before +0.0 and NaNs
+ * sort beyond the infinities of the same sign.
+ * @param tof :: the value to map
+ * @return the sort key
+ */
+uint64_t EventRadixSort::tofKey(const double tof) {
+  uint64_t bits;
+  std::memcpy(&bits, &tof, sizeof(bits));
+  return (bits & SIGN_BIT) ? ~bits : (bits | SIGN_BIT);
+}
+
+/** Map a signed number of nanoseconds to an unsigned integer with the same
+ * ordering.
+ * @param nanoseconds :: the pulse time in nanoseconds
+ * @return the sort key
+ */
+uint64_t EventRadixSort::pulseTimeKey(const int64_t nanoseconds) {
+  return static_cast<uint64_t>(nanoseconds) ^ SIGN_BIT;
+}
+
+/** Sort events by tof.
+ * @param events :: the events to sort
+ * @param mode :: what to move on each pass
+ */
+template <class T>
+void EventRadixSort::sortTof(std::vector<T> &events, Mode mode) {
+  sortByKey(events, tofKeyOf<T>, mode);
+}
+
+/** Sort events by pulse time. Events with the same pulse time keep their
+ * relative order.
+ * @param events :: the events to sort
+ * @param mode :: what to move on each pass
+ */
+template <class T>
+void EventRadixSort::sortPulseTime(std::vector<T> &events, Mode mode) {
+  sortByKey(events, pulseTimeKeyOf<T>, mode);
+}
+
+/** Sort events by pulse time, then by tof within each pulse. This is done as
+ * a sort by tof followed by a stable sort by pulse time.
+ * @param events :: the events to sort
+ * @param mode :: what to move on each pass
+ */
+template <class T>
+void EventRadixSort::sortPulseTimeTOF(std::vector<T> &events, Mode mode) {
+  const size_t n = events.size();
+  if (n < 2)
+    return;
+  const auto lessThan = [](const T &lhs, const T &rhs) {
+    const auto lhsPulse = lhs.pulseTime();
+    const auto rhsPulse = rhs.pulseTime();
+    return lhsPulse < rhsPulse ||
+           (lhsPulse == rhsPulse && lhs.tof() < rhs.tof());
+  };
+  if (n < MIN_RADIX_SORT_SIZE) {
+    std::stable_sort(events.begin(), events.end(), lessThan);
+    return;
+  }
+
+  size_t descents(0);
+  for (size_t i = 1; i < n; ++i) {
+    if (lessThan(events[i], events[i - 1]))
+      ++descents;
+  }
+  if (descents == 0)
+    return;
+
+  std::vector<uint64_t> keys;
+  keys.reserve(n);
+  for (const auto &event : events)
+    keys.push_back(tofKeyOf(event));
+  if (resolveMode(mode, n, descents) == Mode::KeysOnly) {
+    std::vector<uint32_t> index(n);
+    std::iota(index.begin(), index.end(), uint32_t(0));
+    radixSort(keys, index);
+    for (size_t i = 0; i < n; ++i)
+      keys[i] = pulseTimeKeyOf(events[index[i]]);
+    radixSort(keys, index);
+    gather(index, events);
+  } else {
+    radixSort(keys, events);
+    for (size_t i = 0; i < n; ++i)
+      keys[i] = pulseTimeKeyOf(events[i]);
+    radixSort(keys, events);
+  }
+}
+
+/// @cond
+template MANTID_DATAOBJECTS_DLL void
+EventRadixSort::sortTof(std::vector<TofEvent> &, Mode);
+template MANTID_DATAOBJECTS_DLL void
+EventRadixSort::sortTof(std::vector<WeightedEvent> &, Mode);
+template MANTID_DATAOBJECTS_DLL void
+EventRadixSort::sortTof(std::vector<WeightedEventNoTime> &, Mode);
+template MANTID_DATAOBJECTS_DLL void
+EventRadixSort::sortPulseTime(std::vector<TofEvent> &, Mode);
+template MANTID_DATAOBJECTS_DLL void
+EventRadixSort::sortPulseTime(std::vector<WeightedEvent> &, Mode);
+template MANTID_DATAOBJECTS_DLL void
+EventRadixSort::sortPulseTimeTOF(std::vector<TofEvent> &, Mode);
+template MANTID_DATAOBJECTS_DLL void
+EventRadixSort::sortPulseTimeTOF(std::vector<WeightedEvent> &, Mode);
+/// @endcond
+
+} // namespace DataObjects
+} // namespace Mantid
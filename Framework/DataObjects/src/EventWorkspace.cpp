@@ -8,6 +8,7 @@
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
+#include "MantidDataObjects/FileBackedEventStore.h"
 #include "MantidGeometry/IDetector.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/CPUTimer.h"
@@ -15,10 +16,12 @@
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/FunctionTask.h"
 #include "MantidKernel/IPropertyManager.h"
+#include "MantidKernel/make_unique.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 
 #include "tbb/parallel_for.h"
+#include <algorithm>
 #include <limits>
 #include <numeric>
 
@@ -30,6 +33,27 @@ namespace DataObjects {
 namespace {
 // static logger
 Kernel::Logger g_log("EventWorkspace");
+
+/** Read access to the events of a list for the scans over the whole
+ * workspace. The events of a paged out list are read into a temporary copy,
+ * so that the list stays paged out and a scan never holds more than a few
+ * lists in memory.
+ */
+class ResidentEvents {
+public:
+  explicit ResidentEvents(const EventList &list) : m_list(&list) {
+    if (list.isPagedOut()) {
+      m_copy = Kernel::make_unique<EventList>(list);
+      m_copy->pageIn();
+      m_list = m_copy.get();
+    }
+  }
+  const EventList *operator->() const { return m_list; }
+
+private:
+  const EventList *m_list;
+  std::unique_ptr<EventList> m_copy;
+};
 } // namespace
 
 DECLARE_WORKSPACE(EventWorkspace)
@@ -42,7 +66,8 @@ EventWorkspace::EventWorkspace(const Parallel::StorageMode storageMode)
     : IEventWorkspace(storageMode), mru(new EventWorkspaceMRU) {}
 
 EventWorkspace::EventWorkspace(const EventWorkspace &other)
-    : IEventWorkspace(other), mru(new EventWorkspaceMRU) {
+    : IEventWorkspace(other), mru(new EventWorkspaceMRU),
+      m_eventStore(other.m_eventStore) {
   for (const auto &el : other.data) {
     // Create a new event list, copying over the events
     auto newel = new EventList(*el);
@@ -164,20 +189,30 @@ size_t EventWorkspace::blocksize() const {
  */
 size_t EventWorkspace::getNumberHistograms() const { return this->data.size(); }
 
-/// Return const reference to EventList at the given workspace index.
+/// Return reference to EventList at the given workspace index. A paged out
+/// list is read back into memory, since it may be modified.
 EventList &EventWorkspace::getSpectrum(const size_t index) {
   invalidateCommonBinsFlag();
-  auto &spec = const_cast<EventList &>(
-      static_cast<const EventWorkspace &>(*this).getSpectrum(index));
+  if (index >= data.size())
+    throw std::range_error(
+        "EventWorkspace::getSpectrum, workspace index out of range");
+  auto &spec = *data[index];
+  if (m_eventStore)
+    spec.pageIn();
   spec.setMatrixWorkspace(this, index);
   return spec;
 }
 
-/// Return const reference to EventList at the given workspace index.
+/// Return const reference to EventList at the given workspace index. A paged
+/// out list is read back into memory under its own lock, and stays there
+/// until the events are paged out again. The scans over the whole workspace
+/// read paged out lists into temporary copies instead.
 const EventList &EventWorkspace::getSpectrum(const size_t index) const {
   if (index >= data.size())
     throw std::range_error(
         "EventWorkspace::getSpectrum, workspace index out of range");
+  if (m_eventStore)
+    data[index]->pageIn();
   return *data[index];
 }
 
@@ -196,8 +231,8 @@ DateAndTime EventWorkspace::getPulseTimeMin() const {
   DateAndTime temp;
   for (size_t workspaceIndex = 0; workspaceIndex < numWorkspace;
        workspaceIndex++) {
-    const EventList &evList = this->getSpectrum(workspaceIndex);
-    temp = evList.getPulseTimeMin();
+    const ResidentEvents evList(*data[workspaceIndex]);
+    temp = evList->getPulseTimeMin();
     if (temp < tMin)
       tMin = temp;
   }
@@ -215,8 +250,8 @@ DateAndTime EventWorkspace::getPulseTimeMax() const {
   DateAndTime temp;
   for (size_t workspaceIndex = 0; workspaceIndex < numWorkspace;
        workspaceIndex++) {
-    const EventList &evList = this->getSpectrum(workspaceIndex);
-    temp = evList.getPulseTimeMax();
+    const ResidentEvents evList(*data[workspaceIndex]);
+    temp = evList->getPulseTimeMax();
     if (temp > tMax)
       tMax = temp;
   }
@@ -242,9 +277,9 @@ void EventWorkspace::getPulseTimeMinMax(
 #pragma omp for nowait
     for (int64_t workspaceIndex = 0; workspaceIndex < numWorkspace;
          workspaceIndex++) {
-      const EventList &evList = this->getSpectrum(workspaceIndex);
+      const ResidentEvents evList(*data[workspaceIndex]);
       DateAndTime tempMin, tempMax;
-      evList.getPulseTimeMinMax(tempMin, tempMax);
+      evList->getPulseTimeMinMax(tempMin, tempMax);
       tTmin = std::min(tTmin, tempMin);
       tTmax = std::max(tTmax, tempMax);
     }
@@ -275,8 +310,8 @@ DateAndTime EventWorkspace::getTimeAtSampleMin(double tofOffset) const {
     const auto L2 = specInfo.l2(workspaceIndex);
     const double tofFactor = L1 / (L1 + L2);
 
-    const EventList &evList = this->getSpectrum(workspaceIndex);
-    temp = evList.getTimeAtSampleMin(tofFactor, tofOffset);
+    const ResidentEvents evList(*data[workspaceIndex]);
+    temp = evList->getTimeAtSampleMin(tofFactor, tofOffset);
     if (temp < tMin)
       tMin = temp;
   }
@@ -301,8 +336,8 @@ DateAndTime EventWorkspace::getTimeAtSampleMax(double tofOffset) const {
     const auto L2 = specInfo.l2(workspaceIndex);
     const double tofFactor = L1 / (L1 + L2);
 
-    const EventList &evList = this->getSpectrum(workspaceIndex);
-    temp = evList.getTimeAtSampleMax(tofFactor, tofOffset);
+    const ResidentEvents evList(*data[workspaceIndex]);
+    temp = evList->getTimeAtSampleMax(tofFactor, tofOffset);
     if (temp > tMax)
       tMax = temp;
   }
@@ -325,8 +360,8 @@ double EventWorkspace::getEventXMin() const {
   size_t numWorkspace = this->data.size();
   for (size_t workspaceIndex = 0; workspaceIndex < numWorkspace;
        workspaceIndex++) {
-    const EventList &evList = this->getSpectrum(workspaceIndex);
-    const double temp = evList.getTofMin();
+    const ResidentEvents evList(*data[workspaceIndex]);
+    const double temp = evList->getTofMin();
     if (temp < xmin)
       xmin = temp;
   }
@@ -349,8 +384,8 @@ double EventWorkspace::getEventXMax() const {
   size_t numWorkspace = this->data.size();
   for (size_t workspaceIndex = 0; workspaceIndex < numWorkspace;
        workspaceIndex++) {
-    const EventList &evList = this->getSpectrum(workspaceIndex);
-    const double temp = evList.getTofMax();
+    const ResidentEvents evList(*data[workspaceIndex]);
+    const double temp = evList->getTofMax();
     if (temp > xmax)
       xmax = temp;
   }
@@ -375,10 +410,10 @@ void EventWorkspace::getEventXMinMax(double &xmin, double &xmax) const {
 #pragma omp for nowait
     for (int64_t workspaceIndex = 0; workspaceIndex < numWorkspace;
          workspaceIndex++) {
-      const EventList &evList = this->getSpectrum(workspaceIndex);
-      double temp = evList.getTofMin();
+      const ResidentEvents evList(*data[workspaceIndex]);
+      double temp = evList->getTofMin();
       tXmin = std::min(temp, tXmin);
-      temp = evList.getTofMax();
+      temp = evList->getTofMax();
       tXmax = std::max(temp, tXmax);
     }
 #pragma omp critical
@@ -543,7 +578,7 @@ void EventWorkspace::generateHistogram(const std::size_t index,
   if (index >= data.size())
     throw std::range_error(
         "EventWorkspace::generateHistogram, histogram number out of range");
-  this->data[index]->generateHistogram(X, Y, E, skipError);
+  ResidentEvents(*data[index])->generateHistogram(X, Y, E, skipError);
 }
 
 /** Using the event data in the event list, generate a histogram of it w.r.t
@@ -563,7 +598,8 @@ void EventWorkspace::generateHistogramPulseTime(const std::size_t index,
   if (index >= data.size())
     throw std::range_error("EventWorkspace::generateHistogramPulseTime, "
                            "histogram number out of range");
-  this->data[index]->generateHistogramPulseTime(X, Y, E, skipError);
+  ResidentEvents(*data[index])
+      ->generateHistogramPulseTime(X, Y, E, skipError);
 }
 
 /*** Set all histogram X vectors.
@@ -663,13 +699,93 @@ void EventWorkspace::getIntegratedSpectra(std::vector<double> &out,
   for (int wksp_index = 0; wksp_index < int(this->getNumberHistograms());
        wksp_index++) {
     // Get Handle to data
-    EventList *el = this->data[wksp_index];
+    const ResidentEvents el(*data[wksp_index]);
 
     // Let the eventList do the integration
     out[wksp_index] = el->integrate(minX, maxX, entireRange);
   }
 }
 
+/** Set the file the events can be paged out to. Events already paged out to
+ * another file are read back into memory first.
+ * @param store :: the file, or a null pointer to keep all events in memory
+ */
+void EventWorkspace::setEventStore(
+    boost::shared_ptr<FileBackedEventStore> store) {
+  if (m_eventStore && m_eventStore != store) {
+    for (const auto eventList : data)
+      eventList->pageIn();
+  }
+  m_eventStore = std::move(store);
+}
+
+/** Page the events of all spectra out to the event store, freeing their
+ * memory. A spectrum is paged back in when the non-const getSpectrum() is
+ * called for it.
+ * @throw std::runtime_error if there is no event store
+ */
+void EventWorkspace::pageOutEvents() {
+  if (!m_eventStore)
+    throw std::runtime_error(
+        "EventWorkspace::pageOutEvents, no event store has been set");
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(data.size()); ++i)
+    data[i]->pageOut(*m_eventStore);
+}
+
+/** Page the events of a single spectrum out to the event store, without
+ * reading them in first
+ * @param index :: the workspace index of the spectrum
+ */
+void EventWorkspace::pageOutSpectrum(const size_t index) {
+  if (!m_eventStore)
+    throw std::runtime_error(
+        "EventWorkspace::pageOutSpectrum, no event store has been set");
+  if (index >= data.size())
+    throw std::range_error(
+        "EventWorkspace::pageOutSpectrum, workspace index out of range");
+  data[index]->pageOut(*m_eventStore);
+}
+
+/** Hold the events of all spectra in columns (see EventColumns). Rebinning,
+ * integrating and converting units then work on contiguous TOF arrays; a
+ * spectrum is unpacked again by any other operation on its events.
+ */
+void EventWorkspace::switchToColumns() {
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(data.size()); ++i)
+    data[i]->switchToColumns();
+}
+
+/** Compress the events of all spectra (see CompressedEventList).
+ * Histogramming and filtering by pulse time then decode the events a block
+ * at a time; a spectrum is decoded in full by any other operation on its
+ * events.
+ * @param encoding :: how to store the times-of-flight
+ * @param tofResolution :: the quantisation step, for the Quantised encoding
+ * @throw std::invalid_argument if the workspace holds weighted events, or the
+ * resolution is not valid for the Quantised encoding
+ */
+void EventWorkspace::switchToCompressed(
+    CompressedEventList::TofEncoding encoding, double tofResolution) {
+  if (getEventType() != Mantid::API::TOF)
+    throw std::invalid_argument("EventWorkspace::switchToCompressed, only "
+                                "workspaces of TOF events can be compressed");
+  // Check the resolution here rather than in the parallel loop. The tof range
+  // of any spectrum lies within that of the workspace.
+  if (encoding == CompressedEventList::TofEncoding::Quantised &&
+      (!(tofResolution > 0.) ||
+       (getNumberEvents() > 0 &&
+        !((getEventXMax() - getEventXMin()) / tofResolution <
+          static_cast<double>(std::numeric_limits<uint32_t>::max())))))
+    throw std::invalid_argument("EventWorkspace::switchToCompressed, the tof "
+                                "resolution must be positive and fine enough "
+                                "to cover the tof range in 32 bits");
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(data.size()); ++i)
+    data[i]->switchToCompressed(encoding, tofResolution);
+}
+
 } // namespace DataObjects
 } // namespace Mantid
 
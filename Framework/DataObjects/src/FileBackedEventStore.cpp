@@ -0,0 +1,131 @@
+#include "MantidDataObjects/FileBackedEventStore.h"
+
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataObjects {
+
+using Kernel::MemoryMappedFile;
+
+namespace {
+/// Pages start on this boundary, so that no two pages share a cache line
+const size_t PAGE_ALIGNMENT = 64;
+} // namespace
+
+/** Constructor
+ * @param directory :: the directory to create the scratch file in
+ * @param capacity :: the size of the scratch file in bytes. It is sparse, so
+ * only the space written takes up disk space.
+ */
+FileBackedEventStore::FileBackedEventStore(const std::string &directory,
+                                           const size_t capacity)
+    : m_file(directory, capacity), m_end(0), m_inUse(0) {}
+
+/** Copy events to a new page of the file
+ * @param events :: the first event to copy
+ * @param numEvents :: the number of events
+ * @param eventSize :: the size of one event in bytes
+ * @return the page, which frees its space when it is destroyed
+ * @throw std::runtime_error if the file is full
+ */
+boost::shared_ptr<const EventPage>
+FileBackedEventStore::write(const void *events, const size_t numEvents,
+                            const size_t eventSize) {
+  const size_t bytes = numEvents * eventSize;
+  const size_t offset = allocate(bytes);
+  if (bytes > 0) {
+    std::memcpy(m_file.data() + offset, events, bytes);
+    // The kernel writes the pages back when it needs the memory
+    m_file.advise(offset, bytes, MemoryMappedFile::Advice::DontNeed);
+  }
+  auto store = shared_from_this();
+  return boost::shared_ptr<const EventPage>(
+      new EventPage{this, offset, bytes, numEvents},
+      [store](const EventPage *page) {
+        store->release(page->offset, page->bytes);
+        delete page;
+      });
+}
+
+/** Copy the events of a page out of the file
+ * @param page :: the page to read
+ * @param events :: where to copy the events, with room for all of them
+ */
+void FileBackedEventStore::read(const EventPage &page, void *events) const {
+  if (page.bytes == 0)
+    return;
+  // Start reading the whole page ahead of the copy
+  m_file.advise(page.offset, page.bytes, MemoryMappedFile::Advice::WillNeed);
+  m_file.advise(page.offset, page.bytes, MemoryMappedFile::Advice::Sequential);
+  std::memcpy(events, m_file.data() + page.offset, page.bytes);
+  m_file.advise(page.offset, page.bytes, MemoryMappedFile::Advice::DontNeed);
+}
+
+/// @return the number of bytes taken by pages
+size_t FileBackedEventStore::bytesInUse() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_inUse;
+}
+
+/** Find space for a page, taking the first free gap it fits in
+ * @param bytes :: the size of the page
+ * @return the offset of the page
+ */
+size_t FileBackedEventStore::allocate(const size_t bytes) {
+  const size_t size =
+      (bytes + PAGE_ALIGNMENT - 1) / PAGE_ALIGNMENT * PAGE_ALIGNMENT;
+  if (size == 0)
+    return 0;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_inUse += size;
+  for (auto gap = m_free.begin(); gap != m_free.end(); ++gap) {
+    if (gap->second < size)
+      continue;
+    const size_t offset = gap->first;
+    if (gap->second > size)
+      m_free.emplace(offset + size, gap->second - size);
+    m_free.erase(gap);
+    return offset;
+  }
+  if (m_end + size > m_file.capacity()) {
+    m_inUse -= size;
+    throw std::runtime_error("FileBackedEventStore: the scratch file is full");
+  }
+  const size_t offset = m_end;
+  m_end += size;
+  return offset;
+}
+
+/** Give back the space of a page, merging it with the free space around it
+ * @param offset :: the offset of the page
+ * @param bytes :: the size of the page
+ */
+void FileBackedEventStore::release(size_t offset, const size_t bytes) {
+  size_t size = (bytes + PAGE_ALIGNMENT - 1) / PAGE_ALIGNMENT * PAGE_ALIGNMENT;
+  if (size == 0)
+    return;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_inUse -= size;
+  auto next = m_free.lower_bound(offset);
+  if (next != m_free.end() && next->first == offset + size) {
+    size += next->second;
+    next = m_free.erase(next);
+  }
+  if (next != m_free.begin()) {
+    auto previous = std::prev(next);
+    if (previous->first + previous->second == offset) {
+      offset = previous->first;
+      size += previous->second;
+      m_free.erase(previous);
+    }
+  }
+  if (offset + size == m_end)
+    m_end = offset;
+  else
+    m_free.emplace(offset, size);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -6,9 +6,10 @@ namespace DataObjects {
 
 MDBoxSaveable::MDBoxSaveable(API::IMDNode *const Host) : m_MDNode(Host) {}
 
-/** flush data out of the file buffer to the HDD */
+/** flush data out of the file buffer to the HDD. Called by the DiskBuffer
+ * after writing out its objects, so does not wait for the writes to end */
 void MDBoxSaveable::flushData() const {
-  m_MDNode->getBoxController()->getFileIO()->flushData();
+  m_MDNode->getBoxController()->getFileIO()->queueFlushData();
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -0,0 +1,353 @@
+#include "MantidDataObjects/MDHistoExpression.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Number of bins evaluated together: the values of one block, for each
+/// operand waiting on the stack, fit in a typical L2 cache.
+const size_t BLOCK_SIZE = 1024;
+/// Fewer bins than this are evaluated on one thread
+const size_t MIN_PARALLEL_LENGTH = 64 * BLOCK_SIZE;
+
+/// Storage for the values of a block of bins
+struct Block {
+  signal_t signal[BLOCK_SIZE];
+  signal_t errorSquared[BLOCK_SIZE];
+  signal_t numEvents[BLOCK_SIZE];
+};
+
+/// The values of a block of bins, wherever they are
+struct Values {
+  const signal_t *signal;
+  const signal_t *errorSquared;
+  const signal_t *numEvents;
+};
+} // namespace
+
+/** Constructor
+ * @param workspace :: the workspace, which must outlive the expression
+ */
+MDHistoExpression::MDHistoExpression(const MDHistoWorkspace &workspace)
+    : m_steps(1, Step{Operation::Workspace, &workspace, 0.0, 0.0}) {}
+
+/** An expression of a scalar, which adds no events
+ * @param signal :: the signal
+ * @param error :: the error (not squared)
+ * @return the expression
+ */
+MDHistoExpression MDHistoExpression::scalar(const signal_t signal,
+                                            const signal_t error) {
+  MDHistoExpression expression;
+  expression.m_steps.push_back(
+      Step{Operation::Scalar, nullptr, signal, error * error});
+  return expression;
+}
+
+/// Add another expression, as MDHistoWorkspace::add()
+MDHistoExpression &MDHistoExpression::operator+=(const MDHistoExpression &rhs) {
+  return append(rhs, Operation::Add);
+}
+
+/// Subtract another expression, as MDHistoWorkspace::subtract()
+MDHistoExpression &MDHistoExpression::operator-=(const MDHistoExpression &rhs) {
+  return append(rhs, Operation::Subtract);
+}
+
+/// Multiply by another expression, as MDHistoWorkspace::multiply()
+MDHistoExpression &MDHistoExpression::operator*=(const MDHistoExpression &rhs) {
+  return append(rhs, Operation::Multiply);
+}
+
+/// Divide by another expression, as MDHistoWorkspace::divide()
+MDHistoExpression &MDHistoExpression::operator/=(const MDHistoExpression &rhs) {
+  return append(rhs, Operation::Divide);
+}
+
+/// @return the natural logarithm of the expression, as MDHistoWorkspace::log()
+MDHistoExpression MDHistoExpression::log(double filler) const {
+  return apply(Operation::Log, filler);
+}
+
+/// @return the base-10 logarithm of the expression, as
+/// MDHistoWorkspace::log10()
+MDHistoExpression MDHistoExpression::log10(double filler) const {
+  return apply(Operation::Log10, filler);
+}
+
+/// @return the exponential of the expression, as MDHistoWorkspace::exp()
+MDHistoExpression MDHistoExpression::exp() const {
+  return apply(Operation::Exp, 0.0);
+}
+
+/// @return the expression to a power, as MDHistoWorkspace::power()
+MDHistoExpression MDHistoExpression::power(double exponent) const {
+  return apply(Operation::Power, exponent);
+}
+
+/** Evaluate the expression into a workspace, which may also be one of its
+ * operands. The signal, error squared and number of events of every bin are
+ * set, and the number of contributed events.
+ *
+ * @param out :: the workspace, of the same size as the workspace operands
+ * @throw std::invalid_argument if the sizes of the workspaces differ
+ */
+void MDHistoExpression::evaluateInto(MDHistoWorkspace &out) const {
+  // Depth of the stack of operands, which is at its deepest after an operand
+  size_t depth = 0;
+  size_t maxDepth = 0;
+  for (const auto &step : m_steps) {
+    if (step.operation == Operation::Workspace) {
+      out.checkWorkspaceSize(*step.workspace, "expression");
+      maxDepth = std::max(maxDepth, ++depth);
+    } else if (step.operation == Operation::Scalar) {
+      maxDepth = std::max(maxDepth, ++depth);
+    } else if (step.operation == Operation::Add ||
+               step.operation == Operation::Subtract ||
+               step.operation == Operation::Multiply ||
+               step.operation == Operation::Divide) {
+      --depth;
+    }
+  }
+  // Before the bins change under an operand
+  const uint64_t nEventsContributed = evaluateNEventsContributed();
+
+  const size_t length = out.m_length;
+  const auto numBlocks =
+      static_cast<int64_t>((length + BLOCK_SIZE - 1) / BLOCK_SIZE);
+  PRAGMA_OMP(parallel if (length >= MIN_PARALLEL_LENGTH)) {
+    // The operands waiting for an operation, which point into a workspace or
+    // into the buffer of their place on the stack, one stack per thread
+    std::vector<Values> stack(maxDepth);
+    std::unique_ptr<Block[]> buffers(new Block[maxDepth]);
+    PRAGMA_OMP(for)
+    for (int64_t blockIndex = 0; blockIndex < numBlocks; ++blockIndex) {
+      const size_t start = static_cast<size_t>(blockIndex) * BLOCK_SIZE;
+      const size_t n = std::min(BLOCK_SIZE, length - start);
+      size_t top = 0;
+      for (size_t s = 0; s < m_steps.size(); ++s) {
+        const Step &step = m_steps[s];
+        if (step.operation == Operation::Workspace) {
+          const MDHistoWorkspace &ws = *step.workspace;
+          stack[top++] = Values{ws.m_signals + start,
+                                ws.m_errorsSquared + start,
+                                ws.m_numEvents + start};
+          continue;
+        }
+        if (step.operation == Operation::Scalar) {
+          Block &buffer = buffers[top];
+          std::fill_n(buffer.signal, n, step.value);
+          std::fill_n(buffer.errorSquared, n, step.errorSquared);
+          std::fill_n(buffer.numEvents, n, 0.0);
+          stack[top++] =
+              Values{buffer.signal, buffer.errorSquared, buffer.numEvents};
+          continue;
+        }
+        const bool binary = step.operation == Operation::Add ||
+                            step.operation == Operation::Subtract ||
+                            step.operation == Operation::Multiply ||
+                            step.operation == Operation::Divide;
+        if (binary)
+          --top;
+        const Values &a = stack[top - 1];
+        const Values &b = stack[binary ? top : top - 1];
+        // The last step writes straight into the output
+        signal_t *signal = out.m_signals + start;
+        signal_t *errorSquared = out.m_errorsSquared + start;
+        if (s + 1 < m_steps.size()) {
+          signal = buffers[top - 1].signal;
+          errorSquared = buffers[top - 1].errorSquared;
+        }
+        // Only sums change the number of events
+        const signal_t *numEvents = a.numEvents;
+
+        switch (step.operation) {
+        case Operation::Add:
+        case Operation::Subtract: {
+          signal_t *sumEvents = s + 1 < m_steps.size()
+                                    ? buffers[top - 1].numEvents
+                                    : out.m_numEvents + start;
+          const signal_t sign = step.operation == Operation::Add ? 1.0 : -1.0;
+          for (size_t i = 0; i < n; ++i) {
+            const signal_t f = a.signal[i] + sign * b.signal[i];
+            const signal_t df2 = a.errorSquared[i] + b.errorSquared[i];
+            const signal_t events = a.numEvents[i] + b.numEvents[i];
+            signal[i] = f;
+            errorSquared[i] = df2;
+            sumEvents[i] = events;
+          }
+          numEvents = sumEvents;
+          break;
+        }
+        case Operation::Multiply:
+          // df^2 = b^2 da^2 + a^2 db^2, which is safe when a or b are 0
+          for (size_t i = 0; i < n; ++i) {
+            const signal_t f = a.signal[i] * b.signal[i];
+            const signal_t df2 =
+                a.errorSquared[i] * b.signal[i] * b.signal[i] +
+                b.errorSquared[i] * a.signal[i] * a.signal[i];
+            signal[i] = f;
+            errorSquared[i] = df2;
+          }
+          break;
+        case Operation::Divide:
+          // df^2 = da^2 / b^2 + db^2 f^2 / b^2, which is safe when a is 0
+          for (size_t i = 0; i < n; ++i) {
+            const signal_t f = a.signal[i] / b.signal[i];
+            const signal_t b2 = b.signal[i] * b.signal[i];
+            const signal_t df2 =
+                a.errorSquared[i] / b2 + b.errorSquared[i] * f * f / b2;
+            signal[i] = f;
+            errorSquared[i] = df2;
+          }
+          break;
+        case Operation::Log:
+        case Operation::Log10: {
+          // df^2 = da^2 / a^2, times ln(10)^-2 for base 10
+          const bool base10 = step.operation == Operation::Log10;
+          for (size_t i = 0; i < n; ++i) {
+            const signal_t x = a.signal[i];
+            if (x <= 0) {
+              signal[i] = step.value;
+              errorSquared[i] = 0;
+            } else if (base10) {
+              const signal_t df2 = 0.1886117 * a.errorSquared[i] / (x * x);
+              signal[i] = std::log10(x);
+              errorSquared[i] = df2;
+            } else {
+              const signal_t df2 = a.errorSquared[i] / (x * x);
+              signal[i] = std::log(x);
+              errorSquared[i] = df2;
+            }
+          }
+          break;
+        }
+        case Operation::Exp:
+          // df^2 = f^2 da^2
+          for (size_t i = 0; i < n; ++i) {
+            const signal_t f = std::exp(a.signal[i]);
+            const signal_t df2 = f * f * a.errorSquared[i];
+            signal[i] = f;
+            errorSquared[i] = df2;
+          }
+          break;
+        case Operation::Power: {
+          // df^2 = f^2 b^2 da^2 / a^2
+          const signal_t exponentSquared = step.value * step.value;
+          for (size_t i = 0; i < n; ++i) {
+            const signal_t x = a.signal[i];
+            const signal_t f = std::pow(x, step.value);
+            const signal_t df2 =
+                f * f * exponentSquared * a.errorSquared[i] / (x * x);
+            signal[i] = f;
+            errorSquared[i] = df2;
+          }
+          break;
+        }
+        default:
+          break;
+        }
+        stack[top - 1] = Values{signal, errorSquared, numEvents};
+      }
+
+      // Copy whatever did not come from the last step
+      const Values &result = stack[0];
+      if (result.signal != out.m_signals + start) {
+        std::copy_n(result.signal, n, out.m_signals + start);
+        std::copy_n(result.errorSquared, n, out.m_errorsSquared + start);
+      }
+      if (result.numEvents != out.m_numEvents + start)
+        std::copy_n(result.numEvents, n, out.m_numEvents + start);
+    }
+  }
+  out.m_nEventsContributed = nEventsContributed;
+}
+
+/** Append the steps of another expression and an operation on both
+ * @param rhs :: the other expression, the right operand
+ * @param operation :: the operation
+ * @return *this after the operation
+ */
+MDHistoExpression &MDHistoExpression::append(const MDHistoExpression &rhs,
+                                             const Operation operation) {
+  m_steps.insert(m_steps.end(), rhs.m_steps.begin(), rhs.m_steps.end());
+  m_steps.push_back(Step{operation, nullptr, 0.0, 0.0});
+  return *this;
+}
+
+/** @return a copy of the expression with a function applied
+ * @param operation :: the function
+ * @param value :: the filler or exponent of the function
+ */
+MDHistoExpression MDHistoExpression::apply(const Operation operation,
+                                           const signal_t value) const {
+  MDHistoExpression result(*this);
+  result.m_steps.push_back(Step{operation, nullptr, value, 0.0});
+  return result;
+}
+
+/** @return the number of contributed events of the result: the workspaces
+ * added or subtracted contribute theirs, the other operations keep those of
+ * the left operand.
+ */
+uint64_t MDHistoExpression::evaluateNEventsContributed() const {
+  std::vector<uint64_t> stack;
+  for (const auto &step : m_steps) {
+    switch (step.operation) {
+    case Operation::Workspace:
+      stack.push_back(step.workspace->m_nEventsContributed);
+      break;
+    case Operation::Scalar:
+      stack.push_back(0);
+      break;
+    case Operation::Add:
+    case Operation::Subtract: {
+      const uint64_t rhs = stack.back();
+      stack.pop_back();
+      stack.back() += rhs;
+      break;
+    }
+    case Operation::Multiply:
+    case Operation::Divide:
+      stack.pop_back();
+      break;
+    default:
+      break;
+    }
+  }
+  return stack.back();
+}
+
+/// @return the sum of two expressions
+MDHistoExpression operator+(MDHistoExpression lhs,
+                            const MDHistoExpression &rhs) {
+  return lhs += rhs;
+}
+
+/// @return the difference of two expressions
+MDHistoExpression operator-(MDHistoExpression lhs,
+                            const MDHistoExpression &rhs) {
+  return lhs -= rhs;
+}
+
+/// @return the product of two expressions
+MDHistoExpression operator*(MDHistoExpression lhs,
+                            const MDHistoExpression &rhs) {
+  return lhs *= rhs;
+}
+
+/// @return the quotient of two expressions
+MDHistoExpression operator/(MDHistoExpression lhs,
+                            const MDHistoExpression &rhs) {
+  return lhs /= rhs;
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -2,6 +2,7 @@
 #include "MantidAPI/IMDIterator.h"
 #include "MantidAPI/IMDWorkspace.h"
 #include "MantidDataObjects/MDFramesToSpecialCoordinateSystem.h"
+#include "MantidDataObjects/MDHistoExpression.h"
 #include "MantidDataObjects/MDHistoWorkspaceIterator.h"
 #include "MantidGeometry/MDGeometry/IMDDimension.h"
 #include "MantidGeometry/MDGeometry/MDDimensionExtents.h"
@@ -774,12 +775,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator+=(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::add(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "add");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] += b.m_signals[i];
-    m_errorsSquared[i] += b.m_errorsSquared[i];
-    m_numEvents[i] += b.m_numEvents[i];
-  }
-  m_nEventsContributed += b.m_nEventsContributed;
+  (MDHistoExpression(*this) + b).evaluateInto(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -789,11 +785,8 @@ void MDHistoWorkspace::add(const MDHistoWorkspace &b) {
  * @param error :: error (not squared) to apply
  * */
 void MDHistoWorkspace::add(const signal_t signal, const signal_t error) {
-  signal_t errorSquared = error * error;
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] += signal;
-    m_errorsSquared[i] += errorSquared;
-  }
+  (MDHistoExpression(*this) + MDHistoExpression::scalar(signal, error))
+      .evaluateInto(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -813,12 +806,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator-=(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::subtract(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "subtract");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] -= b.m_signals[i];
-    m_errorsSquared[i] += b.m_errorsSquared[i];
-    m_numEvents[i] += b.m_numEvents[i];
-  }
-  m_nEventsContributed += b.m_nEventsContributed;
+  (MDHistoExpression(*this) - b).evaluateInto(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -828,11 +816,8 @@ void MDHistoWorkspace::subtract(const MDHistoWorkspace &b) {
  * @param error :: error (not squared) to apply
  * */
 void MDHistoWorkspace::subtract(const signal_t signal, const signal_t error) {
-  signal_t errorSquared = error * error;
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] -= signal;
-    m_errorsSquared[i] += errorSquared;
-  }
+  (MDHistoExpression(*this) - MDHistoExpression::scalar(signal, error))
+      .evaluateInto(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -861,19 +846,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator*=(const MDHistoWorkspace &b_ws) {
  * */
 void MDHistoWorkspace::multiply(const MDHistoWorkspace &b_ws) {
   checkWorkspaceSize(b_ws, "multiply");
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
-
-    signal_t b = b_ws.m_signals[i];
-    signal_t db2 = b_ws.m_errorsSquared[i];
-
-    signal_t f = a * b;
-    signal_t df2 = da2 * b * b + db2 * a * a;
-
-    m_signals[i] = f;
-    m_errorsSquared[i] = df2;
-  }
+  (MDHistoExpression(*this) * b_ws).evaluateInto(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -889,19 +862,8 @@ void MDHistoWorkspace::multiply(const MDHistoWorkspace &b_ws) {
  * @param error :: error (not squared) to apply
  * @return *this after operation */
 void MDHistoWorkspace::multiply(const signal_t signal, const signal_t error) {
-  signal_t b = signal;
-  signal_t db2 = error * error;
-
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
-
-    signal_t f = a * b;
-    signal_t df2 = da2 * b * b + db2 * a * a;
-
-    m_signals[i] = f;
-    m_errorsSquared[i] = df2;
-  }
+  (MDHistoExpression(*this) * MDHistoExpression::scalar(signal, error))
+      .evaluateInto(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -930,19 +892,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator/=(const MDHistoWorkspace &b_ws) {
  **/
 void MDHistoWorkspace::divide(const MDHistoWorkspace &b_ws) {
   checkWorkspaceSize(b_ws, "divide");
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
-
-    signal_t b = b_ws.m_signals[i];
-    signal_t db2 = b_ws.m_errorsSquared[i];
-
-    signal_t f = a / b;
-    signal_t df2 = da2 / (b * b) + db2 * f * f / (b * b);
-
-    m_signals[i] = f;
-    m_errorsSquared[i] = df2;
-  }
+  (MDHistoExpression(*this) / b_ws).evaluateInto(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -958,19 +908,8 @@ void MDHistoWorkspace::divide(const MDHistoWorkspace &b_ws) {
  * @param error :: error (not squared) to apply
  **/
 void MDHistoWorkspace::divide(const signal_t signal, const signal_t error) {
-  signal_t b = signal;
-  signal_t db2 = error * error;
-  signal_t db2_relative = db2 / (b * b);
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
-
-    signal_t f = a / b;
-    signal_t df2 = da2 / (b * b) + db2_relative * f * f;
-
-    m_signals[i] = f;
-    m_errorsSquared[i] = df2;
-  }
+  (MDHistoExpression(*this) / MDHistoExpression::scalar(signal, error))
+      .evaluateInto(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -980,17 +919,7 @@ void MDHistoWorkspace::divide(const signal_t signal, const signal_t error) {
  * \f$ df^2 = a^2 / da^2 \f$
  */
 void MDHistoWorkspace::log(double filler) {
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
-    if (a <= 0) {
-      m_signals[i] = filler;
-      m_errorsSquared[i] = 0;
-    } else {
-      m_signals[i] = std::log(a);
-      m_errorsSquared[i] = da2 / (a * a);
-    }
-  }
+  MDHistoExpression(*this).log(filler).evaluateInto(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1000,17 +929,7 @@ void MDHistoWorkspace::log(double filler) {
  * \f$ df^2 = (ln(10)^-2) * a^2 / da^2 \f$
  */
 void MDHistoWorkspace::log10(double filler) {
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
-    if (a <= 0) {
-      m_signals[i] = filler;
-      m_errorsSquared[i] = 0;
-    } else {
-      m_signals[i] = std::log10(a);
-      m_errorsSquared[i] = 0.1886117 * da2 / (a * a); // 0.1886117  = ln(10)^-2
-    }
-  }
+  MDHistoExpression(*this).log10(filler).evaluateInto(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1020,12 +939,7 @@ void MDHistoWorkspace::log10(double filler) {
  * \f$ df^2 = f^2 * da^2 \f$
  */
 void MDHistoWorkspace::exp() {
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t f = std::exp(m_signals[i]);
-    signal_t da2 = m_errorsSquared[i];
-    m_signals[i] = f;
-    m_errorsSquared[i] = f * f * da2;
-  }
+  MDHistoExpression(*this).exp().evaluateInto(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1036,14 +950,7 @@ void MDHistoWorkspace::exp() {
  * \f$ df^2 = f^2 * b^2 * (da^2 / a^2) \f$
  */
 void MDHistoWorkspace::power(double exponent) {
-  double exponent_squared = exponent * exponent;
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t f = std::pow(a, exponent);
-    signal_t da2 = m_errorsSquared[i];
-    m_signals[i] = f;
-    m_errorsSquared[i] = f * f * exponent_squared * da2 / (a * a);
-  }
+  MDHistoExpression(*this).power(exponent).evaluateInto(*this);
 }
 
 //==============================================================================================
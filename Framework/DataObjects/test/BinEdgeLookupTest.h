@@ -0,0 +1,200 @@
+#ifndef MANTID_DATAOBJECTS_BINEDGELOOKUPTEST_H_
+#define MANTID_DATAOBJECTS_BINEDGELOOKUPTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/BinEdgeLookup.h"
+#include "MantidDataObjects/Events.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using Mantid::DataObjects::BinEdgeLookup;
+using Mantid::DataObjects::WeightedEvent;
+using Mantid::MantidVec;
+using Mantid::Types::Event::TofEvent;
+
+namespace {
+/// Linear edges as produced by Rebin: the last bin is cut at xMax
+MantidVec linearEdges(const double xMin, const double step, const double xMax) {
+  MantidVec X;
+  for (double x = xMin; x < xMax; x += step)
+    X.push_back(x);
+  X.push_back(xMax);
+  return X;
+}
+
+/// Logarithmic edges as produced by Rebin: the last bin is cut at xMax
+MantidVec logEdges(const double xMin, const double step, const double xMax) {
+  MantidVec X;
+  for (double x = xMin; x < xMax; x *= 1. + step)
+    X.push_back(x);
+  X.push_back(xMax);
+  return X;
+}
+
+/// The bin of x found by searching the edges; X.size() - 1 if outside
+size_t searchBin(const MantidVec &X, const double x) {
+  if (!(x >= X.front() && x < X.back()))
+    return X.size() - 1;
+  return std::upper_bound(X.cbegin(), X.cend(), x) - X.cbegin() - 1;
+}
+
+/// Histogram the events by searching the edges
+MantidVec searchHistogram(const MantidVec &X,
+                          const std::vector<TofEvent> &events) {
+  MantidVec Y(X.size() - 1, 0.);
+  for (const auto &event : events) {
+    const size_t bin = searchBin(X, event.tof());
+    if (bin < Y.size())
+      Y[bin] += 1.;
+  }
+  return Y;
+}
+} // namespace
+
+class BinEdgeLookupTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BinEdgeLookupTest *createSuite() { return new BinEdgeLookupTest(); }
+  static void destroySuite(BinEdgeLookupTest *suite) { delete suite; }
+
+  void test_spacing_is_detected() {
+    const auto linear = linearEdges(0., 0.1, 100.05);
+    TS_ASSERT_EQUALS(BinEdgeLookup(linear).spacing(),
+                     BinEdgeLookup::Spacing::Linear);
+    const auto logarithmic = logEdges(10., 0.01, 20000.);
+    TS_ASSERT_EQUALS(BinEdgeLookup(logarithmic).spacing(),
+                     BinEdgeLookup::Spacing::Logarithmic);
+    const MantidVec irregular{0., 1., 3., 4., 10.};
+    TS_ASSERT_EQUALS(BinEdgeLookup(irregular).spacing(),
+                     BinEdgeLookup::Spacing::Irregular);
+    const MantidVec descending{3., 2., 1.};
+    TS_ASSERT_EQUALS(BinEdgeLookup(descending).spacing(),
+                     BinEdgeLookup::Spacing::Irregular);
+  }
+
+  void test_no_bins() {
+    const MantidVec X{1.};
+    BinEdgeLookup lookup(X);
+    TS_ASSERT_EQUALS(lookup.numberOfBins(), 0);
+    TS_ASSERT_EQUALS(lookup.findBin(1.), 0);
+    MantidVec Y;
+    lookup.addCounts(std::vector<TofEvent>{{1.}}, Y);
+    TS_ASSERT(Y.empty());
+  }
+
+  void test_findBin_matches_search_on_the_edges() {
+    const auto linear = linearEdges(-5., 0.3, 7.);
+    const auto logarithmic = logEdges(1., 0.004, 1000.);
+    const MantidVec irregular{0., 1., 3., 4., 10.};
+    for (const auto &X : {linear, logarithmic, irregular}) {
+      BinEdgeLookup lookup(X);
+      // Every edge, and values just either side of it
+      for (const double edge : X) {
+        for (const double x :
+             {edge, std::nextafter(edge, -1e300), std::nextafter(edge, 1e300)})
+          TS_ASSERT_EQUALS(lookup.findBin(x), searchBin(X, x));
+      }
+    }
+  }
+
+  void test_findBin_outside_and_special_values() {
+    const auto X = logEdges(1., 0.1, 100.);
+    BinEdgeLookup lookup(X);
+    const size_t outside = lookup.numberOfBins();
+    TS_ASSERT_EQUALS(lookup.findBin(-1.), outside);
+    TS_ASSERT_EQUALS(lookup.findBin(0.), outside);
+    TS_ASSERT_EQUALS(lookup.findBin(100.), outside);
+    TS_ASSERT_EQUALS(lookup.findBin(std::numeric_limits<double>::infinity()),
+                     outside);
+    TS_ASSERT_EQUALS(lookup.findBin(std::numeric_limits<double>::quiet_NaN()),
+                     outside);
+  }
+
+  void test_addCounts_matches_search_for_unsorted_events() {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<double> distribution(-10., 1100.);
+    std::vector<TofEvent> events;
+    for (size_t i = 0; i < 10000; ++i)
+      events.emplace_back(distribution(generator));
+    std::vector<double> tofs;
+    for (const auto &event : events)
+      tofs.push_back(event.tof());
+
+    for (const auto &X :
+         {linearEdges(0., 1.7, 1000.), logEdges(1., 0.01, 1000.),
+          MantidVec{0., 1., 3., 4., 10., 500.}}) {
+      const auto expected = searchHistogram(X, events);
+      BinEdgeLookup lookup(X);
+      MantidVec fromEvents(X.size() - 1, 0.);
+      lookup.addCounts(events, fromEvents);
+      TS_ASSERT_EQUALS(fromEvents, expected);
+      MantidVec fromValues(X.size() - 1, 0.);
+      lookup.addCounts(tofs.data(), tofs.size(), fromValues);
+      TS_ASSERT_EQUALS(fromValues, expected);
+    }
+  }
+
+  void test_addWeights() {
+    const MantidVec X{0., 1., 2., 3.};
+    std::vector<WeightedEvent> events{{0.5, 0, 2.0, 4.0},
+                                      {2.5, 0, 3.0, 9.0},
+                                      {0.1, 0, 1.0, 1.0},
+                                      {5., 0, 1.0, 1.0}};
+    MantidVec Y(3, 0.), E2(3, 0.);
+    BinEdgeLookup(X).addWeights(events, Y, E2);
+    TS_ASSERT_EQUALS(Y, MantidVec({3., 0., 3.}));
+    TS_ASSERT_EQUALS(E2, MantidVec({5., 0., 9.}));
+  }
+};
+
+class BinEdgeLookupTestPerformance : public CxxTest::TestSuite {
+public:
+  static BinEdgeLookupTestPerformance *createSuite() {
+    return new BinEdgeLookupTestPerformance();
+  }
+  static void destroySuite(BinEdgeLookupTestPerformance *suite) {
+    delete suite;
+  }
+
+  BinEdgeLookupTestPerformance()
+      : m_linear(linearEdges(0., 1., 20000.)),
+        m_logarithmic(logEdges(10., 0.0005, 20000.)) {
+    std::mt19937 generator(4321);
+    std::uniform_real_distribution<double> distribution(0., 20000.);
+    m_events.reserve(20000000);
+    for (size_t i = 0; i < 20000000; ++i)
+      m_events.emplace_back(distribution(generator));
+  }
+
+  void test_linear_lookup() {
+    MantidVec Y(m_linear.size() - 1, 0.);
+    BinEdgeLookup(m_linear).addCounts(m_events, Y);
+  }
+
+  void test_linear_search() {
+    MantidVec Y = searchHistogram(m_linear, m_events);
+    TS_ASSERT(!Y.empty());
+  }
+
+  void test_log_lookup() {
+    MantidVec Y(m_logarithmic.size() - 1, 0.);
+    BinEdgeLookup(m_logarithmic).addCounts(m_events, Y);
+  }
+
+  void test_log_search() {
+    MantidVec Y = searchHistogram(m_logarithmic, m_events);
+    TS_ASSERT(!Y.empty());
+  }
+
+private:
+  MantidVec m_linear;
+  MantidVec m_logarithmic;
+  std::vector<TofEvent> m_events;
+};
+
+#endif /* MANTID_DATAOBJECTS_BINEDGELOOKUPTEST_H_ */
@@ -0,0 +1,282 @@
+#ifndef MANTID_DATAOBJECTS_COMPRESSEDEVENTLISTTEST_H_
+#define MANTID_DATAOBJECTS_COMPRESSEDEVENTLISTTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/CompressedEventList.h"
+#include "MantidDataObjects/EventList.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+using Mantid::DataObjects::CompressedEventList;
+using Mantid::DataObjects::EventList;
+using Mantid::MantidVec;
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+namespace {
+using TofEncoding = CompressedEventList::TofEncoding;
+
+/// Events in pulse order: numPulses pulses of eventsPerPulse random tofs
+std::vector<TofEvent> pulsedEvents(const size_t numPulses,
+                                   const size_t eventsPerPulse) {
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<double> tof(0., 20000.);
+  std::vector<TofEvent> events;
+  events.reserve(numPulses * eventsPerPulse);
+  for (size_t pulse = 0; pulse < numPulses; ++pulse) {
+    const DateAndTime pulseTime(static_cast<int64_t>(pulse) * 16666667);
+    for (size_t i = 0; i < eventsPerPulse; ++i)
+      events.emplace_back(tof(generator), pulseTime);
+  }
+  return events;
+}
+
+/// Field by field equality, as TofEvent::operator== uses a tolerance
+bool sameEvents(const std::vector<TofEvent> &lhs,
+                const std::vector<TofEvent> &rhs) {
+  return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend(),
+                    [](const TofEvent &a, const TofEvent &b) {
+                      return a.tof() == b.tof() &&
+                             a.pulseTime() == b.pulseTime();
+                    });
+}
+} // namespace
+
+class CompressedEventListTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompressedEventListTest *createSuite() {
+    return new CompressedEventListTest();
+  }
+  static void destroySuite(CompressedEventListTest *suite) { delete suite; }
+
+  void test_empty() {
+    CompressedEventList compressed;
+    TS_ASSERT(compressed.empty());
+    std::vector<TofEvent> events{{1.}};
+    compressed.toEvents(events);
+    TS_ASSERT(events.empty());
+  }
+
+  void test_double_encoding_is_lossless() {
+    const auto events = pulsedEvents(50, 100);
+    CompressedEventList compressed(events);
+    TS_ASSERT_EQUALS(compressed.size(), events.size());
+    TS_ASSERT_EQUALS(compressed.numberOfPulseRuns(), 50);
+    TS_ASSERT_EQUALS(compressed.maxTofError(), 0.);
+    TS_ASSERT_LESS_THAN(compressed.getMemorySize(),
+                        events.size() * sizeof(TofEvent));
+    std::vector<TofEvent> decoded;
+    compressed.toEvents(decoded);
+    TS_ASSERT(sameEvents(decoded, events));
+  }
+
+  void test_runs_do_not_reorder_events() {
+    const std::vector<TofEvent> events{
+        {1., 10}, {2., 10}, {3., 5}, {4., 10}, {5., 10}, {6., 20}};
+    CompressedEventList compressed(events);
+    TS_ASSERT_EQUALS(compressed.numberOfPulseRuns(), 4);
+    std::vector<TofEvent> decoded;
+    compressed.toEvents(decoded);
+    TS_ASSERT(sameEvents(decoded, events));
+  }
+
+  void test_float_encoding_error_is_bounded() {
+    const auto events = pulsedEvents(10, 1000);
+    CompressedEventList compressed(events, TofEncoding::Float);
+    TS_ASSERT_LESS_THAN(compressed.getMemorySize(),
+                        events.size() * (sizeof(float) + 1));
+    TS_ASSERT_LESS_THAN_EQUALS(compressed.maxTofError(), 20000. * 6e-8);
+    std::vector<TofEvent> decoded;
+    compressed.toEvents(decoded);
+    TS_ASSERT_EQUALS(decoded.size(), events.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+      TS_ASSERT_LESS_THAN_EQUALS(
+          std::abs(decoded[i].tof() - events[i].tof()),
+          compressed.maxTofError());
+      TS_ASSERT_EQUALS(decoded[i].pulseTime(), events[i].pulseTime());
+    }
+  }
+
+  void test_quantised_encoding_error_is_bounded() {
+    const auto events = pulsedEvents(10, 1000);
+    const double resolution = 0.01;
+    CompressedEventList compressed(events, TofEncoding::Quantised, resolution);
+    TS_ASSERT_LESS_THAN_EQUALS(compressed.maxTofError(),
+                               0.5 * resolution * (1. + 1e-9));
+    std::vector<TofEvent> decoded;
+    compressed.toEvents(decoded);
+    for (size_t i = 0; i < events.size(); ++i)
+      TS_ASSERT_LESS_THAN_EQUALS(
+          std::abs(decoded[i].tof() - events[i].tof()),
+          compressed.maxTofError());
+  }
+
+  void test_quantised_encoding_rejects_bad_resolution() {
+    const auto events = pulsedEvents(1, 10);
+    TS_ASSERT_THROWS(CompressedEventList(events, TofEncoding::Quantised, 0.),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(
+        CompressedEventList(events, TofEncoding::Quantised, 1e-10),
+        const std::invalid_argument &);
+  }
+
+  void test_generateHistogram_matches_decoded_events() {
+    const auto events = pulsedEvents(20, 500);
+    MantidVec X;
+    for (double x = 0.; x <= 20000.; x += 250.)
+      X.push_back(x);
+    for (const auto encoding :
+         {TofEncoding::Double, TofEncoding::Float, TofEncoding::Quantised}) {
+      CompressedEventList compressed(events, encoding, 0.5);
+      std::vector<TofEvent> decoded;
+      compressed.toEvents(decoded);
+      MantidVec expected(X.size() - 1, 0.);
+      for (const auto &event : decoded) {
+        const auto bin =
+            std::upper_bound(X.cbegin(), X.cend(), event.tof()) - X.cbegin();
+        if (bin > 0 && static_cast<size_t>(bin) < X.size())
+          expected[bin - 1] += 1.;
+      }
+      MantidVec Y, E;
+      compressed.generateHistogram(X, Y, E);
+      TS_ASSERT_EQUALS(Y, expected);
+      TS_ASSERT_DELTA(E[3], std::sqrt(Y[3]), 1e-12);
+    }
+  }
+
+  void test_filterByPulseTime() {
+    const auto events = pulsedEvents(20, 50);
+    const DateAndTime start(5 * 16666667), stop(8 * 16666667);
+    std::vector<TofEvent> expected;
+    for (const auto &event : events) {
+      if (event.pulseTime() >= start && event.pulseTime() < stop)
+        expected.push_back(event);
+    }
+    TS_ASSERT_EQUALS(expected.size(), 150);
+    std::vector<TofEvent> filtered;
+    CompressedEventList(events).filterByPulseTime(start, stop, filtered);
+    TS_ASSERT(sameEvents(filtered, expected));
+
+    // Runs out of pulse time order are all searched
+    std::vector<TofEvent> reversed(events.rbegin(), events.rend());
+    std::reverse(expected.begin(), expected.end());
+    filtered.clear();
+    CompressedEventList(reversed).filterByPulseTime(start, stop, filtered);
+    TS_ASSERT(sameEvents(filtered, expected));
+  }
+
+  void test_eventList_round_trip() {
+    EventList eventList;
+    for (const auto &event : pulsedEvents(5, 20))
+      eventList += event;
+    eventList.sortTof();
+    CompressedEventList compressed(eventList);
+    TS_ASSERT(compressed.isSortedByTof());
+
+    EventList copy;
+    compressed.copyInto(copy);
+    TS_ASSERT_EQUALS(copy.getNumberEvents(), eventList.getNumberEvents());
+    TS_ASSERT(copy.isSortedByTof());
+    TS_ASSERT(sameEvents(copy.getEvents(), eventList.getEvents()));
+  }
+
+  void test_weighted_eventList_throws() {
+    EventList eventList;
+    eventList += TofEvent(1.);
+    eventList.switchTo(Mantid::API::WEIGHTED);
+    TS_ASSERT_THROWS(CompressedEventList{eventList},
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(eventList.switchToCompressed(),
+                     const std::invalid_argument &);
+    TS_ASSERT(!eventList.isCompressed());
+  }
+
+  void test_eventList_storage_mode() {
+    const auto events = pulsedEvents(20, 50);
+    EventList eventList;
+    for (const auto &event : events)
+      eventList += event;
+    EventList compressed(eventList);
+    compressed.switchToCompressed(TofEncoding::Quantised, 0.5);
+    TS_ASSERT(compressed.isCompressed());
+    TS_ASSERT_EQUALS(compressed.getNumberEvents(), events.size());
+    TS_ASSERT_LESS_THAN(compressed.getMemorySize(), eventList.getMemorySize());
+
+    // Histogramming and filtering decode without expanding the list
+    MantidVec X, Y, E, compressedY, compressedE;
+    for (double x = 0.; x <= 21000.; x += 1000.)
+      X.push_back(x);
+    eventList.generateHistogram(X, Y, E);
+    compressed.generateHistogram(X, compressedY, compressedE);
+    TS_ASSERT_EQUALS(std::accumulate(compressedY.cbegin(), compressedY.cend(),
+                                     0.),
+                     static_cast<double>(events.size()));
+    for (size_t i = 0; i < Y.size(); ++i)
+      TS_ASSERT_DELTA(compressedY[i], Y[i], 1.);
+    EventList filtered, compressedFiltered;
+    const DateAndTime start(int64_t(5) * 16666667);
+    const DateAndTime stop(int64_t(10) * 16666667);
+    eventList.filterByPulseTime(start, stop, filtered);
+    compressed.filterByPulseTime(start, stop, compressedFiltered);
+    TS_ASSERT_EQUALS(compressedFiltered.getNumberEvents(), 5 * 50);
+    TS_ASSERT_EQUALS(compressedFiltered.getNumberEvents(),
+                     filtered.getNumberEvents());
+    TS_ASSERT(compressed.isCompressed());
+
+    // Anything else decodes the events, in their original order
+    const auto &decoded = compressed.getEvents();
+    TS_ASSERT(!compressed.isCompressed());
+    TS_ASSERT_EQUALS(decoded.size(), events.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+      TS_ASSERT_DELTA(decoded[i].tof(), events[i].tof(), 0.25);
+      TS_ASSERT_EQUALS(decoded[i].pulseTime(), events[i].pulseTime());
+    }
+  }
+};
+
+class CompressedEventListTestPerformance : public CxxTest::TestSuite {
+public:
+  static CompressedEventListTestPerformance *createSuite() {
+    return new CompressedEventListTestPerformance();
+  }
+  static void destroySuite(CompressedEventListTestPerformance *suite) {
+    delete suite;
+  }
+
+  CompressedEventListTestPerformance()
+      : m_events(pulsedEvents(10000, 1000)),
+        m_compressed(m_events, TofEncoding::Float) {
+    for (double x = 0.; x <= 20000.; x += 10.)
+      m_X.push_back(x);
+  }
+
+  void test_compress() {
+    CompressedEventList compressed(m_events, TofEncoding::Float);
+    TS_ASSERT_EQUALS(compressed.size(), m_events.size());
+  }
+
+  void test_histogram_compressed() {
+    MantidVec Y, E;
+    m_compressed.generateHistogram(m_X, Y, E);
+  }
+
+  void test_filter_compressed() {
+    std::vector<TofEvent> output;
+    m_compressed.filterByPulseTime(DateAndTime(int64_t(1000) * 16666667),
+                                   DateAndTime(int64_t(2000) * 16666667),
+                                   output);
+  }
+
+private:
+  std::vector<TofEvent> m_events;
+  CompressedEventList m_compressed;
+  MantidVec m_X;
+};
+
+#endif /* MANTID_DATAOBJECTS_COMPRESSEDEVENTLISTTEST_H_ */
@@ -0,0 +1,170 @@
+#ifndef MANTID_DATAOBJECTS_EVENTCOLUMNSTEST_H_
+#define MANTID_DATAOBJECTS_EVENTCOLUMNSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/EventColumns.h"
+#include "MantidDataObjects/EventList.h"
+
+#include <cmath>
+
+using namespace Mantid::DataObjects;
+using Mantid::API::EventType;
+using Mantid::Types::Event::TofEvent;
+
+class EventColumnsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventColumnsTest *createSuite() { return new EventColumnsTest(); }
+  static void destroySuite(EventColumnsTest *suite) { delete suite; }
+
+  void test_default_constructor() {
+    EventColumns columns;
+    TS_ASSERT(columns.empty());
+    TS_ASSERT_EQUALS(columns.getEventType(), Mantid::API::TOF);
+    TS_ASSERT(columns.isSortedByTof());
+  }
+
+  void test_tof_events_round_trip() {
+    std::vector<TofEvent> events{{30., 3}, {10., 1}, {20., 2}};
+    EventColumns columns(events);
+    TS_ASSERT_EQUALS(columns.size(), 3);
+    TS_ASSERT_EQUALS(columns.getEventType(), Mantid::API::TOF);
+    TS_ASSERT_EQUALS(columns.pulseTimes().size(), 3);
+    TS_ASSERT(columns.weights().empty());
+
+    std::vector<TofEvent> out;
+    columns.toEvents(out);
+    TS_ASSERT_EQUALS(out, events);
+  }
+
+  void test_weighted_events_round_trip() {
+    std::vector<WeightedEvent> events{{10., 1, 2.0, 4.0}, {5., 2, 3.0, 9.0}};
+    EventColumns columns(events);
+    TS_ASSERT_EQUALS(columns.getEventType(), Mantid::API::WEIGHTED);
+    TS_ASSERT_EQUALS(columns.weights()[1], 3.f);
+    TS_ASSERT_EQUALS(columns.errorSquareds()[1], 9.f);
+
+    std::vector<WeightedEvent> out;
+    columns.toEvents(out);
+    TS_ASSERT_EQUALS(out, events);
+    std::vector<TofEvent> unweighted;
+    TS_ASSERT_THROWS(columns.toEvents(unweighted), std::runtime_error);
+  }
+
+  void test_weighted_no_time_has_no_pulse_times() {
+    std::vector<WeightedEventNoTime> events{{10., 2.0, 4.0}};
+    EventColumns columns(events);
+    TS_ASSERT(columns.pulseTimes().empty());
+    std::vector<WeightedEvent> out;
+    TS_ASSERT_THROWS(columns.toEvents(out), std::runtime_error);
+    std::vector<WeightedEventNoTime> noTime;
+    columns.toEvents(noTime);
+    TS_ASSERT_EQUALS(noTime, events);
+  }
+
+  void test_sortTof_moves_all_columns() {
+    std::vector<WeightedEvent> events{
+        {30., 3, 3.0, 9.0}, {10., 1, 1.0, 1.0}, {20., 2, 2.0, 4.0}};
+    EventColumns columns(events);
+    columns.sortTof();
+    TS_ASSERT(columns.isSortedByTof());
+    for (size_t i = 0; i < 3; ++i) {
+      TS_ASSERT_EQUALS(columns.tofs()[i], 10. * static_cast<double>(i + 1));
+      TS_ASSERT_EQUALS(columns.pulseTimes()[i], static_cast<int64_t>(i + 1));
+      TS_ASSERT_EQUALS(columns.weights()[i], static_cast<float>(i + 1));
+    }
+  }
+
+  void test_conversion_from_and_to_EventList() {
+    EventList el;
+    for (int i = 0; i < 10; ++i)
+      el += TofEvent(static_cast<double>(10 - i), i);
+    el.addDetectorID(42);
+    EventColumns columns(el);
+    TS_ASSERT_EQUALS(columns.size(), 10);
+
+    columns.sortTof();
+    EventList copy;
+    copy.addDetectorID(42);
+    columns.copyInto(copy);
+    TS_ASSERT_EQUALS(copy.getNumberEvents(), 10);
+    TS_ASSERT(copy.isSortedByTof());
+    el.sortTof();
+    TS_ASSERT_EQUALS(copy, el);
+  }
+
+  void test_generateHistogram_matches_EventList() {
+    EventList el;
+    for (int i = 0; i < 1000; ++i)
+      el += TofEvent(static_cast<double>((i * 37) % 1000) + 0.5, i);
+    el.switchTo(Mantid::API::WEIGHTED);
+    el *= 2.0;
+    std::vector<double> X{-10., 0., 100., 250., 500., 990.};
+    std::vector<double> Y, E;
+    el.generateHistogram(X, Y, E);
+
+    EventColumns unsorted(el.getWeightedEvents());
+    std::vector<double> unsortedY, unsortedE;
+    unsorted.generateHistogram(X, unsortedY, unsortedE);
+
+    EventColumns sorted(el);
+    TS_ASSERT(sorted.isSortedByTof());
+    std::vector<double> sortedY, sortedE;
+    sorted.generateHistogram(X, sortedY, sortedE);
+
+    TS_ASSERT_EQUALS(Y.size(), 5);
+    for (size_t i = 0; i < Y.size(); ++i) {
+      TS_ASSERT_DELTA(sortedY[i], Y[i], 1e-10);
+      TS_ASSERT_DELTA(sortedE[i], E[i], 1e-10);
+      TS_ASSERT_DELTA(unsortedY[i], Y[i], 1e-10);
+      TS_ASSERT_DELTA(unsortedE[i], E[i], 1e-10);
+    }
+  }
+
+  void test_generateHistogram_unweighted_errors() {
+    std::vector<TofEvent> events{{1.5}, {2.5}, {2.6}, {2.7}, {4.0}};
+    EventColumns columns(events);
+    columns.sortTof();
+    std::vector<double> X{1., 2., 3., 4.};
+    std::vector<double> Y, E;
+    columns.generateHistogram(X, Y, E);
+    TS_ASSERT_EQUALS(Y, std::vector<double>({1., 3., 0.}));
+    TS_ASSERT_DELTA(E[1], std::sqrt(3.), 1e-12);
+  }
+
+  void test_integrate() {
+    std::vector<TofEvent> events{{1.}, {2.}, {3.}, {4.}};
+    EventColumns columns(events);
+    TS_ASSERT_EQUALS(columns.integrate(0., 0., true), 4.);
+    TS_ASSERT_EQUALS(columns.integrate(2., 3., false), 2.);
+    columns.sortTof();
+    TS_ASSERT_EQUALS(columns.integrate(2., 3., false), 2.);
+    TS_ASSERT_EQUALS(columns.integrate(3., 2., false), 0.);
+  }
+
+  void test_convertTof_with_negative_factor_keeps_sorting() {
+    std::vector<TofEvent> events{{1., 1}, {2., 2}, {3., 3}};
+    EventColumns columns(events);
+    columns.sortTof();
+    columns.convertTof(-1., 10.);
+    TS_ASSERT(columns.isSortedByTof());
+    TS_ASSERT_EQUALS(columns.tofs(), std::vector<double>({7., 8., 9.}));
+    TS_ASSERT_EQUALS(columns.pulseTimes(), std::vector<int64_t>({3, 2, 1}));
+  }
+
+  void test_maskTof() {
+    std::vector<WeightedEvent> events{
+        {4., 4, 1.0, 1.0}, {1., 1, 1.0, 1.0}, {3., 3, 1.0, 1.0},
+        {2., 2, 1.0, 1.0}};
+    EventColumns columns(events);
+    TS_ASSERT_THROWS(columns.maskTof(3., 2.), std::runtime_error);
+    columns.maskTof(2., 3.);
+    TS_ASSERT_EQUALS(columns.tofs(), std::vector<double>({1., 4.}));
+    TS_ASSERT_EQUALS(columns.pulseTimes(), std::vector<int64_t>({1, 4}));
+    TS_ASSERT_EQUALS(columns.weights().size(), 2);
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_EVENTCOLUMNSTEST_H_ */
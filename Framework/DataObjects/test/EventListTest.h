@@ -1203,6 +1203,38 @@ public:
     }
   }
 
+  void test_histogram_regular_binnings_match_bin_search() {
+    this->fake_data();
+    EventList weighted(el);
+    weighted *= 1.5;
+    MantidVec linearX, logX, irregularX;
+    for (double tof = 100.; tof < 5e6; tof += 1234.5)
+      linearX.push_back(tof);
+    linearX.push_back(5e6);
+    for (double tof = 100.; tof < 5e6; tof *= 1.01)
+      logX.push_back(tof);
+    logX.push_back(5e6);
+    for (double tof = 100.; tof < 5e6; tof += 1000. + tof * 0.1)
+      irregularX.push_back(tof);
+
+    for (const auto &X : {linearX, logX, irregularX}) {
+      MantidVec expected(X.size() - 1, 0.);
+      for (const auto &event : el.getEvents()) {
+        const auto upper = std::upper_bound(X.begin(), X.end(), event.tof());
+        if (upper != X.begin() && upper != X.end())
+          expected[upper - X.begin() - 1] += 1.;
+      }
+      MantidVec Y, E;
+      el.generateHistogram(X, Y, E);
+      TS_ASSERT_EQUALS(Y, expected);
+      weighted.generateHistogram(X, Y, E);
+      for (size_t i = 0; i < Y.size(); ++i) {
+        TS_ASSERT_DELTA(Y[i], 1.5 * expected[i], 1e-6);
+        TS_ASSERT_DELTA(E[i], 1.5 * std::sqrt(expected[i]), 1e-6);
+      }
+    }
+  }
+
   void test_histogram_const_call() {
     this->fake_uniform_data();
     this->test_setX(); // Set it up WITH THE default binning
@@ -1459,6 +1491,88 @@ public:
     }
   }
 
+  //-----------------------------------------------------------------------------------------------
+  void test_columns_give_the_same_results_as_vectors() {
+    DummyUnit1 fromUnit;
+    DummyUnit2 toUnit;
+    fromUnit.initialize(1, 2, 3, 4, 5, 6);
+    toUnit.initialize(1, 2, 3, 4, 5, 6);
+    MantidVec X;
+    for (double tof = 0.; tof < 2e7; tof += 12345.)
+      X.push_back(tof);
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      if (this_type != TOF)
+        el *= 1.5;
+      EventList columns(el);
+      columns.switchToColumns();
+      TS_ASSERT(columns.hasColumns());
+      TS_ASSERT_EQUALS(columns.getNumberEvents(), el.getNumberEvents());
+      TS_ASSERT_EQUALS(columns.getTofMin(), el.getTofMin());
+      TS_ASSERT_EQUALS(columns.getTofMax(), el.getTofMax());
+
+      MantidVec Y, E, columnsY, columnsE;
+      el.generateHistogram(X, Y, E);
+      columns.generateHistogram(X, columnsY, columnsE);
+      TS_ASSERT_EQUALS(columnsY, Y);
+      TS_ASSERT_EQUALS(columnsE, E);
+      TS_ASSERT_EQUALS(columns.integrate(1e6, 5e6, false),
+                       el.integrate(1e6, 5e6, false));
+
+      el.convertTof(2.0, 10.0);
+      columns.convertTof(2.0, 10.0);
+      el.maskTof(4e6, 8e6);
+      columns.maskTof(4e6, 8e6);
+      el.convertUnitsViaTof(&fromUnit, &toUnit);
+      columns.convertUnitsViaTof(&fromUnit, &toUnit);
+      TS_ASSERT(columns.hasColumns());
+      TS_ASSERT_EQUALS(columns.getNumberEvents(), el.getNumberEvents());
+      TS_ASSERT_EQUALS(columns.getSortType(), el.getSortType());
+      std::vector<double> tofs, columnsTofs;
+      el.getTofs(tofs);
+      columns.getTofs(columnsTofs);
+      TS_ASSERT_EQUALS(columnsTofs, tofs);
+
+      // Comparing the events unpacks the columns
+      TSM_ASSERT_EQUALS(this_type, columns, el);
+      TS_ASSERT(!columns.hasColumns());
+    }
+  }
+
+  void test_columns_are_unpacked_on_demand() {
+    this->fake_data();
+    el.sortTof();
+    el.switchToColumns();
+    const EventList copy(el);
+    TS_ASSERT(copy.hasColumns());
+    TS_ASSERT(el.hasColumns());
+    // Appending an event unpacks the columns and keeps the events
+    el += TofEvent(1.0, 0);
+    TS_ASSERT(!el.hasColumns());
+    TS_ASSERT_EQUALS(el.getNumberEvents(), copy.getNumberEvents() + 1);
+    // Reading the events of a const list unpacks them too
+    const auto &events = copy.getEvents();
+    TS_ASSERT(!copy.hasColumns());
+    TS_ASSERT_EQUALS(copy.getSortType(), TOF_SORT);
+    TS_ASSERT(std::is_sorted(events.begin(), events.end()));
+    TS_ASSERT_EQUALS(events.size() + 1, el.getNumberEvents());
+  }
+
+  void test_addEventQuickly_and_getEvent_unpack_the_events() {
+    this->fake_data();
+    const size_t numEvents = el.getNumberEvents();
+    const double firstTof = el.getEvent(0).tof();
+    el.switchToColumns();
+    TS_ASSERT_EQUALS(el.getEvent(0).tof(), firstTof);
+    TS_ASSERT(!el.hasColumns());
+    el.switchToCompressed();
+    el.addEventQuickly(TofEvent(1.0, 0));
+    TS_ASSERT(!el.isCompressed());
+    TS_ASSERT_EQUALS(el.getNumberEvents(), numEvents + 1);
+    TS_ASSERT_EQUALS(el.getEvent(numEvents).tof(), 1.0);
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_addPulseTime_allTypes() {
     // Go through each possible EventType as the input
@@ -1833,6 +1947,43 @@ public:
     return;
   }
 
+  //-----------------------------------------------------------------------------------------------
+  /** Every event goes to exactly one output, in its original order, and
+   * events of a group without an output are dropped
+   */
+  void test_splitByPulseTime_keeps_order_and_skips_missing_groups() {
+    fake_uniform_time_sns_data();
+
+    // Group 1 has no output
+    std::map<int, EventList *> outputs;
+    for (int i : {-1, 0, 2})
+      outputs.emplace(i, new EventList());
+
+    TimeSplitterType split;
+    for (int i = 0; i < 9; i++)
+      split.push_back(SplittingInterval(i * 1000000, (i + 1) * 1000000, i % 3));
+
+    el.splitByPulseTime(split, outputs);
+
+    size_t total = 0;
+    for (auto &output : outputs) {
+      const auto &events = output.second->getEvents();
+      total += events.size();
+      for (size_t i = 1; i < events.size(); i++)
+        TS_ASSERT(!(events[i] < events[i - 1]));
+      for (const auto &event : events) {
+        const int64_t t = event.pulseTime().totalNanoseconds();
+        TS_ASSERT_EQUALS(static_cast<int>(t / 1000000) % 3, output.first);
+      }
+    }
+    // Only the 9 pulses inside the splitters are kept, 3 of them in group 1
+    TS_ASSERT_EQUALS(total, 6);
+
+    for (auto &output : outputs) {
+      delete output.second;
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   /** Test method to split events by full time (pulse + tof) withtout correction
    * on TOF
@@ -2761,6 +2912,12 @@ public:
     // Coarse vector, 1000 bins.
     for (double i = 0; i < 100000; i += 100)
       coarseX.push_back(i);
+    // Logarithmic vector, ~11500 bins of 0.1%
+    for (double i = 1.0; i < 100000; i *= 1.001)
+      logX.push_back(i);
+    // Irregular vector, same number of bins as fineX
+    for (double i = 0; i < 100000; i += 1.0)
+      irregularX.push_back(i + 0.25 * std::sin(i));
 
     // Create FrameworkManager such that the effect of config option
     // `MultiThreaded.MaxCores` is visible: The FrameworkManager sets the TBB
@@ -2773,6 +2930,8 @@ public:
       el_sorted_weighted, el4, el5;
   MantidVec fineX;
   MantidVec coarseX;
+  MantidVec logX;
+  MantidVec irregularX;
 
   void setUp() override {
     // Reset the random event list
@@ -2821,6 +2980,19 @@ public:
     el_sorted_weighted.generateHistogram(coarseX, Y, E);
   }
 
+  void test_histogram_log() {
+    MantidVec Y, E;
+    el_sorted.generateHistogram(logX, Y, E);
+    el_sorted_weighted.generateHistogram(logX, Y, E);
+  }
+
+  /// Irregular bins take the search path that linear and log bins avoid
+  void test_histogram_irregular() {
+    MantidVec Y, E;
+    el_sorted.generateHistogram(irregularX, Y, E);
+    el_sorted_weighted.generateHistogram(irregularX, Y, E);
+  }
+
   void test_maskTof() {
     TS_ASSERT_EQUALS(el_sorted.getNumberEvents(), 10000000);
     el_sorted.maskTof(25e3, 75e3);
@@ -0,0 +1,220 @@
+#ifndef MANTID_DATAOBJECTS_EVENTRADIXSORTTEST_H_
+#define MANTID_DATAOBJECTS_EVENTRADIXSORTTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/EventRadixSort.h"
+#include "MantidDataObjects/Events.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+using Mantid::DataObjects::EventRadixSort;
+using Mantid::DataObjects::WeightedEvent;
+using Mantid::DataObjects::WeightedEventNoTime;
+using Mantid::Types::Event::TofEvent;
+
+namespace {
+using Mode = EventRadixSort::Mode;
+const Mode ALL_MODES[] = {Mode::Auto, Mode::Records, Mode::KeysOnly};
+
+/// Events with random tofs in [tofMin, tofMax) and a few distinct pulse times
+std::vector<TofEvent> randomEvents(const size_t n, const double tofMin,
+                                   const double tofMax) {
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<double> tof(tofMin, tofMax);
+  std::uniform_int_distribution<int64_t> pulse(0, 20);
+  std::vector<TofEvent> events;
+  events.reserve(n);
+  for (size_t i = 0; i < n; ++i)
+    events.emplace_back(tof(generator), pulse(generator) * 16666667);
+  return events;
+}
+
+/// Events sorted by tof, with every 50th event swapped with its neighbour
+std::vector<TofEvent> nearlySortedEvents(const size_t n) {
+  auto events = randomEvents(n, 0., 20000.);
+  std::sort(events.begin(), events.end(),
+            [](const TofEvent &lhs, const TofEvent &rhs) {
+              return lhs.tof() < rhs.tof();
+            });
+  for (size_t i = 1; i < n; i += 50)
+    std::swap(events[i - 1], events[i]);
+  return events;
+}
+
+/// Field by field equality, as TofEvent::operator== uses a tolerance
+template <class T>
+bool sameEvents(const std::vector<T> &lhs, const std::vector<T> &rhs) {
+  return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend(),
+                    [](const T &a, const T &b) {
+                      return a.tof() == b.tof() &&
+                             a.pulseTime() == b.pulseTime() &&
+                             a.weight() == b.weight();
+                    });
+}
+
+template <class T> bool lessTof(const T &lhs, const T &rhs) {
+  return lhs.tof() < rhs.tof();
+}
+
+template <class T> bool lessPulseTime(const T &lhs, const T &rhs) {
+  return lhs.pulseTime() < rhs.pulseTime();
+}
+
+template <class T> bool lessPulseTimeTOF(const T &lhs, const T &rhs) {
+  return lhs.pulseTime() < rhs.pulseTime() ||
+         (lhs.pulseTime() == rhs.pulseTime() && lhs.tof() < rhs.tof());
+}
+} // namespace
+
+class EventRadixSortTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventRadixSortTest *createSuite() { return new EventRadixSortTest(); }
+  static void destroySuite(EventRadixSortTest *suite) { delete suite; }
+
+  void test_keys_preserve_order() {
+    const double tofs[] = {-std::numeric_limits<double>::infinity(),
+                           -1e10,
+                           -2.5,
+                           -1e-300,
+                           0.,
+                           1e-300,
+                           1.,
+                           1.0000000000000002,
+                           3e8,
+                           std::numeric_limits<double>::infinity()};
+    for (size_t i = 1; i < sizeof(tofs) / sizeof(tofs[0]); ++i)
+      TS_ASSERT_LESS_THAN(EventRadixSort::tofKey(tofs[i - 1]),
+                          EventRadixSort::tofKey(tofs[i]));
+    const int64_t times[] = {std::numeric_limits<int64_t>::min(), -5, 0, 7,
+                             std::numeric_limits<int64_t>::max()};
+    for (size_t i = 1; i < sizeof(times) / sizeof(times[0]); ++i)
+      TS_ASSERT_LESS_THAN(EventRadixSort::pulseTimeKey(times[i - 1]),
+                          EventRadixSort::pulseTimeKey(times[i]));
+  }
+
+  void test_sortTof_matches_stable_sort() {
+    for (const size_t n : {0, 1, 10, 255, 256, 10000}) {
+      auto expected = randomEvents(n, -100., 20000.);
+      const auto input = expected;
+      std::stable_sort(expected.begin(), expected.end(), lessTof<TofEvent>);
+      for (const auto mode : ALL_MODES) {
+        auto events = input;
+        EventRadixSort::sortTof(events, mode);
+        TS_ASSERT(sameEvents(events, expected));
+      }
+    }
+  }
+
+  void test_sortTof_nearly_sorted() {
+    auto expected = nearlySortedEvents(10000);
+    const auto input = expected;
+    std::stable_sort(expected.begin(), expected.end(), lessTof<TofEvent>);
+    for (const auto mode : ALL_MODES) {
+      auto events = input;
+      EventRadixSort::sortTof(events, mode);
+      TS_ASSERT(sameEvents(events, expected));
+    }
+  }
+
+  void test_sortTof_weighted_events() {
+    const auto tofEvents = randomEvents(5000, 0., 100.);
+    std::vector<WeightedEvent> weighted;
+    std::vector<WeightedEventNoTime> noTime;
+    for (size_t i = 0; i < tofEvents.size(); ++i) {
+      weighted.emplace_back(tofEvents[i], static_cast<float>(i), 1.f);
+      noTime.emplace_back(tofEvents[i].tof(), static_cast<float>(i), 1.f);
+    }
+    auto expectedWeighted = weighted;
+    std::stable_sort(expectedWeighted.begin(), expectedWeighted.end(),
+                     lessTof<WeightedEvent>);
+    auto expectedNoTime = noTime;
+    std::stable_sort(expectedNoTime.begin(), expectedNoTime.end(),
+                     lessTof<WeightedEventNoTime>);
+
+    EventRadixSort::sortTof(weighted);
+    TS_ASSERT(sameEvents(weighted, expectedWeighted));
+    EventRadixSort::sortTof(noTime);
+    TS_ASSERT(sameEvents(noTime, expectedNoTime));
+  }
+
+  void test_sortPulseTime_is_stable() {
+    // Sorting by pulse time must keep the tof order within each pulse
+    auto input = randomEvents(10000, 0., 20000.);
+    std::stable_sort(input.begin(), input.end(), lessTof<TofEvent>);
+    auto expected = input;
+    std::stable_sort(expected.begin(), expected.end(),
+                     lessPulseTime<TofEvent>);
+    for (const auto mode : ALL_MODES) {
+      auto events = input;
+      EventRadixSort::sortPulseTime(events, mode);
+      TS_ASSERT(sameEvents(events, expected));
+    }
+  }
+
+  void test_sortPulseTimeTOF() {
+    const auto input = randomEvents(10000, 0., 20000.);
+    auto expected = input;
+    std::stable_sort(expected.begin(), expected.end(),
+                     lessPulseTimeTOF<TofEvent>);
+    for (const auto mode : ALL_MODES) {
+      auto events = input;
+      EventRadixSort::sortPulseTimeTOF(events, mode);
+      TS_ASSERT(sameEvents(events, expected));
+    }
+  }
+};
+
+class EventRadixSortTestPerformance : public CxxTest::TestSuite {
+public:
+  static EventRadixSortTestPerformance *createSuite() {
+    return new EventRadixSortTestPerformance();
+  }
+  static void destroySuite(EventRadixSortTestPerformance *suite) {
+    delete suite;
+  }
+
+  EventRadixSortTestPerformance()
+      : m_random(randomEvents(5000000, 0., 20000.)),
+        m_nearlySorted(nearlySortedEvents(5000000)) {}
+
+  void test_random_radix_sort() {
+    auto events = m_random;
+    EventRadixSort::sortTof(events);
+  }
+
+  void test_random_std_sort() {
+    auto events = m_random;
+    std::sort(events.begin(), events.end(), lessTof<TofEvent>);
+  }
+
+  void test_nearly_sorted_radix_sort() {
+    auto events = m_nearlySorted;
+    EventRadixSort::sortTof(events);
+  }
+
+  void test_nearly_sorted_std_sort() {
+    auto events = m_nearlySorted;
+    std::sort(events.begin(), events.end(), lessTof<TofEvent>);
+  }
+
+  void test_pulse_time_tof_radix_sort() {
+    auto events = m_random;
+    EventRadixSort::sortPulseTimeTOF(events);
+  }
+
+  void test_pulse_time_tof_std_sort() {
+    auto events = m_random;
+    std::sort(events.begin(), events.end(), lessPulseTimeTOF<TofEvent>);
+  }
+
+private:
+  std::vector<TofEvent> m_random;
+  std::vector<TofEvent> m_nearlySorted;
+};
+
+#endif /* MANTID_DATAOBJECTS_EVENTRADIXSORTTEST_H_ */
@@ -11,7 +11,9 @@
 #include <cxxtest/TestSuite.h>
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <Poco/Path.h>
 
 #include <string>
 
@@ -20,6 +22,7 @@
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/FileBackedEventStore.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 #include "MantidTestHelpers/ComponentCreationHelper.h"
 #include "MantidKernel/Memory.h"
@@ -313,6 +316,86 @@ public:
     }
   }
 
+  void test_paged_out_events() {
+    EventWorkspace_sptr ws = createFlatEventWorkspace();
+    const size_t numEvents = ws->getNumberEvents();
+    TS_ASSERT_THROWS(ws->pageOutEvents(), const std::runtime_error &);
+    ws->setEventStore(boost::make_shared<FileBackedEventStore>(
+        Poco::Path::temp(), 64 * 1024 * 1024));
+    ws->pageOutEvents();
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), numEvents);
+
+    // Scans over the workspace leave the events paged out
+    const size_t pagedOutMemory = ws->getMemorySize();
+    MantidVec sums;
+    ws->getIntegratedSpectra(sums, 0, 0, true);
+    TS_ASSERT_EQUALS(sums[1], (NUMBINS - 1) * 2.0);
+    TS_ASSERT_LESS_THAN(0.0, ws->getEventXMax());
+    TS_ASSERT_EQUALS(ws->getMemorySize(), pagedOutMemory);
+
+    // Reading a spectrum brings its events back into the list itself
+    const EventWorkspace &constWS = *ws;
+    const auto &read = constWS.getSpectrum(2);
+    TS_ASSERT(!read.isPagedOut());
+    TS_ASSERT_EQUALS(&read, &constWS.getSpectrum(2));
+    TS_ASSERT_EQUALS(read.getEvents().size(), (NUMBINS - 1) * 2);
+    TS_ASSERT_EQUALS(constWS.y(2)[0], 2.0);
+
+    // A single spectrum can be paged out again
+    ws->pageOutSpectrum(2);
+    TS_ASSERT(read.isPagedOut());
+    TS_ASSERT_EQUALS(read.getNumberEvents(), (NUMBINS - 1) * 2);
+
+    // Accessing a spectrum to modify it brings its events back
+    auto &spectrum = ws->getSpectrum(1);
+    TS_ASSERT(!spectrum.isPagedOut());
+    TS_ASSERT_EQUALS(spectrum.getEvents().size(), (NUMBINS - 1) * 2);
+
+    // Events added after paging out are kept with the others
+    spectrum.pageOut(*ws->eventStore());
+    spectrum.getEvents().emplace_back(1.0, 0);
+    TS_ASSERT_EQUALS(spectrum.getNumberEvents(), (NUMBINS - 1) * 2 + 1);
+    spectrum.pageOut(*ws->eventStore());
+    TS_ASSERT_EQUALS(spectrum.getNumberEvents(), (NUMBINS - 1) * 2 + 1);
+    spectrum.pageIn();
+    TS_ASSERT_EQUALS(spectrum.getEvents().size(), (NUMBINS - 1) * 2 + 1);
+    TS_ASSERT_EQUALS(spectrum.getEvents().back().tof(), 1.0);
+  }
+
+  void test_columnar_events() {
+    EventWorkspace_sptr ws = createFlatEventWorkspace();
+    const size_t numEvents = ws->getNumberEvents();
+    const auto y = ws->y(1).rawData();
+    ws->switchToColumns();
+    TS_ASSERT(ws->getSpectrum(1).hasColumns());
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), numEvents);
+    TS_ASSERT_EQUALS(ws->y(1).rawData(), y);
+    MantidVec sums;
+    ws->getIntegratedSpectra(sums, 0, 0, true);
+    TS_ASSERT_EQUALS(sums[1], (NUMBINS - 1) * 2.0);
+    TS_ASSERT(ws->getSpectrum(1).hasColumns());
+    TS_ASSERT_EQUALS(ws->getSpectrum(1).getEvents().size(), (NUMBINS - 1) * 2);
+    TS_ASSERT(!ws->getSpectrum(1).hasColumns());
+  }
+
+  void test_compressed_events() {
+    EventWorkspace_sptr ws = createFlatEventWorkspace();
+    const size_t numEvents = ws->getNumberEvents();
+    const auto y = ws->y(1).rawData();
+    TS_ASSERT_THROWS(ws->switchToCompressed(
+                         CompressedEventList::TofEncoding::Quantised, -1.),
+                     const std::invalid_argument &);
+    ws->switchToCompressed();
+    TS_ASSERT(ws->getSpectrum(1).isCompressed());
+    TS_ASSERT_EQUALS(ws->getNumberEvents(), numEvents);
+    TS_ASSERT_EQUALS(ws->y(1).rawData(), y);
+
+    // Weighted events cannot be compressed
+    ws->getSpectrum(1).switchTo(WEIGHTED);
+    TS_ASSERT(!ws->getSpectrum(1).isCompressed());
+    TS_ASSERT_THROWS(ws->switchToCompressed(), const std::invalid_argument &);
+  }
+
   void test_histogram_cache() {
     // Try caching and most-recently-used MRU list.
     EventWorkspace_const_sptr ew2 =
@@ -0,0 +1,131 @@
+#ifndef MANTID_DATAOBJECTS_FILEBACKEDEVENTSTORETEST_H_
+#define MANTID_DATAOBJECTS_FILEBACKEDEVENTSTORETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/EventList.h"
+#include "MantidDataObjects/FileBackedEventStore.h"
+
+#include <Poco/Path.h>
+#include <boost/make_shared.hpp>
+
+using namespace Mantid::DataObjects;
+using Mantid::Types::Event::TofEvent;
+
+class FileBackedEventStoreTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static FileBackedEventStoreTest *createSuite() {
+    return new FileBackedEventStoreTest();
+  }
+  static void destroySuite(FileBackedEventStoreTest *suite) { delete suite; }
+
+  void test_events_are_read_back() {
+    auto store = makeStore(1 << 20);
+    const auto events = makeEvents(1000);
+    auto page = store->write(events.data(), events.size(), sizeof(TofEvent));
+    TS_ASSERT_EQUALS(page->numEvents, 1000);
+    TS_ASSERT_EQUALS(page->bytes, 1000 * sizeof(TofEvent));
+
+    std::vector<TofEvent> read(1000);
+    store->read(*page, read.data());
+    TS_ASSERT_EQUALS(read, events);
+  }
+
+  void test_space_is_reused_once_pages_are_released() {
+    auto store = makeStore(1 << 20);
+    const auto events = makeEvents(100);
+    auto first = store->write(events.data(), 100, sizeof(TofEvent));
+    auto second = store->write(events.data(), 100, sizeof(TofEvent));
+    auto third = store->write(events.data(), 100, sizeof(TofEvent));
+    const size_t firstOffset = first->offset;
+    TS_ASSERT_LESS_THAN(0, store->bytesInUse());
+
+    // Two neighbouring gaps are merged and can hold a larger page
+    first.reset();
+    second.reset();
+    auto larger = store->write(events.data(), 100, 2 * sizeof(TofEvent));
+    TS_ASSERT_EQUALS(larger->offset, firstOffset);
+
+    larger.reset();
+    third.reset();
+    TS_ASSERT_EQUALS(store->bytesInUse(), 0);
+  }
+
+  void test_full_store_throws() {
+    auto store = makeStore(4096);
+    const auto events = makeEvents(1000);
+    TS_ASSERT_THROWS(store->write(events.data(), 1000, sizeof(TofEvent)),
+                     const std::runtime_error &);
+    TS_ASSERT_EQUALS(store->bytesInUse(), 0);
+  }
+
+  void test_event_list_page_out_and_in() {
+    auto store = makeStore(1 << 20);
+    const auto events = makeEvents(500);
+    EventList list(events);
+    list.sortTof();
+    const auto sorted = list.getEvents();
+
+    list.pageOut(*store);
+    TS_ASSERT(list.isPagedOut());
+    TS_ASSERT_EQUALS(list.getNumberEvents(), 500);
+    TS_ASSERT(!list.empty());
+    TS_ASSERT_EQUALS(list.getMemorySize(), sizeof(EventList));
+    TS_ASSERT_EQUALS(list.getSortType(), TOF_SORT);
+
+    list.pageIn();
+    TS_ASSERT(!list.isPagedOut());
+    TS_ASSERT_EQUALS(list.getEvents(), sorted);
+    // The page was given back
+    TS_ASSERT_EQUALS(store->bytesInUse(), 0);
+  }
+
+  void test_weighted_event_list_page_out_and_in() {
+    auto store = makeStore(1 << 20);
+    EventList list(makeEvents(10));
+    list.switchTo(Mantid::API::WEIGHTED_NOTIME);
+    const auto weighted = list.getWeightedEventsNoTime();
+
+    list.pageOut(*store);
+    list.pageIn();
+    TS_ASSERT_EQUALS(list.getEventType(), Mantid::API::WEIGHTED_NOTIME);
+    TS_ASSERT_EQUALS(list.getWeightedEventsNoTime(), weighted);
+  }
+
+  void test_copies_share_the_page() {
+    auto store = makeStore(1 << 20);
+    EventList list(makeEvents(200));
+    list.pageOut(*store);
+    const size_t inUse = store->bytesInUse();
+
+    EventList copy(list);
+    TS_ASSERT(copy.isPagedOut());
+    TS_ASSERT_EQUALS(store->bytesInUse(), inUse);
+    copy.pageIn();
+    TS_ASSERT_EQUALS(copy.getEvents(), makeEvents(200));
+    // The original still needs the page
+    TS_ASSERT(list.isPagedOut());
+    TS_ASSERT_EQUALS(store->bytesInUse(), inUse);
+
+    list.clear();
+    TS_ASSERT_EQUALS(store->bytesInUse(), 0);
+  }
+
+private:
+  boost::shared_ptr<FileBackedEventStore> makeStore(const size_t capacity) {
+    return boost::make_shared<FileBackedEventStore>(Poco::Path::temp(),
+                                                    capacity);
+  }
+
+  std::vector<TofEvent> makeEvents(const size_t numEvents) {
+    std::vector<TofEvent> events;
+    for (size_t i = 0; i < numEvents; ++i)
+      events.emplace_back(static_cast<double>((i * 7919) % 1000),
+                          static_cast<int64_t>(i));
+    return events;
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_FILEBACKEDEVENTSTORETEST_H_ */
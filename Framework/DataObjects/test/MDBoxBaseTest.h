@@ -121,6 +121,9 @@ public:
       const coord_t /*radiusSquared*/, signal_t & /*signal*/,
       signal_t & /*errorSquared*/, const coord_t /*innerRadiusSquared*/,
       const bool /*useOnePercentBackgroundCorrection*/) const override{};
+  void
+  integrateSpheres(std::vector<MDIntegrationSphere> & /*spheres*/,
+                   const std::vector<size_t> & /*indices*/) const override{};
   void centroidSphere(Mantid::API::CoordTransform & /*radiusTransform*/,
                       const coord_t /*radiusSquared*/, coord_t *,
                       signal_t &) const override{};
@@ -889,6 +889,74 @@ public:
       Poco::File(filename).remove();
   }
 
+  //------------------------------------------------------------------------------------------------
+  /** Appending events to a file-backed tree only touches the boxes which
+   * receive them, and keeps the cached totals as a full refresh would */
+  void test_appendEvents_fileBacked() {
+    using MDE = MDLeanEvent<2>;
+    MDGridBox<MDE, 2> *b = MDEventsTestHelper::makeMDGridBox<2>();
+    BoxController_sptr bc =
+        boost::shared_ptr<BoxController>(b->getBoxController());
+    bc->setSplitThreshold(120);
+    bc->setMaxDepth(4);
+    auto loader = boost::shared_ptr<API::IBoxControllerIO>(
+        new MantidTestHelpers::BoxControllerDummyIO(bc.get()));
+    loader->setDataType(b->getCoordType(), b->getEventType());
+    loader->setWriteBufferSize(1000);
+    bc->setFileBacked(loader, "appendDummy");
+    b->setFileBacked();
+
+    // 100 events in each box, all written out
+    MDEventsTestHelper::feedMDBox<2>(b, 1, 100, 0.05f, 0.1f);
+    b->splitAllIfNeeded(nullptr);
+    b->refreshCache();
+    loader->flushCache();
+    TS_ASSERT_EQUALS(loader->getFileLength(), 10000);
+
+    // A few events for the first box, and enough to split the last one
+    std::vector<MDE> events;
+    for (int i = 0; i < 2; i++) {
+      coord_t centers[2] = {0.5f, 0.5f};
+      events.push_back(MDE(3.0, 2.0, centers));
+    }
+    for (int i = 0; i < 150; i++) {
+      coord_t centers[2] = {9.0f + 0.0066f * float(i), 9.5f};
+      events.push_back(MDE(0.5, 0.25, centers));
+    }
+    b->appendEvents(events);
+
+    auto first = dynamic_cast<MDBox<MDE, 2> *>(b->getChild(0));
+    TS_ASSERT(first);
+    TSM_ASSERT("The events on disk were not loaded",
+               !first->getISaveable()->isLoaded());
+    TS_ASSERT_EQUALS(first->getDataInMemorySize(), 2);
+    TS_ASSERT_EQUALS(first->getNPoints(), 102);
+    TS_ASSERT_DELTA(first->getSignal(), 106.0, 1e-5);
+    using gbox_t = MDGridBox<MDE, 2>;
+    TS_ASSERT(dynamic_cast<gbox_t *>(b->getChild(99)));
+    auto untouched = dynamic_cast<MDBox<MDE, 2> *>(b->getChild(50));
+    TS_ASSERT_EQUALS(untouched->getDataInMemorySize(), 0);
+    TS_ASSERT_EQUALS(b->getNPoints(), 10152);
+    TS_ASSERT_DELTA(b->getSignal(), 10081.0, 1e-3);
+    TS_ASSERT_DELTA(b->getErrorSquared(), 10041.5, 1e-3);
+
+    // Written out, the boxes hold both their old and new events
+    loader->flushCache();
+    TS_ASSERT_EQUALS(first->getNPoints(), 102);
+    TS_ASSERT_EQUALS(first->getISaveable()->getFileSize(), 102);
+    std::vector<API::IMDNode *> boxes;
+    b->getBoxes(boxes, 4, false);
+    std::vector<double> signals;
+    for (auto box : boxes)
+      signals.push_back(box->getSignal());
+    b->refreshCache();
+    for (size_t i = 0; i < boxes.size(); ++i)
+      TS_ASSERT_DELTA(boxes[i]->getSignal(), signals[i], 1e-3);
+    TS_ASSERT_EQUALS(b->getNPoints(), 10152);
+
+    delete b;
+  }
+
   //-----------------------------------------------------------------------------------------
 
   //
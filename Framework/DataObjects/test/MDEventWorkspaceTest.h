@@ -550,6 +550,30 @@ public:
     //    TS_ASSERT_DELTA( errorSquared, 1.0, 1e-5);
   }
 
+  void test_getMortonLayout_is_kept_until_the_events_change() {
+    MDEventWorkspace3Lean::sptr ws =
+        MDEventsTestHelper::makeMDEW<3>(10, 0.0, 10.0, 1 /*event per box*/);
+    const size_t memoryWithoutLayout = ws->getMemorySize();
+    auto layout = ws->getMortonLayout();
+    TS_ASSERT_EQUALS(layout->getNPoints(), 1000);
+    TS_ASSERT_EQUALS(ws->getMortonLayout(), layout);
+    TS_ASSERT_EQUALS(ws->getMemorySize(),
+                     memoryWithoutLayout + layout->getMemorySize());
+
+    coord_t centers[3] = {0.5f, 0.5f, 0.5f};
+    ws->addEvent(MDLeanEvent<3>(1.0, 1.0, centers));
+    ws->refreshCache();
+    auto rebuilt = ws->getMortonLayout();
+    TS_ASSERT_DIFFERS(rebuilt, layout);
+    TS_ASSERT_EQUALS(rebuilt->getNPoints(), 1001);
+    // The old layout is still valid for those holding it
+    TS_ASSERT_EQUALS(layout->getNPoints(), 1000);
+
+    ws->clearMortonLayout();
+    TS_ASSERT_EQUALS(ws->getMemorySize(), memoryWithoutLayout +
+                                              sizeof(MDLeanEvent<3>));
+  }
+
   /*
   Generic masking checking helper method.
   */
@@ -31,6 +31,7 @@
 #include <gmock/gmock.h>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <nexus/NeXusFile.hpp>
 #include <vector>
 
@@ -957,6 +958,104 @@ public:
 
   void test_addEvents_inParallel() { do_test_addEvents_inParallel(nullptr); }
 
+  //-------------------------------------------------------------------------------------
+  /** Test that adding events concurrently splits the boxes as they fill up,
+   * without losing any events */
+  void test_addEventsConcurrently() {
+    using gbox_t = MDGridBox<MDLeanEvent<2>, 2>;
+    gbox_t *b = MDEventsTestHelper::makeMDGridBox<2>();
+    b->getBoxController()->setSplitThreshold(100);
+    b->getBoxController()->setMaxDepth(4);
+    int num_repeat = 20;
+
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < num_repeat; i++) {
+      // Make an event in the middle of each box one level down
+      std::vector<MDLeanEvent<2>> events;
+      for (double x = 0.05; x < 10; x += 0.1)
+        for (double y = 0.05; y < 10; y += 0.1) {
+          double centers[2] = {x, y};
+          events.push_back(MDLeanEvent<2>(2.0, 2.0, centers));
+        }
+      TS_ASSERT_THROWS_NOTHING(b->addEventsConcurrently(events););
+    }
+
+    // The boxes were split without a call to splitAllIfNeeded()
+    std::vector<API::IMDNode *> boxes;
+    b->getBoxes(boxes, 4, true);
+    TS_ASSERT_EQUALS(boxes.size(), 100 * 100);
+    for (auto box : boxes) {
+      TS_ASSERT_EQUALS(box->getDepth(), 2);
+      TS_ASSERT_EQUALS(box->getNPoints(), num_repeat);
+    }
+
+    b->refreshCache(nullptr);
+    TS_ASSERT_EQUALS(b->getNPoints(), 10000 * num_repeat);
+    TS_ASSERT_DELTA(b->getSignal(), 10000 * num_repeat * 2.0, 1e-3);
+
+    // clean up  behind
+    BoxController *const bcc = b->getBoxController();
+    delete b;
+    delete bcc;
+  }
+
+  //-------------------------------------------------------------------------------------
+  /** Test that appending events updates the cache of the boxes they go
+   * through, as a refreshCache() of the whole tree would */
+  void test_appendEvents_updates_the_cache() {
+    using gbox_t = MDGridBox<MDLeanEvent<2>, 2>;
+    using ibox_t = MDBoxBase<MDLeanEvent<2>, 2>;
+    gbox_t *b = MDEventsTestHelper::makeMDGridBox<2>();
+    BoxController *const bc = b->getBoxController();
+    bc->setSplitThreshold(50);
+    bc->setMaxDepth(4);
+
+    // Events spread everywhere, then events which split the boxes of one
+    // corner
+    std::vector<MDLeanEvent<2>> events;
+    for (double x = 0.05; x < 10; x += 0.5)
+      for (double y = 0.05; y < 10; y += 0.5) {
+        double centers[2] = {x, y};
+        events.push_back(MDLeanEvent<2>(2.0, 3.0, centers));
+      }
+    b->addEvents(events);
+    b->splitAllIfNeeded(nullptr);
+    b->refreshCache(nullptr);
+
+    events.clear();
+    for (double x = 0.01; x < 2; x += 0.02)
+      for (double y = 0.01; y < 2; y += 0.04) {
+        double centers[2] = {x, y};
+        events.push_back(MDLeanEvent<2>(float(x), 1.5, centers));
+      }
+    b->appendEvents(events);
+
+    std::vector<API::IMDNode *> boxes;
+    b->getBoxes(boxes, 4, false);
+    std::vector<double> signals, errors, weights;
+    std::vector<uint64_t> nPoints;
+    for (auto box : boxes) {
+      signals.push_back(box->getSignal());
+      errors.push_back(box->getErrorSquared());
+      weights.push_back(dynamic_cast<ibox_t *>(box)->getTotalWeight());
+      nPoints.push_back(box->getNPoints());
+    }
+    TS_ASSERT_EQUALS(b->getNPoints(), 400 + 5000);
+    TS_ASSERT_EQUALS(bc->getNumMDBoxes()[2], 4 * 100);
+
+    b->refreshCache(nullptr);
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      TS_ASSERT_DELTA(boxes[i]->getSignal(), signals[i], 1e-3);
+      TS_ASSERT_DELTA(boxes[i]->getErrorSquared(), errors[i], 1e-3);
+      TS_ASSERT_DELTA(dynamic_cast<ibox_t *>(boxes[i])->getTotalWeight(),
+                      weights[i], 1e-9);
+      TS_ASSERT_EQUALS(boxes[i]->getNPoints(), nPoints[i]);
+    }
+
+    delete b;
+    delete bc;
+  }
+
   /** Disabled because parallel RefreshCache is not implemented. Might not be
    * ever? */
   void xtest_addEvents_inParallel_then_refreshCache_inParallel() {
@@ -1380,6 +1479,70 @@ public:
     delete box_ptr;
   }
 
+  //------------------------------------------------------------------------------------------------
+  /** Integrating many spheres in one pass gives each the same sums as
+   * integrating it alone */
+  void test_integrateSpheres_matches_integrateSphere() {
+    using gbox_t = MDGridBox<MDLeanEvent<3>, 3>;
+    gbox_t *box_ptr = MDEventsTestHelper::makeMDGridBox<3>();
+    BoxController *const bc = box_ptr->getBoxController();
+    bc->setSplitThreshold(20);
+    bc->setMaxDepth(4);
+
+    boost::mt19937 rng(1234);
+    boost::uniform_real<coord_t> coordDist(0.f, 10.f);
+    boost::uniform_real<float> signalDist(0.5f, 2.0f);
+    std::vector<MDLeanEvent<3>> events;
+    for (size_t i = 0; i < 20000; ++i) {
+      coord_t centers[3] = {coordDist(rng), coordDist(rng), coordDist(rng)};
+      // More events in one corner, so the boxes there split deeper
+      if (i % 2 == 0)
+        for (auto &c : centers)
+          c *= 0.2f;
+      const float signal = signalDist(rng);
+      events.emplace_back(signal, signal * 0.5f, centers);
+    }
+    box_ptr->addEvents(events);
+    box_ptr->splitAllIfNeeded(nullptr);
+    box_ptr->refreshCache(nullptr);
+
+    // Spheres and shells of all sizes, some off the edges
+    boost::uniform_real<coord_t> centerDist(-1.f, 11.f);
+    boost::uniform_real<double> radiusDist(0.05, 3.0);
+    std::vector<MDIntegrationSphere> spheres;
+    for (size_t i = 0; i < 200; ++i) {
+      MDIntegrationSphere sphere;
+      sphere.center = {centerDist(rng), centerDist(rng), centerDist(rng)};
+      const double radius = radiusDist(rng);
+      sphere.radiusSquared = static_cast<coord_t>(radius * radius);
+      sphere.innerRadiusSquared =
+          i % 3 == 0 ? 0.f : static_cast<coord_t>(0.25 * radius * radius);
+      sphere.useOnePercentBackgroundCorrection = i % 2 == 0;
+      sphere.signal = 0.;
+      sphere.errorSquared = 0.;
+      spheres.push_back(sphere);
+    }
+    std::vector<size_t> indices(spheres.size());
+    std::iota(indices.begin(), indices.end(), size_t(0));
+    box_ptr->integrateSpheres(spheres, indices);
+
+    bool dimensionsUsed[3] = {true, true, true};
+    for (const auto &sphere : spheres) {
+      CoordTransformDistance transform(3, sphere.center.data(),
+                                       dimensionsUsed);
+      signal_t signal = 0;
+      signal_t errorSquared = 0;
+      box_ptr->integrateSphere(transform, sphere.radiusSquared, signal,
+                               errorSquared, sphere.innerRadiusSquared,
+                               sphere.useOnePercentBackgroundCorrection);
+      TS_ASSERT_EQUALS(sphere.signal, signal);
+      TS_ASSERT_EQUALS(sphere.errorSquared, errorSquared);
+    }
+
+    delete bc;
+    delete box_ptr;
+  }
+
   //------------------------------------------------------------------------------------------------
   /** For test_integrateSphere
    *
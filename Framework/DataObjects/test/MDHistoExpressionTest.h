@@ -0,0 +1,96 @@
+#ifndef MANTID_DATAOBJECTS_MDHISTOEXPRESSIONTEST_H_
+#define MANTID_DATAOBJECTS_MDHISTOEXPRESSIONTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/MDHistoExpression.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+using namespace Mantid;
+using namespace Mantid::DataObjects;
+
+class MDHistoExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDHistoExpressionTest *createSuite() {
+    return new MDHistoExpressionTest();
+  }
+  static void destroySuite(MDHistoExpressionTest *suite) { delete suite; }
+
+  void test_size_mismatch_throws() {
+    auto a = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 2, 5);
+    auto b = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 2, 6);
+    TS_ASSERT_THROWS((MDHistoExpression(*a) + *b).evaluateInto(*a),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(MDHistoExpression(*a).evaluateInto(*b),
+                     const std::invalid_argument &);
+  }
+
+  void test_chain_matches_the_in_place_operations() {
+    // Long enough to run in parallel, and not a whole number of blocks
+    auto a = makeWorkspace(2.0, 0.01);
+    // a - b changes sign, for the filler of the logarithm
+    auto b = makeWorkspace(5.0, -0.001);
+    auto c = makeWorkspace(0.5, 0.002);
+
+    auto expected = a->clone();
+    expected->subtract(*b);
+    expected->divide(*c);
+    expected->multiply(3.0, 0.5);
+    expected->log(-1.0);
+    expected->add(*a);
+
+    const auto expression =
+        ((MDHistoExpression(*a) - *b) / *c *
+         MDHistoExpression::scalar(3.0, 0.5)).log(-1.0) +
+        *a;
+    auto out = a->clone();
+    expression.evaluateInto(*out);
+
+    checkSame(*out, *expected);
+    TS_ASSERT_EQUALS(out->getNEvents(), expected->getNEvents());
+  }
+
+  void test_evaluate_into_an_operand() {
+    auto a = makeWorkspace(1.0, 0.01);
+    auto b = makeWorkspace(-4.0, 0.008);
+    auto expected = b->clone();
+    expected->exp();
+    expected->multiply(*a);
+    expected->power(0.5);
+
+    (MDHistoExpression(*b).exp() * *a).power(0.5).evaluateInto(*b);
+    checkSame(*b, *expected);
+  }
+
+private:
+  /// A 3D workspace with a different signal, error and number of events in
+  /// every bin
+  MDHistoWorkspace_sptr makeWorkspace(const double offset,
+                                      const double slope) {
+    auto ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 3, 43);
+    for (size_t i = 0; i < ws->getNPoints(); ++i) {
+      const double x = static_cast<double>(i % 997);
+      ws->setSignalAt(i, offset + slope * x);
+      ws->setErrorSquaredAt(i, 0.5 + 0.001 * x);
+      ws->setNumEventsAt(i, static_cast<signal_t>(i % 7));
+    }
+    ws->updateSum();
+    return ws;
+  }
+
+  void checkSame(const MDHistoWorkspace &actual,
+                 const MDHistoWorkspace &expected) {
+    TS_ASSERT_EQUALS(actual.getNPoints(), expected.getNPoints());
+    for (size_t i = 0; i < actual.getNPoints(); ++i) {
+      TS_ASSERT_DELTA(actual.getSignalAt(i), expected.getSignalAt(i), 1e-12);
+      TS_ASSERT_DELTA(actual.getErrorSquaredArray()[i],
+                      expected.getErrorSquaredArray()[i], 1e-12);
+      TS_ASSERT_EQUALS(actual.getNumEventsAt(i), expected.getNumEventsAt(i));
+    }
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_MDHISTOEXPRESSIONTEST_H_ */
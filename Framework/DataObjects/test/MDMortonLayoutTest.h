@@ -0,0 +1,130 @@
+#ifndef MANTID_DATAOBJECTS_MDMORTONLAYOUTTEST_H_
+#define MANTID_DATAOBJECTS_MDMORTONLAYOUTTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/MDMortonLayout.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+#include <random>
+
+using namespace Mantid;
+using namespace Mantid::DataObjects;
+
+class MDMortonLayoutTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDMortonLayoutTest *createSuite() { return new MDMortonLayoutTest(); }
+  static void destroySuite(MDMortonLayoutTest *suite) { delete suite; }
+
+  void test_empty_extents_throw() {
+    const coord_t min[2] = {0., 1.}, max[2] = {1., 1.};
+    TS_ASSERT_THROWS((MDMortonLayout<MDLeanEvent<2>, 2>({}, min, max)),
+                     const std::invalid_argument &);
+  }
+
+  void test_events_are_sorted_by_key() {
+    const coord_t min[3] = {-1., 0., 2.}, max[3] = {1., 5., 3.};
+    MDMortonLayout<MDLeanEvent<3>, 3> layout(randomEvents<3>(5000, min, max),
+                                             min, max);
+    TS_ASSERT_EQUALS(layout.getNPoints(), 5000);
+    const auto &events = layout.getEvents();
+    for (size_t i = 1; i < events.size(); ++i)
+      TS_ASSERT_LESS_THAN_EQUALS(layout.getKey(events[i - 1].getCenter()),
+                                 layout.getKey(events[i].getCenter()));
+    // The first dimension holds the most significant bit of a key
+    const coord_t low[3] = {-0.5, 4.9, 2.9}, high[3] = {0.5, 0.1, 2.1};
+    TS_ASSERT_LESS_THAN(layout.getKey(low), layout.getKey(high));
+  }
+
+  void test_forEachEventInBox_matches_a_scan() {
+    const coord_t min[3] = {-1., 0., 2.}, max[3] = {1., 5., 3.};
+    const auto events = randomEvents<3>(20000, min, max);
+    MDMortonLayout<MDLeanEvent<3>, 3> layout(events, min, max);
+
+    std::mt19937 generator(12345);
+    for (size_t query = 0; query < 50; ++query) {
+      // Boxes that may stick out of the extents on either side
+      coord_t boxMin[3], boxMax[3];
+      for (size_t d = 0; d < 3; ++d) {
+        std::uniform_real_distribution<coord_t> position(
+            min[d] - (max[d] - min[d]) / 4, max[d] + (max[d] - min[d]) / 4);
+        boxMin[d] = position(generator);
+        boxMax[d] = position(generator);
+        if (boxMax[d] < boxMin[d])
+          std::swap(boxMin[d], boxMax[d]);
+      }
+      size_t expected = 0;
+      for (const auto &event : events)
+        if (isInBox(event, boxMin, boxMax))
+          ++expected;
+      size_t found = 0;
+      layout.forEachEventInBox(boxMin, boxMax,
+                               [&](const MDLeanEvent<3> &event) {
+                                 TS_ASSERT(isInBox(event, boxMin, boxMax));
+                                 ++found;
+                               });
+      TS_ASSERT_EQUALS(found, expected);
+    }
+  }
+
+  void test_centerpointBin_matches_the_box_tree() {
+    auto box = MDEventsTestHelper::makeMDGridBox<2>();
+    MDEventsTestHelper::feedMDBox<2>(box, 3, 40, 0.125f, 0.25f);
+    box->splitAllIfNeeded(nullptr);
+    box->refreshCache(nullptr);
+
+    MDMortonLayout<MDLeanEvent<2>, 2> layout(*box);
+    TS_ASSERT_EQUALS(layout.getNPoints(), box->getNPoints());
+
+    // Bins aligned with the events, between them and partly outside
+    const coord_t edges[][4] = {{0., 0., 10., 10.},
+                                {2., 3., 4., 7.},
+                                {0.3, 1.1, 6.7, 2.9},
+                                {-2., 9., 1., 12.},
+                                {5.125, 5.125, 5.375, 5.375}};
+    for (const auto &edge : edges) {
+      MDBin<MDLeanEvent<2>, 2> expected, bin;
+      for (size_t d = 0; d < 2; ++d) {
+        expected.m_min[d] = bin.m_min[d] = edge[d];
+        expected.m_max[d] = bin.m_max[d] = edge[d + 2];
+      }
+      bool fullyContained = false;
+      box->centerpointBin(expected, &fullyContained);
+      layout.centerpointBin(bin);
+      TS_ASSERT_DELTA(bin.m_signal, expected.m_signal, 1e-6);
+      TS_ASSERT_DELTA(bin.m_errorSquared, expected.m_errorSquared, 1e-6);
+    }
+    API::BoxController *const bc = box->getBoxController();
+    delete box;
+    delete bc;
+  }
+
+private:
+  template <size_t nd>
+  static std::vector<MDLeanEvent<nd>>
+  randomEvents(const size_t number, const coord_t *min, const coord_t *max) {
+    std::mt19937 generator(54321);
+    std::uniform_real_distribution<coord_t> unit(0., 1.);
+    std::vector<MDLeanEvent<nd>> events;
+    events.reserve(number);
+    for (size_t i = 0; i < number; ++i) {
+      coord_t centers[nd];
+      for (size_t d = 0; d < nd; ++d)
+        centers[d] = min[d] + unit(generator) * (max[d] - min[d]);
+      events.emplace_back(1.0f, 1.0f, centers);
+    }
+    return events;
+  }
+
+  static bool isInBox(const MDLeanEvent<3> &event, const coord_t *min,
+                      const coord_t *max) {
+    for (size_t d = 0; d < 3; ++d)
+      if (event.getCenter(d) < min[d] || event.getCenter(d) >= max[d])
+        return false;
+    return true;
+  }
+};
+
+#endif /* MANTID_DATAOBJECTS_MDMORTONLAYOUTTEST_H_ */
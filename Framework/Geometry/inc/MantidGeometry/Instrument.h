@@ -252,6 +252,8 @@ public:
   makeBeamline(ParameterMap &pmap, const ParameterMap *source = nullptr) const;
 
 private:
+  friend class InstrumentCache;
+
   /// Save information about a set of detectors to Nexus
   void saveDetectorSetInfoToNexus(::NeXus::File *file,
                                   const std::vector<detid_t> &detIDs) const;
@@ -54,6 +54,10 @@ public:
   bool isValid(const Kernel::V3D &p) const override {
     return m_shape->isValid(p);
   }
+  void areValid(const std::vector<Kernel::V3D> &points,
+                std::vector<bool> &valid) const override {
+    m_shape->areValid(points, valid);
+  }
   bool isOnSide(const Kernel::V3D &p) const override {
     return m_shape->isOnSide(p);
   }
@@ -74,6 +78,9 @@ public:
   int interceptSurface(Geometry::Track &t) const override {
     return m_shape->interceptSurface(t);
   }
+  void interceptSurfaces(std::vector<Track> &tracks) const override {
+    m_shape->interceptSurfaces(tracks);
+  }
   double solidAngle(const Kernel::V3D &observer) const override {
     return m_shape->solidAngle(observer);
   }
@@ -0,0 +1,74 @@
+#ifndef MANTID_GEOMETRY_INSTRUMENTCACHE_H_
+#define MANTID_GEOMETRY_INSTRUMENTCACHE_H_
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidGeometry/Instrument_fwd.h"
+
+#include <boost/shared_ptr.hpp>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace Mantid {
+namespace Geometry {
+class IObject;
+
+/**
+InstrumentCache : A binary file holding an instrument as the
+InstrumentDefinitionParser leaves it, so that it can be rebuilt without parsing
+the instrument definition again.
+
+The file holds the component tree, with the shapes of the instrument
+definition as their XML, the parameters of the definition, and the
+ComponentInfo and DetectorInfo arrays of the instrument, so that the tree does
+not have to be walked to make them either. It is read through a single memory
+mapping: the components are rebuilt from records read in place, and the arrays
+are copied from the mapping as they are.
+
+Each file holds a key, which is the mangled name of the instrument definition
+and so includes the checksum of its XML, and a version. A file whose key or
+version does not match is not used. A file is only valid on the machine that
+wrote it, as numbers are held in the byte order of that machine.
+
+Instruments with components of other types, or with a separate physical
+instrument, cannot be held in the cache.
+
+Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+National Laboratory & European Spallation Source
+
+This file is part of Mantid.
+
+Mantid is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+
+Mantid is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+File change history is stored at: <https://github.com/mantidproject/mantid>
+Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_GEOMETRY_DLL InstrumentCache {
+public:
+  /// Shapes of the instrument definition, by the name of their type
+  using TypeShapes = std::map<std::string, boost::shared_ptr<IObject>>;
+
+  /// Version of the file format, which changes whenever the format does
+  static const uint32_t VERSION;
+
+  static void save(const Instrument &instrument, const TypeShapes &typeShapes,
+                   const std::string &key, const std::string &filename);
+  static Instrument_sptr load(const std::string &filename,
+                              const std::string &key, TypeShapes &typeShapes);
+};
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_INSTRUMENTCACHE_H_ */
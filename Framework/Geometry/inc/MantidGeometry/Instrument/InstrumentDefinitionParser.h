@@ -77,6 +77,13 @@ public:
     WroteCacheTemp
   };
 
+  /// Caching of the whole instrument
+  enum InstrumentCachingOption {
+    InstrumentCacheNotUsed,
+    ReadInstrumentCache,
+    WroteInstrumentCache
+  };
+
   /// Parse XML contents
   boost::shared_ptr<Instrument>
   parseXML(Kernel::ProgressBase *progressReporter);
@@ -107,6 +114,12 @@ public:
   /// creates a vtp filename from a given xml filename
   const std::string createVTPFileName();
 
+  /// Getter for the applied instrument caching option.
+  InstrumentCachingOption getAppliedInstrumentCachingOption() const;
+
+  /// creates an instrument cache filename from a given xml filename
+  const std::string createInstrumentCacheFileName();
+
 private:
   /// shared Constructor logic
   void initialise(const std::string &filename, const std::string &instName,
@@ -220,6 +233,12 @@ private:
   /// Reads in or creates the geometry cache ('vtp') file
   CachingOption setupGeometryCache();
 
+  /// Reads the whole instrument from the instrument cache, if possible
+  bool readInstrumentCache();
+
+  /// Writes the whole instrument to the instrument cache, if possible
+  void writeInstrumentCache();
+
   /// If appropriate, creates a second instrument containing neutronic detector
   /// positions
   void createNeutronicInstrument();
@@ -412,6 +431,9 @@ private:
 
   /// Caching applied.
   CachingOption m_cachingOption;
+
+  /// Caching of the whole instrument applied.
+  InstrumentCachingOption m_instrumentCachingOption;
 };
 
 } // namespace Geometry
@@ -63,6 +63,8 @@ class ObjCompAssembly;
 class MANTID_GEOMETRY_DLL InstrumentVisitor
     : public Mantid::Geometry::ComponentVisitor {
 private:
+  friend class InstrumentCache;
+
   /// Detector indices
   boost::shared_ptr<std::vector<detid_t>> m_orderedDetectorIds;
 
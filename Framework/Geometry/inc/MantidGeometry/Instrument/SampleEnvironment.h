@@ -65,6 +65,7 @@ public:
                             const size_t maxAttempts) const;
   bool isValid(const Kernel::V3D &point) const;
   int interceptSurfaces(Track &track) const;
+  void interceptSurfaces(std::vector<Track> &tracks) const;
 
   void add(const IObject_const_sptr &component);
 
@@ -24,6 +24,7 @@ class V3D;
 
 namespace Geometry {
 class CompGrp;
+class CompiledRule;
 class GeometryHandler;
 class Rule;
 class Surface;
@@ -123,6 +124,8 @@ public:
   isValid(const Kernel::V3D &) const override; ///< Check if a point is valid
   bool isValid(const std::map<int, int> &)
       const; ///< Check if a set of surfaces are valid.
+  void areValid(const std::vector<Kernel::V3D> &points,
+                std::vector<bool> &valid) const override;
   bool isOnSide(const Kernel::V3D &) const override;
   int calcValidType(const Kernel::V3D &Pt,
                     const Kernel::V3D &uVec) const override;
@@ -143,6 +146,7 @@ public:
 
   // INTERSECTION
   int interceptSurface(Geometry::Track &) const override;
+  void interceptSurfaces(std::vector<Track> &tracks) const override;
 
   // Solid angle - uses triangleSolidAngle unless many (>30000) triangles
   double solidAngle(const Kernel::V3D &observer) const override;
@@ -207,6 +211,7 @@ private:
                int &compUnit) const;
   std::unique_ptr<CompGrp> procComp(std::unique_ptr<Rule>) const;
   int checkSurfaceValid(const Kernel::V3D &, const Kernel::V3D &) const;
+  void interceptSurfaces(Track *tracks, const size_t count) const;
 
   /// Calculate bounding box using Rule system
   void calcBoundingBoxByRule();
@@ -243,6 +248,8 @@ private:
 
   /// Top rule [ Geometric scope of object]
   std::unique_ptr<Rule> TopRule;
+  /// The top rule compiled with the surfaces, when the surfaces are listed
+  std::unique_ptr<CompiledRule> m_compiledRule;
   /// Object's bounding box
   BoundingBox m_boundingBox;
   // -- DEPRECATED --
@@ -0,0 +1,125 @@
+#ifndef MANTID_GEOMETRY_COMPILEDRULE_H_
+#define MANTID_GEOMETRY_COMPILEDRULE_H_
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+class Rule;
+class Surface;
+
+/**
+CompiledRule : The Rule tree of a CSGObject, and the surfaces it refers to,
+flattened into arrays so that points can be tested against it without virtual
+calls, many at a time.
+
+The tree is held in prefix order, each node with the position after its
+subtree, so that the second branch of an intersection or union can be skipped.
+Planes, spheres and cylinders along an axis are held as their parameters and
+tested exactly as Surface::side tests them; other surfaces, and complemented
+objects, are tested through their own classes.
+
+Points are tested in batches of up to 64, with the result for each batch held
+as the bits of a mask. A branch is skipped once it cannot change the result
+for any point of the batch.
+
+The surfaces are read when the rule is compiled, so it must be compiled again
+if they or the tree change.
+
+Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+National Laboratory & European Spallation Source
+
+This file is part of Mantid.
+
+Mantid is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+
+Mantid is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+File change history is stored at: <https://github.com/mantidproject/mantid>
+Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_GEOMETRY_DLL CompiledRule {
+public:
+  /// Number of points tested together
+  static constexpr size_t BATCH_SIZE = 64;
+
+  explicit CompiledRule(const Rule *rule);
+
+  bool isValid(const Kernel::V3D &point) const;
+  void isValid(const std::vector<Kernel::V3D> &points,
+               std::vector<bool> &valid) const;
+  uint64_t validMask(const Kernel::V3D *points, const size_t count) const;
+
+private:
+  enum class Op : uint8_t {
+    /// Both branches
+    And,
+    /// Either branch
+    Or,
+    /// Not the branch
+    Not,
+    /// The side of a surface
+    Side,
+    /// A rule tested through its own class
+    Call,
+    /// Always or never valid
+    Constant
+  };
+  struct Instruction {
+    Op op;
+    /// Sign of the side of a surface
+    int8_t sign;
+    /// Index of a surface or rule, or the value of a constant
+    uint32_t operand;
+    /// Index after the subtree of the instruction
+    uint32_t end;
+  };
+
+  enum class Kind : uint8_t { Plane, Sphere, AxisCylinder, Other };
+  struct CompiledSurface {
+    Kind kind;
+    /// Axis of a cylinder
+    uint8_t axis;
+    /// Normal and distance of a plane, or centre and radius
+    double parameters[4];
+    const Surface *surface;
+  };
+
+  /// Coordinates of a batch of points
+  struct Batch {
+    double x[BATCH_SIZE];
+    double y[BATCH_SIZE];
+    double z[BATCH_SIZE];
+    const Kernel::V3D *points;
+    size_t count;
+  };
+
+  void compile(const Rule *rule);
+  uint32_t addSurface(const Surface *surface);
+  uint64_t evaluate(const uint32_t index, const Batch &batch,
+                    const uint64_t active) const;
+  uint64_t sideMask(const CompiledSurface &surface, const int sign,
+                    const Batch &batch) const;
+
+  std::vector<Instruction> m_instructions;
+  std::vector<CompiledSurface> m_surfaces;
+  std::vector<const Rule *> m_calls;
+};
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_COMPILEDRULE_H_ */
@@ -70,6 +70,11 @@ public:
   virtual int getName() const = 0;
 
   virtual int interceptSurface(Geometry::Track &) const = 0;
+  /// Check many points at once
+  virtual void areValid(const std::vector<Kernel::V3D> &points,
+                        std::vector<bool> &valid) const;
+  /// Fill many tracks at once
+  virtual void interceptSurfaces(std::vector<Track> &tracks) const;
   // Solid angle
   virtual double solidAngle(const Kernel::V3D &observer) const = 0;
   // Solid angle with a scaling of the object
@@ -6,11 +6,13 @@
 //----------------------------------------------------------------------
 #include "MantidGeometry/DllConfig.h"
 #include "MantidGeometry/Objects/IObject.h"
+#include "MantidGeometry/Objects/TriangleBVH.h"
 #include "MantidKernel/Material.h"
 #include "MantidGeometry/Rendering/ShapeInfo.h"
 #include "BoundingBox.h"
 #include <map>
 #include <memory>
+#include <mutex>
 
 namespace Mantid {
 //----------------------------------------------------------------------
@@ -37,7 +39,8 @@ class vtkGeometryCacheWriter;
 
 Mesh Object of Triangles assumed to form one or more
 non-intersecting closed surfaces enclosing separate volumes.
-The number of vertices is limited to 65535.
+Rays are traced through a bounding volume hierarchy of the triangles, built
+when first needed.
 
 Copyright &copy; 2017-2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
 National Laboratory & European Spallation Source
@@ -63,10 +66,18 @@ Code Documentation is available at: <http://doxygen.mantidproject.org>
 class MANTID_GEOMETRY_DLL MeshObject : public IObject {
 public:
   /// Constructor
-  MeshObject(const std::vector<uint16_t> &faces,
+  MeshObject(const std::vector<uint32_t> &faces,
              const std::vector<Mantid::Kernel::V3D> &vertices,
              const Kernel::Material &material);
   /// Constructor
+  MeshObject(std::vector<uint32_t> &&faces,
+             std::vector<Mantid::Kernel::V3D> &&vertices,
+             const Kernel::Material &&material);
+  /// Constructor from 16-bit faces
+  MeshObject(const std::vector<uint16_t> &faces,
+             const std::vector<Mantid::Kernel::V3D> &vertices,
+             const Kernel::Material &material);
+  /// Constructor from 16-bit faces
   MeshObject(std::vector<uint16_t> &&faces,
              std::vector<Mantid::Kernel::V3D> &&vertices,
              const Kernel::Material &&material);
@@ -168,6 +179,8 @@ private:
                    Kernel::V3D &v3) const;
   /// Search object for valid point
   bool searchForObject(Kernel::V3D &point) const;
+  /// Get the hierarchy of the triangles, building it if needed
+  const TriangleBVH &bvh() const;
 
   /// Cache for object's bounding box
   mutable BoundingBox m_boundingBox;
@@ -191,8 +204,11 @@ private:
 
   /// Contents
   /// Triangles are specified by indices into a list of vertices.
-  std::vector<uint16_t> m_triangles;
+  std::vector<uint32_t> m_triangles;
   std::vector<Kernel::V3D> m_vertices;
+  /// Hierarchy of the triangles for tracing rays
+  mutable std::unique_ptr<TriangleBVH> m_bvh;
+  mutable std::once_flag m_bvhBuilt;
   /// material composition
   Kernel::Material m_material;
 };
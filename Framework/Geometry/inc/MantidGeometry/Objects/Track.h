@@ -7,8 +7,8 @@
 #include "MantidGeometry/DllConfig.h"
 #include "MantidGeometry/IComponent.h"
 #include "MantidGeometry/Objects/IObject.h"
+#include "MantidKernel/SmallVector.h"
 #include "MantidKernel/Tolerance.h"
-#include <list>
 
 namespace Mantid {
 //----------------------------------------------------------------------
@@ -144,8 +144,10 @@ struct IntersectionPoint {
 */
 class MANTID_GEOMETRY_DLL Track {
 public:
-  using LType = std::list<Link>;
-  using PType = std::list<IntersectionPoint>;
+  // Most tracks cross a few surfaces, so the links and points are kept within
+  // the Track and a Track reused for many rays does not allocate
+  using LType = Kernel::SmallVector<Link, 4>;
+  using PType = Kernel::SmallVector<IntersectionPoint, 8>;
 
 public:
   /// Default constructor
@@ -0,0 +1,141 @@
+#ifndef MANTID_GEOMETRY_TRIANGLEBVH_H_
+#define MANTID_GEOMETRY_TRIANGLEBVH_H_
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+
+/**
+TriangleBVH : A bounding volume hierarchy over the triangles of a mesh, which
+finds the triangles a ray may cross without testing all of them.
+
+Each node holds the axis-aligned box of a range of triangles, and the triangles
+of an inner node are split between its two children at the median of their
+centres along the longest side of the box. A ray query visits the triangles of
+every leaf whose box the ray crosses. The boxes are slightly enlarged, so that
+no triangle the ray crosses within the tolerance of the intersection test is
+missed.
+
+Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+National Laboratory & European Spallation Source
+
+This file is part of Mantid.
+
+Mantid is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+
+Mantid is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+File change history is stored at: <https://github.com/mantidproject/mantid>
+Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_GEOMETRY_DLL TriangleBVH {
+public:
+  TriangleBVH(const std::vector<uint32_t> &triangles,
+              const std::vector<Kernel::V3D> &vertices);
+
+  /// @return the number of nodes of the hierarchy
+  size_t numberOfNodes() const { return m_nodes.size(); }
+
+  /**
+   * Call a function with the index of every triangle whose leaf box is
+   * crossed by a ray. Some of the triangles may not be crossed themselves.
+   * @param start :: start point of the ray
+   * @param direction :: direction of the ray
+   * @param visit :: called with the index of each triangle
+   */
+  template <typename Visitor>
+  void forEachTriangleOnRay(const Kernel::V3D &start,
+                            const Kernel::V3D &direction,
+                            Visitor &&visit) const {
+    if (m_nodes.empty())
+      return;
+    const Ray ray(start, direction);
+    // The depth is bounded by the median splits
+    std::array<uint32_t, 64> stack;
+    size_t depth = 0;
+    stack[depth++] = 0;
+    while (depth > 0) {
+      const Node &node = m_nodes[stack[--depth]];
+      if (!ray.crosses(node))
+        continue;
+      if (node.count > 0) {
+        for (uint32_t i = node.first; i < node.first + node.count; ++i)
+          visit(static_cast<size_t>(m_triangleIndices[i]));
+      } else {
+        // The first child follows its parent
+        stack[depth++] = node.first;
+        stack[depth++] = static_cast<uint32_t>(&node - m_nodes.data()) + 1;
+      }
+    }
+  }
+
+private:
+  struct Node {
+    double min[3];
+    double max[3];
+    /// First triangle of a leaf, or second child of an inner node
+    uint32_t first;
+    /// Number of triangles of a leaf, or 0 for an inner node
+    uint32_t count;
+  };
+
+  /// A ray, prepared for crossing boxes
+  struct Ray {
+    Ray(const Kernel::V3D &start, const Kernel::V3D &direction);
+    bool crosses(const Node &node) const {
+      double tMin = 0.0;
+      double tMax = std::numeric_limits<double>::max();
+      for (size_t i = 0; i < 3; ++i) {
+        if (direction[i] == 0.0) {
+          if (start[i] < node.min[i] || start[i] > node.max[i])
+            return false;
+          continue;
+        }
+        double t1 = (node.min[i] - start[i]) * inverse[i];
+        double t2 = (node.max[i] - start[i]) * inverse[i];
+        if (t1 > t2)
+          std::swap(t1, t2);
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax)
+          return false;
+      }
+      return true;
+    }
+    double start[3];
+    double direction[3];
+    double inverse[3];
+  };
+
+  uint32_t build(const std::vector<Kernel::V3D> &lower,
+                 const std::vector<Kernel::V3D> &upper, const uint32_t first,
+                 const uint32_t count, const double padding);
+
+  /// The nodes, depth first with the root first
+  std::vector<Node> m_nodes;
+  /// Triangle indices, grouped by leaf
+  std::vector<uint32_t> m_triangleIndices;
+};
+
+} // namespace Geometry
+} // namespace Mantid
+
+#endif /* MANTID_GEOMETRY_TRIANGLEBVH_H_ */
@@ -1366,12 +1366,15 @@ boost::shared_ptr<ParameterMap> Instrument::makeLegacyParameterMap() const {
  * This can be called for the base instrument once it is completely created, in
  * particular when it is stored in the InstrumentDataService for reusing it
  * later and avoiding repeated tree walks if several workspaces with the same
- * instrument are loaded. */
+ * instrument are loaded. Nothing is done if they have been created already,
+ * e.g. when the instrument was read from an InstrumentCache. */
 void Instrument::parseTreeAndCacheBeamline() {
   if (isParametrized())
     throw std::logic_error("Instrument::parseTreeAndCacheBeamline must be "
                            "called with the base instrument, not a "
                            "parametrized instrument");
+  if (m_componentInfo)
+    return;
   std::tie(m_componentInfo, m_detectorInfo) =
       InstrumentVisitor::makeWrappers(*this);
 }
@@ -0,0 +1,968 @@
+#include "MantidGeometry/Instrument/InstrumentCache.h"
+#include "MantidBeamline/ComponentInfo.h"
+#include "MantidBeamline/DetectorInfo.h"
+#include "MantidGeometry/IDetector.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
+#include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/InstrumentVisitor.h"
+#include "MantidGeometry/Instrument/ObjCompAssembly.h"
+#include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidGeometry/Instrument/RectangularDetectorPixel.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Instrument/XMLInstrumentParameter.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/ShapeFactory.h"
+#include "MantidKernel/Interpolation.h"
+#include "MantidKernel/Logger.h"
+
+#include <Poco/File.h>
+#include <Poco/Process.h>
+#include <Poco/SharedMemory.h>
+
+#include <boost/make_shared.hpp>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace Mantid {
+namespace Geometry {
+
+using Kernel::Quat;
+using Kernel::V3D;
+
+const uint32_t InstrumentCache::VERSION = 1;
+
+namespace {
+/// static logger
+Kernel::Logger g_log("InstrumentCache");
+
+/// Starts and ends each file
+const char MAGIC[8] = {'M', 'T', 'D', 'I', 'N', 'S', 'T', 'C'};
+
+/// Shape of a component without one
+const int32_t NO_SHAPE = -1;
+/// The empty shape InstrumentVisitor gives components without one
+const int32_t VISITOR_NULL_SHAPE = -2;
+
+/// Classes of component which can be held
+enum class Type : uint8_t {
+  Instrument,
+  Component,
+  ObjComponent,
+  Detector,
+  CompAssembly,
+  ObjCompAssembly,
+  RectangularDetector,
+  RectangularDetectorPixel
+};
+
+/// Flags of a component
+enum Flag : uint8_t {
+  /// Created by the RectangularDetector above it
+  Generated = 1,
+  MarkedDetector = 2,
+  MarkedMonitor = 4,
+  Source = 8,
+  Sample = 16
+};
+
+/// A component, as held in the file. Components are held in prefix order, so
+/// that each parent comes before its children.
+struct ComponentRecord {
+  /// Position relative to the parent
+  double position[3];
+  /// Rotation relative to the parent, as w, a, b, c
+  double rotation[4];
+  /// Offset of the name in the names of all components
+  uint64_t nameOffset;
+  uint32_t nameLength;
+  /// Index of the parent, or -1 for the instrument
+  int32_t parent;
+  /// Index of the shape, or NO_SHAPE
+  int32_t shape;
+  /// ID of a detector
+  int32_t detectorID;
+  Type type;
+  uint8_t flags;
+  uint8_t padding[6];
+};
+static_assert(sizeof(ComponentRecord) == 88,
+              "The file format depends on the layout of ComponentRecord");
+
+/// The parameters RectangularDetector::initialize was given, in the order of
+/// the banks in the records
+struct RectangularRecord {
+  double xstart;
+  double xstep;
+  double ystart;
+  double ystep;
+  int32_t xpixels;
+  int32_t ypixels;
+  int32_t idstart;
+  int32_t idstepbyrow;
+  int32_t idstep;
+  /// Index of the shape of the pixels
+  int32_t shape;
+  uint8_t idfillbyfirst_y;
+  uint8_t padding[7];
+};
+static_assert(sizeof(RectangularRecord) == 64,
+              "The file format depends on the layout of RectangularRecord");
+
+/// Writes values to a stream, aligning arrays so that they can be read in
+/// place
+class Writer {
+public:
+  explicit Writer(std::ostream &stream) : m_stream(stream), m_offset(0) {}
+
+  void bytes(const void *data, const size_t size) {
+    m_stream.write(static_cast<const char *>(data),
+                   static_cast<std::streamsize>(size));
+    m_offset += size;
+  }
+  template <typename T> void value(const T &v) { bytes(&v, sizeof(T)); }
+  void string(const std::string &s) {
+    value<uint64_t>(s.size());
+    bytes(s.data(), s.size());
+  }
+  template <typename T> void array(const T *data, const size_t size) {
+    value<uint64_t>(size);
+    align();
+    bytes(data, size * sizeof(T));
+  }
+  template <typename T, typename A> void array(const std::vector<T, A> &v) {
+    array(v.data(), v.size());
+  }
+
+private:
+  void align() {
+    static const char zeros[8] = {};
+    bytes(zeros, (8 - m_offset % 8) % 8);
+  }
+
+  std::ostream &m_stream;
+  size_t m_offset;
+};
+
+/// Reads the values written by a Writer from memory, throwing if they run
+/// past its end
+class Reader {
+public:
+  Reader(const char *begin, const char *end)
+      : m_begin(begin), m_current(begin), m_end(end) {}
+
+  const char *bytes(const uint64_t size) {
+    if (size > static_cast<uint64_t>(m_end - m_current))
+      throw std::runtime_error("the file is truncated");
+    const char *data = m_current;
+    m_current += size;
+    return data;
+  }
+  template <typename T> T value() {
+    T v;
+    std::memcpy(&v, bytes(sizeof(T)), sizeof(T));
+    return v;
+  }
+  std::string string() {
+    const auto size = value<uint64_t>();
+    const char *data = bytes(size);
+    return std::string(data, size);
+  }
+  /// @return the elements of an array, in place
+  template <typename T> const T *array(uint64_t &size) {
+    size = value<uint64_t>();
+    bytes((8 - (m_current - m_begin) % 8) % 8);
+    if (size > static_cast<uint64_t>(m_end - m_current) / sizeof(T))
+      throw std::runtime_error("the file is truncated");
+    return reinterpret_cast<const T *>(bytes(size * sizeof(T)));
+  }
+  template <typename T> std::vector<T> vector() {
+    uint64_t size;
+    const T *data = array<T>(size);
+    return std::vector<T>(data, data + size);
+  }
+  /// @return the elements of an array, which must have the given size
+  template <typename T> const T *fixedArray(const uint64_t expected) {
+    uint64_t size;
+    const T *data = array<T>(size);
+    if (size != expected)
+      throw std::runtime_error("an array has the wrong size");
+    return data;
+  }
+
+private:
+  const char *m_begin;
+  const char *m_current;
+  const char *m_end;
+};
+
+/// The shapes of an instrument, each held once
+class ShapeTable {
+public:
+  /// @return the index of a shape, adding it if necessary
+  int32_t index(const boost::shared_ptr<const IObject> &shape) {
+    if (!shape)
+      return NO_SHAPE;
+    const auto found = m_indices.find(shape.get());
+    if (found != m_indices.end())
+      return found->second;
+    const auto *csgObject = dynamic_cast<const CSGObject *>(shape.get());
+    if (!csgObject)
+      throw std::invalid_argument("only shapes defined by CSGObject can be "
+                                  "held in the instrument cache");
+    const auto index = static_cast<int32_t>(m_shapes.size());
+    m_shapes.push_back(csgObject);
+    m_indices.emplace(shape.get(), index);
+    return index;
+  }
+  void addType(const std::string &name,
+               const boost::shared_ptr<const IObject> &shape) {
+    if (shape)
+      m_types.emplace_back(name, index(shape));
+  }
+
+  void write(Writer &writer) const {
+    writer.value<uint64_t>(m_shapes.size());
+    for (const auto *shape : m_shapes) {
+      // A default CSGObject is left without XML
+      writer.string(shape->getShapeXML());
+      writer.value<int32_t>(shape->getName());
+      writer.string(shape->id());
+    }
+    writer.value<uint64_t>(m_types.size());
+    for (const auto &type : m_types) {
+      writer.string(type.first);
+      writer.value<int32_t>(type.second);
+    }
+  }
+
+private:
+  std::vector<const CSGObject *> m_shapes;
+  std::unordered_map<const IObject *, int32_t> m_indices;
+  std::vector<std::pair<std::string, int32_t>> m_types;
+};
+
+/// The shapes read from a file
+class ReadShapes {
+public:
+  explicit ReadShapes(Reader &reader) {
+    const auto count = reader.value<uint64_t>();
+    for (uint64_t i = 0; i < count; ++i) {
+      const auto xml = reader.string();
+      const auto objNum = reader.value<int32_t>();
+      const auto id = reader.string();
+      auto shape = xml.empty() ? boost::make_shared<CSGObject>()
+                               : ShapeFactory().createShape(xml, false);
+      shape->setName(objNum);
+      shape->setID(id);
+      m_shapes.push_back(std::move(shape));
+    }
+    const auto types = reader.value<uint64_t>();
+    for (uint64_t i = 0; i < types; ++i) {
+      const auto name = reader.string();
+      m_types[name] = shape(reader.value<int32_t>());
+    }
+  }
+
+  boost::shared_ptr<IObject> shape(const int32_t index) const {
+    if (index == NO_SHAPE)
+      return nullptr;
+    if (index < 0 || static_cast<size_t>(index) >= m_shapes.size())
+      throw std::runtime_error("a shape index is out of range");
+    return m_shapes[index];
+  }
+  InstrumentCache::TypeShapes &types() { return m_types; }
+
+private:
+  std::vector<boost::shared_ptr<IObject>> m_shapes;
+  InstrumentCache::TypeShapes m_types;
+};
+
+/// @return the axis along a vector of ReferenceFrame
+PointingAlong axis(const V3D &direction) {
+  for (int i = 0; i < 3; ++i) {
+    if (direction[i] != 0.)
+      return static_cast<PointingAlong>(i);
+  }
+  throw std::invalid_argument("the reference frame has no theta sign axis");
+}
+
+/// @return the type of a component
+Type typeOf(const IComponent &component) {
+  // Exactly the classes, as a derived class may hold more than is saved
+  const auto &type = typeid(component);
+  if (type == typeid(Instrument))
+    return Type::Instrument;
+  if (type == typeid(Component))
+    return Type::Component;
+  if (type == typeid(ObjComponent))
+    return Type::ObjComponent;
+  if (type == typeid(Detector))
+    return Type::Detector;
+  if (type == typeid(CompAssembly))
+    return Type::CompAssembly;
+  if (type == typeid(ObjCompAssembly))
+    return Type::ObjCompAssembly;
+  if (type == typeid(RectangularDetector))
+    return Type::RectangularDetector;
+  if (type == typeid(RectangularDetectorPixel))
+    return Type::RectangularDetectorPixel;
+  throw std::invalid_argument("components of type " +
+                              std::string(type.name()) +
+                              " cannot be held in the instrument cache");
+}
+
+/// The component tree of an instrument, flattened into records
+class Components {
+public:
+  /**
+   * @param instrument :: the instrument
+   * @param detectors :: whether each marked detector is a monitor
+   * @param source :: the source, which may be null
+   * @param sample :: the sample position, which may be null
+   * @param shapes :: the table the shapes are added to
+   */
+  Components(const Instrument &instrument,
+             std::unordered_map<const IDetector *, bool> detectors,
+             const IComponent *source, const IComponent *sample,
+             ShapeTable &shapes)
+      : m_detectors(std::move(detectors)), m_source(source), m_sample(sample),
+        m_shapes(shapes) {
+    add(instrument, -1, false);
+  }
+
+  uint32_t index(const IComponent *component) const {
+    const auto found = m_indices.find(component);
+    if (found == m_indices.end())
+      throw std::invalid_argument("the instrument refers to a component "
+                                  "outside of its tree");
+    return found->second;
+  }
+
+  void write(Writer &writer) const {
+    writer.array(m_records);
+    writer.array(m_names);
+    writer.array(m_rectangular);
+  }
+
+private:
+  void add(const IComponent &component, const int32_t parent,
+           const bool generated) {
+    const auto index = static_cast<uint32_t>(m_records.size());
+    m_indices.emplace(&component, index);
+
+    ComponentRecord record;
+    std::memset(&record, 0, sizeof(record));
+    const V3D position = component.getRelativePos();
+    const Quat rotation = component.getRelativeRot();
+    for (size_t i = 0; i < 3; ++i)
+      record.position[i] = position[i];
+    record.rotation[0] = rotation.real();
+    record.rotation[1] = rotation.imagI();
+    record.rotation[2] = rotation.imagJ();
+    record.rotation[3] = rotation.imagK();
+    const auto name = component.getName();
+    record.nameOffset = m_names.size();
+    record.nameLength = static_cast<uint32_t>(name.size());
+    m_names.insert(m_names.end(), name.begin(), name.end());
+    record.parent = parent;
+    record.shape = NO_SHAPE;
+    record.type = typeOf(component);
+    record.flags = generated ? Generated : 0;
+    if (&component == m_source)
+      record.flags |= Source;
+    if (&component == m_sample)
+      record.flags |= Sample;
+
+    if (const auto *objComponent =
+            dynamic_cast<const IObjComponent *>(&component))
+      record.shape = m_shapes.index(objComponent->shape());
+    if (const auto *detector = dynamic_cast<const IDetector *>(&component)) {
+      record.detectorID = detector->getID();
+      const auto marked = m_detectors.find(detector);
+      if (marked != m_detectors.end())
+        record.flags |= marked->second ? MarkedMonitor : MarkedDetector;
+    }
+    if (record.type == Type::RectangularDetector)
+      addRectangular(dynamic_cast<const RectangularDetector &>(component));
+    m_records.push_back(record);
+
+    if (const auto *assembly =
+            dynamic_cast<const ICompAssembly *>(&component)) {
+      const bool childrenGenerated =
+          generated || record.type == Type::RectangularDetector;
+      for (int i = 0; i < assembly->nelements(); ++i)
+        add(*(*assembly)[i], static_cast<int32_t>(index), childrenGenerated);
+    }
+  }
+
+  void addRectangular(const RectangularDetector &bank) {
+    RectangularRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.xstart = bank.xstart();
+    record.xstep = bank.xstep();
+    record.ystart = bank.ystart();
+    record.ystep = bank.ystep();
+    record.xpixels = bank.xpixels();
+    record.ypixels = bank.ypixels();
+    record.idstart = bank.idstart();
+    record.idstepbyrow = bank.idstepbyrow();
+    record.idstep = bank.idstep();
+    record.shape = m_shapes.index(bank.getAtXY(0, 0)->shape());
+    record.idfillbyfirst_y = bank.idfillbyfirst_y() ? 1 : 0;
+    m_rectangular.push_back(record);
+  }
+
+  std::unordered_map<const IDetector *, bool> m_detectors;
+  const IComponent *m_source;
+  const IComponent *m_sample;
+  ShapeTable &m_shapes;
+  std::unordered_map<const IComponent *, uint32_t> m_indices;
+  std::vector<ComponentRecord> m_records;
+  std::vector<char> m_names;
+  std::vector<RectangularRecord> m_rectangular;
+};
+
+void writeInterpolation(Writer &writer,
+                        const boost::shared_ptr<Kernel::Interpolation> &value) {
+  writer.value<uint8_t>(value ? 1 : 0);
+  if (value) {
+    std::ostringstream out;
+    out.precision(std::numeric_limits<double>::max_digits10);
+    out << *value;
+    writer.string(out.str());
+  }
+}
+
+boost::shared_ptr<Kernel::Interpolation> readInterpolation(Reader &reader) {
+  if (reader.value<uint8_t>() == 0)
+    return nullptr;
+  auto interpolation = boost::make_shared<Kernel::Interpolation>();
+  std::istringstream in(reader.string());
+  in >> *interpolation;
+  return interpolation;
+}
+
+void writeParameter(Writer &writer, const uint32_t component,
+                    const XMLInstrumentParameter &parameter) {
+  writer.value(component);
+  writer.string(parameter.m_logfileID);
+  writer.string(parameter.m_value);
+  writeInterpolation(writer, parameter.m_interpolation);
+  writer.string(parameter.m_formula);
+  writer.string(parameter.m_formulaUnit);
+  writer.string(parameter.m_resultUnit);
+  writer.string(parameter.m_paramName);
+  writer.string(parameter.m_type);
+  writer.string(parameter.m_tie);
+  writer.value<uint64_t>(parameter.m_constraint.size());
+  for (const auto &constraint : parameter.m_constraint)
+    writer.string(constraint);
+  writer.string(parameter.m_penaltyFactor);
+  writer.string(parameter.m_fittingFunction);
+  writer.string(parameter.m_extractSingleValueAs);
+  writer.string(parameter.m_eq);
+  writer.string(parameter.m_description);
+  writer.value(parameter.m_angleConvertConst);
+}
+
+boost::shared_ptr<XMLInstrumentParameter>
+readParameter(Reader &reader, const IComponent *component) {
+  const auto logfileID = reader.string();
+  const auto value = reader.string();
+  const auto interpolation = readInterpolation(reader);
+  const auto formula = reader.string();
+  const auto formulaUnit = reader.string();
+  const auto resultUnit = reader.string();
+  const auto paramName = reader.string();
+  const auto type = reader.string();
+  const auto tie = reader.string();
+  std::vector<std::string> constraint(reader.value<uint64_t>());
+  for (auto &c : constraint)
+    c = reader.string();
+  auto penaltyFactor = reader.string();
+  const auto fittingFunction = reader.string();
+  const auto extractSingleValueAs = reader.string();
+  const auto eq = reader.string();
+  const auto description = reader.string();
+  const auto angleConvertConst = reader.value<double>();
+  return boost::make_shared<XMLInstrumentParameter>(
+      logfileID, value, interpolation, formula, formulaUnit, resultUnit,
+      paramName, type, tie, constraint, penaltyFactor, fittingFunction,
+      extractSingleValueAs, eq, component, angleConvertConst, description);
+}
+
+void writeVectors(Writer &writer, const std::vector<Eigen::Vector3d> &values) {
+  std::vector<double> flat;
+  flat.reserve(3 * values.size());
+  for (const auto &value : values)
+    flat.insert(flat.end(), value.data(), value.data() + 3);
+  writer.array(flat);
+}
+
+template <typename A>
+void writeQuaternions(Writer &writer,
+                      const std::vector<Eigen::Quaterniond, A> &values) {
+  std::vector<double> flat;
+  flat.reserve(4 * values.size());
+  for (const auto &value : values) {
+    flat.push_back(value.w());
+    flat.push_back(value.x());
+    flat.push_back(value.y());
+    flat.push_back(value.z());
+  }
+  writer.array(flat);
+}
+
+void writeIndices(Writer &writer, const std::vector<size_t> &indices) {
+  writer.array(std::vector<uint64_t>(indices.begin(), indices.end()));
+}
+
+void writeRanges(Writer &writer,
+                 const std::vector<std::pair<size_t, size_t>> &ranges) {
+  std::vector<uint64_t> flat;
+  flat.reserve(2 * ranges.size());
+  for (const auto &range : ranges) {
+    flat.push_back(range.first);
+    flat.push_back(range.second);
+  }
+  writer.array(flat);
+}
+
+boost::shared_ptr<std::vector<Eigen::Vector3d>> readVectors(Reader &reader,
+                                                            const size_t size) {
+  const auto *flat = reader.fixedArray<double>(3 * size);
+  auto values = boost::make_shared<std::vector<Eigen::Vector3d>>(size);
+  for (size_t i = 0; i < size; ++i)
+    (*values)[i] =
+        Eigen::Vector3d(flat[3 * i], flat[3 * i + 1], flat[3 * i + 2]);
+  return values;
+}
+
+boost::shared_ptr<std::vector<Eigen::Quaterniond,
+                              Eigen::aligned_allocator<Eigen::Quaterniond>>>
+readQuaternions(Reader &reader, const size_t size) {
+  const auto *flat = reader.fixedArray<double>(4 * size);
+  auto values = boost::make_shared<std::vector<
+      Eigen::Quaterniond, Eigen::aligned_allocator<Eigen::Quaterniond>>>();
+  values->reserve(size);
+  for (size_t i = 0; i < size; ++i)
+    values->emplace_back(flat[4 * i], flat[4 * i + 1], flat[4 * i + 2],
+                         flat[4 * i + 3]);
+  return values;
+}
+
+boost::shared_ptr<std::vector<size_t>> readIndices(Reader &reader,
+                                                   const size_t size) {
+  const auto *indices = reader.fixedArray<uint64_t>(size);
+  return boost::make_shared<std::vector<size_t>>(indices, indices + size);
+}
+
+boost::shared_ptr<std::vector<std::pair<size_t, size_t>>>
+readRanges(Reader &reader, const size_t size) {
+  const auto *flat = reader.fixedArray<uint64_t>(2 * size);
+  auto ranges =
+      boost::make_shared<std::vector<std::pair<size_t, size_t>>>(size);
+  for (size_t i = 0; i < size; ++i)
+    (*ranges)[i] = {flat[2 * i], flat[2 * i + 1]};
+  return ranges;
+}
+
+/// Check that an index read from the file is within range
+size_t checked(const uint64_t index, const size_t size) {
+  if (index >= size)
+    throw std::runtime_error("an index is out of range");
+  return static_cast<size_t>(index);
+}
+} // namespace
+
+/**
+ * Save an instrument, as it was left by InstrumentDefinitionParser
+ * @param instrument :: the base instrument, whose tree is complete
+ * @param typeShapes :: the shapes of the instrument definition
+ * @param key :: identifies the instrument definition
+ * @param filename :: the file, which is replaced once it has been written
+ * @throw std::invalid_argument if the instrument cannot be held in the cache
+ * @throw std::runtime_error if the file cannot be written
+ */
+void InstrumentCache::save(const Instrument &instrument,
+                           const TypeShapes &typeShapes, const std::string &key,
+                           const std::string &filename) {
+  if (instrument.isParametrized() || instrument.getPhysicalInstrument())
+    throw std::invalid_argument("only a base instrument without a physical "
+                                "instrument can be held in the cache");
+
+  // Everything is gathered before the file is opened, so that an instrument
+  // which cannot be held leaves no file
+  ShapeTable shapes;
+  for (const auto &type : typeShapes)
+    shapes.addType(type.first, type.second);
+  std::unordered_map<const IDetector *, bool> detectors;
+  for (const auto &detector : instrument.m_detectorCache)
+    detectors.emplace(std::get<1>(detector).get(), std::get<2>(detector));
+  const Components components(instrument, std::move(detectors),
+                              instrument.m_sourceCache,
+                              instrument.m_sampleCache, shapes);
+
+  std::vector<uint32_t> choppers;
+  for (const auto *chopper : *instrument.m_chopperPoints)
+    choppers.push_back(components.index(chopper));
+
+  std::vector<std::pair<uint32_t, const XMLInstrumentParameter *>> parameters;
+  for (const auto &parameter : instrument.getLogfileCache())
+    parameters.emplace_back(components.index(parameter.first.second),
+                            parameter.second.get());
+
+  InstrumentVisitor visitor(
+      boost::shared_ptr<const Instrument>(&instrument, NoDeleting()));
+  visitor.walkInstrument();
+  std::vector<uint32_t> componentRecords;
+  componentRecords.reserve(visitor.m_componentIds->size());
+  for (const auto *componentId : *visitor.m_componentIds)
+    componentRecords.push_back(components.index(componentId));
+  std::vector<int32_t> componentShapes;
+  componentShapes.reserve(visitor.m_shapes->size());
+  for (const auto &shape : *visitor.m_shapes)
+    componentShapes.push_back(shape == visitor.m_nullShape
+                                  ? VISITOR_NULL_SHAPE
+                                  : shapes.index(shape));
+
+  const auto frame = instrument.getReferenceFrame();
+  const auto temporary =
+      filename + ".tmp" + std::to_string(Poco::Process::id());
+  try {
+    std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+    if (!stream)
+      throw std::runtime_error("cannot open " + temporary);
+    Writer writer(stream);
+    writer.bytes(MAGIC, sizeof(MAGIC));
+    writer.value(VERSION);
+    writer.string(key);
+
+    writer.string(instrument.getName());
+    writer.value<int64_t>(instrument.getValidFromDate().totalNanoseconds());
+    writer.value<int64_t>(instrument.getValidToDate().totalNanoseconds());
+    writer.string(instrument.getDefaultView());
+    writer.string(instrument.getDefaultAxis());
+    writer.value<uint8_t>(frame->pointingUp());
+    writer.value<uint8_t>(frame->pointingAlongBeam());
+    writer.value<uint8_t>(axis(frame->vecThetaSign()));
+    writer.value<uint8_t>(frame->getHandedness());
+    writer.string(frame->origin());
+    writer.value<uint64_t>(instrument.m_logfileUnit.size());
+    for (const auto &unit : instrument.m_logfileUnit) {
+      writer.string(unit.first);
+      writer.string(unit.second);
+    }
+
+    shapes.write(writer);
+    components.write(writer);
+    writer.array(choppers);
+    writer.value<uint64_t>(parameters.size());
+    for (const auto &parameter : parameters)
+      writeParameter(writer, parameter.first, *parameter.second);
+
+    writer.value<uint64_t>(visitor.m_orderedDetectorIds->size());
+    writer.array(componentRecords);
+    writer.array(componentShapes);
+    writeIndices(writer, *visitor.m_assemblySortedDetectorIndices);
+    writeIndices(writer, *visitor.m_assemblySortedComponentIndices);
+    writeIndices(writer, *visitor.m_parentComponentIndices);
+    std::vector<uint64_t> childCounts;
+    std::vector<uint64_t> children;
+    for (const auto &nodeChildren : *visitor.m_children) {
+      childCounts.push_back(nodeChildren.size());
+      children.insert(children.end(), nodeChildren.begin(),
+                      nodeChildren.end());
+    }
+    writer.array(childCounts);
+    writer.array(children);
+    writeRanges(writer, *visitor.m_detectorRanges);
+    writeRanges(writer, *visitor.m_componentRanges);
+    writeVectors(writer, *visitor.m_positions);
+    writeQuaternions(writer, *visitor.m_rotations);
+    writeVectors(writer, *visitor.m_detectorPositions);
+    writeQuaternions(writer, *visitor.m_detectorRotations);
+    writeIndices(writer, *visitor.m_monitorIndices);
+    writeVectors(writer, *visitor.m_scaleFactors);
+    std::vector<uint8_t> componentTypes;
+    for (const auto type : *visitor.m_componentType)
+      componentTypes.push_back(static_cast<uint8_t>(type));
+    writer.array(componentTypes);
+    writer.value(visitor.m_sourceIndex);
+    writer.value(visitor.m_sampleIndex);
+    writer.bytes(MAGIC, sizeof(MAGIC));
+
+    stream.close();
+    if (!stream)
+      throw std::runtime_error("cannot write " + temporary);
+    Poco::File(temporary).renameTo(filename);
+  } catch (...) {
+    try {
+      Poco::File file(temporary);
+      if (file.exists())
+        file.remove();
+    } catch (std::exception &) {
+    }
+    throw;
+  }
+}
+
+/**
+ * Load an instrument saved by save()
+ * @param filename :: the file
+ * @param key :: identifies the instrument definition, which must match the
+ * key the file was saved with
+ * @param typeShapes :: set to the shapes of the instrument definition
+ * @return the instrument, with its ComponentInfo and DetectorInfo, or null if
+ * the file does not exist or cannot be used
+ */
+Instrument_sptr InstrumentCache::load(const std::string &filename,
+                                      const std::string &key,
+                                      TypeShapes &typeShapes) {
+  try {
+    Poco::File file(filename);
+    if (!file.exists() || file.getSize() == 0)
+      return nullptr;
+    Poco::SharedMemory mapping(file, Poco::SharedMemory::AM_READ);
+    Reader reader(mapping.begin(), mapping.end());
+
+    if (std::memcmp(reader.bytes(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0)
+      throw std::runtime_error("it is not an instrument cache");
+    if (reader.value<uint32_t>() != VERSION || reader.string() != key) {
+      g_log.information() << "The instrument cache " << filename
+                          << " is for another version or definition\n";
+      return nullptr;
+    }
+
+    auto instrument = boost::make_shared<Instrument>(reader.string());
+    instrument->setValidFromDate(
+        Types::Core::DateAndTime(reader.value<int64_t>()));
+    instrument->setValidToDate(
+        Types::Core::DateAndTime(reader.value<int64_t>()));
+    instrument->setDefaultView(reader.string());
+    instrument->setDefaultViewAxis(reader.string());
+    const auto up = static_cast<PointingAlong>(reader.value<uint8_t>());
+    const auto alongBeam = static_cast<PointingAlong>(reader.value<uint8_t>());
+    const auto thetaSign = static_cast<PointingAlong>(reader.value<uint8_t>());
+    const auto handedness = static_cast<Handedness>(reader.value<uint8_t>());
+    instrument->setReferenceFrame(boost::make_shared<ReferenceFrame>(
+        up, alongBeam, thetaSign, handedness, reader.string()));
+    const auto units = reader.value<uint64_t>();
+    for (uint64_t i = 0; i < units; ++i) {
+      auto unit = reader.string();
+      instrument->getLogfileUnit()[unit] = reader.string();
+    }
+
+    ReadShapes shapes(reader);
+    uint64_t nRecords, nNames, nRectangular;
+    const auto *records = reader.array<ComponentRecord>(nRecords);
+    const auto *names = reader.array<char>(nNames);
+    const auto *rectangular = reader.array<RectangularRecord>(nRectangular);
+    if (nRecords == 0 || records[0].type != Type::Instrument)
+      throw std::runtime_error("the components are not an instrument");
+
+    // Rebuild the tree, taking the components a RectangularDetector creates
+    // from it in the order they were saved
+    std::vector<IComponent *> components(nRecords, nullptr);
+    std::vector<ICompAssembly *> assemblies(nRecords, nullptr);
+    std::vector<int> nextChild(nRecords, 0);
+    std::vector<std::string> componentNames(nRecords);
+    size_t nextRectangular = 0;
+    for (size_t i = 0; i < nRecords; ++i) {
+      const auto &record = records[i];
+      if (record.nameOffset > nNames ||
+          record.nameLength > nNames - record.nameOffset)
+        throw std::runtime_error("a name is out of range");
+      componentNames[i].assign(names + record.nameOffset, record.nameLength);
+      const auto &name = componentNames[i];
+
+      IComponent *component = nullptr;
+      if (i == 0) {
+        component = instrument.get();
+      } else {
+        if (record.parent < 0 || static_cast<size_t>(record.parent) >= i ||
+            !assemblies[record.parent])
+          throw std::runtime_error("a component has no parent");
+        ICompAssembly *parent = assemblies[record.parent];
+        if (record.flags & Generated) {
+          int &child = nextChild[record.parent];
+          if (child >= parent->nelements())
+            throw std::runtime_error("a generated component is missing");
+          component = (*parent)[child++].get();
+          if (component->getName() != name)
+            throw std::runtime_error("a generated component does not match");
+        } else {
+          switch (record.type) {
+          case Type::Component:
+            component = new Component(name, parent);
+            parent->add(component);
+            break;
+          case Type::ObjComponent:
+            component =
+                new ObjComponent(name, shapes.shape(record.shape), parent);
+            parent->add(component);
+            break;
+          case Type::Detector:
+            component = new Detector(name, record.detectorID,
+                                     shapes.shape(record.shape), parent);
+            parent->add(component);
+            break;
+          case Type::CompAssembly:
+            component = new CompAssembly(name, parent);
+            break;
+          case Type::ObjCompAssembly: {
+            auto *assembly = new ObjCompAssembly(name, parent);
+            if (record.shape != NO_SHAPE)
+              assembly->setOutline(shapes.shape(record.shape));
+            component = assembly;
+            break;
+          }
+          case Type::RectangularDetector: {
+            if (nextRectangular >= nRectangular)
+              throw std::runtime_error("a RectangularDetector is missing");
+            const auto &bank = rectangular[nextRectangular++];
+            auto *detector = new RectangularDetector(name, parent);
+            detector->initialize(shapes.shape(bank.shape), bank.xpixels,
+                                 bank.xstart, bank.xstep, bank.ypixels,
+                                 bank.ystart, bank.ystep, bank.idstart,
+                                 bank.idfillbyfirst_y != 0, bank.idstepbyrow,
+                                 bank.idstep);
+            component = detector;
+            break;
+          }
+          default:
+            throw std::runtime_error("a component has an unexpected type");
+          }
+        }
+      }
+      component->setPos(
+          V3D(record.position[0], record.position[1], record.position[2]));
+      component->setRot(Quat(record.rotation[0], record.rotation[1],
+                             record.rotation[2], record.rotation[3]));
+      components[i] = component;
+      assemblies[i] = dynamic_cast<ICompAssembly *>(component);
+    }
+
+    for (size_t i = 0; i < nRecords; ++i) {
+      const auto flags = records[i].flags;
+      if (flags & (MarkedDetector | MarkedMonitor)) {
+        const auto *detector = dynamic_cast<const IDetector *>(components[i]);
+        if (!detector)
+          throw std::runtime_error("a marked detector is not a detector");
+        if (flags & MarkedMonitor)
+          instrument->markAsMonitor(detector);
+        else
+          instrument->markAsDetectorIncomplete(detector);
+      }
+      if (flags & Source)
+        instrument->m_sourceCache = components[i];
+      if (flags & Sample)
+        instrument->m_sampleCache = components[i];
+    }
+    instrument->markAsDetectorFinalize();
+
+    uint64_t nChoppers;
+    const auto *choppers = reader.array<uint32_t>(nChoppers);
+    for (uint64_t i = 0; i < nChoppers; ++i) {
+      const auto *chopper = dynamic_cast<const ObjComponent *>(
+          components[checked(choppers[i], components.size())]);
+      if (!chopper)
+        throw std::runtime_error("a chopper point is not an ObjComponent");
+      instrument->m_chopperPoints->push_back(chopper);
+    }
+
+    const auto nParameters = reader.value<uint64_t>();
+    for (uint64_t i = 0; i < nParameters; ++i) {
+      const IComponent *component =
+          components[checked(reader.value<uint32_t>(), components.size())];
+      auto parameter = readParameter(reader, component);
+      instrument->getLogfileCache().emplace(
+          std::make_pair(parameter->m_paramName, component),
+          std::move(parameter));
+    }
+
+    // The visitor is given the arrays it would have found by walking the tree
+    InstrumentVisitor visitor(
+        boost::shared_ptr<const Instrument>(instrument.get(), NoDeleting()));
+    const auto nDetectors = static_cast<size_t>(reader.value<uint64_t>());
+    if (nDetectors != visitor.m_orderedDetectorIds->size())
+      throw std::runtime_error("the detectors do not match");
+    uint64_t nComponents;
+    const auto *componentRecords = reader.array<uint32_t>(nComponents);
+    if (nComponents < nDetectors)
+      throw std::runtime_error("the components do not match");
+    const auto nNonDetectors = static_cast<size_t>(nComponents) - nDetectors;
+    visitor.m_componentIds->resize(nComponents);
+    visitor.m_names->resize(nComponents);
+    visitor.m_componentIdToIndexMap->reserve(nComponents);
+    for (size_t i = 0; i < nComponents; ++i) {
+      const auto record = checked(componentRecords[i], components.size());
+      auto *componentId = components[record]->getComponentID();
+      (*visitor.m_componentIds)[i] = componentId;
+      (*visitor.m_componentIdToIndexMap)[componentId] = i;
+      (*visitor.m_names)[i] = componentNames[record];
+    }
+    const auto *componentShapes = reader.fixedArray<int32_t>(nComponents);
+    visitor.m_shapes->resize(nComponents);
+    for (size_t i = 0; i < nComponents; ++i) {
+      if (componentShapes[i] == VISITOR_NULL_SHAPE)
+        (*visitor.m_shapes)[i] = visitor.m_nullShape;
+      else
+        (*visitor.m_shapes)[i] = shapes.shape(componentShapes[i]);
+    }
+    visitor.m_assemblySortedDetectorIndices = readIndices(reader, nDetectors);
+    visitor.m_assemblySortedComponentIndices =
+        readIndices(reader, nNonDetectors);
+    visitor.m_parentComponentIndices = readIndices(reader, nComponents);
+    const auto *childCounts = reader.fixedArray<uint64_t>(nNonDetectors);
+    uint64_t nChildren;
+    const auto *children = reader.array<uint64_t>(nChildren);
+    visitor.m_children->resize(nNonDetectors);
+    for (size_t i = 0, first = 0; i < nNonDetectors; ++i) {
+      if (childCounts[i] > nChildren - first)
+        throw std::runtime_error("the children do not match");
+      (*visitor.m_children)[i].assign(children + first,
+                                      children + first + childCounts[i]);
+      first += static_cast<size_t>(childCounts[i]);
+    }
+    visitor.m_detectorRanges = readRanges(reader, nNonDetectors);
+    visitor.m_componentRanges = readRanges(reader, nNonDetectors);
+    visitor.m_positions = readVectors(reader, nNonDetectors);
+    visitor.m_rotations = readQuaternions(reader, nNonDetectors);
+    visitor.m_detectorPositions = readVectors(reader, nDetectors);
+    visitor.m_detectorRotations = readQuaternions(reader, nDetectors);
+    visitor.m_monitorIndices = boost::make_shared<std::vector<size_t>>();
+    for (const auto index : reader.vector<uint64_t>())
+      visitor.m_monitorIndices->push_back(checked(index, nDetectors));
+    visitor.m_scaleFactors = readVectors(reader, nComponents);
+    const auto *componentTypes = reader.fixedArray<uint8_t>(nNonDetectors);
+    visitor.m_componentType->assign(nNonDetectors,
+                                    Beamline::ComponentType::Generic);
+    for (size_t i = 0; i < nNonDetectors; ++i)
+      (*visitor.m_componentType)[i] =
+          static_cast<Beamline::ComponentType>(componentTypes[i]);
+    visitor.m_sourceIndex = reader.value<int64_t>();
+    visitor.m_sampleIndex = reader.value<int64_t>();
+    if (std::memcmp(reader.bytes(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0)
+      throw std::runtime_error("the file is incomplete");
+    std::tie(instrument->m_componentInfo, instrument->m_detectorInfo) =
+        visitor.makeWrappers();
+
+    typeShapes.swap(shapes.types());
+    return instrument;
+  } catch (std::exception &e) {
+    g_log.warning() << "Cannot use the instrument cache " << filename << ": "
+                    << e.what() << "\n";
+  }
+  return nullptr;
+}
+
+} // namespace Geometry
+} // namespace Mantid
@@ -2,6 +2,7 @@
 #include <sstream>
 
 #include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/InstrumentCache.h"
 #include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
 #include "MantidGeometry/Instrument/ObjCompAssembly.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
@@ -51,6 +52,23 @@ namespace Geometry {
 namespace {
 // initialize the static logger
 Kernel::Logger g_log("InstrumentDefinitionParser");
+
+/// @return true if instruments are to be read from and written to the
+/// instrument cache
+bool instrumentCacheEnabled() {
+  int enabled(0);
+  ConfigService::Instance().getValue("instrumentDefinition.binaryCache",
+                                     enabled);
+  return enabled != 0;
+}
+
+/// @return the instrument cache file in the temporary directory, used if the
+/// geometry cache directory cannot be written
+std::string instrumentCacheFallBackFileName(const std::string &mangledName) {
+  return Poco::Path(ConfigService::Instance().getTempDir())
+      .append(mangledName + ".instcache")
+      .toString();
+}
 }
 //----------------------------------------------------------------------------------------------
 /** Default Constructor - not very functional in this state
@@ -60,7 +78,8 @@ InstrumentDefinitionParser::InstrumentDefinitionParser()
       m_cacheFile(boost::make_shared<NullIDFObject>()), m_pDoc(nullptr),
       m_hasParameterElement_beenSet(false), m_haveDefaultFacing(false),
       m_deltaOffsets(false), m_angleConvertConst(1.0),
-      m_indirectPositions(false), m_cachingOption(NoneApplied) {
+      m_indirectPositions(false), m_cachingOption(NoneApplied),
+      m_instrumentCachingOption(InstrumentCacheNotUsed) {
   initialise("", "", "", "");
 }
 //----------------------------------------------------------------------------------------------
@@ -77,7 +96,8 @@ InstrumentDefinitionParser::InstrumentDefinitionParser(
       m_cacheFile(boost::make_shared<NullIDFObject>()), m_pDoc(nullptr),
       m_hasParameterElement_beenSet(false), m_haveDefaultFacing(false),
       m_deltaOffsets(false), m_angleConvertConst(1.0),
-      m_indirectPositions(false), m_cachingOption(NoneApplied) {
+      m_indirectPositions(false), m_cachingOption(NoneApplied),
+      m_instrumentCachingOption(InstrumentCacheNotUsed) {
   initialise(filename, instName, xmlText, "");
 }
 
@@ -97,7 +117,8 @@ InstrumentDefinitionParser::InstrumentDefinitionParser(
       m_cacheFile(boost::make_shared<NullIDFObject>()), m_pDoc(nullptr),
       m_hasParameterElement_beenSet(false), m_haveDefaultFacing(false),
       m_deltaOffsets(false), m_angleConvertConst(1.0),
-      m_indirectPositions(false), m_cachingOption(NoneApplied) {
+      m_indirectPositions(false), m_cachingOption(NoneApplied),
+      m_instrumentCachingOption(InstrumentCacheNotUsed) {
   initialise(xmlFile->getFileFullPathStr(), instName, xmlText,
              expectedCacheFile->getFileFullPathStr());
 
@@ -222,6 +243,13 @@ void InstrumentDefinitionParser::throwIfTypeNameNotUnique(
  */
 Instrument_sptr
 InstrumentDefinitionParser::parseXML(Kernel::ProgressBase *progressReporter) {
+  const bool useInstrumentCache = instrumentCacheEnabled();
+  if (useInstrumentCache && readInstrumentCache()) {
+    // The shapes still use the geometry cache for rendering
+    m_cachingOption = setupGeometryCache();
+    return m_instrument;
+  }
+
   auto pDoc = getDocument();
 
   // Get pointer to root element
@@ -279,6 +307,9 @@ InstrumentDefinitionParser::parseXML(Kernel::ProgressBase *progressReporter) {
   // (which does the final sorting).
   m_instrument->markAsDetectorFinalize();
 
+  if (useInstrumentCache)
+    writeInstrumentCache();
+
   // And give back what we created
   return m_instrument;
 }
@@ -2561,6 +2592,71 @@ InstrumentDefinitionParser::getAppliedCachingOption() const {
   return m_cachingOption;
 }
 
+/**
+Read the whole instrument from the instrument cache, from the geometry cache
+directory or else the temporary directory, rather than parsing the XML.
+@return true if the instrument was read.
+*/
+bool InstrumentDefinitionParser::readInstrumentCache() {
+  const std::string mangledName = getMangledName();
+  if (mangledName.empty())
+    return false;
+  for (const auto &filename :
+       {createInstrumentCacheFileName(),
+        instrumentCacheFallBackFileName(mangledName)}) {
+    InstrumentCache::TypeShapes typeShapes;
+    auto instrument = InstrumentCache::load(filename, mangledName, typeShapes);
+    if (instrument) {
+      g_log.information("Loading instrument from cache " + filename);
+      instrument->setFilename(m_instrument->getFilename());
+      instrument->setXmlText(m_instrument->getXmlText());
+      m_instrument = instrument;
+      mapTypeNameToShape.swap(typeShapes);
+      m_instrumentCachingOption = ReadInstrumentCache;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+Write the whole instrument to the instrument cache, in the geometry cache
+directory or else the temporary directory. An instrument which cannot be cached
+is left as it is, and will be parsed again next time.
+*/
+void InstrumentDefinitionParser::writeInstrumentCache() {
+  const std::string mangledName = getMangledName();
+  if (mangledName.empty())
+    return;
+  for (const auto &filename :
+       {createInstrumentCacheFileName(),
+        instrumentCacheFallBackFileName(mangledName)}) {
+    try {
+      InstrumentCache::save(*m_instrument, mapTypeNameToShape, mangledName,
+                            filename);
+      g_log.information("Created instrument cache in " + filename);
+      m_instrumentCachingOption = WroteInstrumentCache;
+      return;
+    } catch (std::invalid_argument &e) {
+      g_log.information() << "Instrument cannot be cached: " << e.what()
+                          << "\n";
+      return;
+    } catch (std::exception &e) {
+      g_log.information() << "Unable to write instrument cache " << filename
+                          << ": " << e.what() << "\n";
+    }
+  }
+}
+
+/**
+Getter for the applied instrument caching option.
+@return selected caching.
+*/
+InstrumentDefinitionParser::InstrumentCachingOption
+InstrumentDefinitionParser::getAppliedInstrumentCachingOption() const {
+  return m_instrumentCachingOption;
+}
+
 void InstrumentDefinitionParser::createNeutronicInstrument() {
   // Create a copy of the instrument
   auto physical = Kernel::make_unique<Instrument>(*m_instrument);
@@ -2984,6 +3080,22 @@ const std::string InstrumentDefinitionParser::createVTPFileName() {
   return retVal;
 }
 
+/** Creates the name of the instrument cache file, in the geometry cache
+ * directory, from the mangled name of the instrument definition
+ * @return the full path of the file, or empty if there is no mangled name
+ */
+const std::string InstrumentDefinitionParser::createInstrumentCacheFileName() {
+  std::string retVal;
+  std::string filename = getMangledName();
+  if (!filename.empty()) {
+    Poco::Path path(ConfigService::Instance().getVTPFileDirectory());
+    path.makeDirectory();
+    path.append(filename + ".instcache");
+    retVal = path.toString();
+  }
+  return retVal;
+}
+
 /** Return a subelement of an XML element, but also checks that there exist
  *exactly one entry
  *  of this subelement.
@@ -99,6 +99,17 @@ int SampleEnvironment::interceptSurfaces(Track &track) const {
   return nsegments;
 }
 
+/**
+ * Update many tracks with their intersections within the environment, as
+ * interceptSurfaces does for one
+ * @param tracks The tracks to update
+ */
+void SampleEnvironment::interceptSurfaces(std::vector<Track> &tracks) const {
+  for (const auto &component : m_components) {
+    component->interceptSurfaces(tracks);
+  }
+}
+
 /**
  * @param component An object defining some component of the environment
  */
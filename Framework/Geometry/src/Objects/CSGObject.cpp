@@ -1,5 +1,6 @@
 #include "MantidGeometry/Objects/CSGObject.h"
 
+#include "MantidGeometry/Objects/CompiledRule.h"
 #include "MantidGeometry/Objects/Rules.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidGeometry/Rendering/GeometryHandler.h"
@@ -18,6 +19,7 @@
 #include "MantidKernel/PseudoRandomNumberGenerator.h"
 #include "MantidKernel/Quat.h"
 #include "MantidKernel/RegexStrings.h"
+#include "MantidKernel/SmallVector.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/Tolerance.h"
 
@@ -30,6 +32,7 @@
 #include <boost/random/ranlux.hpp>
 #include <boost/random/uniform_01.hpp>
 
+#include <algorithm>
 #include <array>
 #include <deque>
 #include <iostream>
@@ -94,6 +97,8 @@ CSGObject &CSGObject::operator=(const CSGObject &A) {
 
     if (TopRule)
       createSurfaceList();
+    else
+      m_compiledRule.reset();
   }
   return *this;
 }
@@ -466,9 +471,24 @@ int CSGObject::checkSurfaceValid(const Kernel::V3D &C,
 bool CSGObject::isValid(const Kernel::V3D &point) const {
   if (!TopRule)
     return false;
+  if (m_compiledRule)
+    return m_compiledRule->isValid(point);
   return TopRule->isValid(point);
 }
 
+/**
+* Determines whether many points are within the object or on the surface
+* @param points :: Points to be tested
+* @param valid :: Set to whether each point is valid
+*/
+void CSGObject::areValid(const std::vector<Kernel::V3D> &points,
+                         std::vector<bool> &valid) const {
+  if (TopRule && m_compiledRule)
+    m_compiledRule->isValid(points, valid);
+  else
+    IObject::areValid(points, valid);
+}
+
 /**
 * Determines is group of surface maps are valid
 * @param SMap :: map of SurfaceNumber : status
@@ -521,6 +541,7 @@ int CSGObject::createSurfaceList(const int outFlag) {
       std::cerr << (*vc)->getName() << '\n';
     }
   }
+  m_compiledRule = Kernel::make_unique<CompiledRule>(TopRule.get());
   return 1;
 }
 
@@ -614,6 +635,7 @@ void CSGObject::print() const {
 void CSGObject::makeComplement() {
   std::unique_ptr<Rule> NCG = procComp(std::move(TopRule));
   TopRule = std::move(NCG);
+  m_compiledRule.reset();
 }
 
 /**
@@ -670,6 +692,7 @@ void CSGObject::write(std::ostream &OX) const {
 */
 int CSGObject::procString(const std::string &Line) {
   TopRule = nullptr;
+  m_compiledRule.reset();
   std::map<int, std::unique_ptr<Rule>> RuleList; // List for the rules
   int Ridx = 0; // Current index (not necessary size of RuleList
   // SURFACE REPLACEMENT
@@ -754,28 +777,89 @@ int CSGObject::procString(const std::string &Line) {
 */
 int CSGObject::interceptSurface(Geometry::Track &UT) const {
   int originalCount = UT.count(); // Number of intersections original track
-  // Loop over all the surfaces.
-  LineIntersectVisit LI(UT.startPoint(), UT.direction());
-  std::vector<const Surface *>::const_iterator vc;
-  for (vc = m_SurList.begin(); vc != m_SurList.end(); ++vc) {
-    (*vc)->acceptVisitor(LI);
+  interceptSurfaces(&UT, 1);
+  // Return number of track segments added
+  return (UT.count() - originalCount);
+}
+
+/**
+* Fill many tracks with their valid sections, as interceptSurface does
+* @param tracks :: Initial tracks
+*/
+void CSGObject::interceptSurfaces(std::vector<Track> &tracks) const {
+  interceptSurfaces(tracks.data(), tracks.size());
+}
+
+/**
+* Fill tracks with their valid sections. The points either side of the
+* intersections of all the tracks are tested together.
+* @param tracks :: The first track
+* @param count :: Number of tracks
+*/
+void CSGObject::interceptSurfaces(Track *tracks, const size_t count) const {
+  // Forward going intersections, and the points before and after each
+  Kernel::SmallVector<Kernel::V3D, 8> points;
+  Kernel::SmallVector<Kernel::V3D, 16> testPoints;
+  Kernel::SmallVector<size_t, 4> ends;
+  for (size_t i = 0; i < count; ++i) {
+    const Track &track = tracks[i];
+    // Loop over all the surfaces.
+    LineIntersectVisit LI(track.startPoint(), track.direction());
+    for (const auto surface : m_SurList) {
+      surface->acceptVisitor(LI);
+    }
+    const auto &IPoints(LI.getPoints());
+    const auto &dPoints(LI.getDistance());
+    // As calcValidType
+    const Kernel::V3D shift(track.direction() * Kernel::Tolerance * 25.0);
+    auto ditr = dPoints.begin();
+    auto itrEnd = IPoints.end();
+    for (auto iitr = IPoints.begin(); iitr != itrEnd; ++iitr, ++ditr) {
+      if (*ditr > 0.0) // only interested in forward going points
+      {
+        points.push_back(*iitr);
+        testPoints.push_back(*iitr - shift);
+        testPoints.push_back(*iitr + shift);
+      }
+    }
+    ends.push_back(points.size());
   }
-  const auto &IPoints(LI.getPoints());
-  const auto &dPoints(LI.getDistance());
 
-  auto ditr = dPoints.begin();
-  auto itrEnd = IPoints.end();
-  for (auto iitr = IPoints.begin(); iitr != itrEnd; ++iitr, ++ditr) {
-    if (*ditr > 0.0) // only interested in forward going points
-    {
+  // Bit i of batch b is set if test point 64 * b + i is valid
+  Kernel::SmallVector<uint64_t, 1> valid;
+  for (size_t first = 0; first < testPoints.size();
+       first += CompiledRule::BATCH_SIZE) {
+    const size_t batch =
+        std::min(CompiledRule::BATCH_SIZE, testPoints.size() - first);
+    if (m_compiledRule) {
+      valid.push_back(m_compiledRule->validMask(&testPoints[first], batch));
+    } else {
+      uint64_t mask(0);
+      for (size_t j = 0; j < batch; ++j) {
+        if (isValid(testPoints[first + j]))
+          mask |= uint64_t(1) << j;
+      }
+      valid.push_back(mask);
+    }
+  }
+  const auto isValidTest = [&valid](const size_t j) {
+    return ((valid[j / CompiledRule::BATCH_SIZE] >>
+             (j % CompiledRule::BATCH_SIZE)) &
+            1) != 0;
+  };
+
+  size_t point = 0;
+  for (size_t i = 0; i < count; ++i) {
+    Track &track = tracks[i];
+    for (; point < ends[i]; ++point) {
       // Is the point and enterance/exit Point
-      const int flag = calcValidType(*iitr, UT.direction());
-      UT.addPoint(flag, *iitr, *this);
+      const bool flagA = isValidTest(2 * point);
+      const bool flagB = isValidTest(2 * point + 1);
+      const int flag = (flagA == flagB) ? 0 : (flagA ? -1 : 1);
+      track.addPoint(flag, points[point], *this);
     }
+    track.buildLink();
   }
-  UT.buildLink();
-  // Return number of track segments added
-  return (UT.count() - originalCount);
 }
 
 /**
@@ -887,6 +971,8 @@ double CSGObject::rayTraceSolidAngle(const Kernel::V3D &observer) const {
   dtheta = thetaMax / res;
   int count = 0, countPhi;
   sum = 0.;
+  // The rays of each ring of theta are traced together
+  std::vector<Track> tracks;
   for (itheta = 1; itheta <= res; itheta++) {
     // itegrate theta from 0 to maximum from bounding box, or PI otherwise
     theta = thetaMax * (itheta - 0.5) / res;
@@ -895,18 +981,21 @@ double CSGObject::rayTraceSolidAngle(const Kernel::V3D &observer) const {
       resPhi = resPhiMin;
     dphi = 2 * M_PI / resPhi;
     countPhi = 0;
+    tracks.clear();
     for (jphi = 1; jphi <= resPhi; jphi++) {
       // integrate phi from 0 to 2*PI
       phi = 2.0 * M_PI * (jphi - 0.5) / resPhi;
       Kernel::V3D dir(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta));
       if (usePt)
         zToPt.rotate(dir);
-      if (!useBB || boundingBox.doesLineIntersect(observer, dir)) {
-        Track tr(observer, dir);
-        if (this->interceptSurface(tr) > 0) {
-          sum += dtheta * dphi * sin(theta);
-          countPhi++;
-        }
+      if (!useBB || boundingBox.doesLineIntersect(observer, dir))
+        tracks.emplace_back(observer, dir);
+    }
+    this->interceptSurfaces(tracks);
+    for (const auto &tr : tracks) {
+      if (tr.count() > 0) {
+        sum += dtheta * dphi * sin(theta);
+        countPhi++;
       }
     }
     // this break (only used in no BB defined) may be wrong if object has hole
@@ -928,14 +1017,18 @@ double CSGObject::rayTraceSolidAngle(const Kernel::V3D &observer) const {
         resPhi = resPhiMin;
       dphi = 2 * M_PI / resPhi;
       countPhi = 0;
+      tracks.clear();
       for (jphi = 1; jphi <= resPhi; jphi++) {
         phi = 2.0 * M_PI * (jphi - 0.5) / resPhi;
         Kernel::V3D dir(sin(theta) * cos(phi), sin(theta) * sin(phi),
                         cos(theta));
         if (usePt)
           zToPt.rotate(dir);
-        Track tr(observer, dir);
-        if (this->interceptSurface(tr) > 0) {
+        tracks.emplace_back(observer, dir);
+      }
+      this->interceptSurfaces(tracks);
+      for (const auto &tr : tracks) {
+        if (tr.count() > 0) {
           sum += dtheta * dphi * sin(theta);
           countPhi++;
         }
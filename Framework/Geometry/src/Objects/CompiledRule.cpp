@@ -0,0 +1,282 @@
+#include "MantidGeometry/Objects/CompiledRule.h"
+#include "MantidGeometry/Objects/Rules.h"
+#include "MantidGeometry/Surfaces/Cylinder.h"
+#include "MantidGeometry/Surfaces/Plane.h"
+#include "MantidGeometry/Surfaces/Sphere.h"
+#include "MantidKernel/Tolerance.h"
+
+#include <algorithm>
+#include <cmath>
+#include <typeinfo>
+
+namespace Mantid {
+namespace Geometry {
+
+using Kernel::Tolerance;
+using Kernel::V3D;
+
+constexpr size_t CompiledRule::BATCH_SIZE;
+
+namespace {
+/// @return the mask of the first count points of a batch
+uint64_t lanes(const size_t count) {
+  return count == CompiledRule::BATCH_SIZE ? ~uint64_t(0)
+                                           : (uint64_t(1) << count) - 1;
+}
+} // namespace
+
+/**
+ * Compile a rule and the surfaces it refers to
+ * @param rule :: the top of the rule tree, which may be null
+ */
+CompiledRule::CompiledRule(const Rule *rule) { compile(rule); }
+
+/**
+ * @param point :: a point
+ * @return true if the point is within the object or on its surface
+ */
+bool CompiledRule::isValid(const V3D &point) const {
+  return (validMask(&point, 1) & 1) != 0;
+}
+
+/**
+ * Test many points
+ * @param points :: the points
+ * @param valid :: set to whether each point is within the object or on its
+ * surface
+ */
+void CompiledRule::isValid(const std::vector<V3D> &points,
+                           std::vector<bool> &valid) const {
+  valid.resize(points.size());
+  for (size_t first = 0; first < points.size(); first += BATCH_SIZE) {
+    const size_t count = std::min(BATCH_SIZE, points.size() - first);
+    const uint64_t mask = validMask(points.data() + first, count);
+    for (size_t i = 0; i < count; ++i)
+      valid[first + i] = ((mask >> i) & 1) != 0;
+  }
+}
+
+/**
+ * Test a batch of points
+ * @param points :: the first point
+ * @param count :: the number of points, up to BATCH_SIZE
+ * @return bit i set if point i is within the object or on its surface
+ */
+uint64_t CompiledRule::validMask(const V3D *points, const size_t count) const {
+  Batch batch;
+  for (size_t i = 0; i < count; ++i) {
+    batch.x[i] = points[i].X();
+    batch.y[i] = points[i].Y();
+    batch.z[i] = points[i].Z();
+  }
+  batch.points = points;
+  batch.count = count;
+  const uint64_t all = lanes(count);
+  return evaluate(0, batch, all) & all;
+}
+
+/**
+ * Append the instructions of a rule and the rules below it, as Rule::isValid
+ * would test them
+ * @param rule :: the rule, which may be null
+ */
+void CompiledRule::compile(const Rule *rule) {
+  const auto index = m_instructions.size();
+  m_instructions.push_back(Instruction{Op::Constant, 0, 0, 0});
+  Instruction instruction{Op::Constant, 0, 0, 0};
+  if (!rule) {
+    // Never valid
+  } else if (dynamic_cast<const Intersection *>(rule)) {
+    if (rule->leaf(0) && rule->leaf(1)) {
+      instruction.op = Op::And;
+      compile(rule->leaf(0));
+      compile(rule->leaf(1));
+    }
+  } else if (dynamic_cast<const Union *>(rule)) {
+    instruction.op = Op::Or;
+    compile(rule->leaf(0));
+    compile(rule->leaf(1));
+  } else if (const auto *surfPoint = dynamic_cast<const SurfPoint *>(rule)) {
+    if (surfPoint->getKey()) {
+      instruction.op = Op::Side;
+      instruction.sign = static_cast<int8_t>(surfPoint->getSign());
+      instruction.operand = addSurface(surfPoint->getKey());
+    }
+  } else if (dynamic_cast<const CompGrp *>(rule)) {
+    if (rule->leaf(0)) {
+      instruction.op = Op::Not;
+      compile(rule->leaf(0));
+    } else {
+      instruction.operand = 1;
+    }
+  } else if (dynamic_cast<const BoolValue *>(rule)) {
+    instruction.operand = rule->isValid(V3D()) ? 1 : 0;
+  } else {
+    // e.g. a complemented object, which may change after compiling
+    instruction.op = Op::Call;
+    instruction.operand = static_cast<uint32_t>(m_calls.size());
+    m_calls.push_back(rule);
+  }
+  instruction.end = static_cast<uint32_t>(m_instructions.size());
+  m_instructions[index] = instruction;
+}
+
+/**
+ * Add a surface, unless it has been added already
+ * @param surface :: the surface
+ * @return its index
+ */
+uint32_t CompiledRule::addSurface(const Surface *surface) {
+  const auto found = std::find_if(
+      m_surfaces.cbegin(), m_surfaces.cend(),
+      [surface](const CompiledSurface &s) { return s.surface == surface; });
+  if (found != m_surfaces.cend())
+    return static_cast<uint32_t>(found - m_surfaces.cbegin());
+
+  CompiledSurface compiled{Kind::Other, 0, {0., 0., 0., 0.}, surface};
+  // Only the classes themselves, as a derived class may change the side
+  const auto &type = typeid(*surface);
+  if (type == typeid(Plane)) {
+    const auto &plane = static_cast<const Plane &>(*surface);
+    compiled.kind = Kind::Plane;
+    for (size_t i = 0; i < 3; ++i)
+      compiled.parameters[i] = plane.getNormal()[i];
+    compiled.parameters[3] = plane.getDistance();
+  } else if (type == typeid(Sphere)) {
+    const auto &sphere = static_cast<const Sphere &>(*surface);
+    compiled.kind = Kind::Sphere;
+    const V3D centre = sphere.getCentre();
+    for (size_t i = 0; i < 3; ++i)
+      compiled.parameters[i] = centre[i];
+    compiled.parameters[3] = sphere.getRadius();
+  } else if (type == typeid(Cylinder)) {
+    const auto &cylinder = static_cast<const Cylinder &>(*surface);
+    const V3D normal = cylinder.getNormal();
+    // As Cylinder::setNvec finds the axis
+    for (uint8_t i = 0; i < 3; ++i) {
+      if (std::fabs(normal[i]) > (1.0 - Tolerance)) {
+        if (cylinder.getRadius() > 0.0) {
+          compiled.kind = Kind::AxisCylinder;
+          compiled.axis = i;
+          const V3D centre = cylinder.getCentre();
+          for (size_t j = 0; j < 3; ++j)
+            compiled.parameters[j] = centre[j];
+          compiled.parameters[3] = cylinder.getRadius();
+        }
+        break;
+      }
+    }
+  }
+  m_surfaces.push_back(compiled);
+  return static_cast<uint32_t>(m_surfaces.size() - 1);
+}
+
+/**
+ * Test the points of a batch against the subtree of an instruction
+ * @param index :: the instruction
+ * @param batch :: the points
+ * @param active :: the points whose result is needed
+ * @return the mask of valid points, of which only the active ones are set
+ * reliably
+ */
+uint64_t CompiledRule::evaluate(const uint32_t index, const Batch &batch,
+                                const uint64_t active) const {
+  const Instruction &instruction = m_instructions[index];
+  switch (instruction.op) {
+  case Op::And: {
+    const uint64_t first = evaluate(index + 1, batch, active);
+    if ((first & active) == 0)
+      return 0;
+    return first & evaluate(m_instructions[index + 1].end, batch,
+                            active & first);
+  }
+  case Op::Or: {
+    const uint64_t first = evaluate(index + 1, batch, active);
+    if ((first & active) == active)
+      return first;
+    return first | evaluate(m_instructions[index + 1].end, batch,
+                            active & ~first);
+  }
+  case Op::Not:
+    return ~evaluate(index + 1, batch, active);
+  case Op::Side:
+    return sideMask(m_surfaces[instruction.operand], instruction.sign, batch);
+  case Op::Call: {
+    const Rule *rule = m_calls[instruction.operand];
+    uint64_t mask(0);
+    for (size_t i = 0; i < batch.count; ++i) {
+      if (((active >> i) & 1) && rule->isValid(batch.points[i]))
+        mask |= uint64_t(1) << i;
+    }
+    return mask;
+  }
+  case Op::Constant:
+    return instruction.operand ? ~uint64_t(0) : 0;
+  }
+  return 0;
+}
+
+/**
+ * Test the points of a batch against a side of a surface, as SurfPoint does
+ * @param surface :: the surface
+ * @param sign :: +1 for the outside of the surface, -1 for the inside
+ * @param batch :: the points
+ * @return the mask of the points on the side or on the surface
+ */
+uint64_t CompiledRule::sideMask(const CompiledSurface &surface, const int sign,
+                                const Batch &batch) const {
+  const double *p = surface.parameters;
+  const size_t count = batch.count;
+  // The sides are found exactly as by Surface::side of each class, in loops
+  // which the compiler can vectorize
+  int8_t sides[BATCH_SIZE];
+  switch (surface.kind) {
+  case Kind::Plane:
+    for (size_t i = 0; i < count; ++i) {
+      const double Dp =
+          (p[0] * batch.x[i] + p[1] * batch.y[i] + p[2] * batch.z[i]) - p[3];
+      sides[i] = static_cast<int8_t>(
+          (Tolerance < std::fabs(Dp)) ? ((Dp > 0) ? 1 : -1) : 0);
+    }
+    break;
+  case Kind::Sphere:
+    for (size_t i = 0; i < count; ++i) {
+      const double xdiff(batch.x[i] - p[0]), ydiff(batch.y[i] - p[1]),
+          zdiff(batch.z[i] - p[2]);
+      const double displace =
+          std::sqrt(xdiff * xdiff + ydiff * ydiff + zdiff * zdiff) - p[3];
+      sides[i] = static_cast<int8_t>(
+          (std::fabs(displace) < Tolerance) ? 0 : ((displace > 0.0) ? 1 : -1));
+    }
+    break;
+  case Kind::AxisCylinder: {
+    const double *coordinates[3] = {batch.x, batch.y, batch.z};
+    const size_t a = (surface.axis + 1) % 3;
+    const size_t b = (surface.axis + 2) % 3;
+    const double *u = coordinates[a];
+    const double *v = coordinates[b];
+    for (size_t i = 0; i < count; ++i) {
+      double x = u[i] - p[a];
+      x *= x;
+      double y = v[i] - p[b];
+      y *= y;
+      const double displace = x + y - p[3] * p[3];
+      sides[i] = static_cast<int8_t>((std::fabs(displace / p[3]) < Tolerance)
+                                         ? 0
+                                         : ((displace > 0.0) ? 1 : -1));
+    }
+    break;
+  }
+  case Kind::Other:
+    for (size_t i = 0; i < count; ++i)
+      sides[i] = static_cast<int8_t>(surface.surface->side(batch.points[i]));
+    break;
+  }
+  uint64_t mask(0);
+  for (size_t i = 0; i < count; ++i)
+    mask |= static_cast<uint64_t>(sides[i] * sign >= 0) << i;
+  return mask;
+}
+
+} // namespace Geometry
+} // namespace Mantid
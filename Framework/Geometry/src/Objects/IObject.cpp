@@ -0,0 +1,33 @@
+#include "MantidGeometry/Objects/IObject.h"
+#include "MantidGeometry/Objects/Track.h"
+#include "MantidKernel/V3D.h"
+
+namespace Mantid {
+namespace Geometry {
+
+/**
+ * Check whether many points are within the object or on its surface. Objects
+ * which can check points faster together override this.
+ * @param points :: the points
+ * @param valid :: set to whether each point is valid
+ */
+void IObject::areValid(const std::vector<Kernel::V3D> &points,
+                       std::vector<bool> &valid) const {
+  valid.resize(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+    valid[i] = isValid(points[i]);
+}
+
+/**
+ * Fill many tracks with their intersections with the object, as
+ * interceptSurface does. Objects which can trace rays faster together override
+ * this.
+ * @param tracks :: the tracks
+ */
+void IObject::interceptSurfaces(std::vector<Track> &tracks) const {
+  for (auto &track : tracks)
+    interceptSurface(track);
+}
+
+} // namespace Geometry
+} // namespace Mantid
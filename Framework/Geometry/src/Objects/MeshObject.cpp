@@ -10,6 +10,8 @@
 
 #include <boost/make_shared.hpp>
 
+#include <algorithm>
+
 namespace Mantid {
 namespace Geometry {
 
@@ -17,7 +19,7 @@ using Kernel::Material;
 using Kernel::V3D;
 using Kernel::Quat;
 
-MeshObject::MeshObject(const std::vector<uint16_t> &faces,
+MeshObject::MeshObject(const std::vector<uint32_t> &faces,
                        const std::vector<V3D> &vertices,
                        const Kernel::Material &material)
     : m_boundingBox(), m_id("MeshObject"), m_triangles(faces),
@@ -26,7 +28,7 @@ MeshObject::MeshObject(const std::vector<uint16_t> &faces,
   initialize();
 }
 
-MeshObject::MeshObject(std::vector<uint16_t> &&faces,
+MeshObject::MeshObject(std::vector<uint32_t> &&faces,
                        std::vector<V3D> &&vertices,
                        const Kernel::Material &&material)
     : m_boundingBox(), m_id("MeshObject"), m_triangles(std::move(faces)),
@@ -35,13 +37,37 @@ MeshObject::MeshObject(std::vector<uint16_t> &&faces,
   initialize();
 }
 
+MeshObject::MeshObject(const std::vector<uint16_t> &faces,
+                       const std::vector<V3D> &vertices,
+                       const Kernel::Material &material)
+    : m_boundingBox(), m_id("MeshObject"),
+      m_triangles(faces.begin(), faces.end()), m_vertices(vertices),
+      m_material(material) {
+
+  initialize();
+}
+
+MeshObject::MeshObject(std::vector<uint16_t> &&faces,
+                       std::vector<V3D> &&vertices,
+                       const Kernel::Material &&material)
+    : m_boundingBox(), m_id("MeshObject"),
+      m_triangles(faces.begin(), faces.end()),
+      m_vertices(std::move(vertices)), m_material(material) {
+
+  initialize();
+}
+
 // Do things that need to be done in constructor
 void MeshObject::initialize() {
 
-  if (m_vertices.size() > std::numeric_limits<uint16_t>::max()) {
+  const auto badVertex = std::find_if(
+      m_triangles.cbegin(), m_triangles.cend(),
+      [this](const uint32_t index) { return index >= m_vertices.size(); });
+  if (badVertex != m_triangles.cend()) {
     throw std::invalid_argument(
-        "Too many vertices (" + std::to_string(m_vertices.size()) +
-        "). MeshObject cannot have more than 65535 vertices.");
+        "Triangles refer to vertex " + std::to_string(*badVertex) +
+        " of a MeshObject with " + std::to_string(m_vertices.size()) +
+        " vertices.");
   }
   m_handler = boost::make_shared<GeometryHandler>(this);
 }
@@ -182,13 +208,15 @@ void MeshObject::getIntersections(const Kernel::V3D &start,
 
   V3D vertex1, vertex2, vertex3, intersection;
   int entryExit;
-  for (size_t i = 0; getTriangle(i, vertex1, vertex2, vertex3); ++i) {
+  // Only the triangles in the boxes crossed by the ray
+  bvh().forEachTriangleOnRay(start, direction, [&](const size_t i) {
+    getTriangle(i, vertex1, vertex2, vertex3);
     if (rayIntersectsTriangle(start, direction, vertex1, vertex2, vertex3,
                               intersection, entryExit)) {
       intersectionPoints.push_back(intersection);
       entryExitFlags.push_back(entryExit);
     }
-  }
+  });
   // still need to deal with edge cases
 }
 
@@ -268,6 +296,19 @@ bool MeshObject::getTriangle(const size_t index, V3D &vertex1, V3D &vertex2,
   return triangleExists;
 }
 
+/**
+* Get the bounding volume hierarchy of the triangles, which is built on the
+* first call, as many MeshObjects, e.g. scaled copies for solid angles, never
+* trace a ray.
+* @returns the hierarchy
+*/
+const TriangleBVH &MeshObject::bvh() const {
+  std::call_once(m_bvhBuilt, [this]() {
+    m_bvh = Kernel::make_unique<TriangleBVH>(m_triangles, m_vertices);
+  });
+  return *m_bvh;
+}
+
 /**
 * Find the solid angle of a triangle defined by vectors a,b,c from point
 *"observer"
@@ -610,7 +651,7 @@ std::vector<uint32_t> MeshObject::getTriangles() const {
   if (nFaceCorners > 0) {
     faces.resize(static_cast<std::size_t>(nFaceCorners));
     for (size_t i = 0; i < nFaceCorners; ++i) {
-      faces[i] = static_cast<int>(m_triangles[i]);
+      faces[i] = m_triangles[i];
     }
   }
   return faces;
@@ -0,0 +1,139 @@
+#include "MantidGeometry/Objects/TriangleBVH.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace Mantid {
+namespace Geometry {
+
+using Kernel::V3D;
+
+namespace {
+/// Maximum number of triangles in a leaf
+constexpr uint32_t MAX_LEAF_SIZE = 4;
+/// Enlargement of the boxes, relative to the size of the mesh
+constexpr double RELATIVE_PADDING = 1e-6;
+} // namespace
+
+/**
+ * Build the hierarchy of a mesh
+ * @param triangles :: the vertex indices of the triangles, three per triangle
+ * @param vertices :: the vertices
+ * @throw std::invalid_argument if a triangle refers to a missing vertex
+ */
+TriangleBVH::TriangleBVH(const std::vector<uint32_t> &triangles,
+                         const std::vector<V3D> &vertices) {
+  const size_t numberOfTriangles = triangles.size() / 3;
+  if (numberOfTriangles == 0)
+    return;
+  if (numberOfTriangles > std::numeric_limits<uint32_t>::max())
+    throw std::invalid_argument("Too many triangles for a TriangleBVH");
+
+  // The box of each triangle, and of the mesh
+  std::vector<V3D> lower(numberOfTriangles), upper(numberOfTriangles);
+  V3D meshLower(vertices.front()), meshUpper(vertices.front());
+  for (size_t i = 0; i < numberOfTriangles; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      const auto index = triangles[3 * i + j];
+      if (index >= vertices.size())
+        throw std::invalid_argument(
+            "Triangle " + std::to_string(i) + " refers to vertex " +
+            std::to_string(index) + " of " + std::to_string(vertices.size()));
+      const V3D &vertex = vertices[index];
+      for (size_t k = 0; k < 3; ++k) {
+        if (j == 0 || vertex[k] < lower[i][k])
+          lower[i][k] = vertex[k];
+        if (j == 0 || vertex[k] > upper[i][k])
+          upper[i][k] = vertex[k];
+      }
+    }
+    for (size_t k = 0; k < 3; ++k) {
+      meshLower[k] = std::min(meshLower[k], lower[i][k]);
+      meshUpper[k] = std::max(meshUpper[k], upper[i][k]);
+    }
+  }
+  const V3D extent = meshUpper - meshLower;
+  const double padding =
+      RELATIVE_PADDING *
+      std::max(std::max(extent.X(), extent.Y()), std::max(extent.Z(), 1.0));
+
+  m_triangleIndices.resize(numberOfTriangles);
+  for (size_t i = 0; i < numberOfTriangles; ++i)
+    m_triangleIndices[i] = static_cast<uint32_t>(i);
+  // A binary tree with leaves of at least half the maximum size
+  m_nodes.reserve(4 * numberOfTriangles / MAX_LEAF_SIZE + 1);
+  build(lower, upper, 0, static_cast<uint32_t>(numberOfTriangles), padding);
+}
+
+/**
+ * Build the node of a range of triangles, and the nodes below it
+ * @param lower :: the lower corner of the box of each triangle
+ * @param upper :: the upper corner of the box of each triangle
+ * @param first :: the first triangle of the range in m_triangleIndices
+ * @param count :: the number of triangles in the range
+ * @param padding :: enlargement of the boxes
+ * @return the index of the node
+ */
+uint32_t TriangleBVH::build(const std::vector<V3D> &lower,
+                            const std::vector<V3D> &upper,
+                            const uint32_t first, const uint32_t count,
+                            const double padding) {
+  Node node;
+  for (size_t k = 0; k < 3; ++k) {
+    node.min[k] = std::numeric_limits<double>::max();
+    node.max[k] = std::numeric_limits<double>::lowest();
+  }
+  for (uint32_t i = first; i < first + count; ++i) {
+    const auto triangle = m_triangleIndices[i];
+    for (size_t k = 0; k < 3; ++k) {
+      node.min[k] = std::min(node.min[k], lower[triangle][k]);
+      node.max[k] = std::max(node.max[k], upper[triangle][k]);
+    }
+  }
+  for (size_t k = 0; k < 3; ++k) {
+    node.min[k] -= padding;
+    node.max[k] += padding;
+  }
+  const auto index = static_cast<uint32_t>(m_nodes.size());
+  if (count <= MAX_LEAF_SIZE) {
+    node.first = first;
+    node.count = count;
+    m_nodes.push_back(node);
+    return index;
+  }
+
+  // Split at the median of the centres along the longest side
+  size_t axis = 0;
+  for (size_t k = 1; k < 3; ++k) {
+    if (node.max[k] - node.min[k] > node.max[axis] - node.min[axis])
+      axis = k;
+  }
+  const uint32_t half = count / 2;
+  const auto begin = m_triangleIndices.begin() + first;
+  std::nth_element(begin, begin + half, begin + count,
+                   [&](const uint32_t a, const uint32_t b) {
+                     return lower[a][axis] + upper[a][axis] <
+                            lower[b][axis] + upper[b][axis];
+                   });
+  node.count = 0;
+  m_nodes.push_back(node);
+  build(lower, upper, first, half, padding);
+  m_nodes[index].first = build(lower, upper, first + half, count - half, padding);
+  return index;
+}
+
+/**
+ * Prepare a ray for crossing boxes
+ * @param start :: start point of the ray
+ * @param direction :: direction of the ray
+ */
+TriangleBVH::Ray::Ray(const V3D &start, const V3D &direction) {
+  for (size_t i = 0; i < 3; ++i) {
+    this->start[i] = start[i];
+    this->direction[i] = direction[i];
+    this->inverse[i] = direction[i] != 0.0 ? 1.0 / direction[i] : 0.0;
+  }
+}
+
+} // namespace Geometry
+} // namespace Mantid
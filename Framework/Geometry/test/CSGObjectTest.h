@@ -629,6 +629,77 @@ public:
     TS_ASSERT_DELTA(1.0, distanceInside, 1e-10);
   }
 
+  void testAreValidMatchesIsValid() {
+    auto shell = ComponentCreationHelper::createHollowShell(0.5, 1.0);
+    std::vector<V3D> points;
+    for (int i = -60; i <= 60; ++i)
+      points.emplace_back(0.025 * i, 0.0, 0.0);
+    std::vector<bool> valid;
+    shell->areValid(points, valid);
+    TS_ASSERT_EQUALS(points.size(), valid.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      TS_ASSERT_EQUALS(shell->isValid(points[i]), valid[i]);
+    }
+    // On the outer surface, inside the hole and outside
+    TS_ASSERT(valid[100]);
+    TS_ASSERT(!valid[60]);
+    TS_ASSERT(!valid[120]);
+  }
+
+  void testIsValidFollowsChangesToTheRules() {
+    std::map<int, boost::shared_ptr<Surface>> surfaces;
+    surfaces[41] = boost::make_shared<Sphere>();
+    surfaces[41]->setSurface("so 1.0");
+    surfaces[41]->setName(41);
+    surfaces[42] = boost::make_shared<Sphere>();
+    surfaces[42]->setSurface("so 2.0");
+    surfaces[42]->setName(42);
+    CSGObject object;
+    object.setObject(41, "-41");
+    object.populate(surfaces);
+    const V3D between(1.5, 0.0, 0.0);
+    TS_ASSERT(!object.isValid(between));
+
+    object.setObject(42, "-42");
+    object.populate(surfaces);
+    TS_ASSERT(object.isValid(between));
+
+    object.makeComplement();
+    TS_ASSERT(!object.isValid(between));
+    TS_ASSERT(object.isValid(V3D(3.0, 0.0, 0.0)));
+
+    CSGObject copy;
+    copy = object;
+    TS_ASSERT(copy.isValid(V3D(3.0, 0.0, 0.0)));
+  }
+
+  void testInterceptSurfacesMatchesInterceptSurface() {
+    auto shell = ComponentCreationHelper::createHollowShell(0.5, 1.0);
+    std::vector<Track> tracks;
+    for (int i = 0; i < 50; ++i) {
+      const double angle = 0.1 * i;
+      const V3D start(-2.0, 0.02 * i, 0.0);
+      V3D direction(std::cos(angle), std::sin(angle), 0.1);
+      direction.normalize();
+      tracks.emplace_back(start, direction);
+    }
+    shell->interceptSurfaces(tracks);
+    size_t nhits(0);
+    for (const auto &track : tracks) {
+      Track single(track.startPoint(), track.direction());
+      TS_ASSERT_EQUALS(track.count(), shell->interceptSurface(single));
+      TS_ASSERT_EQUALS(track.count(), single.count());
+      for (auto link = track.cbegin(), singleLink = single.cbegin();
+           link != track.cend() && singleLink != single.cend();
+           ++link, ++singleLink) {
+        TS_ASSERT_EQUALS(link->entryPoint, singleLink->entryPoint);
+        TS_ASSERT_EQUALS(link->exitPoint, singleLink->exitPoint);
+      }
+      nhits += track.count() > 0;
+    }
+    TS_ASSERT_LESS_THAN(0, nhits);
+  }
+
   void testFindPointInCube()
   /**
   Test find point in cube
@@ -1561,6 +1632,33 @@ public:
     }
   }
 
+  void test_areValid_Composite_With_Hole() {
+    std::vector<V3D> points;
+    points.reserve(npoints);
+    for (size_t i = 0; i < npoints; ++i) {
+      points.emplace_back(rng.nextValue(-0.01, 0.01),
+                          rng.nextValue(-0.01, 0.01),
+                          rng.nextValue(-0.01, 0.01));
+    }
+    std::vector<bool> valid;
+    for (size_t i = 0; i < 50; ++i) {
+      shell->areValid(points, valid);
+    }
+  }
+
+  void test_interceptSurfaces_Composite_With_Hole() {
+    std::vector<Track> tracks;
+    tracks.reserve(npoints);
+    for (size_t i = 0; i < 10; ++i) {
+      tracks.clear();
+      for (size_t j = 0; j < npoints; ++j) {
+        const double y = -0.01 + 0.02 * static_cast<double>(j) / npoints;
+        tracks.emplace_back(V3D(-0.02, y, 0.001), V3D(1.0, 0.0, 0.0));
+      }
+      shell->interceptSurfaces(tracks);
+    }
+  }
+
 private:
   const size_t npoints = 20000;
   Mantid::Kernel::MersenneTwister rng;
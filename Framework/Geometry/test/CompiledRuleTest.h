@@ -0,0 +1,136 @@
+#ifndef MANTID_GEOMETRY_COMPILEDRULETEST_H_
+#define MANTID_GEOMETRY_COMPILEDRULETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/CompiledRule.h"
+#include "MantidGeometry/Objects/Rules.h"
+#include "MantidGeometry/Surfaces/Cone.h"
+#include "MantidGeometry/Surfaces/Cylinder.h"
+#include "MantidGeometry/Surfaces/Plane.h"
+#include "MantidKernel/make_unique.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+
+#include <boost/make_shared.hpp>
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::V3D;
+
+class CompiledRuleTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompiledRuleTest *createSuite() { return new CompiledRuleTest(); }
+  static void destroySuite(CompiledRuleTest *suite) { delete suite; }
+
+  void test_sphere_matches_rules() {
+    auto sphere = ComponentCreationHelper::createSphere(1.0, V3D(0.25, 0, 0));
+    checkAgainstRule(sphere->topRule());
+  }
+
+  void test_hollow_shell_matches_rules() {
+    auto shell = ComponentCreationHelper::createHollowShell(0.5, 1.0);
+    checkAgainstRule(shell->topRule());
+  }
+
+  void test_capped_cylinder_matches_rules() {
+    auto cylinder = ComponentCreationHelper::createCappedCylinder(
+        0.75, 1.5, V3D(0, -0.5, 0), V3D(0, 1, 0), "cyl");
+    checkAgainstRule(cylinder->topRule());
+  }
+
+  void test_cuboid_matches_rules() {
+    auto cuboid = ComponentCreationHelper::createCuboid(1.0, 1.5, 0.5);
+    checkAgainstRule(cuboid->topRule());
+  }
+
+  void test_other_surfaces_and_complemented_objects_match_rules() {
+    auto cone = boost::make_shared<Cone>();
+    cone->setSurface("k/z 0.0 0.0 0.0 0.25");
+    auto tilted = boost::make_shared<Cylinder>();
+    tilted->setSurface("c/x 0.25 0.0 0.5");
+    tilted->setNorm(V3D(1, 1, 0));
+    auto plane = boost::make_shared<Plane>();
+    plane->setSurface("px 0.5");
+    auto cylinder = ComponentCreationHelper::createCappedCylinder(
+        0.5, 1.0, V3D(-0.5, 0, 0), V3D(1, 0, 0), "cyl");
+    auto complement = Mantid::Kernel::make_unique<CompObj>();
+    complement->setObj(cylinder.get());
+
+    // (cone inside, tilted cylinder inside) : (x < 0.5, not in the cylinder)
+    auto rule = Mantid::Kernel::make_unique<Union>(
+        Mantid::Kernel::make_unique<Intersection>(surfPoint(cone, -1),
+                                                  surfPoint(tilted, -1)),
+        Mantid::Kernel::make_unique<Intersection>(surfPoint(plane, -1),
+                                                  std::move(complement)));
+    checkAgainstRule(rule.get());
+  }
+
+  void test_missing_rule_is_never_valid() {
+    CompiledRule compiled(nullptr);
+    TS_ASSERT(!compiled.isValid(V3D()));
+    const std::vector<V3D> points(3, V3D(1, 2, 3));
+    std::vector<bool> valid;
+    compiled.isValid(points, valid);
+    TS_ASSERT_EQUALS(std::vector<bool>(3, false), valid);
+  }
+
+  void test_points_are_tested_in_batches_of_any_size() {
+    auto sphere = ComponentCreationHelper::createSphere(1.0);
+    CompiledRule compiled(sphere->topRule());
+    std::vector<V3D> points;
+    for (size_t i = 0; i < 2 * CompiledRule::BATCH_SIZE + 3; ++i)
+      points.emplace_back(0.01 * static_cast<double>(i), 0, 0);
+    std::vector<bool> valid;
+    compiled.isValid(points, valid);
+    TS_ASSERT_EQUALS(points.size(), valid.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      TS_ASSERT_EQUALS(points[i].X() <= 1.0 + 1e-6, valid[i]);
+    }
+
+    // Points 98 to 102 of a batch cross the surface
+    const uint64_t mask = compiled.validMask(points.data() + 98, 5);
+    TS_ASSERT_EQUALS(uint64_t(7), mask);
+  }
+
+private:
+  static std::unique_ptr<Rule>
+  surfPoint(const boost::shared_ptr<Surface> &surface, const int sign) {
+    auto rule = Mantid::Kernel::make_unique<SurfPoint>();
+    rule->setKey(surface);
+    rule->setKeyN(sign);
+    return std::move(rule);
+  }
+
+  /// Points every 0.125 in a box, many of which lie on surfaces
+  static std::vector<V3D> grid(const V3D &minPoint, const V3D &maxPoint) {
+    std::vector<V3D> points;
+    const double step(0.125);
+    for (double x = minPoint.X(); x <= maxPoint.X(); x += step)
+      for (double y = minPoint.Y(); y <= maxPoint.Y(); y += step)
+        for (double z = minPoint.Z(); z <= maxPoint.Z(); z += step)
+          points.emplace_back(x, y, z);
+    return points;
+  }
+
+  void checkAgainstRule(const Rule *rule) {
+    CompiledRule compiled(rule);
+    const auto points = grid(V3D(-1.5, -1.5, -1.5), V3D(1.5, 1.5, 1.5));
+    std::vector<bool> valid;
+    compiled.isValid(points, valid);
+    TS_ASSERT_EQUALS(points.size(), valid.size());
+    size_t nvalid(0), nmismatched(0);
+    for (size_t i = 0; i < points.size(); ++i) {
+      const bool expected = rule->isValid(points[i]);
+      if (expected != valid[i] || expected != compiled.isValid(points[i]))
+        ++nmismatched;
+      nvalid += expected;
+    }
+    TS_ASSERT_EQUALS(nmismatched, 0);
+    TS_ASSERT_LESS_THAN(0, nvalid);
+    TS_ASSERT_LESS_THAN(nvalid, points.size());
+  }
+};
+
+#endif /* MANTID_GEOMETRY_COMPILEDRULETEST_H_ */
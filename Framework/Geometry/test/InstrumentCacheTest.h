@@ -0,0 +1,242 @@
+#ifndef MANTID_GEOMETRY_INSTRUMENTCACHETEST_H_
+#define MANTID_GEOMETRY_INSTRUMENTCACHETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/InstrumentCache.h"
+#include "MantidGeometry/Instrument/InstrumentDefinitionParser.h"
+#include "MantidGeometry/Instrument/InstrumentVisitor.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidGeometry/Instrument/ReferenceFrame.h"
+#include "MantidGeometry/Instrument/XMLInstrumentParameter.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Strings.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+#include <fstream>
+#include <set>
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::ConfigService;
+using Mantid::Kernel::V3D;
+
+class InstrumentCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static InstrumentCacheTest *createSuite() {
+    return new InstrumentCacheTest();
+  }
+  static void destroySuite(InstrumentCacheTest *suite) { delete suite; }
+
+  InstrumentCacheTest()
+      : m_filename(Poco::Path(ConfigService::Instance().getTempDir())
+                       .append("InstrumentCacheTest.instcache")
+                       .toString()) {}
+
+  void tearDown() override { removeFile(m_filename); }
+
+  void test_instrument_is_rebuilt() {
+    const auto original = parse("IDF_for_UNIT_TESTING2.xml", "UnitTesting2");
+    InstrumentCache::TypeShapes typeShapes;
+    typeShapes["monitor"] = boost::const_pointer_cast<IObject>(
+        original->getDetector(1001)->shape());
+    InstrumentCache::save(*original, typeShapes, "key", m_filename);
+
+    InstrumentCache::TypeShapes loadedShapes;
+    const auto loaded = InstrumentCache::load(m_filename, "key", loadedShapes);
+    TS_ASSERT(loaded);
+    if (!loaded)
+      return;
+    checkSameInstrument(*original, *loaded);
+
+    // The named shape is the one the monitor has
+    TS_ASSERT_EQUALS(1, loadedShapes.size());
+    TS_ASSERT_EQUALS(loaded->getDetector(1001)->shape(),
+                     loadedShapes["monitor"]);
+    const V3D monitor = loaded->getDetector(1001)->getPos();
+    TS_ASSERT(loaded->getDetector(1001)->isValid(V3D(-0.0621, 0.0641, 0.01) +
+                                                 monitor));
+    TS_ASSERT(!loaded->getDetector(1001)->isValid(
+        V3D(-0.0621, 0.0651, 0.01) + monitor));
+  }
+
+  void test_rectangular_detector_is_rebuilt() {
+    const auto original = parse("IDF_for_RECTANGULAR_UNIT_TESTING.xml",
+                                "RectangularUnitTest");
+    InstrumentCache::save(*original, {}, "key", m_filename);
+    InstrumentCache::TypeShapes typeShapes;
+    const auto loaded = InstrumentCache::load(m_filename, "key", typeShapes);
+    TS_ASSERT(loaded);
+    if (!loaded)
+      return;
+    checkSameInstrument(*original, *loaded);
+
+    const auto bank = boost::dynamic_pointer_cast<const RectangularDetector>(
+        loaded->getComponentByName("bank1"));
+    TS_ASSERT(bank);
+    if (!bank)
+      return;
+    TS_ASSERT_EQUALS(bank->nelements(), 100);
+    TS_ASSERT_EQUALS(bank->getAtXY(1, 1)->getID(), 1301);
+    TS_ASSERT_DELTA(bank->getAtXY(1, 0)->getPos().X(), -0.098, 1e-4);
+    TS_ASSERT_DELTA(bank->getAtXY(1, 1)->getPos().Y(), -0.198, 1e-4);
+  }
+
+  void test_other_key_is_not_loaded() {
+    const auto original = parse("IDF_for_UNIT_TESTING2.xml", "UnitTesting2");
+    InstrumentCache::save(*original, {}, "key", m_filename);
+    InstrumentCache::TypeShapes typeShapes;
+    TS_ASSERT(!InstrumentCache::load(m_filename, "other", typeShapes));
+  }
+
+  void test_missing_or_truncated_file_is_not_loaded() {
+    InstrumentCache::TypeShapes typeShapes;
+    TS_ASSERT(!InstrumentCache::load(m_filename, "key", typeShapes));
+
+    const auto original = parse("IDF_for_UNIT_TESTING2.xml", "UnitTesting2");
+    InstrumentCache::save(*original, {}, "key", m_filename);
+    const auto contents = Mantid::Kernel::Strings::loadFile(m_filename);
+    std::ofstream(m_filename, std::ios::binary | std::ios::trunc)
+        << contents.substr(0, contents.size() - 100);
+    TS_ASSERT(!InstrumentCache::load(m_filename, "key", typeShapes));
+    TS_ASSERT(typeShapes.empty());
+  }
+
+  void test_parser_writes_then_reads_cache() {
+    ConfigService::Instance().setString("instrumentDefinition.binaryCache",
+                                        "1");
+    const auto filename = idfFilename("IDF_for_UNIT_TESTING2.xml");
+    const auto xmlText = Mantid::Kernel::Strings::loadFile(filename);
+
+    InstrumentDefinitionParser writer(filename, "UnitTesting2", xmlText);
+    const auto cacheFilename = writer.createInstrumentCacheFileName();
+    const auto fallBackFilename =
+        Poco::Path(ConfigService::Instance().getTempDir())
+            .append(Poco::Path(cacheFilename).getFileName())
+            .toString();
+    removeFile(cacheFilename);
+    removeFile(fallBackFilename);
+    // The cache goes to the temporary directory if the first cannot be written
+    const auto original = writer.parseXML(nullptr);
+    TS_ASSERT_EQUALS(InstrumentDefinitionParser::WroteInstrumentCache,
+                     writer.getAppliedInstrumentCachingOption());
+
+    InstrumentDefinitionParser reader(filename, "UnitTesting2", xmlText);
+    const auto loaded = reader.parseXML(nullptr);
+    TS_ASSERT_EQUALS(InstrumentDefinitionParser::ReadInstrumentCache,
+                     reader.getAppliedInstrumentCachingOption());
+    checkSameInstrument(*original, *loaded);
+    TS_ASSERT_EQUALS(xmlText, loaded->getXmlText());
+
+    ConfigService::Instance().setString("instrumentDefinition.binaryCache",
+                                        "0");
+    removeFile(cacheFilename);
+    removeFile(fallBackFilename);
+  }
+
+private:
+  static std::string idfFilename(const std::string &name) {
+    return ConfigService::Instance().getInstrumentDirectory() +
+           "/IDFs_for_UNIT_TESTING/" + name;
+  }
+
+  static Instrument_sptr parse(const std::string &name,
+                               const std::string &instName) {
+    const auto filename = idfFilename(name);
+    InstrumentDefinitionParser parser(
+        filename, instName, Mantid::Kernel::Strings::loadFile(filename));
+    auto instrument = parser.parseXML(nullptr);
+    instrument->parseTreeAndCacheBeamline();
+    return instrument;
+  }
+
+  static void removeFile(const std::string &filename) {
+    Poco::File file(filename);
+    if (file.exists())
+      file.remove();
+  }
+
+  static std::multiset<std::string>
+  describeParameters(const Instrument &instrument) {
+    std::multiset<std::string> descriptions;
+    for (const auto &parameter : instrument.getLogfileCache())
+      descriptions.insert(parameter.first.first + ";" +
+                          parameter.first.second->getFullName() + ";" +
+                          parameter.second->m_value + ";" +
+                          parameter.second->m_type + ";" +
+                          parameter.second->m_formula);
+    return descriptions;
+  }
+
+  static void checkSameInstrument(const Instrument &original,
+                                  const Instrument &loaded) {
+    TS_ASSERT_EQUALS(original.getName(), loaded.getName());
+    TS_ASSERT_EQUALS(original.getValidFromDate(), loaded.getValidFromDate());
+    TS_ASSERT_EQUALS(original.getValidToDate(), loaded.getValidToDate());
+    TS_ASSERT_EQUALS(original.getDefaultView(), loaded.getDefaultView());
+    TS_ASSERT_EQUALS(original.getDefaultAxis(), loaded.getDefaultAxis());
+    TS_ASSERT_EQUALS(original.getReferenceFrame()->pointingUp(),
+                     loaded.getReferenceFrame()->pointingUp());
+    TS_ASSERT_EQUALS(original.getReferenceFrame()->pointingAlongBeam(),
+                     loaded.getReferenceFrame()->pointingAlongBeam());
+    TS_ASSERT_EQUALS(original.getReferenceFrame()->vecThetaSign(),
+                     loaded.getReferenceFrame()->vecThetaSign());
+
+    TS_ASSERT_EQUALS(original.getSource()->getName(),
+                     loaded.getSource()->getName());
+    TS_ASSERT_EQUALS(original.getSample()->getPos(),
+                     loaded.getSample()->getPos());
+    TS_ASSERT_EQUALS(original.getDetectorIDs(false),
+                     loaded.getDetectorIDs(false));
+    TS_ASSERT_EQUALS(original.getMonitors(), loaded.getMonitors());
+    for (const auto id : original.getDetectorIDs(false)) {
+      const auto detector = original.getDetector(id);
+      const auto loadedDetector = loaded.getDetector(id);
+      TS_ASSERT_EQUALS(detector->getFullName(), loadedDetector->getFullName());
+      TS_ASSERT_EQUALS(detector->getPos(), loadedDetector->getPos());
+      TS_ASSERT_EQUALS(detector->getRotation(), loadedDetector->getRotation());
+    }
+
+    // The parameters refer to the same components
+    TS_ASSERT_LESS_THAN(0, original.getLogfileCache().size());
+    TS_ASSERT_EQUALS(describeParameters(original), describeParameters(loaded));
+
+    // The beamline read from the cache matches one made by walking the tree
+    const auto walked = InstrumentVisitor::makeWrappers(loaded);
+    ParameterMap pmap;
+    const auto cached = loaded.makeBeamline(pmap);
+    const auto &componentInfo = *cached.first;
+    const auto &detectorInfo = *cached.second;
+    TS_ASSERT_EQUALS(walked.first->size(), componentInfo.size());
+    TS_ASSERT_EQUALS(walked.second->size(), detectorInfo.size());
+    for (size_t i = 0; i < componentInfo.size(); ++i) {
+      TS_ASSERT_EQUALS(walked.first->componentID(i),
+                       componentInfo.componentID(i));
+      TS_ASSERT_EQUALS(walked.first->name(i), componentInfo.name(i));
+      TS_ASSERT_EQUALS(walked.first->position(i), componentInfo.position(i));
+      TS_ASSERT_EQUALS(walked.first->hasValidShape(i),
+                       componentInfo.hasValidShape(i));
+      TS_ASSERT_EQUALS(walked.first->children(i), componentInfo.children(i));
+      TS_ASSERT_EQUALS(walked.first->componentType(i),
+                       componentInfo.componentType(i));
+    }
+    for (size_t i = 0; i < detectorInfo.size(); ++i) {
+      TS_ASSERT_EQUALS(walked.second->isMonitor(i), detectorInfo.isMonitor(i));
+      TS_ASSERT_EQUALS(walked.second->position(i), detectorInfo.position(i));
+    }
+    TS_ASSERT_EQUALS(walked.first->source(), componentInfo.source());
+    TS_ASSERT_EQUALS(walked.first->sample(), componentInfo.sample());
+  }
+
+  const std::string m_filename;
+};
+
+#endif /* MANTID_GEOMETRY_INSTRUMENTCACHETEST_H_ */
@@ -273,6 +273,47 @@ std::unique_ptr<MeshObject> createLShape() {
                      Mantid::Kernel::Material()));
   return retVal;
 }
+
+std::unique_ptr<MeshObject> createSphere(const double radius,
+                                         const size_t nRings,
+                                         const size_t nSegments) {
+  /**
+  * Create a sphere centred at the origin from nRings rings of
+  * nSegments segments, with more vertices than 16-bit faces can hold
+  * if it is fine enough.
+  */
+  std::vector<V3D> vertices;
+  vertices.emplace_back(0, 0, radius);
+  for (size_t i = 1; i < nRings; ++i) {
+    const double theta = M_PI * static_cast<double>(i) / nRings;
+    for (size_t j = 0; j < nSegments; ++j) {
+      const double phi = 2. * M_PI * static_cast<double>(j) / nSegments;
+      vertices.emplace_back(radius * std::sin(theta) * std::cos(phi),
+                            radius * std::sin(theta) * std::sin(phi),
+                            radius * std::cos(theta));
+    }
+  }
+  vertices.emplace_back(0, 0, -radius);
+  const auto southPole = static_cast<uint32_t>(vertices.size() - 1);
+  auto ring = [nSegments](const size_t i, const size_t j) {
+    return static_cast<uint32_t>(1 + (i - 1) * nSegments + j % nSegments);
+  };
+
+  std::vector<uint32_t> triangles;
+  for (size_t j = 0; j < nSegments; ++j) {
+    triangles.insert(triangles.end(), {0, ring(1, j), ring(1, j + 1)});
+    for (size_t i = 1; i + 1 < nRings; ++i) {
+      triangles.insert(triangles.end(),
+                       {ring(i, j), ring(i + 1, j), ring(i + 1, j + 1)});
+      triangles.insert(triangles.end(),
+                       {ring(i, j), ring(i + 1, j + 1), ring(i, j + 1)});
+    }
+    triangles.insert(triangles.end(),
+                     {ring(nRings - 1, j), southPole, ring(nRings - 1, j + 1)});
+  }
+  return Mantid::Kernel::make_unique<MeshObject>(
+      std::move(triangles), std::move(vertices), Mantid::Kernel::Material());
+}
 }
 
 class MeshObjectTest : public CxxTest::TestSuite {
@@ -317,11 +358,20 @@ public:
     TS_ASSERT_THROWS_NOTHING(geom_obj->clone());
   }
 
-  void testTooManyVertices() {
-    auto tooManyVertices = std::vector<V3D>(70000);
-    auto triangles = std::vector<uint16_t>(1000);
-    TS_ASSERT_THROWS_ANYTHING(
-        MeshObject(triangles, tooManyVertices, Mantid::Kernel::Material()));
+  void testMoreVerticesThan16BitFacesHold() {
+    auto vertices = std::vector<V3D>(70000);
+    auto triangles = std::vector<uint32_t>(999);
+    triangles.back() = 69999;
+    TS_ASSERT_THROWS_NOTHING(
+        MeshObject(triangles, vertices, Mantid::Kernel::Material()));
+  }
+
+  void testTriangleWithMissingVertex() {
+    auto vertices = std::vector<V3D>(4);
+    auto triangles = std::vector<uint16_t>(12);
+    triangles.back() = 4;
+    TS_ASSERT_THROWS(MeshObject(triangles, vertices, Mantid::Kernel::Material()),
+                     const std::invalid_argument &);
   }
 
   void testMaterial() {
@@ -510,6 +560,22 @@ public:
     checkTrackIntercept(std::move(geom_obj), track, expectedResults);
   }
 
+  void testInterceptFineSphere() {
+    // Over 65535 vertices
+    auto geom_obj = createSphere(2.0, 300, 300);
+    TS_ASSERT(geom_obj->numberOfVertices() > 65535);
+    // Directions clear of the vertices and edges of the rings
+    for (auto direction :
+         {V3D(1, 0.013, 0.027), V3D(0.011, 0.019, 1), V3D(0.6, 0.37, -0.8)}) {
+      direction.normalize();
+      Track track(direction * -10.0, direction);
+      TS_ASSERT_EQUALS(geom_obj->interceptSurface(track), 1);
+      TS_ASSERT_DELTA(track.front().distInsideObject, 4.0, 1e-3);
+    }
+    TS_ASSERT(geom_obj->isValid(V3D(0.5, 1.5, -0.2)));
+    TS_ASSERT(!geom_obj->isValid(V3D(0.5, 1.9, -0.5)));
+  }
+
   void testTrackTwoIsolatedCubes()
   /**
   Test a track going through two objects
@@ -1070,7 +1136,7 @@ public:
 
   MeshObjectTestPerformance()
       : rng(200000), octahedron(createOctahedron()), lShape(createLShape()),
-        smallCube(createCube(0.2)) {
+        smallCube(createCube(0.2)), fineSphere(createSphere(1.0, 300, 300)) {
     testPoints = create_test_points();
     testRays = create_test_rays();
   }
@@ -1106,6 +1172,22 @@ public:
     }
   }
 
+  void test_interceptSurface_fine_sphere() {
+    const size_t number(10000);
+    for (size_t i = 0; i < number; ++i) {
+      Track testRay(testRays[i % testRays.size()]);
+      fineSphere->interceptSurface(testRay);
+    }
+  }
+
+  void test_generatePointInside_fine_sphere() {
+    const size_t npoints(6000);
+    const size_t maxAttempts(500);
+    for (size_t i = 0; i < npoints; ++i) {
+      fineSphere->generatePointInObject(rng, maxAttempts);
+    }
+  }
+
   void test_solid_angle() {
     const size_t number(10000);
     for (size_t i = 0; i < number; ++i) {
@@ -1217,6 +1299,7 @@ private:
   std::unique_ptr<MeshObject> octahedron;
   std::unique_ptr<MeshObject> lShape;
   std::unique_ptr<MeshObject> smallCube;
+  std::unique_ptr<MeshObject> fineSphere;
   std::vector<V3D> testPoints;
   std::vector<Track> testRays;
 };
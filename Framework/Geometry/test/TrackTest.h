@@ -7,7 +7,11 @@
 #include "MantidGeometry/Instrument/Component.h"
 #include "MantidGeometry/Objects/CSGObject.h"
 #include "MantidGeometry/Objects/Track.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/V3D.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+
+#include <cmath>
 
 using namespace Mantid;
 using namespace Geometry;
@@ -129,4 +133,56 @@ public:
   }
 };
 
+class TrackTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TrackTestPerformance *createSuite() {
+    return new TrackTestPerformance();
+  }
+  static void destroySuite(TrackTestPerformance *suite) { delete suite; }
+
+  TrackTestPerformance()
+      : shell(ComponentCreationHelper::createHollowShell(0.009, 0.01)) {}
+
+  void test_trace_rays_through_a_shell() {
+    TS_ASSERT_EQUALS(traceRays(), nrays);
+  }
+
+  /// Each thread traces as many rays as the single thread above, so the time
+  /// stays the same if the throughput per thread does
+  void test_trace_rays_through_a_shell_on_every_thread() {
+    const int nthreads = PARALLEL_GET_MAX_THREADS;
+    std::vector<size_t> hits(nthreads, 0);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < nthreads; ++i) {
+      hits[i] = traceRays();
+    }
+    for (const auto nhits : hits) {
+      TS_ASSERT_EQUALS(nhits, nrays);
+    }
+  }
+
+private:
+  /// Trace rays through the centre of the shell, reusing one track
+  /// @return the number of rays crossing both walls of the shell
+  size_t traceRays() const {
+    Track track;
+    size_t nhits(0);
+    for (size_t i = 0; i < nrays; ++i) {
+      const double angle = 2. * M_PI * static_cast<double>(i) /
+                           static_cast<double>(nrays);
+      const V3D direction(std::cos(angle), std::sin(angle), 0.);
+      track.reset(direction * -0.1, direction);
+      track.clearIntersectionResults();
+      if (shell->interceptSurface(track) == 2)
+        ++nhits;
+    }
+    return nhits;
+  }
+
+  const size_t nrays = 200000;
+  IObject_sptr shell;
+};
+
 #endif
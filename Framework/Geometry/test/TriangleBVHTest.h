@@ -0,0 +1,94 @@
+#ifndef MANTID_GEOMETRY_TRIANGLEBVHTEST_H_
+#define MANTID_GEOMETRY_TRIANGLEBVHTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidGeometry/Objects/TriangleBVH.h"
+
+#include <cmath>
+#include <set>
+
+using Mantid::Geometry::TriangleBVH;
+using Mantid::Kernel::V3D;
+
+class TriangleBVHTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TriangleBVHTest *createSuite() { return new TriangleBVHTest(); }
+  static void destroySuite(TriangleBVHTest *suite) { delete suite; }
+
+  TriangleBVHTest() {
+    // A grid of n by n squares in the z = 0 plane, each of two triangles
+    const uint32_t n = 20;
+    for (uint32_t i = 0; i <= n; ++i) {
+      for (uint32_t j = 0; j <= n; ++j)
+        m_vertices.emplace_back(i, j, 0);
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+      for (uint32_t j = 0; j < n; ++j) {
+        const uint32_t corner = i * (n + 1) + j;
+        m_triangles.insert(m_triangles.end(),
+                           {corner, corner + n + 1, corner + n + 2});
+        m_triangles.insert(m_triangles.end(),
+                           {corner, corner + n + 2, corner + 1});
+      }
+    }
+  }
+
+  void test_ray_visits_only_the_triangles_near_it() {
+    TriangleBVH bvh(m_triangles, m_vertices);
+    TS_ASSERT(bvh.numberOfNodes() > 1);
+    // Down through the square at (3, 7)
+    const auto visited = visit(bvh, V3D(3.5, 7.25, 1), V3D(0, 0, -1));
+    TS_ASSERT(visited.count(2 * (3 * 20 + 7)));
+    // A few leaves of the 800 triangles
+    TS_ASSERT_LESS_THAN_EQUALS(visited.size(), 16);
+  }
+
+  void test_ray_visits_every_triangle_it_crosses() {
+    TriangleBVH bvh(m_triangles, m_vertices);
+    // Through a vertex shared by six triangles, along a diagonal and in
+    // the plane of the grid
+    auto visited = visit(bvh, V3D(5, 5, 1), V3D(0, 0, -1));
+    for (const size_t triangle : {168, 169, 170, 209, 210, 211})
+      TS_ASSERT(visited.count(triangle));
+    visited = visit(bvh, V3D(-1, -1, -1), V3D(1, 1, 1) * (1. / std::sqrt(3.)));
+    TS_ASSERT(visited.count(0));
+    visited = visit(bvh, V3D(-1, 2.5, 0), V3D(1, 0, 0));
+    for (size_t i = 0; i < 20; ++i)
+      TS_ASSERT(visited.count(2 * (i * 20 + 2)));
+  }
+
+  void test_ray_behind_or_beside_the_mesh_visits_nothing() {
+    TriangleBVH bvh(m_triangles, m_vertices);
+    TS_ASSERT(visit(bvh, V3D(3.5, 7.25, -1), V3D(0, 0, -1)).empty());
+    TS_ASSERT(visit(bvh, V3D(21, 7.25, 1), V3D(0, 0, -1)).empty());
+    TS_ASSERT(visit(bvh, V3D(-1, 2.5, 0.1), V3D(1, 0, 0)).empty());
+  }
+
+  void test_empty_mesh() {
+    TriangleBVH bvh({}, {});
+    TS_ASSERT_EQUALS(bvh.numberOfNodes(), 0);
+    TS_ASSERT(visit(bvh, V3D(), V3D(1, 0, 0)).empty());
+  }
+
+  void test_missing_vertex_throws() {
+    TS_ASSERT_THROWS(TriangleBVH({0, 1, 3}, {V3D(), V3D(1, 0, 0), V3D()}),
+                     const std::invalid_argument &);
+  }
+
+private:
+  std::set<size_t> visit(const TriangleBVH &bvh, const V3D &start,
+                         const V3D &direction) {
+    std::set<size_t> visited;
+    bvh.forEachTriangleOnRay(start, direction,
+                             [&visited](const size_t i) { visited.insert(i); });
+    return visited;
+  }
+
+  std::vector<uint32_t> m_triangles;
+  std::vector<V3D> m_vertices;
+};
+
+#endif /* MANTID_GEOMETRY_TRIANGLEBVHTEST_H_ */
@@ -0,0 +1,145 @@
+#ifndef MANTID_KERNEL_ASYNCBLOCKIO_H_
+#define MANTID_KERNEL_ASYNCBLOCKIO_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/**
+AsyncBlockIO : Runs the reads and writes of blocks of a file on a thread of
+its own, so that the threads using the file do not wait for it.
+
+Positions and sizes are in units of a fixed number of bytes, e.g. events, as
+used by DiskBuffer. The file itself is accessed through the functions given
+on construction, which are only ever called from the I/O thread.
+
+- Writes are queued with a copy of their data and performed in order. Writes
+  come before reads, as they hold memory and may hold up a reader.
+- Blocks can be asked for ahead of their use, in the order they will be used.
+  Each request starts a stream of its own, so that several readers may read
+  ahead at once. Adjacent blocks are read together in runs as large as the
+  buffer allows. Taking a block from a run drops the runs of the stream before
+  it, which are taken to have been skipped, and frees the run once all of it
+  has been taken.
+- A block which overlaps a queued write is only read, or taken from a run,
+  once the write is done, so readers always see the latest data.
+
+Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+National Laboratory & European Spallation Source
+
+This file is part of Mantid.
+
+Mantid is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+
+Mantid is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+File change history is stored at: <https://github.com/mantidproject/mantid>
+Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL AsyncBlockIO {
+public:
+  /// Reads a block of a position and size into a buffer
+  using Reader = std::function<void(uint64_t, uint64_t, char *)>;
+  /// Writes a block of a position and size from a buffer
+  using Writer = std::function<void(uint64_t, uint64_t, char *)>;
+  /// Makes the writes so far reach the file
+  using Flusher = std::function<void()>;
+
+  AsyncBlockIO(const size_t unitSize, Reader reader, Writer writer,
+               Flusher flusher, const size_t bufferSize = 256 * 1024 * 1024);
+  AsyncBlockIO(const AsyncBlockIO &) = delete;
+  AsyncBlockIO &operator=(const AsyncBlockIO &) = delete;
+  ~AsyncBlockIO();
+
+  size_t readAhead(const std::vector<std::pair<uint64_t, uint64_t>> &blocks);
+  bool takeReadAhead(const uint64_t position, const uint64_t size,
+                     char *data);
+  void clearReadAhead(const size_t stream);
+
+  void write(const uint64_t position, const uint64_t size,
+             std::vector<char> data);
+  void flush();
+  void wait();
+
+private:
+  /// Adjacent blocks read together
+  struct Run {
+    enum State { Queued, Reading, Ready };
+    /// The read-ahead request the run belongs to
+    size_t stream;
+    uint64_t position;
+    uint64_t size;
+    /// Number of units taken by readers
+    uint64_t taken;
+    State state;
+    /// Whether the run was given up, while it was being read
+    bool dropped;
+    std::vector<char> data;
+  };
+  /// A queued write, or flush if it has no size
+  struct Write {
+    uint64_t position;
+    uint64_t size;
+    std::vector<char> data;
+  };
+
+  void ioLoop();
+  std::shared_ptr<Run> nextRunToRead() const;
+  bool overlapsWrite(const uint64_t position, const uint64_t size) const;
+  void dropRun(Run &run);
+  void rethrowError();
+
+  /// Bytes per unit of position or size
+  const size_t m_unitSize;
+  const Reader m_reader;
+  const Writer m_writer;
+  const Flusher m_flusher;
+  /// Bytes of read-ahead, and of queued writes, to buffer at most
+  const size_t m_bufferSize;
+
+  /// Guards everything below
+  std::mutex m_mutex;
+  /// Signals any change to the runs or writes
+  std::condition_variable m_changed;
+  /// Runs to read or ready to take, in the order they will be used
+  std::deque<std::shared_ptr<Run>> m_runs;
+  /// Bytes of runs being read or ready
+  size_t m_readAheadBytes;
+  /// The stream of the next read-ahead request
+  size_t m_nextStream;
+  /// Writes to do, the first of which may be in progress
+  std::deque<Write> m_writes;
+  /// Bytes of the queued writes
+  size_t m_writeBytes;
+  /// The first error of a write or flush, thrown to the next caller
+  std::exception_ptr m_error;
+  /// Set to finish the writes and stop
+  bool m_stop;
+  std::thread m_thread;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_ASYNCBLOCKIO_H_ */
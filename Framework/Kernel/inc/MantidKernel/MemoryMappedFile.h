@@ -0,0 +1,81 @@
+#ifndef MANTID_KERNEL_MEMORYMAPPEDFILE_H_
+#define MANTID_KERNEL_MEMORYMAPPEDFILE_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <cstddef>
+#include <string>
+
+namespace Mantid {
+namespace Kernel {
+
+/**
+MemoryMappedFile : A temporary scratch file mapped into the address space of
+the process. The whole capacity is mapped once, so pointers into the mapping
+stay valid for the lifetime of the object. Where the platform allows it the
+file is sparse and is removed as soon as it is created, so it only takes disk
+space for the pages written and disappears when the object is destroyed.
+
+Pages written through the mapping are owned by the operating system's page
+cache rather than by the process: advise() tells the kernel which ranges are
+about to be read or are no longer needed, which lets data far larger than
+physical memory be streamed through the mapping.
+
+Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+National Laboratory & European Spallation Source
+
+This file is part of Mantid.
+
+Mantid is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+
+Mantid is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+File change history is stored at: <https://github.com/mantidproject/mantid>.
+Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL MemoryMappedFile {
+public:
+  /// How a range of the mapping is about to be used
+  enum class Advice { Normal, Sequential, WillNeed, DontNeed };
+
+  MemoryMappedFile(const std::string &directory, const size_t capacity);
+  ~MemoryMappedFile();
+  MemoryMappedFile(const MemoryMappedFile &) = delete;
+  MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+  /// @return the start of the mapping
+  char *data() const { return m_data; }
+  /// @return the size of the mapping in bytes
+  size_t capacity() const { return m_capacity; }
+  void advise(const size_t offset, const size_t length,
+              const Advice advice) const;
+
+private:
+  /// Start of the mapping
+  char *m_data;
+  /// Size of the mapping in bytes
+  size_t m_capacity;
+#ifdef _WIN32
+  /// Handle of the file
+  void *m_file;
+  /// Handle of the file mapping object
+  void *m_mapping;
+#else
+  /// File descriptor of the file
+  int m_fd;
+#endif
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_MEMORYMAPPEDFILE_H_ */
@@ -0,0 +1,247 @@
+#ifndef MANTID_KERNEL_SMALLVECTOR_H_
+#define MANTID_KERNEL_SMALLVECTOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Mantid {
+namespace Kernel {
+
+/**
+SmallVector : A sequence container which holds up to N elements within the
+object itself, and more on the heap, so that short sequences are built without
+any allocation. Clearing it keeps the heap memory, if any, for reuse.
+
+It has the interface of std::vector that is needed for short ordered
+sequences: inserting or erasing shifts the elements after, and invalidates
+the iterators to them, as for std::vector.
+
+Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+National Laboratory & European Spallation Source
+
+This file is part of Mantid.
+
+Mantid is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+
+Mantid is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+File change history is stored at: <https://github.com/mantidproject/mantid>
+Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+template <typename T, size_t N> class SmallVector {
+  static_assert(N > 0, "SmallVector needs room for at least one element");
+
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  SmallVector() noexcept : m_data(inlineData()), m_size(0), m_capacity(N) {}
+
+  /// Construct from a range of elements
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  SmallVector(InputIt first, InputIt last) : SmallVector() {
+    for (; first != last; ++first)
+      push_back(*first);
+  }
+
+  SmallVector(const SmallVector &other) : SmallVector() {
+    reserve(other.m_size);
+    std::uninitialized_copy(other.begin(), other.end(), m_data);
+    m_size = other.m_size;
+  }
+
+  SmallVector(SmallVector &&other) noexcept(
+      std::is_nothrow_move_constructible<T>::value)
+      : SmallVector() {
+    takeFrom(other);
+  }
+
+  SmallVector &operator=(const SmallVector &other) {
+    if (this != &other) {
+      clear();
+      reserve(other.m_size);
+      std::uninitialized_copy(other.begin(), other.end(), m_data);
+      m_size = other.m_size;
+    }
+    return *this;
+  }
+
+  SmallVector &operator=(SmallVector &&other) noexcept(
+      std::is_nothrow_move_constructible<T>::value) {
+    if (this != &other) {
+      clear();
+      freeHeap();
+      takeFrom(other);
+    }
+    return *this;
+  }
+
+  ~SmallVector() {
+    clear();
+    freeHeap();
+  }
+
+  iterator begin() noexcept { return m_data; }
+  iterator end() noexcept { return m_data + m_size; }
+  const_iterator begin() const noexcept { return m_data; }
+  const_iterator end() const noexcept { return m_data + m_size; }
+  const_iterator cbegin() const noexcept { return m_data; }
+  const_iterator cend() const noexcept { return m_data + m_size; }
+
+  reference operator[](const size_type i) { return m_data[i]; }
+  const_reference operator[](const size_type i) const { return m_data[i]; }
+  reference front() { return m_data[0]; }
+  const_reference front() const { return m_data[0]; }
+  reference back() { return m_data[m_size - 1]; }
+  const_reference back() const { return m_data[m_size - 1]; }
+
+  size_type size() const noexcept { return m_size; }
+  bool empty() const noexcept { return m_size == 0; }
+  size_type capacity() const noexcept { return m_capacity; }
+  /// @return true if the elements are held within the object
+  bool isInline() const noexcept { return m_data == inlineData(); }
+
+  /// Remove all the elements, keeping the memory
+  void clear() noexcept {
+    for (size_type i = 0; i < m_size; ++i)
+      m_data[i].~T();
+    m_size = 0;
+  }
+
+  void reserve(const size_type n) {
+    if (n > m_capacity)
+      grow(n);
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args> reference emplace_back(Args &&... args) {
+    if (m_size == m_capacity) {
+      // The arguments may refer to an element, which growing would move
+      T value(std::forward<Args>(args)...);
+      grow(2 * m_capacity);
+      new (m_data + m_size) T(std::move(value));
+    } else {
+      new (m_data + m_size) T(std::forward<Args>(args)...);
+    }
+    return m_data[m_size++];
+  }
+
+  /** Insert an element before a position
+   * @param pos :: the position
+   * @param value :: the element
+   * @return the position of the element inserted
+   */
+  iterator insert(const_iterator pos, const T &value) {
+    const auto index = static_cast<size_type>(pos - m_data);
+    // The value may be an element, which would be moved
+    T copy(value);
+    if (m_size == m_capacity)
+      grow(2 * m_capacity);
+    if (index == m_size) {
+      new (m_data + m_size) T(std::move(copy));
+    } else {
+      new (m_data + m_size) T(std::move(m_data[m_size - 1]));
+      std::move_backward(m_data + index, m_data + m_size - 1,
+                         m_data + m_size);
+      m_data[index] = std::move(copy);
+    }
+    ++m_size;
+    return m_data + index;
+  }
+
+  /** Erase an element
+   * @param pos :: the position of the element
+   * @return the position of the element after the one erased
+   */
+  iterator erase(const_iterator pos) {
+    const auto it = m_data + (pos - m_data);
+    std::move(it + 1, end(), it);
+    --m_size;
+    m_data[m_size].~T();
+    return it;
+  }
+
+private:
+  T *inlineData() noexcept { return reinterpret_cast<T *>(&m_inline); }
+  const T *inlineData() const noexcept {
+    return reinterpret_cast<const T *>(&m_inline);
+  }
+
+  /// Move the elements to heap memory of a larger capacity
+  void grow(const size_type n) {
+    T *data = static_cast<T *>(::operator new(n * sizeof(T)));
+    try {
+      std::uninitialized_copy(std::make_move_iterator(begin()),
+                              std::make_move_iterator(end()), data);
+    } catch (...) {
+      ::operator delete(data);
+      throw;
+    }
+    const size_type size = m_size;
+    clear();
+    freeHeap();
+    m_data = data;
+    m_size = size;
+    m_capacity = n;
+  }
+
+  /// Free the heap memory, if any, once the elements are destroyed
+  void freeHeap() noexcept {
+    if (!isInline()) {
+      ::operator delete(m_data);
+      m_data = inlineData();
+      m_capacity = N;
+    }
+  }
+
+  /// Take the elements of another vector into this empty one
+  void takeFrom(SmallVector &other) {
+    if (other.isInline()) {
+      std::uninitialized_copy(std::make_move_iterator(other.begin()),
+                              std::make_move_iterator(other.end()), m_data);
+      m_size = other.m_size;
+      other.clear();
+    } else {
+      m_data = other.m_data;
+      m_size = other.m_size;
+      m_capacity = other.m_capacity;
+      other.m_data = other.inlineData();
+      other.m_size = 0;
+      other.m_capacity = N;
+    }
+  }
+
+  typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type m_inline;
+  T *m_data;
+  size_type m_size;
+  size_type m_capacity;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_SMALLVECTOR_H_ */
@@ -0,0 +1,93 @@
+#ifndef MANTID_KERNEL_TIMESERIESINDEX_H_
+#define MANTID_KERNEL_TIMESERIESINDEX_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/**
+TimeSeriesIndex : A search structure over a time series of numbers sorted by
+time, built once and queried many times.
+
+The series is taken as a step function: each value holds from its time until
+the next entry, the first value also holds before the first time and the last
+value after the last time. Entries sharing a time last for no time at all, so
+the last of them holds.
+
+Two structures are kept next to copies of the times and values:
+- the running integral of the value over time at each entry, so that the
+  integral over any window costs two binary searches;
+- the range of the values in blocks of entries, and in blocks of those blocks,
+  so that a search for the next value inside or outside a range of values
+  skips whole blocks that cannot contain one.
+
+Copyright &copy; 2018 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+National Laboratory & European Spallation Source
+
+This file is part of Mantid.
+
+Mantid is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+
+Mantid is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+File change history is stored at: <https://github.com/mantidproject/mantid>
+Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL TimeSeriesIndex {
+public:
+  TimeSeriesIndex(std::vector<int64_t> times, std::vector<double> values);
+
+  /// @return the number of entries
+  size_t size() const { return m_times.size(); }
+  /// @return the time of an entry in nanoseconds
+  int64_t time(const size_t i) const { return m_times[i]; }
+  /// @return the value of an entry
+  double value(const size_t i) const { return m_values[i]; }
+
+  double integrate(const int64_t start, const int64_t stop) const;
+
+  size_t nextInRange(const size_t first, const double min,
+                     const double max) const;
+  size_t nextOutOfRange(const size_t first, const double min,
+                        const double max) const;
+
+private:
+  /// The range of the values of a block of entries
+  struct ValueRange {
+    double min;
+    double max;
+    bool hasNaN;
+  };
+
+  double integralTo(const int64_t time) const;
+  template <class Match, class MayMatch>
+  size_t find(size_t first, Match match, MayMatch mayMatch) const;
+
+  /// Times of the entries in nanoseconds
+  std::vector<int64_t> m_times;
+  /// Values of the entries
+  std::vector<double> m_values;
+  /// Integral of the value in value-seconds from the first entry to each entry
+  std::vector<double> m_integral;
+  /// Ranges of blocks of entries, then of blocks of those ranges, and so on
+  std::vector<std::vector<ValueRange>> m_ranges;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_TIMESERIESINDEX_H_ */
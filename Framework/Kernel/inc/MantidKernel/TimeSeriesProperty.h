@@ -9,6 +9,9 @@
 #include "MantidKernel/ITimeSeriesProperty.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/Statistics.h"
+
+#include <boost/shared_ptr.hpp>
+
 #include <cstdint>
 #include <utility>
 
@@ -21,6 +24,7 @@ namespace Mantid {
 namespace Kernel {
 class DataItem;
 class SplittingInterval;
+class TimeSeriesIndex;
 
 enum TimeSeriesSortStatus { TSUNKNOWN, TSUNSORTED, TSSORTED };
 
@@ -333,6 +337,8 @@ private:
   std::string setValueFromProperty(const Property &right) override;
   /// Find if time lies in a filtered region
   bool isTimeFiltered(const Types::Core::DateAndTime &time) const;
+  /// The search structure over the sorted values, built on first use
+  boost::shared_ptr<const TimeSeriesIndex> timeIndex() const;
 
   /// Holds the time series data
   mutable std::vector<TimeValueUnit<TYPE>> m_values;
@@ -350,6 +356,9 @@ private:
   mutable std::vector<std::pair<size_t, size_t>> m_filterQuickRef;
   /// True if a filter has been applied
   mutable bool m_filterApplied;
+  /// Search structure over the values, only accessed atomically by const
+  /// methods. Reset whenever the values change.
+  mutable boost::shared_ptr<const TimeSeriesIndex> m_index;
 };
 
 /// Function filtering double TimeSeriesProperties according to the requested
@@ -183,6 +183,23 @@ public:
    */
   virtual double singleFromTOF(const double tof) const = 0;
 
+  /** Convert a range of X values to TOF. The unit must be initialized.
+   * @param first :: the first value to convert
+   * @param last :: one past the last value to convert
+   * @param result :: where to write the TOFs, which may be first
+   */
+  virtual void batchToTOF(const double *first, const double *last,
+                          double *result) const;
+
+  /** Convert a range of tof values to this unit. The unit must be
+   * initialized.
+   * @param first :: the first tof to convert
+   * @param last :: one past the last tof to convert
+   * @param result :: where to write the values, which may be first
+   */
+  virtual void batchFromTOF(const double *first, const double *last,
+                            double *result) const;
+
   /// @return true if the unit was initialized and so can use singleToTOF()
   bool isInitialized() const { return initialized; }
 
@@ -303,6 +320,10 @@ public:
   void init() override;
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void batchToTOF(const double *first, const double *last,
+                  double *result) const override;
+  void batchFromTOF(const double *first, const double *last,
+                    double *result) const override;
   Unit *clone() const override;
   ///@return -DBL_MAX as ToF convertible to TOF for in any time range
   double conversionTOFMin() const override;
@@ -320,6 +341,10 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void batchToTOF(const double *first, const double *last,
+                  double *result) const override;
+  void batchFromTOF(const double *first, const double *last,
+                    double *result) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -347,6 +372,10 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void batchToTOF(const double *first, const double *last,
+                  double *result) const override;
+  void batchFromTOF(const double *first, const double *last,
+                    double *result) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -394,6 +423,10 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void batchToTOF(const double *first, const double *last,
+                  double *result) const override;
+  void batchFromTOF(const double *first, const double *last,
+                    double *result) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -444,6 +477,10 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void batchToTOF(const double *first, const double *last,
+                  double *result) const override;
+  void batchFromTOF(const double *first, const double *last,
+                    double *result) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -489,6 +526,10 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void batchToTOF(const double *first, const double *last,
+                  double *result) const override;
+  void batchFromTOF(const double *first, const double *last,
+                    double *result) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -548,6 +589,10 @@ public:
 
   double singleToTOF(const double ki) const override;
   double singleFromTOF(const double tof) const override;
+  void batchToTOF(const double *first, const double *last,
+                  double *result) const override;
+  void batchFromTOF(const double *first, const double *last,
+                    double *result) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -574,6 +619,10 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void batchToTOF(const double *first, const double *last,
+                  double *result) const override;
+  void batchFromTOF(const double *first, const double *last,
+                    double *result) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -593,6 +642,10 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void batchToTOF(const double *first, const double *last,
+                  double *result) const override;
+  void batchFromTOF(const double *first, const double *last,
+                    double *result) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
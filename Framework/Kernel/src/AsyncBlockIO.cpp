@@ -0,0 +1,307 @@
+#include "MantidKernel/AsyncBlockIO.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Mantid {
+namespace Kernel {
+
+/** Constructor, which starts the I/O thread
+ * @param unitSize :: bytes per unit of position or size
+ * @param reader :: reads a block
+ * @param writer :: writes a block
+ * @param flusher :: makes the writes reach the file
+ * @param bufferSize :: bytes of read-ahead, and of queued writes, to buffer
+ * at most
+ */
+AsyncBlockIO::AsyncBlockIO(const size_t unitSize, Reader reader, Writer writer,
+                           Flusher flusher, const size_t bufferSize)
+    : m_unitSize(unitSize), m_reader(std::move(reader)),
+      m_writer(std::move(writer)), m_flusher(std::move(flusher)),
+      m_bufferSize(bufferSize), m_readAheadBytes(0), m_nextStream(1),
+      m_writeBytes(0), m_stop(false) {
+  m_thread = std::thread(&AsyncBlockIO::ioLoop, this);
+}
+
+/// Destructor, which drops the read-ahead and waits for the queued writes
+AsyncBlockIO::~AsyncBlockIO() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &run : m_runs)
+      dropRun(*run);
+    m_runs.clear();
+    m_stop = true;
+  }
+  m_changed.notify_all();
+  m_thread.join();
+}
+
+/** Ask for blocks to be read ahead of their use
+ * @param blocks :: the positions and sizes of the blocks, in the order they
+ * will be used
+ * @return the stream of the blocks, to clear when they are no longer needed
+ */
+size_t AsyncBlockIO::readAhead(
+    const std::vector<std::pair<uint64_t, uint64_t>> &blocks) {
+  // Runs of up to a quarter of the buffer, so that one is read while others
+  // are used
+  const uint64_t maxRunSize =
+      std::max(uint64_t(1), static_cast<uint64_t>(m_bufferSize / 4 /
+                                                  std::max(m_unitSize,
+                                                           size_t(1))));
+  size_t stream;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    stream = m_nextStream++;
+  }
+  std::vector<std::shared_ptr<Run>> runs;
+  for (const auto &block : blocks) {
+    if (block.second == 0)
+      continue;
+    if (!runs.empty()) {
+      Run &last = *runs.back();
+      if (last.position + last.size == block.first &&
+          last.size + block.second <= maxRunSize) {
+        last.size += block.second;
+        continue;
+      }
+    }
+    runs.push_back(std::make_shared<Run>(
+        Run{stream, block.first, block.second, 0, Run::Queued, false, {}}));
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_runs.insert(m_runs.end(), runs.begin(), runs.end());
+  }
+  m_changed.notify_all();
+  return stream;
+}
+
+/** Take a block read ahead. Waits for any queued write overlapping the block,
+ * and for the run holding the block if it is still to be read.
+ *
+ * @param position :: position of the block
+ * @param size :: size of the block
+ * @param data :: buffer of size * unitSize bytes, filled if the block is taken
+ * @return true if the block was taken, false if it must be read by the caller
+ */
+bool AsyncBlockIO::takeReadAhead(const uint64_t position, const uint64_t size,
+                                 char *data) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_changed.wait(lock, [&] { return !overlapsWrite(position, size); });
+
+  auto found = std::find_if(
+      m_runs.begin(), m_runs.end(), [&](const std::shared_ptr<Run> &run) {
+        return run->position <= position &&
+               position + size <= run->position + run->size;
+      });
+  if (found == m_runs.end())
+    return false;
+  const std::shared_ptr<Run> run = *found;
+  // The runs of the stream before were skipped, and their memory may be
+  // holding this one up
+  const auto end = std::remove_if(
+      m_runs.begin(), found, [&](const std::shared_ptr<Run> &skipped) {
+        if (skipped->stream != run->stream)
+          return false;
+        dropRun(*skipped);
+        return true;
+      });
+  m_runs.erase(end, found);
+  m_changed.notify_all();
+
+  m_changed.wait(lock,
+                 [&] { return run->dropped || run->state == Run::Ready; });
+  if (run->dropped)
+    return false;
+  std::memcpy(data, run->data.data() + (position - run->position) * m_unitSize,
+              static_cast<size_t>(size) * m_unitSize);
+  run->taken += size;
+  if (run->taken >= run->size) {
+    dropRun(*run);
+    m_runs.erase(std::find(m_runs.begin(), m_runs.end(), run));
+    m_changed.notify_all();
+  }
+  return true;
+}
+
+/** Drop the read-ahead of a stream, e.g. when its reader stops or the order
+ * of use changes
+ * @param stream :: the stream returned by readAhead
+ */
+void AsyncBlockIO::clearReadAhead(const size_t stream) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto end = std::remove_if(
+        m_runs.begin(), m_runs.end(), [&](const std::shared_ptr<Run> &run) {
+          if (run->stream != stream)
+            return false;
+          dropRun(*run);
+          return true;
+        });
+    m_runs.erase(end, m_runs.end());
+  }
+  m_changed.notify_all();
+}
+
+/** Queue a write, waiting while the queued writes fill the buffer
+ * @param position :: position of the block
+ * @param size :: size of the block
+ * @param data :: the size * unitSize bytes to write
+ */
+void AsyncBlockIO::write(const uint64_t position, const uint64_t size,
+                         std::vector<char> data) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  rethrowError();
+  m_changed.wait(lock, [&] {
+    return m_writeBytes == 0 || m_writeBytes + data.size() <= m_bufferSize;
+  });
+  m_writeBytes += data.size();
+  m_writes.push_back(Write{position, size, std::move(data)});
+  lock.unlock();
+  m_changed.notify_all();
+}
+
+/// Queue a flush after the queued writes
+void AsyncBlockIO::flush() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_writes.push_back(Write{0, 0, {}});
+  }
+  m_changed.notify_all();
+}
+
+/** Wait for the queued writes and flushes
+ * @throw the first error of a write or flush since the last call
+ */
+void AsyncBlockIO::wait() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_changed.wait(lock, [&] { return m_writes.empty(); });
+  rethrowError();
+}
+
+/// The body of the I/O thread
+void AsyncBlockIO::ioLoop() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_changed.wait(lock, [&] {
+      return m_stop || !m_writes.empty() || nextRunToRead() != nullptr;
+    });
+
+    if (!m_writes.empty()) {
+      // The first write stays queued until done, so that readers wait for it
+      Write &write = m_writes.front();
+      lock.unlock();
+      try {
+        if (write.size == 0)
+          m_flusher();
+        else
+          m_writer(write.position, write.size, write.data.data());
+      } catch (...) {
+        std::lock_guard<std::mutex> errorLock(m_mutex);
+        if (!m_error)
+          m_error = std::current_exception();
+      }
+      lock.lock();
+      // Runs read before the write are out of date
+      if (write.size != 0) {
+        for (auto it = m_runs.begin(); it != m_runs.end();) {
+          Run &run = **it;
+          if (run.state == Run::Ready &&
+              run.position < write.position + write.size &&
+              write.position < run.position + run.size) {
+            dropRun(run);
+            it = m_runs.erase(it);
+          } else {
+            ++it;
+          }
+        }
+      }
+      m_writeBytes -= write.data.size();
+      m_writes.pop_front();
+      m_changed.notify_all();
+      continue;
+    }
+
+    const std::shared_ptr<Run> run = nextRunToRead();
+    if (run) {
+      run->state = Run::Reading;
+      const size_t bytes = static_cast<size_t>(run->size) * m_unitSize;
+      m_readAheadBytes += bytes;
+      lock.unlock();
+      std::vector<char> data(bytes);
+      bool isRead = true;
+      try {
+        m_reader(run->position, run->size, data.data());
+      } catch (...) {
+        // The reader of the block gets the error when reading it itself
+        isRead = false;
+      }
+      lock.lock();
+      if (run->dropped || !isRead) {
+        m_readAheadBytes -= bytes;
+        if (!run->dropped) {
+          run->dropped = true;
+          m_runs.erase(std::find(m_runs.begin(), m_runs.end(), run));
+        }
+      } else {
+        run->data.swap(data);
+        run->state = Run::Ready;
+      }
+      m_changed.notify_all();
+      continue;
+    }
+
+    if (m_stop)
+      return;
+  }
+}
+
+/** @return the first queued run, if the buffer has room for it or holds no
+ * other read-ahead, or null
+ */
+std::shared_ptr<AsyncBlockIO::Run> AsyncBlockIO::nextRunToRead() const {
+  if (m_stop)
+    return nullptr;
+  for (const auto &run : m_runs) {
+    if (run->state != Run::Queued)
+      continue;
+    const size_t bytes = static_cast<size_t>(run->size) * m_unitSize;
+    if (m_readAheadBytes == 0 || m_readAheadBytes + bytes <= m_bufferSize)
+      return run;
+    return nullptr;
+  }
+  return nullptr;
+}
+
+/// @return true if a block overlaps a queued write
+bool AsyncBlockIO::overlapsWrite(const uint64_t position,
+                                 const uint64_t size) const {
+  return std::any_of(m_writes.begin(), m_writes.end(), [&](const Write &w) {
+    return w.size != 0 && w.position < position + size &&
+           position < w.position + w.size;
+  });
+}
+
+/** Give up a run, freeing its memory unless it is being read, in which case
+ * the I/O thread frees it. The caller removes it from the runs.
+ */
+void AsyncBlockIO::dropRun(Run &run) {
+  if (run.state == Run::Ready)
+    m_readAheadBytes -= run.data.size();
+  run.dropped = true;
+  run.data.clear();
+  run.data.shrink_to_fit();
+}
+
+/// Throw the stored error of a write, once
+void AsyncBlockIO::rethrowError() {
+  if (m_error) {
+    std::exception_ptr error = m_error;
+    m_error = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace Kernel
+} // namespace Mantid
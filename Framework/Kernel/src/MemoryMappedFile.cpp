@@ -0,0 +1,157 @@
+#include "MantidKernel/MemoryMappedFile.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Build the message of an exception for a failed system call
+std::string systemError(const std::string &what) {
+  return "MemoryMappedFile: " + what + " failed: " + std::strerror(errno);
+}
+} // namespace
+
+#ifdef _WIN32
+
+/** Create a scratch file and map it
+ * @param directory :: the directory to create the file in
+ * @param capacity :: the size of the file in bytes
+ * @throw std::runtime_error if the file cannot be created or mapped
+ */
+MemoryMappedFile::MemoryMappedFile(const std::string &directory,
+                                   const size_t capacity)
+    : m_data(nullptr), m_capacity(capacity), m_file(INVALID_HANDLE_VALUE),
+      m_mapping(nullptr) {
+  char path[MAX_PATH];
+  if (GetTempFileNameA(directory.c_str(), "mtd", 0, path) == 0)
+    throw std::runtime_error("MemoryMappedFile: cannot create a file in " +
+                             directory);
+  m_file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                       CREATE_ALWAYS,
+                       FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+                       nullptr);
+  if (m_file == INVALID_HANDLE_VALUE)
+    throw std::runtime_error("MemoryMappedFile: cannot open " +
+                             std::string(path));
+  const auto size = static_cast<unsigned long long>(capacity);
+  m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READWRITE,
+                                 static_cast<DWORD>(size >> 32),
+                                 static_cast<DWORD>(size & 0xFFFFFFFF),
+                                 nullptr);
+  if (m_mapping)
+    m_data = static_cast<char *>(
+        MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, capacity));
+  if (!m_data) {
+    if (m_mapping)
+      CloseHandle(m_mapping);
+    CloseHandle(m_file);
+    throw std::runtime_error("MemoryMappedFile: cannot map " +
+                             std::string(path));
+  }
+}
+
+/// Unmap and delete the file
+MemoryMappedFile::~MemoryMappedFile() {
+  UnmapViewOfFile(m_data);
+  CloseHandle(m_mapping);
+  CloseHandle(m_file);
+}
+
+/** Tell the operating system how a range will be used. Only DontNeed has an
+ * effect on Windows, where the range is taken out of the working set.
+ * @param offset :: start of the range in bytes
+ * @param length :: length of the range in bytes
+ * @param advice :: the expected use
+ */
+void MemoryMappedFile::advise(const size_t offset, const size_t length,
+                              const Advice advice) const {
+  if (advice == Advice::DontNeed && length > 0)
+    VirtualUnlock(m_data + offset, length);
+}
+
+#else
+
+/** Create a scratch file and map it
+ * @param directory :: the directory to create the file in
+ * @param capacity :: the size of the file in bytes
+ * @throw std::runtime_error if the file cannot be created or mapped
+ */
+MemoryMappedFile::MemoryMappedFile(const std::string &directory,
+                                   const size_t capacity)
+    : m_data(nullptr), m_capacity(capacity), m_fd(-1) {
+  const std::string pattern = directory + "/mantid-scratch-XXXXXX";
+  std::vector<char> path(pattern.begin(), pattern.end());
+  path.push_back('\0');
+  m_fd = mkstemp(path.data());
+  if (m_fd < 0)
+    throw std::runtime_error(systemError("creating a file in " + directory));
+  // Nothing else needs the name: the file goes once it is closed
+  unlink(path.data());
+  // A file extended this way is sparse
+  if (ftruncate(m_fd, static_cast<off_t>(capacity)) != 0) {
+    const auto message = systemError("resizing the scratch file");
+    close(m_fd);
+    throw std::runtime_error(message);
+  }
+  void *data =
+      mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (data == MAP_FAILED) {
+    const auto message = systemError("mapping the scratch file");
+    close(m_fd);
+    throw std::runtime_error(message);
+  }
+  m_data = static_cast<char *>(data);
+}
+
+/// Unmap and close the file, which deletes it
+MemoryMappedFile::~MemoryMappedFile() {
+  munmap(m_data, m_capacity);
+  close(m_fd);
+}
+
+/** Tell the operating system how a range will be used. The range is widened
+ * to whole pages.
+ * @param offset :: start of the range in bytes
+ * @param length :: length of the range in bytes
+ * @param advice :: the expected use
+ */
+void MemoryMappedFile::advise(const size_t offset, const size_t length,
+                              const Advice advice) const {
+  if (length == 0)
+    return;
+  static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t start = offset - offset % pageSize;
+  int flag = MADV_NORMAL;
+  switch (advice) {
+  case Advice::Normal:
+    break;
+  case Advice::Sequential:
+    flag = MADV_SEQUENTIAL;
+    break;
+  case Advice::WillNeed:
+    flag = MADV_WILLNEED;
+    break;
+  case Advice::DontNeed:
+    flag = MADV_DONTNEED;
+    break;
+  }
+  // This is only a hint, so failures are ignored
+  madvise(m_data + start, offset + length - start, flag);
+}
+
+#endif
+
+} // namespace Kernel
+} // namespace Mantid
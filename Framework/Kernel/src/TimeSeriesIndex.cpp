@@ -0,0 +1,171 @@
+#include "MantidKernel/TimeSeriesIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Number of entries, or of ranges, summarised by one range
+const size_t BLOCK_SIZE = 64;
+} // namespace
+
+/** Constructor
+ * @param times :: the times of the entries in nanoseconds, sorted
+ * @param values :: the values of the entries
+ * @throw std::invalid_argument if the series is empty or the sizes differ
+ */
+TimeSeriesIndex::TimeSeriesIndex(std::vector<int64_t> times,
+                                 std::vector<double> values)
+    : m_times(std::move(times)), m_values(std::move(values)) {
+  if (m_times.empty() || m_times.size() != m_values.size())
+    throw std::invalid_argument("TimeSeriesIndex: the series must be non-empty "
+                                "with one value per time");
+
+  m_integral.resize(m_times.size());
+  m_integral[0] = 0.;
+  for (size_t i = 1; i < m_times.size(); ++i)
+    m_integral[i] =
+        m_integral[i - 1] +
+        m_values[i - 1] *
+            (static_cast<double>(m_times[i] - m_times[i - 1]) * 1e-9);
+
+  // Summarise the values, then the summaries, until one block is left
+  std::vector<ValueRange> entries(m_values.size());
+  for (size_t i = 0; i < m_values.size(); ++i) {
+    const bool isNaN = std::isnan(m_values[i]);
+    entries[i].min = isNaN ? std::numeric_limits<double>::infinity()
+                           : m_values[i];
+    entries[i].max = isNaN ? -std::numeric_limits<double>::infinity()
+                           : m_values[i];
+    entries[i].hasNaN = isNaN;
+  }
+  const std::vector<ValueRange> *below = &entries;
+  while (below->size() > BLOCK_SIZE) {
+    std::vector<ValueRange> level((below->size() + BLOCK_SIZE - 1) /
+                                  BLOCK_SIZE);
+    for (size_t i = 0; i < level.size(); ++i) {
+      const auto begin = below->begin() + i * BLOCK_SIZE;
+      const auto end =
+          below->begin() + std::min(below->size(), (i + 1) * BLOCK_SIZE);
+      level[i] = *begin;
+      for (auto range = begin + 1; range != end; ++range) {
+        level[i].min = std::min(level[i].min, range->min);
+        level[i].max = std::max(level[i].max, range->max);
+        level[i].hasNaN = level[i].hasNaN || range->hasNaN;
+      }
+    }
+    m_ranges.push_back(std::move(level));
+    below = &m_ranges.back();
+  }
+}
+
+/** Integrate the value over a window of time
+ * @param start :: start of the window in nanoseconds
+ * @param stop :: end of the window in nanoseconds
+ * @return the integral in value-seconds
+ */
+double TimeSeriesIndex::integrate(const int64_t start,
+                                  const int64_t stop) const {
+  return integralTo(stop) - integralTo(start);
+}
+
+/** Find the next entry whose value is in a range
+ * @param first :: the entry to start looking from
+ * @param min :: the lowest value in the range
+ * @param max :: the highest value in the range
+ * @return the index of the entry, or size() if there is none
+ */
+size_t TimeSeriesIndex::nextInRange(const size_t first, const double min,
+                                    const double max) const {
+  return find(first,
+              [min, max](const double value) {
+                return value >= min && value <= max;
+              },
+              [min, max](const ValueRange &range) {
+                return range.max >= min && range.min <= max;
+              });
+}
+
+/** Find the next entry whose value is outside a range. NaN is outside any
+ * range.
+ * @param first :: the entry to start looking from
+ * @param min :: the lowest value in the range
+ * @param max :: the highest value in the range
+ * @return the index of the entry, or size() if there is none
+ */
+size_t TimeSeriesIndex::nextOutOfRange(const size_t first, const double min,
+                                       const double max) const {
+  return find(first,
+              [min, max](const double value) {
+                return !(value >= min && value <= max);
+              },
+              [min, max](const ValueRange &range) {
+                return range.hasNaN || range.min < min || range.max > max;
+              });
+}
+
+/** Integral of the value from the first entry to a time, which is negative
+ * before the first entry
+ * @param time :: the time in nanoseconds
+ * @return the integral in value-seconds
+ */
+double TimeSeriesIndex::integralTo(const int64_t time) const {
+  // The last entry at or before the time holds at the time
+  const auto next = std::upper_bound(m_times.begin(), m_times.end(), time);
+  const size_t entry = next == m_times.begin()
+                           ? 0
+                           : static_cast<size_t>(next - m_times.begin()) - 1;
+  return m_integral[entry] +
+         m_values[entry] *
+             (static_cast<double>(time - m_times[entry]) * 1e-9);
+}
+
+/** Find the next entry that matches, skipping the blocks whose range rules
+ * out a match
+ * @param first :: the entry to start looking from
+ * @param match :: tells whether a value matches
+ * @param mayMatch :: tells whether a block with a range may hold a match
+ * @return the index of the entry, or size() if there is none
+ */
+template <class Match, class MayMatch>
+size_t TimeSeriesIndex::find(size_t first, Match match,
+                             MayMatch mayMatch) const {
+  // Level 0 are the entries, level l > 0 the ranges in m_ranges[l - 1]
+  size_t level = 0;
+  size_t position = first;
+  while (true) {
+    const size_t count =
+        level == 0 ? m_values.size() : m_ranges[level - 1].size();
+    if (position >= count)
+      return m_values.size();
+    // Look through the rest of the current block of this level
+    const size_t blockEnd =
+        std::min(count, (position / BLOCK_SIZE + 1) * BLOCK_SIZE);
+    for (; position < blockEnd; ++position) {
+      if (level == 0 ? match(m_values[position])
+                     : mayMatch(m_ranges[level - 1][position]))
+        break;
+    }
+    if (position < blockEnd) {
+      if (level == 0)
+        return position;
+      // Look inside the block that may hold a match
+      --level;
+      position *= BLOCK_SIZE;
+    } else {
+      if (blockEnd == count)
+        return m_values.size();
+      // Nothing in this block: carry on from the next block one level up
+      ++level;
+      position = blockEnd / BLOCK_SIZE;
+    }
+  }
+}
+
+} // namespace Kernel
+} // namespace Mantid
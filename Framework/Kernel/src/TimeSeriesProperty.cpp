@@ -2,10 +2,12 @@
 #include "MantidKernel/EmptyValues.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/TimeSeriesIndex.h"
 #include "MantidKernel/TimeSplitter.h"
 #include "MantidKernel/make_unique.h"
 #include <nexus/NeXusFile.hpp>
 
+#include <boost/make_shared.hpp>
 #include <boost/regex.hpp>
 
 namespace Mantid {
@@ -138,6 +140,7 @@ operator+=(Property const *right) {
       m_values.insert(m_values.end(), rhs->m_values.begin(),
                       rhs->m_values.end());
       m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+      m_index.reset();
     } else {
       // Do nothing if appending yourself to yourself. The net result would be
       // the same anyway
@@ -309,6 +312,7 @@ void TimeSeriesProperty<TYPE>::filterByTime(
 
   // 4. Make size consistent
   m_size = static_cast<int>(m_values.size());
+  m_index.reset();
 }
 
 /**
@@ -386,6 +390,7 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
   mp_copy.clear();
 
   m_size = static_cast<int>(m_values.size());
+  m_index.reset();
 }
 
 /**
@@ -421,6 +426,7 @@ void TimeSeriesProperty<TYPE>::splitByTime(
         dynamic_cast<TimeSeriesProperty<TYPE> *>(outputs[i]);
     if (myOutput) {
       outputs_tsp.push_back(myOutput);
+      myOutput->m_index.reset();
       if (this->m_values.size() == 1) {
         // Special case for TSP with a single entry = just copy.
         myOutput->m_values = this->m_values;
@@ -727,52 +733,31 @@ void TimeSeriesProperty<TYPE>::makeFilterByValue(
   if (m_values.empty())
     return;
 
-  // 1. Sort
-  sortIfNecessary();
-
-  // 2. Do the rest
-  bool lastGood(false);
-  time_duration tol = DateAndTime::durationFromSeconds(TimeTolerance);
-  int numgood = 0;
-  DateAndTime t;
-  DateAndTime start, stop;
-
-  for (size_t i = 0; i < m_values.size(); ++i) {
-    const DateAndTime lastTime = t;
-    // The new entry
-    t = m_values[i].time();
-    TYPE val = m_values[i].value();
-
-    // A good value?
-    const bool isGood = ((val >= min) && (val <= max));
-    if (isGood)
-      numgood++;
-
-    if (isGood != lastGood) {
-      // We switched from bad to good or good to bad
-
-      if (isGood) {
-        // Start of a good section. Subtract tolerance from the time if
-        // boundaries are centred.
-        start = centre ? t - tol : t;
-      } else {
-        // End of the good section. Add tolerance to the LAST GOOD time if
-        // boundaries are centred.
-        // Otherwise, use the first 'bad' time.
-        stop = centre ? lastTime + tol : t;
-        split.emplace_back(start, stop, 0);
-        // Reset the number of good ones, for next time
-        numgood = 0;
-      }
-      lastGood = isGood;
+  const auto indexPtr = timeIndex();
+  const TimeSeriesIndex &index = *indexPtr;
+  const time_duration tol = DateAndTime::durationFromSeconds(TimeTolerance);
+  const size_t numValues = index.size();
+
+  // Jump from the start of each run of good values to its end
+  size_t first = index.nextInRange(0, min, max);
+  while (first < numValues) {
+    // Start of a good section. Subtract tolerance from the time if boundaries
+    // are centred.
+    const DateAndTime firstTime(index.time(first));
+    const DateAndTime start = centre ? firstTime - tol : firstTime;
+    const size_t bad = index.nextOutOfRange(first + 1, min, max);
+    if (bad == numValues) {
+      // The log ended on "good" so we need to close it using the last time
+      split.emplace_back(start, DateAndTime(index.time(numValues - 1)) + tol,
+                         0);
+      break;
     }
-  }
-
-  if (numgood > 0) {
-    // The log ended on "good" so we need to close it using the last time we
-    // found
-    stop = t + tol;
+    // End of the good section. Add tolerance to the LAST GOOD time if
+    // boundaries are centred. Otherwise, use the first 'bad' time.
+    const DateAndTime stop = centre ? DateAndTime(index.time(bad - 1)) + tol
+                                    : DateAndTime(index.time(bad));
     split.emplace_back(start, stop, 0);
+    first = index.nextInRange(bad + 1, min, max);
   }
 }
 
@@ -873,31 +858,16 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(
     return static_cast<double>(m_values.front().value());
   }
 
-  sortIfNecessary();
+  const auto indexPtr = timeIndex();
+  const TimeSeriesIndex &index = *indexPtr;
 
   double numerator(0.0), totalTime(0.0);
   // Loop through the filter ranges
   for (const auto &time : filter) {
     // Calculate the total time duration (in seconds) within by the filter
     totalTime += time.duration();
-
-    // Get the log value and index at the start time of the filter
-    int index;
-    double value = getSingleValue(time.start(), index);
-    DateAndTime startTime = time.start();
-
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
-      ++index;
-      numerator +=
-          DateAndTime::secondsFromDuration(m_values[index].time() - startTime) *
-          value;
-      startTime = m_values[index].time();
-      value = static_cast<double>(m_values[index].value());
-    }
-
-    // Now close off with the end of the current filter range
-    numerator +=
-        DateAndTime::secondsFromDuration(time.stop() - startTime) * value;
+    numerator += index.integrate(time.start().totalNanoseconds(),
+                                 time.stop().totalNanoseconds());
   }
 
   // 'Normalise' by the total time
@@ -953,9 +923,13 @@ TimeSeriesProperty<TYPE>::valueAsCorrectMap() const {
   // 2. Data Strcture
   std::map<DateAndTime, TYPE> asMap;
 
-  if (!m_values.empty()) {
-    for (size_t i = 0; i < m_values.size(); i++)
-      asMap[m_values[i].time()] = m_values[i].value();
+  // The values are sorted, so each one goes at the end of the map. Of the
+  // values sharing a time, the last one is kept.
+  for (const auto &entry : m_values) {
+    if (!asMap.empty() && asMap.rbegin()->first == entry.time())
+      asMap.rbegin()->second = entry.value();
+    else
+      asMap.emplace_hint(asMap.end(), entry.time(), entry.value());
   }
 
   return asMap;
@@ -1050,6 +1024,7 @@ void TimeSeriesProperty<TYPE>::addValue(const Types::Core::DateAndTime &time,
   m_values.push_back(newvalue);
   // Increment the separate record of the property's size
   m_size++;
+  m_index.reset();
 
   // Toggle the sorted flag if necessary
   // (i.e. if the flag says we're sorted and the added time is before the prior
@@ -1110,6 +1085,7 @@ void TimeSeriesProperty<TYPE>::addValues(
   for (size_t i = 0; i < length; ++i) {
     m_values.emplace_back(times[i], values[i]);
   }
+  m_index.reset();
 
   if (!values.empty())
     m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
@@ -1323,6 +1299,7 @@ TimeSeriesProperty<TYPE>::setDataItem(const boost::shared_ptr<DataItem>) {
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
   m_size = 0;
   m_values.clear();
+  m_index.reset();
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   m_filterApplied = false;
@@ -1915,6 +1892,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
 
   // update m_size
   countSize();
+  m_index.reset();
 
   // 3. Finish
   g_log.warning() << "Log " << this->name() << " has " << numremoved
@@ -1958,6 +1936,7 @@ void TimeSeriesProperty<TYPE>::sortIfNecessary() const {
         "TimeSeriesProperty is not sorted.  Sorting is operated on it. ");
     std::stable_sort(m_values.begin(), m_values.end());
     m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
+    m_index.reset();
   }
 }
 
@@ -2210,6 +2189,7 @@ TimeSeriesProperty<TYPE>::setValueFromProperty(const Property &right) {
   m_filter = prop->m_filter;
   m_filterQuickRef = prop->m_filterQuickRef;
   m_filterApplied = prop->m_filterApplied;
+  m_index = boost::atomic_load(&prop->m_index);
   return "";
 }
 
@@ -2402,6 +2382,51 @@ bool TimeSeriesProperty<TYPE>::isTimeFiltered(
   return filterEntry->second;
 }
 
+/**
+ * The search structure over the values, sorted by time. It is built on first
+ * use and kept until the values change. It holds the times and values again
+ * as 64-bit integers and doubles, plus a running integral, so it takes about
+ * 24 bytes per entry on top of the log itself.
+ *
+ * Several threads may ask for the index of an unchanging log at once: the
+ * pointer is only read and set atomically, and should two threads build the
+ * index, the first one stored is kept. Each caller holds on to the index it
+ * gets, so it stays valid while it is used.
+ * @returns :: the index
+ */
+template <typename TYPE>
+boost::shared_ptr<const TimeSeriesIndex>
+TimeSeriesProperty<TYPE>::timeIndex() const {
+  sortIfNecessary();
+  auto index = boost::atomic_load(&m_index);
+  if (index)
+    return index;
+  std::vector<int64_t> times;
+  std::vector<double> values;
+  times.reserve(m_values.size());
+  values.reserve(m_values.size());
+  for (const auto &entry : m_values) {
+    times.push_back(entry.time().totalNanoseconds());
+    values.push_back(static_cast<double>(entry.value()));
+  }
+  auto built = boost::make_shared<const TimeSeriesIndex>(std::move(times),
+                                                         std::move(values));
+  // On failure, index is set to the one another thread stored
+  if (boost::atomic_compare_exchange(&m_index, &index, built))
+    return built;
+  return index;
+}
+
+/** Function specialization for TimeSeriesProperty<std::string>
+ *  @throws Kernel::Exception::NotImplementedError always
+ */
+template <>
+boost::shared_ptr<const TimeSeriesIndex>
+TimeSeriesProperty<std::string>::timeIndex() const {
+  throw Exception::NotImplementedError("TimeSeriesProperty::timeIndex is not "
+                                       "implemented for string properties");
+}
+
 /**
  * Get a list of the splitting intervals, if filtering is enabled.
  * Otherwise the interval is just first time - last time.
@@ -5,7 +5,10 @@
 #include "MantidKernel/Unit.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/UnitLabelTypes.h"
+#include <algorithm>
 #include <cfloat>
+#include <cmath>
+#include <cstddef>
 
 namespace Mantid {
 namespace Kernel {
@@ -138,9 +141,7 @@ void Unit::toTOF(std::vector<double> &xdata, std::vector<double> &ydata,
                  const double &_delta) {
   UNUSED_ARG(ydata);
   this->initialize(_l1, _l2, _twoTheta, _emode, _efixed, _delta);
-  size_t numX = xdata.size();
-  for (size_t i = 0; i < numX; i++)
-    xdata[i] = this->singleToTOF(xdata[i]);
+  this->batchToTOF(xdata.data(), xdata.data() + xdata.size(), xdata.data());
 }
 
 /** Convert a single value to TOF
@@ -169,9 +170,7 @@ void Unit::fromTOF(std::vector<double> &xdata, std::vector<double> &ydata,
                    const double &_efixed, const double &_delta) {
   UNUSED_ARG(ydata);
   this->initialize(_l1, _l2, _twoTheta, _emode, _efixed, _delta);
-  size_t numX = xdata.size();
-  for (size_t i = 0; i < numX; i++)
-    xdata[i] = this->singleFromTOF(xdata[i]);
+  this->batchFromTOF(xdata.data(), xdata.data() + xdata.size(), xdata.data());
 }
 
 /** Convert a single value from TOF
@@ -191,6 +190,30 @@ double Unit::convertSingleFromTOF(const double xvalue, const double &l1,
   return this->singleFromTOF(xvalue);
 }
 
+/** Convert a range of X values to TOF one at a time. Units override this
+ * with a loop the compiler can vectorise.
+ * @param first :: the first value to convert
+ * @param last :: one past the last value to convert
+ * @param result :: where to write the TOFs, which may be first
+ */
+void Unit::batchToTOF(const double *first, const double *last,
+                      double *result) const {
+  for (; first != last; ++first, ++result)
+    *result = this->singleToTOF(*first);
+}
+
+/** Convert a range of tof values to this unit one at a time. Units override
+ * this with a loop the compiler can vectorise.
+ * @param first :: the first tof to convert
+ * @param last :: one past the last tof to convert
+ * @param result :: where to write the values, which may be first
+ */
+void Unit::batchFromTOF(const double *first, const double *last,
+                        double *result) const {
+  for (; first != last; ++first, ++result)
+    *result = this->singleFromTOF(*first);
+}
+
 std::pair<double, double> Unit::conversionRange() const {
   double u1 = this->singleFromTOF(this->conversionTOFMin());
   double u2 = this->singleFromTOF(this->conversionTOFMax());
@@ -287,6 +310,18 @@ double TOF::singleFromTOF(const double tof) const {
   return tof;
 }
 
+void TOF::batchToTOF(const double *first, const double *last,
+                     double *result) const {
+  if (result != first)
+    std::copy(first, last, result);
+}
+
+void TOF::batchFromTOF(const double *first, const double *last,
+                       double *result) const {
+  if (result != first)
+    std::copy(first, last, result);
+}
+
 Unit *TOF::clone() const { return new TOF(*this); }
 double TOF::conversionTOFMin() const { return -DBL_MAX; }
 ///@return DBL_MAX as ToF convetanble to TOF for in any time range
@@ -395,6 +430,25 @@ double Wavelength::singleFromTOF(const double tof) const {
   x *= factorFrom;
   return x;
 }
+
+void Wavelength::batchToTOF(const double *first, const double *last,
+                            double *result) const {
+  const double factor = factorTo;
+  // If Direct or Indirect we want to correct TOF values..
+  const double shift = (emode == 1 || emode == 2) ? sfpTo : 0.;
+  const auto size = last - first;
+  for (std::ptrdiff_t i = 0; i < size; ++i)
+    result[i] = first[i] * factor + shift;
+}
+
+void Wavelength::batchFromTOF(const double *first, const double *last,
+                              double *result) const {
+  const double factor = factorFrom;
+  const double shift = do_sfpFrom ? sfpFrom : 0.;
+  const auto size = last - first;
+  for (std::ptrdiff_t i = 0; i < size; ++i)
+    result[i] = (first[i] - shift) * factor;
+}
 ///@return  Minimal time of flight, which can be reversively converted into
 /// wavelength
 double Wavelength::conversionTOFMin() const {
@@ -471,6 +525,28 @@ double Energy::singleFromTOF(const double tof) const {
   return factorFrom / (temp * temp);
 }
 
+void Energy::batchToTOF(const double *first, const double *last,
+                        double *result) const {
+  const double factor = factorTo;
+  const auto size = last - first;
+  for (std::ptrdiff_t i = 0; i < size; ++i) {
+    // Protect against divide by zero
+    const double x = first[i] == 0.0 ? DBL_MIN : first[i];
+    result[i] = factor / std::sqrt(x);
+  }
+}
+
+void Energy::batchFromTOF(const double *first, const double *last,
+                          double *result) const {
+  const double factor = factorFrom;
+  const auto size = last - first;
+  for (std::ptrdiff_t i = 0; i < size; ++i) {
+    // Protect against divide by zero
+    const double tof = first[i] == 0.0 ? DBL_MIN : first[i];
+    result[i] = factor / (tof * tof);
+  }
+}
+
 Unit *Energy::clone() const { return new Energy(*this); }
 
 // ============================================================================================
@@ -577,6 +653,22 @@ double dSpacing::singleToTOF(const double x) const { return x * factorTo; }
 double dSpacing::singleFromTOF(const double tof) const {
   return tof / factorFrom;
 }
+
+void dSpacing::batchToTOF(const double *first, const double *last,
+                          double *result) const {
+  const double factor = factorTo;
+  const auto size = last - first;
+  for (std::ptrdiff_t i = 0; i < size; ++i)
+    result[i] = first[i] * factor;
+}
+
+void dSpacing::batchFromTOF(const double *first, const double *last,
+                            double *result) const {
+  const double factor = factorFrom;
+  const auto size = last - first;
+  for (std::ptrdiff_t i = 0; i < size; ++i)
+    result[i] = first[i] / factor;
+}
 double dSpacing::conversionTOFMin() const { return 0; }
 double dSpacing::conversionTOFMax() const { return DBL_MAX / factorTo; }
 
@@ -688,6 +780,28 @@ double MomentumTransfer::singleFromTOF(const double tof) const {
   return factorFrom / temp;
 }
 
+void MomentumTransfer::batchToTOF(const double *first, const double *last,
+                                  double *result) const {
+  const double factor = factorTo;
+  const auto size = last - first;
+  for (std::ptrdiff_t i = 0; i < size; ++i) {
+    // Protect against divide by zero
+    const double x = first[i] == 0.0 ? DBL_MIN : first[i];
+    result[i] = factor / x;
+  }
+}
+
+void MomentumTransfer::batchFromTOF(const double *first, const double *last,
+                                    double *result) const {
+  const double factor = factorFrom;
+  const auto size = last - first;
+  for (std::ptrdiff_t i = 0; i < size; ++i) {
+    // Protect against divide by zero
+    const double tof = first[i] == 0.0 ? DBL_MIN : first[i];
+    result[i] = factor / tof;
+  }
+}
+
 double MomentumTransfer::conversionTOFMin() const {
   return factorFrom / DBL_MAX;
 }
@@ -861,6 +975,46 @@ double DeltaE::singleFromTOF(const double tof) const {
     return DBL_MAX;
 }
 
+void DeltaE::batchToTOF(const double *first, const double *last,
+                        double *result) const {
+  const auto size = last - first;
+  const double tofMax = DeltaE::conversionTOFMax();
+  if (emode != 1 && emode != 2) {
+    std::fill(result, result + size, tofMax);
+    return;
+  }
+  // Direct geometry fixes the initial energy, indirect the final one
+  const double sign = emode == 1 ? -1. : 1.;
+  const double factor = factorTo;
+  const double fixed = efixed;
+  const double scaling = unitScaling;
+  const double other = t_other;
+  for (std::ptrdiff_t i = 0; i < size; ++i) {
+    const double energy = fixed + sign * (first[i] / scaling);
+    // This shouldn't ever be <= 0 (unless the efixed value is wrong)
+    result[i] = energy <= 0.0 ? tofMax : factor / std::sqrt(energy) + other;
+  }
+}
+
+void DeltaE::batchFromTOF(const double *first, const double *last,
+                          double *result) const {
+  const auto size = last - first;
+  if (emode != 1 && emode != 2) {
+    std::fill(result, result + size, DBL_MAX);
+    return;
+  }
+  const double sign = emode == 1 ? -1. : 1.;
+  const double factor = factorFrom;
+  const double fixed = efixed;
+  const double scale = sign * unitScaling;
+  const double other = t_otherFrom;
+  const double unphysical = emode == 1 ? -DBL_MAX : DBL_MAX;
+  for (std::ptrdiff_t i = 0; i < size; ++i) {
+    const double t = first[i] - other;
+    result[i] = t <= 0.0 ? unphysical : (factor / (t * t) - fixed) * scale;
+  }
+}
+
 double DeltaE::conversionTOFMin() const {
   double time(
       DBL_MAX); // impossible for elastic, this units do not work for elastic
@@ -1063,6 +1217,27 @@ double Momentum::singleFromTOF(const double tof) const {
   return factorFrom / x;
 }
 
+void Momentum::batchToTOF(const double *first, const double *last,
+                          double *result) const {
+  const double factor = factorTo;
+  // If Direct or Indirect we want to correct TOF values..
+  const double shift = (emode == 1 || emode == 2) ? sfpTo : 0.;
+  const auto size = last - first;
+  for (std::ptrdiff_t i = 0; i < size; ++i)
+    result[i] = factor / first[i] + shift;
+}
+
+void Momentum::batchFromTOF(const double *first, const double *last,
+                            double *result) const {
+  const double factor = factorFrom;
+  const double shift = do_sfpFrom ? sfpFrom : 0.;
+  const auto size = last - first;
+  for (std::ptrdiff_t i = 0; i < size; ++i) {
+    const double x = first[i] - shift;
+    result[i] = factor / (x == 0 ? DBL_MIN : x);
+  }
+}
+
 Unit *Momentum::clone() const { return new Momentum(*this); }
 
 // ============================================================================================
@@ -1114,6 +1289,17 @@ double SpinEchoLength::singleFromTOF(const double tof) const {
   return x;
 }
 
+/// The Wavelength kernel does not apply here: convert value by value
+void SpinEchoLength::batchToTOF(const double *first, const double *last,
+                              double *result) const {
+  Unit::batchToTOF(first, last, result);
+}
+
+void SpinEchoLength::batchFromTOF(const double *first, const double *last,
+                                double *result) const {
+  Unit::batchFromTOF(first, last, result);
+}
+
 Unit *SpinEchoLength::clone() const { return new SpinEchoLength(*this); }
 
 // ============================================================================================
@@ -1159,6 +1345,17 @@ double SpinEchoTime::singleFromTOF(const double tof) const {
   return x;
 }
 
+/// The Wavelength kernel does not apply here: convert value by value
+void SpinEchoTime::batchToTOF(const double *first, const double *last,
+                            double *result) const {
+  Unit::batchToTOF(first, last, result);
+}
+
+void SpinEchoTime::batchFromTOF(const double *first, const double *last,
+                              double *result) const {
+  Unit::batchFromTOF(first, last, result);
+}
+
 Unit *SpinEchoTime::clone() const { return new SpinEchoTime(*this); }
 
 // ================================================================================
@@ -0,0 +1,155 @@
+#ifndef MANTID_KERNEL_ASYNCBLOCKIOTEST_H_
+#define MANTID_KERNEL_ASYNCBLOCKIOTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/AsyncBlockIO.h"
+#include "MantidKernel/make_unique.h"
+
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+using Mantid::Kernel::AsyncBlockIO;
+
+/// A "file" of 4-byte units in memory, recording its use
+class FakeBlockFile {
+public:
+  explicit FakeBlockFile(const size_t units) : m_data(units * 4) {
+    for (size_t i = 0; i < m_data.size(); ++i)
+      m_data[i] = static_cast<char>(i / 4);
+  }
+  std::unique_ptr<AsyncBlockIO> makeIO(const size_t bufferSize = 1024) {
+    return Mantid::Kernel::make_unique<AsyncBlockIO>(
+        4,
+        [this](uint64_t pos, uint64_t size, char *data) {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          ++m_reads;
+          std::memcpy(data, m_data.data() + pos * 4, size * 4);
+        },
+        [this](uint64_t pos, uint64_t size, char *data) {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          if (m_failWrites)
+            throw std::runtime_error("disk full");
+          m_log += "w" + std::to_string(pos);
+          std::memcpy(m_data.data() + pos * 4, data, size * 4);
+        },
+        [this]() {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_log += "f";
+        },
+        bufferSize);
+  }
+
+  std::mutex m_mutex;
+  std::vector<char> m_data;
+  size_t m_reads = 0;
+  std::string m_log;
+  bool m_failWrites = false;
+};
+
+class AsyncBlockIOTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AsyncBlockIOTest *createSuite() { return new AsyncBlockIOTest(); }
+  static void destroySuite(AsyncBlockIOTest *suite) { delete suite; }
+
+  void test_adjacent_blocks_are_read_together() {
+    FakeBlockFile file(100);
+    auto io = file.makeIO();
+    io->readAhead({{0, 5}, {5, 10}, {15, 2}, {40, 3}});
+    std::vector<char> block(10 * 4);
+    TS_ASSERT(io->takeReadAhead(5, 10, block.data()));
+    TS_ASSERT_EQUALS(block[0], 5);
+    TS_ASSERT_EQUALS(block[39], 14);
+    TS_ASSERT(io->takeReadAhead(40, 3, block.data()));
+    TS_ASSERT_EQUALS(block[0], 40);
+    // Taking a later run dropped the rest of the first one
+    TS_ASSERT(!io->takeReadAhead(15, 2, block.data()));
+    TS_ASSERT(!io->takeReadAhead(60, 2, block.data()));
+    io.reset();
+    TS_ASSERT_EQUALS(file.m_reads, 2);
+  }
+
+  void test_runs_are_limited_by_the_buffer() {
+    FakeBlockFile file(100);
+    // Runs of 16 units of 4 bytes
+    auto io = file.makeIO(256);
+    std::vector<std::pair<uint64_t, uint64_t>> blocks;
+    for (uint64_t i = 0; i < 100; i += 4)
+      blocks.emplace_back(i, 4);
+    io->readAhead(blocks);
+    std::vector<char> block(4 * 4);
+    for (const auto &b : blocks) {
+      TS_ASSERT(io->takeReadAhead(b.first, b.second, block.data()));
+      TS_ASSERT_EQUALS(block[0], static_cast<char>(b.first));
+    }
+    io.reset();
+    TS_ASSERT_EQUALS(file.m_reads, 7);
+  }
+
+  void test_streams_do_not_drop_each_other() {
+    FakeBlockFile file(100);
+    auto io = file.makeIO();
+    const size_t first = io->readAhead({{0, 4}, {20, 4}});
+    const size_t second = io->readAhead({{40, 4}, {60, 4}});
+    TS_ASSERT_DIFFERS(first, second);
+    std::vector<char> block(4 * 4);
+    // Taking from the second stream leaves the first one alone
+    TS_ASSERT(io->takeReadAhead(60, 4, block.data()));
+    TS_ASSERT(io->takeReadAhead(0, 4, block.data()));
+    TS_ASSERT_EQUALS(block[0], 0);
+    TS_ASSERT(!io->takeReadAhead(40, 4, block.data()));
+    // Clearing a stream only drops its own blocks
+    const size_t third = io->readAhead({{80, 4}});
+    io->clearReadAhead(first);
+    TS_ASSERT(!io->takeReadAhead(20, 4, block.data()));
+    TS_ASSERT(io->takeReadAhead(80, 4, block.data()));
+    TS_ASSERT_EQUALS(block[0], 80);
+    io->clearReadAhead(third);
+  }
+
+  void test_reads_see_queued_writes() {
+    FakeBlockFile file(100);
+    auto io = file.makeIO();
+    io->readAhead({{10, 4}});
+    std::vector<char> block(4 * 4);
+    io->write(10, 2, std::vector<char>(2 * 4, 'x'));
+    // The run is either dropped by the write or read after it
+    if (io->takeReadAhead(10, 4, block.data())) {
+      TS_ASSERT_EQUALS(block[0], 'x');
+    }
+    io->readAhead({{10, 4}});
+    TS_ASSERT(io->takeReadAhead(10, 4, block.data()));
+    TS_ASSERT_EQUALS(block[0], 'x');
+    TS_ASSERT_EQUALS(block[12], 13);
+  }
+
+  void test_writes_and_flushes_are_in_order() {
+    FakeBlockFile file(100);
+    auto io = file.makeIO(16);
+    io->write(8, 2, std::vector<char>(8, 'a'));
+    io->write(0, 2, std::vector<char>(8, 'b'));
+    io->flush();
+    io->write(4, 2, std::vector<char>(8, 'c'));
+    io->flush();
+    io->wait();
+    TS_ASSERT_EQUALS(file.m_log, "w8w0fw4f");
+    TS_ASSERT_EQUALS(file.m_data[0], 'b');
+    TS_ASSERT_EQUALS(file.m_data[16], 'c');
+    TS_ASSERT_EQUALS(file.m_data[32], 'a');
+  }
+
+  void test_write_errors_are_thrown_to_the_caller() {
+    FakeBlockFile file(100);
+    file.m_failWrites = true;
+    auto io = file.makeIO();
+    io->write(0, 1, std::vector<char>(4));
+    TS_ASSERT_THROWS(io->wait(), const std::runtime_error &);
+    TS_ASSERT_THROWS_NOTHING(io->wait());
+  }
+};
+
+#endif /* MANTID_KERNEL_ASYNCBLOCKIOTEST_H_ */
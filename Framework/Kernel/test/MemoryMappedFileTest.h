@@ -0,0 +1,47 @@
+#ifndef MANTID_KERNEL_MEMORYMAPPEDFILETEST_H_
+#define MANTID_KERNEL_MEMORYMAPPEDFILETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/MemoryMappedFile.h"
+
+#include <Poco/Path.h>
+
+#include <cstring>
+
+using Mantid::Kernel::MemoryMappedFile;
+
+class MemoryMappedFileTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MemoryMappedFileTest *createSuite() {
+    return new MemoryMappedFileTest();
+  }
+  static void destroySuite(MemoryMappedFileTest *suite) { delete suite; }
+
+  void test_mapping_has_the_requested_capacity() {
+    MemoryMappedFile file(Poco::Path::temp(), 1 << 20);
+    TS_ASSERT(file.data());
+    TS_ASSERT_EQUALS(file.capacity(), 1 << 20);
+    // A new file reads as zeros
+    TS_ASSERT_EQUALS(file.data()[0], 0);
+    TS_ASSERT_EQUALS(file.data()[(1 << 20) - 1], 0);
+  }
+
+  void test_data_survives_dropping_the_pages() {
+    MemoryMappedFile file(Poco::Path::temp(), 1 << 20);
+    const char text[] = "event data";
+    std::memcpy(file.data() + 100000, text, sizeof(text));
+    file.advise(100000, sizeof(text), MemoryMappedFile::Advice::DontNeed);
+    file.advise(0, file.capacity(), MemoryMappedFile::Advice::WillNeed);
+    TS_ASSERT_EQUALS(std::string(file.data() + 100000), text);
+  }
+
+  void test_missing_directory_throws() {
+    TS_ASSERT_THROWS(MemoryMappedFile("/this/directory/does/not/exist", 4096),
+                     const std::runtime_error &);
+  }
+};
+
+#endif /* MANTID_KERNEL_MEMORYMAPPEDFILETEST_H_ */
@@ -0,0 +1,93 @@
+#ifndef MANTID_KERNEL_SMALLVECTORTEST_H_
+#define MANTID_KERNEL_SMALLVECTORTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/SmallVector.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using Mantid::Kernel::SmallVector;
+
+class SmallVectorTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SmallVectorTest *createSuite() { return new SmallVectorTest(); }
+  static void destroySuite(SmallVectorTest *suite) { delete suite; }
+
+  void test_elements_stay_inline_up_to_the_capacity() {
+    SmallVector<int, 3> v;
+    TS_ASSERT(v.empty());
+    v.push_back(1);
+    v.push_back(2);
+    v.push_back(3);
+    TS_ASSERT(v.isInline());
+    v.push_back(4);
+    TS_ASSERT(!v.isInline());
+    TS_ASSERT_EQUALS(v.size(), 4);
+    TS_ASSERT_EQUALS(std::vector<int>(v.begin(), v.end()),
+                     std::vector<int>({1, 2, 3, 4}));
+  }
+
+  void test_clear_keeps_the_memory() {
+    SmallVector<int, 2> v;
+    for (int i = 0; i < 5; ++i)
+      v.push_back(i);
+    const auto capacity = v.capacity();
+    const int *data = &v.front();
+    v.clear();
+    TS_ASSERT(v.empty());
+    v.push_back(7);
+    TS_ASSERT_EQUALS(v.capacity(), capacity);
+    TS_ASSERT_EQUALS(&v.front(), data);
+  }
+
+  void test_insert_and_erase_keep_the_order() {
+    SmallVector<std::string, 2> v;
+    v.insert(v.end(), "c");
+    v.insert(v.begin(), "a");
+    // Grows to the heap
+    auto it = v.insert(v.begin() + 1, "b");
+    TS_ASSERT_EQUALS(*it, "b");
+    v.insert(v.end(), v.front());
+    TS_ASSERT_EQUALS(std::vector<std::string>(v.begin(), v.end()),
+                     std::vector<std::string>({"a", "b", "c", "a"}));
+    it = v.erase(v.begin() + 1);
+    TS_ASSERT_EQUALS(*it, "c");
+    v.erase(v.end() - 1);
+    TS_ASSERT_EQUALS(std::vector<std::string>(v.begin(), v.end()),
+                     std::vector<std::string>({"a", "c"}));
+  }
+
+  void test_copy_and_move() {
+    SmallVector<std::shared_ptr<int>, 2> small, large;
+    small.push_back(std::make_shared<int>(1));
+    for (int i = 0; i < 4; ++i)
+      large.push_back(std::make_shared<int>(i));
+
+    auto smallCopy(small);
+    auto largeCopy(large);
+    TS_ASSERT_EQUALS(smallCopy.front(), small.front());
+    TS_ASSERT_EQUALS(largeCopy.back(), large.back());
+    TS_ASSERT_EQUALS(large.back().use_count(), 2);
+
+    auto smallMoved(std::move(small));
+    auto largeMoved(std::move(large));
+    TS_ASSERT(small.empty());
+    TS_ASSERT(large.empty());
+    TS_ASSERT(smallMoved.isInline());
+    TS_ASSERT_EQUALS(*largeMoved.back(), 3);
+
+    smallCopy = largeMoved;
+    TS_ASSERT_EQUALS(smallCopy.size(), 4);
+    largeCopy = std::move(smallMoved);
+    TS_ASSERT_EQUALS(largeCopy.size(), 1);
+    TS_ASSERT_EQUALS(*largeCopy.front(), 1);
+    TS_ASSERT_EQUALS(largeMoved.back().use_count(), 2);
+  }
+};
+
+#endif /* MANTID_KERNEL_SMALLVECTORTEST_H_ */
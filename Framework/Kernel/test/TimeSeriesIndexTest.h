@@ -0,0 +1,78 @@
+#ifndef MANTID_KERNEL_TIMESERIESINDEXTEST_H_
+#define MANTID_KERNEL_TIMESERIESINDEXTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/TimeSeriesIndex.h"
+
+#include <cmath>
+#include <limits>
+
+using Mantid::Kernel::TimeSeriesIndex;
+
+class TimeSeriesIndexTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TimeSeriesIndexTest *createSuite() {
+    return new TimeSeriesIndexTest();
+  }
+  static void destroySuite(TimeSeriesIndexTest *suite) { delete suite; }
+
+  void test_empty_series_throws() {
+    TS_ASSERT_THROWS(TimeSeriesIndex({}, {}), const std::invalid_argument &);
+    TS_ASSERT_THROWS(TimeSeriesIndex({1, 2}, {1.}),
+                     const std::invalid_argument &);
+  }
+
+  void test_integrate_holds_values_between_entries() {
+    // 1 from 0 s, 3 from 1 s, 2 from 3 s
+    TimeSeriesIndex index({0, SECOND, 3 * SECOND}, {1., 3., 2.});
+    TS_ASSERT_DELTA(index.integrate(0, 3 * SECOND), 7., 1e-12);
+    TS_ASSERT_DELTA(index.integrate(SECOND / 2, 2 * SECOND), 3.5, 1e-12);
+    // The first value holds before the first entry, the last after the last
+    TS_ASSERT_DELTA(index.integrate(-SECOND, 0), 1., 1e-12);
+    TS_ASSERT_DELTA(index.integrate(3 * SECOND, 5 * SECOND), 4., 1e-12);
+  }
+
+  void test_the_last_of_entries_sharing_a_time_holds() {
+    TimeSeriesIndex index({0, SECOND, SECOND}, {1., 5., 2.});
+    TS_ASSERT_DELTA(index.integrate(0, 2 * SECOND), 3., 1e-12);
+    TS_ASSERT_DELTA(index.integrate(SECOND, 2 * SECOND), 2., 1e-12);
+  }
+
+  void test_range_searches_match_a_scan() {
+    // Long enough for several levels of ranges
+    const size_t numValues = 100000;
+    std::vector<int64_t> times(numValues);
+    std::vector<double> values(numValues);
+    for (size_t i = 0; i < numValues; ++i) {
+      times[i] = static_cast<int64_t>(i);
+      values[i] = 100. * std::sin(static_cast<double>(i) * 1e-3);
+    }
+    values[54321] = std::numeric_limits<double>::quiet_NaN();
+    TimeSeriesIndex index(times, values);
+
+    const double min = 99.9, max = 100.;
+    size_t expectIn = 0, expectOut = 0;
+    for (size_t first = 0; first < numValues; first += 997) {
+      expectIn = first;
+      while (expectIn < numValues &&
+             !(values[expectIn] >= min && values[expectIn] <= max))
+        ++expectIn;
+      expectOut = first;
+      while (expectOut < numValues && values[expectOut] >= -100. &&
+             values[expectOut] <= 99.)
+        ++expectOut;
+      TS_ASSERT_EQUALS(index.nextInRange(first, min, max), expectIn);
+      TS_ASSERT_EQUALS(index.nextOutOfRange(first, -100., 99.), expectOut);
+    }
+    TS_ASSERT_EQUALS(index.nextInRange(0, 200., 300.), numValues);
+    TS_ASSERT_EQUALS(index.nextOutOfRange(numValues, 0., 1.), numValues);
+  }
+
+private:
+  static const int64_t SECOND = 1000000000;
+};
+
+#endif /* MANTID_KERNEL_TIMESERIESINDEXTEST_H_ */
@@ -12,6 +12,7 @@
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <thread>
 #include <vector>
 
 using namespace Mantid::Kernel;
@@ -2242,6 +2243,20 @@ public:
     TS_ASSERT_DELTA(log->timeAverageValue(), 5.588, 1e-3);
   }
 
+  void test_timeAverageValue_from_several_threads() {
+    const auto &log = getFilteredTestLog();
+    // The index over the values is built by whichever thread gets there first
+    std::vector<double> averages(4, 0.);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < averages.size(); ++i)
+      threads.emplace_back(
+          [&log, &averages, i] { averages[i] = log->timeAverageValue(); });
+    for (auto &thread : threads)
+      thread.join();
+    for (const auto average : averages)
+      TS_ASSERT_DELTA(average, 5.588, 1e-3);
+  }
+
   void test_filteredValuesAsVector() {
     const auto &log = getFilteredTestLog();
 
@@ -1390,6 +1390,37 @@ public:
     TS_ASSERT_EQUALS(degrees.unitID(), "Degrees");
   }
 
+  //----------------------------------------------------------------------
+  // Batch conversion tests
+  //----------------------------------------------------------------------
+
+  void test_batch_conversion_matches_single_values() {
+    const std::vector<double> values{0.0, 0.5, 1.0, 2.5, 10.0, 3000.0};
+    // Spin echo units are elastic, energy transfer ones inelastic
+    const std::vector<Unit *> elasticUnits{
+        &tof, &lambda, &energy, &energyk, &d, &q, &k_i, &delta, &tau};
+    const std::vector<Unit *> inelasticUnits{
+        &tof, &lambda, &energy, &energyk, &d, &q, &k_i, &dE, &dEk, &dEf};
+    for (int emode = 0; emode <= 2; ++emode) {
+      const auto &units = emode == 0 ? elasticUnits : inelasticUnits;
+      for (auto unit : units) {
+        unit->initialize(10.0, 2.0, 0.5, emode, 25.0, 0.0);
+        std::vector<double> batch(values.size());
+        unit->batchToTOF(values.data(), values.data() + values.size(),
+                         batch.data());
+        for (size_t i = 0; i < values.size(); ++i)
+          TS_ASSERT_EQUALS(batch[i], unit->singleToTOF(values[i]));
+
+        // In place
+        batch = values;
+        unit->batchFromTOF(batch.data(), batch.data() + batch.size(),
+                           batch.data());
+        for (size_t i = 0; i < values.size(); ++i)
+          TS_ASSERT_EQUALS(batch[i], unit->singleFromTOF(values[i]));
+      }
+    }
+  }
+
 private:
   Units::Label label;
   Units::TOF tof;
@@ -6,6 +6,7 @@
 #include "MantidAPI/DataProcessorAlgorithm.h"
 #include "MantidAPI/WorkspaceHistory.h"
 #include "MantidAPI/IMDEventWorkspace.h"
+#include "MantidDataObjects/MDEventWorkspace.h"
 #include <set>
 
 namespace {}
@@ -105,7 +106,13 @@ private:
       const std::vector<double> &gs, const std::vector<double> &efix,
       const std::string &filename, const bool filebackend);
 
+  template <typename MDE, size_t nd>
+  void appendEvents(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
+
   std::map<std::string, std::string> validateInputs() override;
+
+  /// Workspace the new data are appended to, if Incremental
+  API::IMDEventWorkspace_sptr m_appendTo;
 };
 
 } // namespace MDAlgorithms
@@ -8,6 +8,7 @@
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidDataObjects/MDMortonLayout.h"
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
 #include "MantidGeometry/MDGeometry/MDImplicitFunction.h"
 #include "MantidKernel/System.h"
@@ -27,6 +28,13 @@ namespace MDAlgorithms {
  * The output workspace may have fewer
  * dimensions than the input MDEventWorkspace.
  *
+ * The box tree is first classified against the bins: boxes which lie within
+ * a single bin add their cached totals, boxes outside the bins are skipped,
+ * and only the leaf boxes across bin edges have their events binned.
+ * Alternatively, for axis-aligned binning, the events can be copied into a
+ * MDMortonLayout, from which each chunk of bins reads only the events within
+ * it.
+ *
  * @author Janik Zikovsky
  * @date 2011-03-29 11:28:06.048254
  */
@@ -66,11 +74,47 @@ private:
   template <typename MDE, size_t nd>
   void binByIterating(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
 
-  /// Method to bin a single MDBox
+  /// Where a box lies relative to the bins of a chunk
+  enum class BoxPlacement { Outside, SingleBin, Partial };
+
+  /// Method to classify a box against the bins of a chunk
+  template <typename MDE, size_t nd>
+  BoxPlacement placeBox(DataObjects::MDBoxBase<MDE, nd> *box,
+                        const size_t *const chunkMin,
+                        const size_t *const chunkMax, size_t &linearIndex);
+
+  /// Method to plan the binning of a box and the boxes within it
+  template <typename MDE, size_t nd>
+  void planBox(DataObjects::MDBoxBase<MDE, nd> *box,
+               const size_t *const chunkMin, const size_t *const chunkMax,
+               std::vector<API::IMDNode *> &partialBoxes);
+
+  /// Method to bin the events of a single MDBox
   template <typename MDE, size_t nd>
   void binMDBox(DataObjects::MDBox<MDE, nd> *box, const size_t *const chunkMin,
                 const size_t *const chunkMax);
 
+  /// Method to bin the events of a Morton layout within a chunk
+  template <typename MDE, size_t nd>
+  void binLayout(const DataObjects::MDMortonLayout<MDE, nd> &layout,
+                 const size_t *const chunkMin, const size_t *const chunkMax);
+
+  /// Method to bin a single event
+  template <typename MDE, size_t nd>
+  void binEvent(const MDE &event, const size_t *const chunkMin,
+                const size_t *const chunkMax);
+
+  /// Whether the events can be binned from a Morton layout
+  template <typename MDE, size_t nd>
+  bool canUseLayout(DataObjects::MDEventWorkspace<MDE, nd> &ws);
+
+  /// Cache the binning transform in a form quick to apply
+  void cacheBinTransform(const size_t nd);
+
+  /// The bin coordinate of a position in one output dimension
+  template <size_t nd>
+  coord_t binCoordinate(const size_t bd, const coord_t *const center) const;
+
   /// The output MDHistoWorkspace
   Mantid::DataObjects::MDHistoWorkspace_sptr outWS;
   /// Progress reporting
@@ -84,6 +128,14 @@ private:
   signal_t *errors;
   signal_t *numEvents;
   bool m_accumulate{false};
+
+  /// For an axis-aligned binning transform, the input dimension, origin and
+  /// scaling of each output dimension
+  std::vector<size_t> m_binFrom;
+  std::vector<coord_t> m_binOrigin;
+  std::vector<coord_t> m_binScaling;
+  /// Otherwise, the rows of the affine matrix of the binning transform
+  std::vector<coord_t> m_binMatrix;
 };
 
 } // namespace Mantid
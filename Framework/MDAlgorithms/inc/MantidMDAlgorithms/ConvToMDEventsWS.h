@@ -17,6 +17,10 @@ namespace Mantid {
 namespace API {
 class Progress;
 }
+namespace Kernel {
+class ThreadPool;
+class ThreadScheduler;
+}
 namespace MDAlgorithms {
 /** The class specializes ConvToDataObjectsBase for the case when the conversion
   occurs from Events WS to the MD events WS
@@ -61,15 +65,36 @@ public:
   void runConversion(API::Progress *pProgress) override;
 
 private:
+  /// Converted events waiting to be added to the workspace
+  struct EventStage {
+    std::vector<float> sigErr;
+    std::vector<uint16_t> runIndex;
+    std::vector<uint32_t> detIDs;
+    std::vector<coord_t> coord;
+    /// Scratch space for the values, signals and errors of a block of events
+    std::vector<double> x, signal, errorSq;
+  };
+
   // function runs the conversion on
   size_t conversionChunk(size_t workspaceIndex) override;
+  // function converts a range of spectra, adding the events to the workspace
+  // concurrently with other tasks
+  void convertSpectraConcurrently(size_t startSpectra, size_t endSpectra);
+  // function converts all spectra, splitting the boxes at intervals
+  void addEventsSplittingAtIntervals(Kernel::ThreadPool &tp,
+                                     Kernel::ThreadScheduler *ts,
+                                     API::Progress *pProgress);
   // the pointer to the source event workspace as event ws does not work through
   // the public Matrix WS interface
   DataObjects::EventWorkspace_const_sptr m_EventWS;
 
-  /**function converts particular type of events into MD space and add these
-   * events to the workspace itself    */
-  template <class T> size_t convertEventList(size_t workspaceIndex);
+  /**function converts particular type of events into MD space and appends
+   * these events to the stage buffers    */
+  template <class T>
+  size_t convertEventList(size_t workspaceIndex, MDTransfInterface &qConverter,
+                          EventStage &stage) const;
+  size_t convertEventList(size_t workspaceIndex, MDTransfInterface &qConverter,
+                          EventStage &stage) const;
 };
 
 } // endNamespace DataObjects
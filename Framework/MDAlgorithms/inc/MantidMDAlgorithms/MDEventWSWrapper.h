@@ -74,6 +74,13 @@ public:
   void addMDData(std::vector<float> &sigErr, std::vector<uint16_t> &runIndex,
                  std::vector<uint32_t> &detId, std::vector<coord_t> &Coord,
                  size_t dataSize) const;
+  /// add the data to the internal workspace from one of several threads adding
+  /// data at the same time. The workspace has to be in memory and split
+  void addMDDataConcurrently(std::vector<float> &sigErr,
+                             std::vector<uint16_t> &runIndex,
+                             std::vector<uint32_t> &detId,
+                             std::vector<coord_t> &Coord,
+                             size_t dataSize) const;
   /// releases the shared pointer to the MD workspace, stored by the class and
   /// makes the class instance undefined;
   void releaseWorkspace();
@@ -108,6 +115,9 @@ private:
   /// vector holding function pointers to the code, which adds diffrent
   /// dimension number events to the workspace
   std::vector<fpAddData> mdEvAddAndForget;
+  /// vector holding function pointers to the code, which adds diffrent
+  /// dimension number events to the workspace from several threads at once
+  std::vector<fpAddData> mdEvAddConcurrently;
   /// vector holding function pointers to the code, which refreshes centroid
   /// (could it be moved to IMD?)
   std::vector<fpVoidMethod> mdCalCentroid;
@@ -124,6 +134,10 @@ private:
   void addMDDataND(float *sigErr, uint16_t *runIndex, uint32_t *detId,
                    coord_t *Coord, size_t dataSize) const;
   template <size_t nd>
+  void addMDDataConcurrentlyND(float *sigErr, uint16_t *runIndex,
+                               uint32_t *detId, coord_t *Coord,
+                               size_t dataSize) const;
+  template <size_t nd>
   void addAndTraceMDDataND(float *sig_err, uint16_t *run_index,
                            uint32_t *det_id, coord_t *Coord,
                            size_t data_size) const;
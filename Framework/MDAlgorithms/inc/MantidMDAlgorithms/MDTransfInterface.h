@@ -10,6 +10,8 @@
 
 #include "MantidMDAlgorithms/MDWSDescription.h"
 
+#include <algorithm>
+
 namespace Mantid {
 namespace MDAlgorithms {
 /** Interface to set of sub-classes used by ConvertToMD algorithm and
@@ -162,6 +164,42 @@ public:
   virtual bool calcMatrixCoord(const double &X, std::vector<coord_t> &Coord,
                                double &signal, double &errSq) const = 0;
 
+  /** Calculate the coordinates of a block of points of the current detector,
+   * set up by calcYDepCoordinates(). Points outside the range requested by
+   * the algorithm are dropped and the rest are packed to the front.
+   *
+   * This does what calcMatrixCoord() does for each point, which it calls
+   * here. It should be overridden by transformations whose inner loop can be
+   * run over a whole block at once.
+   *
+   * @param X      -- n values of X, in the units of inputUnitID()
+   * @param signal -- n signals, which can change as in calcMatrixCoord()
+   * @param errSq  -- n squared errors, which can change likewise
+   * @param n      -- the number of points
+   * @param Coord  -- the vector of ND-coordinates, with the coordinates which
+   *                  do not depend on X calculated
+   * @param coords -- space for n * Coord.size() values, set to the coordinates
+   *                  of the points kept, one point after another
+   * @return the number of points kept, whose signals and errors are moved
+   *         to the front of signal and errSq
+   */
+  virtual size_t calcMatrixCoords(const double *X, double *signal,
+                                  double *errSq, size_t n,
+                                  std::vector<coord_t> &Coord,
+                                  coord_t *coords) const {
+    const size_t nd = Coord.size();
+    size_t nKept(0);
+    for (size_t j = 0; j < n; ++j) {
+      if (!calcMatrixCoord(X[j], Coord, signal[j], errSq[j]))
+        continue;
+      std::copy(Coord.begin(), Coord.end(), coords + nKept * nd);
+      signal[nKept] = signal[j];
+      errSq[nKept] = errSq[j];
+      ++nKept;
+    }
+    return nKept;
+  }
+
   /* clone method allowing to provide the copy of the particular class */
   virtual MDTransfInterface *clone() const = 0;
   // destructor
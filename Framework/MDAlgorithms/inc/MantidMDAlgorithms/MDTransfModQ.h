@@ -57,6 +57,9 @@ public:
   bool calcYDepCoordinates(std::vector<coord_t> &Coord, size_t i) override;
   bool calcMatrixCoord(const double &x, std::vector<coord_t> &Coord,
                        double &signal, double &ErrSq) const override;
+  size_t calcMatrixCoords(const double *x, double *signal, double *errSq,
+                          size_t n, std::vector<coord_t> &Coord,
+                          coord_t *coords) const override;
   // constructor;
   MDTransfModQ();
   /* clone method allowing to provide the copy of the particular class */
@@ -135,6 +138,9 @@ protected:
   // remove
   int *m_pDetMasks;
 
+  /// the number of points calcMatrixCoords() works out together
+  static const size_t COORDS_BLOCK_SIZE = 256;
+
 private:
   /// how to transform workspace data in elastic case
   inline bool calcMatrixCoordElastic(const double &k0,
@@ -142,6 +148,10 @@ private:
   /// how to transform workspace data in inelastic case
   inline bool calcMatrixCoordInelastic(const double &E_tr,
                                        std::vector<coord_t> &Coord) const;
+  /// |Q|^2 of a run of points in elastic case
+  void calcQsqElastic(const double *k0, size_t n, double *Qsq) const;
+  /// |Q|^2 of a run of points in inelastic case
+  void calcQsqInelastic(const double *E_tr, size_t n, double *Qsq) const;
 };
 
 } // End MDAlgorighms namespace
@@ -53,6 +53,9 @@ public:
   bool calcYDepCoordinates(std::vector<coord_t> &Coord, size_t i) override;
   bool calcMatrixCoord(const double &x, std::vector<coord_t> &Coord, double &s,
                        double &err) const override;
+  size_t calcMatrixCoords(const double *x, double *signal, double *errSq,
+                          size_t n, std::vector<coord_t> &Coord,
+                          coord_t *coords) const override;
   // constructor;
   MDTransfQ3D();
   /* clone method allowing to provide the copy of the particular class */
@@ -112,6 +115,9 @@ private:
   /// how to transform workspace data in inelastic case
   inline bool calcMatrixCoord3DInelastic(const double &E_tr,
                                          std::vector<coord_t> &Coord) const;
+  /// Q of a run of points, without checking the limits
+  void calcQBlock(const double *x, size_t n,
+                  coord_t (*Q)[COORDS_BLOCK_SIZE]) const;
 };
 
 } // End MDAlgorighms namespace
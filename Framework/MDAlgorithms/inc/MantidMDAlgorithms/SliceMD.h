@@ -78,6 +78,12 @@ private:
   /// Method to actually do the slice
   template <typename MDE, size_t nd, typename OMDE, size_t ond>
   void slice(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
+  /// Method to add the events of the slice to a file-backed output in batches
+  template <typename MDE, size_t nd, typename OMDE, size_t ond>
+  uint64_t streamSlice(const std::vector<API::IMDNode *> &boxes,
+                       Geometry::MDImplicitFunction &function,
+                       DataObjects::MDEventWorkspace<OMDE, ond> &outWS,
+                       const std::string &scratchFilename);
 
 protected: // for testing
   /*  /// Method to slice box's events if the box itself belongs to the slice
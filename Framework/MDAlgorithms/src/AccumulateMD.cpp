@@ -9,11 +9,14 @@
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/FileFinder.h"
 #include "MantidAPI/HistoryView.h"
+#include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDHistoWorkspaceIterator.h"
 #include "MantidAPI/FileProperty.h"
 #include "MantidKernel/EnabledWhenProperty.h"
 
 #include <Poco/File.h>
+#include <algorithm>
+#include <limits>
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/trim.hpp>
@@ -22,6 +25,16 @@ using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
 
+namespace {
+/// Lean events carry no run index
+template <size_t nd> void shiftRunIndex(MDLeanEvent<nd> &, uint16_t) {}
+
+/// Point the run index of an event at the experiment info it was given
+template <size_t nd> void shiftRunIndex(MDEvent<nd> &event, uint16_t offset) {
+  event.setRunIndex(static_cast<uint16_t>(event.getRunIndex() + offset));
+}
+} // namespace
+
 namespace Mantid {
 namespace MDAlgorithms {
 
@@ -161,9 +174,20 @@ getHistoricalDataSources(const WorkspaceHistory &ws_history,
     if (alg_history->name() == create_alg_name ||
         alg_history->name() == accumulate_alg_name) {
       auto props = alg_history->getProperties();
+      // AccumulateMD records the sources it appended data from, as some of
+      // DataSources may not have existed yet. Older histories only have
+      // DataSources.
+      const bool hasAppended =
+          std::any_of(props.cbegin(), props.cend(),
+                      [](const PropertyHistory_const_sptr &prop) {
+                        return prop->name() == "AppendedDataSources";
+                      });
+      const std::string sources_name =
+          hasAppended ? "AppendedDataSources" : "DataSources";
       for (auto &prop : props) {
         PropertyHistory_const_sptr prop_history = prop;
-        if (prop_history->name() == "DataSources") {
+        if (prop_history->name() == sources_name &&
+            !prop_history->value().empty()) {
           insertDataSources(prop_history->value(), historical_data_sources);
         }
       }
@@ -234,6 +258,11 @@ void AccumulateMD::init() {
           Direction::Input),
       "Input workspaces to process, or filenames to load and process");
 
+  declareProperty(make_unique<ArrayProperty<std::string>>(
+                      "AppendedDataSources", Direction::Output),
+                  "The data sources whose data were added to the workspace. "
+                  "These are the ones skipped by later calls.");
+
   declareProperty(make_unique<ArrayProperty<double>>("EFix", Direction::Input),
                   "datasource energy values in meV");
 
@@ -288,6 +317,18 @@ void AccumulateMD::init() {
       "Create workspace from fresh rather than appending to "
       "existing workspace data.");
 
+  declareProperty(
+      make_unique<PropertyWithValue<bool>>("Incremental", false,
+                                           Direction::Input),
+      "Insert the new events into the boxes of InputWorkspace, which is "
+      "modified and returned, instead of merging both into a new workspace. "
+      "OutputWorkspace must be the same as InputWorkspace. "
+      "Only the boxes receiving events are updated, and a file-backed "
+      "InputWorkspace keeps its file. The new data must lie within the "
+      "extents of InputWorkspace.");
+  setPropertySettings("Incremental", make_unique<EnabledWhenProperty>(
+                                         "Clean", IS_EQUAL_TO, "0"));
+
   declareProperty(
       make_unique<FileProperty>("Filename", "", FileProperty::OptionalSave,
                                 ".nxs"),
@@ -349,6 +390,7 @@ void AccumulateMD::exec() {
     IMDEventWorkspace_sptr out_ws = createMDWorkspace(
         input_data, psi, gl, gs, efix, out_filename, filebackend);
     this->setProperty("OutputWorkspace", out_ws);
+    this->setProperty("AppendedDataSources", input_data);
     g_log.notice() << this->name()
                    << " successfully created a clean workspace\n";
     this->progress(1.0);
@@ -386,6 +428,25 @@ void AccumulateMD::exec() {
   this->interruption_point();
   this->progress(0.5); // Report as CreateMD is complete
 
+  const bool incremental = this->getProperty("Incremental");
+  if (incremental) {
+    m_appendTo = input_ws;
+    CALL_MDEVENT_FUNCTION(appendEvents, tmp_ws);
+    m_appendTo.reset();
+    if (input_ws->isFileBacked()) {
+      // Write the changed boxes and the new box structure to the file
+      Algorithm_sptr save_alg = createChildAlgorithm("SaveMD", 0.9, 1.0);
+      save_alg->setProperty<IMDWorkspace_sptr>("InputWorkspace", input_ws);
+      save_alg->setProperty("UpdateFileBackEnd", true);
+      save_alg->executeAsChildAlg();
+    }
+    this->setProperty("OutputWorkspace", input_ws);
+    this->setProperty("AppendedDataSources", input_data);
+    g_log.notice() << this->name() << " successfully appended data\n";
+    this->progress(1.0);
+    return; // POSSIBLE EXIT POINT
+  }
+
   const std::string temp_ws_name = "TEMP_WORKSPACE_ACCUMULATEMD";
   // Currently have to use ADS here as list of workspaces can only be passed as
   // a list of workspace names as a string
@@ -402,6 +463,7 @@ void AccumulateMD::exec() {
       merge_alg->getProperty("OutputWorkspace");
 
   this->setProperty("OutputWorkspace", out_ws);
+  this->setProperty("AppendedDataSources", input_data);
   g_log.notice() << this->name() << " successfully appended data\n";
 
   this->progress(1.0); // Report as MergeMD is complete
@@ -450,6 +512,85 @@ IMDEventWorkspace_sptr AccumulateMD::createMDWorkspace(
   return create_alg->getProperty("OutputWorkspace");
 }
 
+/*
+ * Append the events of new data to the workspace being accumulated, updating
+ * only the boxes which receive them
+ * @param ws :: workspace holding the new data
+ * @throws std::invalid_argument if the new data do not match the workspace
+ * or lie outside its extents
+ */
+template <typename MDE, size_t nd>
+void AccumulateMD::appendEvents(
+    typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws) {
+  auto target = boost::dynamic_pointer_cast<MDEventWorkspace<MDE, nd>>(
+      m_appendTo);
+  if (!target)
+    throw std::invalid_argument("The new data do not have the number of "
+                                "dimensions and event type of "
+                                "InputWorkspace.");
+  for (size_t d = 0; d < nd; ++d) {
+    if (ws->getDimension(d)->getName() != target->getDimension(d)->getName())
+      throw std::invalid_argument("The new data do not have the dimensions of "
+                                  "InputWorkspace.");
+  }
+
+  std::vector<API::IMDNode *> boxes;
+  ws->getBox()->getBoxes(boxes, 1000, true);
+
+  // Check every event before any is added, as the boxes of the workspace
+  // cannot hold events outside its extents. Cancelling is only possible
+  // until then, so that the workspace is never left partly appended to.
+  for (auto node : boxes) {
+    this->interruption_point();
+    auto box = dynamic_cast<MDBox<MDE, nd> *>(node);
+    if (!box)
+      continue;
+    for (const auto &event : box->getConstEvents()) {
+      for (size_t d = 0; d < nd; ++d) {
+        const coord_t x = event.getCenter(d);
+        const auto dim = target->getDimension(d);
+        if (x < dim->getMinimum() || x > dim->getMaximum())
+          throw std::invalid_argument(
+              "The new data lie outside the extents of InputWorkspace in " +
+              dim->getName() + ". Set Incremental to false to merge the data "
+                               "into a new workspace covering both.");
+      }
+    }
+    box->releaseEvents();
+  }
+
+  const size_t numExperiments =
+      target->getNumExperimentInfo() + ws->getNumExperimentInfo();
+  if (numExperiments > std::numeric_limits<uint16_t>::max())
+    throw std::invalid_argument(
+        "currently we can not combine more then 65535 experiments");
+  const auto runOffset = static_cast<uint16_t>(target->getNumExperimentInfo());
+  for (uint16_t i = 0; i < ws->getNumExperimentInfo(); ++i)
+    target->addExperimentInfo(ExperimentInfo_sptr(
+        ws->getExperimentInfo(i)->cloneExperimentInfo()));
+
+  // Each batch is sorted into the boxes from the top, so make them large
+  const size_t batchSize = size_t(1) << 22;
+  std::vector<MDE> batch;
+  for (auto node : boxes) {
+    auto box = dynamic_cast<MDBox<MDE, nd> *>(node);
+    if (!box || box->getIsMasked())
+      continue;
+    const std::vector<MDE> &events = box->getConstEvents();
+    batch.insert(batch.end(), events.begin(), events.end());
+    box->releaseEvents();
+    if (batch.size() >= batchSize) {
+      for (auto &event : batch)
+        shiftRunIndex(event, runOffset);
+      target->appendEvents(batch);
+      batch.clear();
+    }
+  }
+  for (auto &event : batch)
+    shiftRunIndex(event, runOffset);
+  target->appendEvents(batch);
+}
+
 /*
  * Validate the input properties
  * @returns a map of properties names with errors
@@ -477,6 +618,16 @@ std::map<std::string, std::string> AccumulateMD::validateInputs() {
         "Filename must be given if FileBackEnd is required.";
   }
 
+  const bool incremental = this->getProperty("Incremental");
+  const bool clean = this->getProperty("Clean");
+  if (incremental && !clean &&
+      this->getPropertyValue("OutputWorkspace") !=
+          this->getPropertyValue("InputWorkspace")) {
+    validation_output["OutputWorkspace"] =
+        "Incremental appends to InputWorkspace in place, so OutputWorkspace "
+        "must be the same workspace.";
+  }
+
   const size_t ws_entries = data_sources.size();
 
   if (u.size() < 3) {
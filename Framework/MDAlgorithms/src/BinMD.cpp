@@ -17,6 +17,9 @@
 #include "MantidKernel/Utils.h"
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+#include <limits>
+
 namespace Mantid {
 namespace MDAlgorithms {
 
@@ -71,6 +74,17 @@ void BinMD::init() {
       "due to disk thrashing.");
   setPropertyGroup("Parallel", grp);
 
+  declareProperty(
+      make_unique<PropertyWithValue<bool>>("UseMortonLayout", false,
+                                           Direction::Input),
+      "Bin from a single array of the events sorted along a Morton "
+      "(Z-order) curve, so that each chunk of bins reads only the events "
+      "within it. The array is built on first use and kept with the input "
+      "workspace until its events change, taking as much memory again as "
+      "the events. It is ignored unless the binning is axis-aligned and the "
+      "workspace is in memory without masked boxes.");
+  setPropertyGroup("UseMortonLayout", grp);
+
   declareProperty(make_unique<WorkspaceProperty<IMDHistoWorkspace>>(
                       "TemporaryDataWorkspace", "", Direction::Input,
                       PropertyMode::Optional),
@@ -84,7 +98,165 @@ void BinMD::init() {
 }
 
 //----------------------------------------------------------------------------------------------
-/** Bin the contents of a MDBox
+/** Cache the binning transform in a form quick to apply, for binCoordinate()
+ *
+ * @param nd :: number of dimensions of the input workspace
+ */
+void BinMD::cacheBinTransform(const size_t nd) {
+  if (m_transform->getInD() != nd)
+    throw std::invalid_argument("BinMD: the binning transformation does not "
+                                "match the dimensions of the input workspace.");
+  m_binFrom.clear();
+  m_binOrigin.clear();
+  m_binScaling.clear();
+  m_binMatrix.clear();
+  if (auto aligned = dynamic_cast<CoordTransformAligned *>(m_transform)) {
+    m_binFrom.assign(aligned->getDimensionToBinFrom(),
+                     aligned->getDimensionToBinFrom() + m_outD);
+    m_binOrigin.assign(aligned->getOrigin(), aligned->getOrigin() + m_outD);
+    m_binScaling.assign(aligned->getScaling(), aligned->getScaling() + m_outD);
+  } else {
+    auto affine = dynamic_cast<CoordTransformAffine *>(m_transform);
+    const Matrix<coord_t> matrix =
+        affine ? affine->getMatrix() : m_transform->makeAffineMatrix();
+    m_binMatrix.reserve(m_outD * (nd + 1));
+    for (size_t bd = 0; bd < m_outD; bd++)
+      for (size_t d = 0; d <= nd; d++)
+        m_binMatrix.push_back(matrix[bd][d]);
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** The bin coordinate of a position in one output dimension. This gives the
+ * same result as applying the binning transform, with the loop over the
+ * input dimensions unrolled.
+ *
+ * @param bd :: the output dimension
+ * @param center :: the position in the input workspace
+ * @return the coordinate, whose integer part is the bin index
+ */
+template <size_t nd>
+inline coord_t BinMD::binCoordinate(const size_t bd,
+                                    const coord_t *const center) const {
+  if (!m_binFrom.empty())
+    return (center[m_binFrom[bd]] - m_binOrigin[bd]) * m_binScaling[bd];
+
+  const coord_t *row = m_binMatrix.data() + bd * (nd + 1);
+  coord_t x = 0.0;
+  for (size_t d = 0; d < nd; d++)
+    x += row[d] * center[d];
+  // The last input coordinate is "1" always
+  return x + row[nd];
+}
+
+//----------------------------------------------------------------------------------------------
+/** Classify a box against the bins of a chunk.
+ *
+ * The bin coordinate is monotonic in each input coordinate, as each is
+ * scaled and summed, so its extremes over the box are at the two corners
+ * picked by the signs of the coefficients. They are evaluated exactly as
+ * events are, so the classification agrees with binning the events.
+ *
+ * @param box :: pointer to the box to classify
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ * @param linearIndex :: set to the index of the bin holding the whole box,
+ *if there is one
+ * @return where the box lies
+ */
+template <typename MDE, size_t nd>
+BinMD::BoxPlacement BinMD::placeBox(MDBoxBase<MDE, nd> *box,
+                                    const size_t *const chunkMin,
+                                    const size_t *const chunkMax,
+                                    size_t &linearIndex) {
+  coord_t lowCorner[nd];
+  coord_t highCorner[nd];
+  bool singleBin = true;
+  linearIndex = 0;
+
+  for (size_t bd = 0; bd < m_outD; bd++) {
+    for (size_t d = 0; d < nd; d++) {
+      const coord_t coefficient =
+          m_binFrom.empty()
+              ? m_binMatrix[bd * (nd + 1) + d]
+              : (m_binFrom[bd] == d ? m_binScaling[bd] : coord_t(0.0));
+      const auto &extents = box->getExtents(d);
+      lowCorner[d] = coefficient < 0 ? extents.getMax() : extents.getMin();
+      highCorner[d] = coefficient < 0 ? extents.getMin() : extents.getMax();
+    }
+    const coord_t low = this->binCoordinate<nd>(bd, lowCorner);
+    const coord_t high = this->binCoordinate<nd>(bd, highCorner);
+
+    // Events are within the chunk if chunkMin <= x < chunkMax
+    if (!(high >= static_cast<coord_t>(chunkMin[bd]) &&
+          low < static_cast<coord_t>(chunkMax[bd])))
+      return BoxPlacement::Outside;
+    if (singleBin && low >= static_cast<coord_t>(chunkMin[bd]) &&
+        high < static_cast<coord_t>(chunkMax[bd]) &&
+        size_t(low) == size_t(high))
+      linearIndex += indexMultiplier[bd] * size_t(low);
+    else
+      singleBin = false;
+  }
+  return singleBin ? BoxPlacement::SingleBin : BoxPlacement::Partial;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Plan the binning of a box and the boxes within it. Boxes within a single
+ *bin add their cached signal straight away; leaf boxes across bin edges are
+ *added to the list of boxes whose events are to be binned.
+ *
+ * @param box :: pointer to the box to plan
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ * @param partialBoxes :: the leaf boxes to bin event by event
+ */
+template <typename MDE, size_t nd>
+void BinMD::planBox(MDBoxBase<MDE, nd> *box, const size_t *const chunkMin,
+                    const size_t *const chunkMax,
+                    std::vector<API::IMDNode *> &partialBoxes) {
+  if (box->getNPoints() == 0)
+    return;
+
+  size_t linearIndex = 0;
+  const BoxPlacement placement =
+      this->placeBox(box, chunkMin, chunkMax, linearIndex);
+  if (placement == BoxPlacement::Outside)
+    return;
+
+  const size_t numChildren = box->getNumChildren();
+  if (numChildren == 0) {
+    // A leaf box
+    if (box->getIsMasked())
+      return;
+    if (placement == BoxPlacement::Partial) {
+      partialBoxes.push_back(box);
+      return;
+    }
+  } else if (placement == BoxPlacement::Partial || box->getIsMasked()) {
+    // The totals of a grid box include its masked boxes, which are left out
+    for (size_t i = 0; i < numChildren; i++)
+      this->planBox(static_cast<MDBoxBase<MDE, nd> *>(box->getChild(i)),
+                    chunkMin, chunkMax, partialBoxes);
+    return;
+  }
+
+  // The entire box is within a single bin: add its CACHED signal, and don't
+  // bother looking at each event. This may save lots of time loading from
+  // disk.
+  signals[linearIndex] += box->getSignal();
+  errors[linearIndex] += box->getErrorSquared();
+  // TODO: If DataObjects get a weight, this would need to get the summed
+  // weight.
+  numEvents[linearIndex] += static_cast<signal_t>(box->getNPoints());
+}
+
+//----------------------------------------------------------------------------------------------
+/** Bin the events of a MDBox
  *
  * @param box :: pointer to the MDBox to bin
  * @param chunkMin :: the minimum index in each dimension to consider "valid"
@@ -95,128 +267,115 @@ void BinMD::init() {
 template <typename MDE, size_t nd>
 inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
                             const size_t *const chunkMax) {
-  // An array to hold the rotated/transformed coordinates
-  auto outCenter = new coord_t[m_outD];
-
-  // Evaluate whether the entire box is in the same bin
-  if (box->getNPoints() > (1 << nd) * 2) {
-    // There is a check that the number of events is enough for it to make sense
-    // to do all this processing.
-    size_t numVertexes = 0;
-    auto vertexes = box->getVertexesArray(numVertexes);
-
-    // All vertexes have to be within THE SAME BIN = have the same linear index.
-    size_t lastLinearIndex = 0;
-    bool badOne = false;
-
-    for (size_t i = 0; i < numVertexes; i++) {
-      // Cache the center of the event (again for speed)
-      const coord_t *inCenter = vertexes.get() + i * nd;
-
-      // Now transform to the output dimensions
-      m_transform->apply(inCenter, outCenter);
-      // std::cout << "Input coord " << VMD(nd,inCenter) << " transformed to "
-      // <<  VMD(nd,outCenter) << '\n';
-
-      // To build up the linear index
-      size_t linearIndex = 0;
-      // To mark VERTEXES outside range
-      badOne = false;
-
-      /// Loop through the dimensions on which we bin
-      for (size_t bd = 0; bd < m_outD; bd++) {
-        // What is the bin index in that dimension
-        coord_t x = outCenter[bd];
-        size_t ix = size_t(x);
-        // Within range (for this chunk)?
-        if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-          // Build up the linear index
-          linearIndex += indexMultiplier[bd] * ix;
-        } else {
-          // Outside the range
-          badOne = true;
-          break;
-        }
-      } // (for each dim in MDHisto)
+  const std::vector<MDE> &events = box->getConstEvents();
+  for (auto it = events.begin(); it != events.end(); ++it)
+    this->binEvent<MDE, nd>(*it, chunkMin, chunkMax);
+  // Done with the events list
+  box->releaseEvents();
+}
 
-      // Is the vertex at the same place as the last one?
-      if (!badOne) {
-        if ((i > 0) && (linearIndex != lastLinearIndex)) {
-          // Change of index
-          badOne = true;
-          break;
-        }
-        lastLinearIndex = linearIndex;
-      }
+//----------------------------------------------------------------------------------------------
+/** Bin the events of a Morton layout that may fall in the bins of a chunk.
+ * Only the events within one bin of the chunk along each binned dimension
+ * are visited; each is then binned exactly as binMDBox() does.
+ *
+ * @param layout :: all the events of the workspace
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ */
+template <typename MDE, size_t nd>
+void BinMD::binLayout(const MDMortonLayout<MDE, nd> &layout,
+                      const size_t *const chunkMin,
+                      const size_t *const chunkMax) {
+  coord_t min[nd];
+  coord_t max[nd];
+  std::fill(min, min + nd, std::numeric_limits<coord_t>::lowest());
+  std::fill(max, max + nd, std::numeric_limits<coord_t>::max());
+  for (size_t bd = 0; bd < m_outD; bd++) {
+    // Widen the range by a bin so that rounding cannot drop events
+    const coord_t binWidth = coord_t(1.0) / m_binScaling[bd];
+    min[m_binFrom[bd]] =
+        m_binOrigin[bd] + (static_cast<coord_t>(chunkMin[bd]) - 1) * binWidth;
+    max[m_binFrom[bd]] =
+        m_binOrigin[bd] + (static_cast<coord_t>(chunkMax[bd]) + 1) * binWidth;
+  }
+  layout.forEachEventInBox(min, max,
+                           [this, chunkMin, chunkMax](const MDE &event) {
+                             this->binEvent<MDE, nd>(event, chunkMin, chunkMax);
+                           });
+}
 
-      // Was the vertex completely outside the range?
-      if (badOne)
-        break;
-    } // (for each vertex)
-
-    if (!badOne) {
-      // Yes, the entire box is within a single bin
-      //        std::cout << "Box at " << box->getExtentsStr() << " is within a
-      //        single bin.\n";
-      // Add the CACHED signal from the entire box
-      signals[lastLinearIndex] += box->getSignal();
-      errors[lastLinearIndex] += box->getErrorSquared();
-      // TODO: If DataObjects get a weight, this would need to get the summed
-      // weight.
-      numEvents[lastLinearIndex] += static_cast<signal_t>(box->getNPoints());
-
-      // And don't bother looking at each event. This may save lots of time
-      // loading from disk.
-      delete[] outCenter;
+//----------------------------------------------------------------------------------------------
+/** Bin a single event, if it lies within the bins of a chunk
+ *
+ * @param event :: the event to bin
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ */
+template <typename MDE, size_t nd>
+inline void BinMD::binEvent(const MDE &event, const size_t *const chunkMin,
+                            const size_t *const chunkMax) {
+  // Cache the center of the event (again for speed)
+  const coord_t *inCenter = event.getCenter();
+
+  // To build up the linear index
+  size_t linearIndex = 0;
+
+  /// Loop through the dimensions on which we bin
+  for (size_t bd = 0; bd < m_outD; bd++) {
+    // What is the bin index in that dimension
+    coord_t x = this->binCoordinate<nd>(bd, inCenter);
+    size_t ix = size_t(x);
+    // Within range (for this chunk)?
+    if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
+      // Build up the linear index
+      linearIndex += indexMultiplier[bd] * ix;
+    } else {
+      // Outside the range
       return;
     }
-  }
+  } // (for each dim in MDHisto)
+
+  // Sum the signals as doubles to preserve precision
+  signals[linearIndex] += static_cast<signal_t>(event.getSignal());
+  errors[linearIndex] += static_cast<signal_t>(event.getErrorSquared());
+  // TODO: If DataObjects get a weight, this would need to get the summed
+  // weight.
+  numEvents[linearIndex] += 1.0;
+}
 
-  // If you get here, you could not determine that the entire box was in the
-  // same bin.
-  // So you need to iterate through events.
-  const std::vector<MDE> &events = box->getConstEvents();
-  for (auto it = events.begin(); it != events.end(); ++it) {
-    // Cache the center of the event (again for speed)
-    const coord_t *inCenter = it->getCenter();
-
-    // Now transform to the output dimensions
-    m_transform->apply(inCenter, outCenter);
-
-    // To build up the linear index
-    size_t linearIndex = 0;
-    // To mark events outside range
-    bool badOne = false;
-
-    /// Loop through the dimensions on which we bin
-    for (size_t bd = 0; bd < m_outD; bd++) {
-      // What is the bin index in that dimension
-      coord_t x = outCenter[bd];
-      size_t ix = size_t(x);
-      // Within range (for this chunk)?
-      if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-        // Build up the linear index
-        linearIndex += indexMultiplier[bd] * ix;
-      } else {
-        // Outside the range
-        badOne = true;
-        break;
-      }
-    } // (for each dim in MDHisto)
-
-    if (!badOne) {
-      // Sum the signals as doubles to preserve precision
-      signals[linearIndex] += static_cast<signal_t>(it->getSignal());
-      errors[linearIndex] += static_cast<signal_t>(it->getErrorSquared());
-      // TODO: If DataObjects get a weight, this would need to get the summed
-      // weight.
-      numEvents[linearIndex] += 1.0;
+//----------------------------------------------------------------------------------------------
+/** Whether the events can be binned from a Morton layout: the layout takes
+ * no account of masked boxes, and is binned in input coordinates, which only
+ * an axis-aligned transform maps to bins one dimension at a time.
+ *
+ * @param ws :: MDEventWorkspace of the given type.
+ * @return true if UseMortonLayout is set and the layout can be used
+ */
+template <typename MDE, size_t nd>
+bool BinMD::canUseLayout(MDEventWorkspace<MDE, nd> &ws) {
+  const bool useLayout = getProperty("UseMortonLayout");
+  if (!useLayout)
+    return false;
+  if (m_binFrom.empty() || ws.getBoxController()->isFileBacked()) {
+    g_log.information() << "UseMortonLayout is ignored for binning that is "
+                           "not axis-aligned or a file-backed workspace.\n";
+    return false;
+  }
+  std::vector<API::IMDNode *> leaves;
+  ws.getBox()->getBoxes(leaves, 1000, true);
+  for (const auto leaf : leaves) {
+    if (leaf->getIsMasked()) {
+      g_log.information()
+          << "UseMortonLayout is ignored for a workspace with masked boxes.\n";
+      return false;
     }
   }
-  // Done with the events list
-  box->releaseEvents();
-
-  delete[] outCenter;
+  return true;
 }
 
 //----------------------------------------------------------------------------------------------
@@ -245,12 +404,22 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   signals = outWS->getSignalArray();
   errors = outWS->getErrorSquaredArray();
   numEvents = outWS->getNumEventsArray();
+  this->cacheBinTransform(nd);
 
   if (!m_accumulate) {
     // Start with signal/error/numEvents at 0.0
     outWS->setTo(0.0, 0.0, 0.0);
   }
 
+  // The events in one array sorted along the Morton curve, if asked. The
+  // workspace keeps the layout for later binning until its events change.
+  boost::shared_ptr<const MDMortonLayout<MDE, nd>> layout;
+  if (this->canUseLayout(*ws)) {
+    if (prog)
+      prog->report("Sorting the events along the Morton curve");
+    layout = ws->getMortonLayout();
+  }
+
   // The dimension (in the output workspace) along which we chunk for parallel
   // processing
   // TODO: Find the smartest dimension to chunk against
@@ -302,26 +471,32 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       else
         chunkMax[chunkDimension] = size_t(chunk + chunkNumBins);
 
-      // Build an implicit function (it needs to be in the space of the
-      // MDEventWorkspace)
-      MDImplicitFunction *function =
-          this->getImplicitFunctionForChunk(chunkMin.data(), chunkMax.data());
+      // Bin only the events of the layout near this chunk
+      if (layout) {
+        this->binLayout(*layout, chunkMin.data(), chunkMax.data());
+        if (prog)
+          prog->report();
+        continue;
+      }
 
-      // Use getBoxes() to get an array with a pointer to each box
+      // Classify the boxes against the bins of this chunk, adding those
+      // within a single bin, and keeping the leaf boxes across bin edges.
       std::vector<API::IMDNode *> boxes;
-      // Leaf-only; no depth limit; with the implicit function passed to it.
-      ws->getBox()->getBoxes(boxes, 1000, true, function);
+      this->planBox(ws->getBox(), chunkMin.data(), chunkMax.data(), boxes);
 
       // Sort boxes by file position IF file backed. This reduces seeking time,
       // hopefully.
-      if (bc->isFileBacked())
+      size_t prefetch = 0;
+      if (bc->isFileBacked()) {
         API::IMDNode::sortObjByID(boxes);
+        prefetch = bc->prefetchBoxes(boxes);
+      }
 
       // For progress reporting, the # of boxes
       if (prog) {
         PARALLEL_CRITICAL(BinMD_progress) {
           g_log.debug() << "Chunk " << chunk << ": found " << boxes.size()
-                        << " boxes within the implicit function.\n";
+                        << " boxes across bin edges.\n";
           progNumSteps += boxes.size();
           prog->setNumSteps(progNumSteps);
         }
@@ -331,7 +506,7 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       for (auto &boxe : boxes) {
         MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
         // Perform the binning in this separate method.
-        if (box && !box->getIsMasked())
+        if (box)
           this->binMDBox(box, chunkMin.data(), chunkMax.data());
 
         // Progress reporting
@@ -341,6 +516,7 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
         if (this->m_cancel)
           break;
       } // for each box in the vector
+      bc->cancelPrefetch(prefetch);
       PARALLEL_END_INTERUPT_REGION
     } // for each chunk in parallel
     PARALLEL_CHECK_INTERUPT_REGION
@@ -1,13 +1,35 @@
 #include "MantidMDAlgorithms/ConvToMDEventsWS.h"
 
+#include "MantidKernel/FunctionTask.h"
 #include "MantidMDAlgorithms/UnitsConversionHelper.h"
 
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <memory>
+
 namespace Mantid {
 namespace MDAlgorithms {
+
+namespace {
+/// Number of converted events a task collects before adding them to the
+/// workspace when converting concurrently
+const size_t EVENTS_PER_STAGE = 65536;
+/// Number of events of a list converted together
+const size_t EVENTS_PER_BLOCK = 1024;
+} // namespace
+
 /**function converts particular list of events of type T into MD workspace and
- * adds these events to the workspace itself  */
+ * appends them to the stage buffers
+ @param workspaceIndex -- the index of the event list to convert
+ @param qConverter     -- the MD transformation, which is changed to describe
+                          the detector of the event list
+ @param stage          -- the buffers to append the converted events to
+ @return the number of events appended */
 template <class T>
-size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
+size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex,
+                                          MDTransfInterface &qConverter,
+                                          EventStage &stage) const {
 
   const Mantid::DataObjects::EventList &el =
       m_EventWS->getSpectrum(workspaceIndex);
@@ -24,21 +46,16 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
   std::vector<coord_t> locCoord(m_Coord);
   // set up unit conversion and calculate up all coordinates, which depend on
   // spectra index only
-  if (!m_QConverter->calcYDepCoordinates(locCoord, workspaceIndex))
+  if (!qConverter.calcYDepCoordinates(locCoord, workspaceIndex))
     return 0; // skip if any y outsize of the range of interest;
   localUnitConv.updateConversion(workspaceIndex);
   //
-  // allocate temporary buffers for MD Events data
-  // MD events coordinates buffer
-  std::vector<coord_t> allCoord;
-  std::vector<float> sig_err;      // array for signal and error.
-  std::vector<uint16_t> run_index; // Buffer for run index for each event
-  std::vector<uint32_t> det_ids;   // Buffer of det Id-s for each event
-
-  allCoord.reserve(this->m_NDims * numEvents);
-  sig_err.reserve(2 * numEvents);
-  run_index.reserve(numEvents);
-  det_ids.reserve(numEvents);
+  // the coordinates, signals and errors are written straight into the stage
+  // buffers, which are shrunk to the events kept afterwards
+  const size_t nd = locCoord.size();
+  const size_t nStaged = stage.runIndex.size();
+  stage.coord.resize(nd * (nStaged + numEvents));
+  stage.sigErr.resize(2 * (nStaged + numEvents));
 
   // This little dance makes the getting vector of events more general (since
   // you can't overload by return type).
@@ -46,47 +63,103 @@ size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex) {
   getEventsFrom(el, events_ptr);
   const typename std::vector<T> &events = *events_ptr;
 
-  // Iterators to start/end
-  for (auto it = events.cbegin(); it != events.cend(); it++) {
-    double val = localUnitConv.convertUnits(it->tof());
-    double signal = it->weight();
-    double errorSq = it->errorSquared();
-    if (!m_QConverter->calcMatrixCoord(val, locCoord, signal, errorSq))
-      continue; // skip ND outside the range
-
-    sig_err.push_back(static_cast<float>(signal));
-    sig_err.push_back(static_cast<float>(errorSq));
-    run_index.push_back(runIndexLoc);
-    det_ids.push_back(detID);
-    allCoord.insert(allCoord.end(), locCoord.begin(), locCoord.end());
+  // Convert the events a block at a time, so that the unit conversion and the
+  // transformation run over arrays rather than making calls per event
+  const size_t blockSize = std::min(numEvents, EVENTS_PER_BLOCK);
+  stage.x.resize(blockSize);
+  stage.signal.resize(blockSize);
+  stage.errorSq.resize(blockSize);
+  double *x = stage.x.data();
+  double *signal = stage.signal.data();
+  double *errorSq = stage.errorSq.data();
+  size_t nAdded(0);
+  for (size_t start = 0; start < numEvents; start += blockSize) {
+    const size_t n = std::min(blockSize, numEvents - start);
+    for (size_t i = 0; i < n; ++i) {
+      const T &event = events[start + i];
+      x[i] = event.tof();
+      signal[i] = event.weight();
+      errorSq[i] = event.errorSquared();
+    }
+    localUnitConv.convertUnits(x, x + n, x);
+    // skips ND outside the range
+    const size_t nKept = qConverter.calcMatrixCoords(
+        x, signal, errorSq, n, locCoord,
+        stage.coord.data() + nd * (nStaged + nAdded));
+    float *sigErr = stage.sigErr.data() + 2 * (nStaged + nAdded);
+    for (size_t i = 0; i < nKept; ++i) {
+      sigErr[2 * i] = static_cast<float>(signal[i]);
+      sigErr[2 * i + 1] = static_cast<float>(errorSq[i]);
+    }
+    nAdded += nKept;
   }
+  stage.coord.resize(nd * (nStaged + nAdded));
+  stage.sigErr.resize(2 * (nStaged + nAdded));
+  stage.runIndex.resize(nStaged + nAdded, runIndexLoc);
+  stage.detIDs.resize(nStaged + nAdded, detID);
 
-  // Add them to the MDEW
-  size_t n_added_events = run_index.size();
-  m_OutWSWrapper->addMDData(sig_err, run_index, det_ids, allCoord,
-                            n_added_events);
-  return n_added_events;
+  return nAdded;
 }
 
-/** The method runs conversion for a single event list, corresponding to a
- * particular workspace index */
-size_t ConvToMDEventsWS::conversionChunk(size_t workspaceIndex) {
+/** The method converts a single event list of any event type into MD events
+ * and appends them to the stage buffers */
+size_t ConvToMDEventsWS::convertEventList(size_t workspaceIndex,
+                                          MDTransfInterface &qConverter,
+                                          EventStage &stage) const {
 
   switch (m_EventWS->getSpectrum(workspaceIndex).getEventType()) {
   case Mantid::API::TOF:
     return this->convertEventList<Mantid::Types::Event::TofEvent>(
-        workspaceIndex);
+        workspaceIndex, qConverter, stage);
   case Mantid::API::WEIGHTED:
     return this->convertEventList<Mantid::DataObjects::WeightedEvent>(
-        workspaceIndex);
+        workspaceIndex, qConverter, stage);
   case Mantid::API::WEIGHTED_NOTIME:
     return this->convertEventList<Mantid::DataObjects::WeightedEventNoTime>(
-        workspaceIndex);
+        workspaceIndex, qConverter, stage);
   default:
     throw std::runtime_error("EventList had an unexpected data type!");
   }
 }
 
+/** The method runs conversion for a single event list, corresponding to a
+ * particular workspace index */
+size_t ConvToMDEventsWS::conversionChunk(size_t workspaceIndex) {
+
+  EventStage stage;
+  size_t n_added_events =
+      this->convertEventList(workspaceIndex, *m_QConverter, stage);
+  // Add them to the MDEW
+  m_OutWSWrapper->addMDData(stage.sigErr, stage.runIndex, stage.detIDs,
+                            stage.coord, n_added_events);
+  return n_added_events;
+}
+
+/** The method converts a range of event lists, adding the events to the
+ * workspace concurrently with the other tasks converting other ranges.
+ *@param startSpectra -- the first workspace index to convert
+ *@param endSpectra   -- one past the last workspace index to convert
+ */
+void ConvToMDEventsWS::convertSpectraConcurrently(size_t startSpectra,
+                                                  size_t endSpectra) {
+  // The transformation keeps the detector being converted, so each task
+  // needs its own
+  std::unique_ptr<MDTransfInterface> qConverter(m_QConverter->clone());
+  EventStage stage;
+  for (size_t wi = startSpectra; wi < endSpectra; wi++) {
+    this->convertEventList(wi, *qConverter, stage);
+    if (stage.runIndex.size() >= EVENTS_PER_STAGE || wi + 1 == endSpectra) {
+      m_OutWSWrapper->addMDDataConcurrently(stage.sigErr, stage.runIndex,
+                                            stage.detIDs, stage.coord,
+                                            stage.runIndex.size());
+      stage.sigErr.clear();
+      stage.runIndex.clear();
+      stage.detIDs.clear();
+      stage.coord.clear();
+    }
+  }
+}
+
 /** method sets up all internal variables necessary to convert from Event
 Workspace to MDEvent workspace
 @param WSD         -- the class describing the target MD workspace, sorurce
@@ -117,8 +190,6 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   // Get the box controller
   Mantid::API::BoxController_sptr bc =
       m_OutWSWrapper->pWorkspace()->getBoxController();
-  size_t lastNumBoxes = bc->getTotalNumMDBoxes();
-  size_t nEventsInWS = m_OutWSWrapper->pWorkspace()->getNPoints();
   // Is the access to input events thread-safe?
   // bool MultiThreadedAdding = m_EventWS->threadSafe();
   // preprocessed detectors insure that each detector has its own spectra
@@ -132,14 +203,23 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
     nThreads = 0; // negative m_NumThreads correspond to all cores used, 0 no
                   // threads and positive number -- nThreads requested;
   bool runMultithreaded = false;
+  // In memory, the tasks add the events they convert as they go and split the
+  // boxes they fill up, rather than stopping to split all boxes at intervals
+  bool addConcurrently = false;
+  size_t nTasks = 0;
   if (m_NumThreads != 0) {
     runMultithreaded = true;
+    addConcurrently = !m_OutWSWrapper->pWorkspace()->isFileBacked();
+    nTasks = addConcurrently
+                 ? std::min(nValidSpectra,
+                            bc->getAddingEvents_numTasksPerBlock())
+                 : nValidSpectra;
     // Create the thread pool that will run all of these. It will be deleted by
     // the threadpool
     ts = new Kernel::ThreadSchedulerFIFO();
     // it will initiate thread pool with number threads or machine's cores (0 in
     // tp constructor)
-    pProgress->resetNumSteps(nValidSpectra, 0, 1);
+    pProgress->resetNumSteps(nTasks, 0, 1);
   }
   Kernel::ThreadPool tp(ts, nThreads, new API::Progress(*pProgress));
   //<<<--  Thread control stuff
@@ -149,6 +229,49 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   if (!m_QConverter->calcGenericVariables(m_Coord, m_NDims))
     return;
 
+  if (addConcurrently) {
+    m_OutWSWrapper->pWorkspace()->splitBox();
+    const size_t spectraPerTask =
+        nTasks > 0 ? (nValidSpectra + nTasks - 1) / nTasks : 1;
+    for (size_t wi = 0; wi < nValidSpectra; wi += spectraPerTask) {
+      const size_t endSpectra = std::min(nValidSpectra, wi + spectraPerTask);
+      ts->push(new Kernel::FunctionTask(
+          boost::bind(&ConvToMDEventsWS::convertSpectraConcurrently, this, wi,
+                      endSpectra)));
+    }
+    tp.joinAll();
+  } else {
+    this->addEventsSplittingAtIntervals(tp, ts, pProgress);
+  }
+
+  // Recount totals at the end.
+  m_OutWSWrapper->pWorkspace()->refreshCache();
+  // m_OutWSWrapper->refreshCentroid();
+  pProgress->report();
+
+  /// Set the special coordinate system flag on the output workspace.
+  m_OutWSWrapper->pWorkspace()->setCoordinateSystem(m_coordinateSystem);
+}
+
+/** The method converts the event lists one by one, stopping at intervals to
+ * split all the boxes which have filled up
+ *@param tp        -- the thread pool to split the boxes with
+ *@param ts        -- the scheduler of the thread pool, or NULL to split the
+ *                    boxes in this thread
+ *@param pProgress -- the progress reporter
+ */
+void ConvToMDEventsWS::addEventsSplittingAtIntervals(
+    Kernel::ThreadPool &tp, Kernel::ThreadScheduler *ts,
+    API::Progress *pProgress) {
+  // Get the box controller
+  Mantid::API::BoxController_sptr bc =
+      m_OutWSWrapper->pWorkspace()->getBoxController();
+  size_t lastNumBoxes = bc->getTotalNumMDBoxes();
+  size_t nEventsInWS = m_OutWSWrapper->pWorkspace()->getNPoints();
+  // preprocessed detectors insure that each detector has its own spectra
+  size_t nValidSpectra = m_NSpectra;
+  bool runMultithreaded = ts != nullptr;
+
   size_t eventsAdded = 0;
   for (size_t wi = 0; wi < nValidSpectra; wi++) {
 
@@ -183,14 +306,6 @@ void ConvToMDEventsWS::runConversion(API::Progress *pProgress) {
   } else {
     m_OutWSWrapper->pWorkspace()->splitAllIfNeeded(nullptr);
   }
-
-  // Recount totals at the end.
-  m_OutWSWrapper->pWorkspace()->refreshCache();
-  // m_OutWSWrapper->refreshCentroid();
-  pProgress->report();
-
-  /// Set the special coordinate system flag on the output workspace.
-  m_OutWSWrapper->pWorkspace()->setCoordinateSystem(m_coordinateSystem);
 }
 
 } // endNamespace DataObjects
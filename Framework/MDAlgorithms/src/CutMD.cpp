@@ -1,4 +1,5 @@
 #include "MantidMDAlgorithms/CutMD.h"
+#include "MantidAPI/FileProperty.h"
 #include "MantidAPI/IMDEventWorkspace.h"
 #include "MantidAPI/IMDHistoWorkspace.h"
 #include "MantidAPI/ITableWorkspace.h"
@@ -271,6 +272,13 @@ void CutMD::init() {
                   "Sets the maximum recursion depth to use. Can be used to "
                   "constrain the workspaces internal structure");
 
+  declareProperty(
+      make_unique<FileProperty>("OutputFilename", "",
+                                FileProperty::OptionalSave, ".nxs"),
+      "Optional: a NeXus file for the output MDEventWorkspace to be "
+      "file-backed. The events of the cut are streamed to it, so the cut need "
+      "not fit in memory. Ignored if NoPix is True.");
+
   std::vector<std::string> propOptions{AutoMethod, RLUMethod,
                                        InvAngstromMethod};
   char buffer[1024];
@@ -419,6 +427,11 @@ void CutMD::exec() {
       int recursion_depth = getProperty("MaxRecursionDepth");
       cutAlg->setProperty("TakeMaxRecursionDepthFromInput", false);
       cutAlg->setProperty("MaxRecursionDepth", recursion_depth);
+      const std::string filename = getProperty("OutputFilename");
+      if (!filename.empty()) {
+        cutAlg->setProperty("OutputFilename", filename);
+        cutAlg->setProperty("StreamToFile", true);
+      }
     }
 
     for (size_t i = 0; i < numDims; ++i) {
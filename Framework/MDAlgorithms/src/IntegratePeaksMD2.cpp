@@ -28,6 +28,7 @@
 #include <cmath>
 #include <gsl/gsl_integration.h>
 #include <fstream>
+#include <limits>
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -286,8 +287,70 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   // 5-10% speedup.  Perhaps is should just be removed permanantly, but for
   // now it is commented out to avoid the seg faults.  Refs #5533
   // PRAGMA_OMP(parallel for schedule(dynamic, 10) )
-  // Initialize progress reporting
   int nPeaks = peakWS->getNumberPeaks();
+
+  // Get the peak center as a position in the dimensions of the workspace
+  auto peakPosition = [CoordinatesToUse](const IPeak &p) {
+    V3D pos;
+    if (CoordinatesToUse == Mantid::Kernel::QLab) //"Q (lab frame)"
+      pos = p.getQLabFrame();
+    else if (CoordinatesToUse == Mantid::Kernel::QSample) //"Q (sample frame)"
+      pos = p.getQSampleFrame();
+    else if (CoordinatesToUse == Mantid::Kernel::HKL) //"HKL"
+      pos = p.getHKL();
+    return pos;
+  };
+
+  // The spheres around all the peaks are integrated together, in one pass
+  // over the boxes, before the peaks are gone through one by one
+  std::vector<double> edges(nPeaks);
+  std::vector<MDIntegrationSphere> spheres;
+  const size_t noSphere = std::numeric_limits<size_t>::max();
+  std::vector<size_t> peakSpheres(nPeaks, noSphere);
+  std::vector<size_t> backgroundSpheres(nPeaks, noSphere);
+  for (int i = 0; i < nPeaks; ++i) {
+    const IPeak &p = peakWS->getPeak(i);
+    edges[i] = detectorQ(p.getQLabFrame(),
+                         std::max(BackgroundOuterRadius, PeakRadius));
+    if (cylinderBool ||
+        (edges[i] < std::max(BackgroundOuterRadius, PeakRadius) &&
+         !integrateEdge))
+      continue;
+    const V3D pos = peakPosition(p);
+    std::vector<coord_t> center(nd);
+    coord_t lenQpeak = 0.0;
+    for (size_t d = 0; d < nd; ++d) {
+      center[d] = static_cast<coord_t>(pos[d]);
+      lenQpeak += center[d] * center[d];
+    }
+    lenQpeak = adaptiveQMultiplier != 0.0 ? std::sqrt(lenQpeak) : 0.0f;
+    const double adaptiveRadius = adaptiveQMultiplier * lenQpeak + PeakRadius;
+    if (adaptiveRadius <= 0.0)
+      continue;
+
+    peakSpheres[i] = spheres.size();
+    spheres.push_back(MDIntegrationSphere{
+        center, static_cast<coord_t>(adaptiveRadius * adaptiveRadius),
+        0.0 /* innerRadiusSquared */, useOnePercentBackgroundCorrection, 0.,
+        0.});
+    if (BackgroundOuterRadius > PeakRadius) {
+      backgroundSpheres[i] = spheres.size();
+      spheres.push_back(MDIntegrationSphere{
+          center,
+          static_cast<coord_t>((adaptiveQBackgroundMultiplier * lenQpeak +
+                                BackgroundOuterRadius) *
+                               (adaptiveQBackgroundMultiplier * lenQpeak +
+                                BackgroundOuterRadius)),
+          static_cast<coord_t>((adaptiveQBackgroundMultiplier * lenQpeak +
+                                BackgroundInnerRadius) *
+                               (adaptiveQBackgroundMultiplier * lenQpeak +
+                                BackgroundInnerRadius)),
+          useOnePercentBackgroundCorrection, 0., 0.});
+    }
+  }
+  ws->integrateSpheres(spheres);
+
+  // Initialize progress reporting
   Progress progress(this, 0., 1., nPeaks);
   for (int i = 0; i < nPeaks; ++i) {
     if (this->getCancel())
@@ -298,18 +361,11 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     IPeak &p = peakWS->getPeak(i);
 
     // Get the peak center as a position in the dimensions of the workspace
-    V3D pos;
-    if (CoordinatesToUse == Mantid::Kernel::QLab) //"Q (lab frame)"
-      pos = p.getQLabFrame();
-    else if (CoordinatesToUse == Mantid::Kernel::QSample) //"Q (sample frame)"
-      pos = p.getQSampleFrame();
-    else if (CoordinatesToUse == Mantid::Kernel::HKL) //"HKL"
-      pos = p.getHKL();
+    V3D pos = peakPosition(p);
 
     // Do not integrate if sphere is off edge of detector
 
-    double edge = detectorQ(p.getQLabFrame(),
-                            std::max(BackgroundOuterRadius, PeakRadius));
+    double edge = edges[i];
     if (edge < std::max(BackgroundOuterRadius, PeakRadius)) {
       g_log.warning() << "Warning: sphere/cylinder for integration is off edge "
                          "of detector for peak " << i
@@ -362,7 +418,6 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
           adaptiveQBackgroundMultiplier * lenQpeak + BackgroundInnerRadius;
       BackgroundOuterRadiusVector[i] =
           adaptiveQBackgroundMultiplier * lenQpeak + BackgroundOuterRadius;
-      CoordTransformDistance sphere(nd, center, dimensionsUsed);
 
       if (Peak *shapeablePeak = dynamic_cast<Peak *>(&p)) {
 
@@ -373,28 +428,16 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
         shapeablePeak->setPeakShape(sphere);
       }
 
-      // Perform the integration into whatever box is contained within.
-      ws->getBox()->integrateSphere(
-          sphere, static_cast<coord_t>(adaptiveRadius * adaptiveRadius), signal,
-          errorSquared, 0.0 /* innerRadiusSquared */,
-          useOnePercentBackgroundCorrection);
+      // The integration into whatever box is contained within, done above
+      signal = spheres[peakSpheres[i]].signal;
+      errorSquared = spheres[peakSpheres[i]].errorSquared;
 
       // Integrate around the background radius
 
       if (BackgroundOuterRadius > PeakRadius) {
         // Get the total signal inside "BackgroundOuterRadius"
-        ws->getBox()->integrateSphere(
-            sphere,
-            static_cast<coord_t>((adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundOuterRadius) *
-                                 (adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundOuterRadius)),
-            bgSignal, bgErrorSquared,
-            static_cast<coord_t>((adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundInnerRadius) *
-                                 (adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundInnerRadius)),
-            useOnePercentBackgroundCorrection);
+        bgSignal = spheres[backgroundSpheres[i]].signal;
+        bgErrorSquared = spheres[backgroundSpheres[i]].errorSquared;
 
         // Relative volume of peak vs the BackgroundOuterRadius sphere
         double ratio = (PeakRadius / BackgroundOuterRadius);
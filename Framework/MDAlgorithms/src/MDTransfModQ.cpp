@@ -6,6 +6,8 @@ namespace MDAlgorithms {
 // register the class, whith conversion factory under ModQ name
 // clang-format off
 DECLARE_MD_TRANSFID(MDTransfModQ, |Q|)
+
+const size_t MDTransfModQ::COORDS_BLOCK_SIZE;
 // clang-format on
 
 /**method calculates the units, the transformation expects the input ws to be
@@ -82,6 +84,44 @@ bool MDTransfModQ::calcMatrixCoord(const double &x, std::vector<coord_t> &Coord,
   }
 }
 
+/** Calculate the coordinates of a block of points of the current detector.
+ * See MDTransfInterface::calcMatrixCoords(). The squares of |Q| are worked out
+ * for a run of points before any is dropped, so that the loop vectorises.
+ */
+size_t MDTransfModQ::calcMatrixCoords(const double *x, double *signal,
+                                      double *errSq, size_t n,
+                                      std::vector<coord_t> &Coord,
+                                      coord_t *coords) const {
+  const size_t nd = Coord.size();
+  const bool elastic = m_Emode == Kernel::DeltaEMode::Elastic;
+  double Qsq[COORDS_BLOCK_SIZE];
+  size_t nKept(0);
+  for (size_t start = 0; start < n; start += COORDS_BLOCK_SIZE) {
+    const size_t blockSize = std::min(n - start, COORDS_BLOCK_SIZE);
+    if (elastic)
+      calcQsqElastic(x + start, blockSize, Qsq);
+    else
+      calcQsqInelastic(x + start, blockSize, Qsq);
+
+    for (size_t i = 0; i < blockSize; ++i) {
+      const size_t j = start + i;
+      if (!elastic && (x[j] < m_DimMin[1] || x[j] >= m_DimMax[1]))
+        continue;
+      if (Qsq[i] < m_DimMin[0] || Qsq[i] >= m_DimMax[0])
+        continue;
+      coord_t *point = coords + nKept * nd;
+      std::copy(Coord.begin(), Coord.end(), point);
+      point[0] = static_cast<coord_t>(sqrt(Qsq[i]));
+      if (!elastic)
+        point[1] = static_cast<coord_t>(x[j]);
+      signal[nKept] = signal[j];
+      errSq[nKept] = errSq[j];
+      ++nKept;
+    }
+  }
+  return nKept;
+}
+
 /** Method fills-in all additional properties requested by user and not defined
 *by matrix workspace itself.
 *  it fills in [nd - (1 or 2 -- depending on emode)] values into Coord vector;
@@ -189,6 +229,50 @@ bool MDTransfModQ::calcMatrixCoordInelastic(const double &E_tr,
 
   return true;
 }
+/** Calculate the squares of |Q| for a run of energy transfers in the inelastic
+ * case, as calcMatrixCoordInelastic() does for one.
+ * @param E_tr -- n energy transfers
+ * @param n    -- the number of points
+ * @param Qsq  -- set to the n squares of |Q|
+ */
+void MDTransfModQ::calcQsqInelastic(const double *E_tr, size_t n,
+                                    double *Qsq) const {
+  const double eSign =
+      this->m_Emode == Kernel::DeltaEMode::Direct ? -1.0 : 1.0;
+  const double *const rot = m_RotMat.data();
+  for (size_t j = 0; j < n; ++j) {
+    const double k_tr = sqrt((m_Ei + eSign * E_tr[j]) /
+                             PhysicalConstants::E_mev_toNeutronWavenumberSq);
+    const double qx = -m_ex * k_tr;
+    const double qy = -m_ey * k_tr;
+    const double qz = m_Ki - m_ez * k_tr;
+    const double Qx = (rot[0] * qx + rot[1] * qy + rot[2] * qz);
+    const double Qy = (rot[3] * qx + rot[4] * qy + rot[5] * qz);
+    const double Qz = (rot[6] * qx + rot[7] * qy + rot[8] * qz);
+    Qsq[j] = Qx * Qx + Qy * Qy + Qz * Qz;
+  }
+}
+
+/** Calculate the squares of |Q| for a run of momenta in the elastic case, as
+ * calcMatrixCoordElastic() does for one.
+ * @param k0  -- n modules of the momentum
+ * @param n   -- the number of points
+ * @param Qsq -- set to the n squares of |Q|
+ */
+void MDTransfModQ::calcQsqElastic(const double *k0, size_t n,
+                                  double *Qsq) const {
+  const double *const rot = m_RotMat.data();
+  for (size_t j = 0; j < n; ++j) {
+    const double qx = -m_ex * k0[j];
+    const double qy = -m_ey * k0[j];
+    const double qz = (1 - m_ez) * k0[j];
+    const double Qx = (rot[0] * qx + rot[1] * qy + rot[2] * qz);
+    const double Qy = (rot[3] * qx + rot[4] * qy + rot[5] * qz);
+    const double Qz = (rot[6] * qx + rot[7] * qy + rot[8] * qz);
+    Qsq[j] = Qx * Qx + Qy * Qy + Qz * Qz;
+  }
+}
+
 /** function calculates workspace-dependent coordinates in elastic case.
 * Namely, it calculates module of Momentum transfer
 * put it into specified (0) position in the Coord vector
@@ -168,6 +168,96 @@ bool MDTransfQ3D::calcMatrixCoord3DElastic(const double &k0,
   return true;
 }
 
+/** Calculate the coordinates of a block of points of the current detector.
+ * See MDTransfInterface::calcMatrixCoords(). Q is worked out for a run of
+ * points before any is dropped, so that the loop vectorises.
+ */
+size_t MDTransfQ3D::calcMatrixCoords(const double *x, double *signal,
+                                     double *errSq, size_t n,
+                                     std::vector<coord_t> &Coord,
+                                     coord_t *coords) const {
+  const size_t nd = Coord.size();
+  const bool elastic = m_Emode == Kernel::DeltaEMode::Elastic;
+  coord_t Q[3][COORDS_BLOCK_SIZE];
+  size_t nKept(0);
+  for (size_t start = 0; start < n; start += COORDS_BLOCK_SIZE) {
+    const size_t blockSize = std::min(n - start, COORDS_BLOCK_SIZE);
+    calcQBlock(x + start, blockSize, Q);
+
+    for (size_t i = 0; i < blockSize; ++i) {
+      const size_t j = start + i;
+      const auto E_tr = static_cast<coord_t>(x[j]);
+      if (!elastic && (E_tr < m_DimMin[3] || E_tr >= m_DimMax[3]))
+        continue;
+      if (Q[0][i] < m_DimMin[0] || Q[0][i] >= m_DimMax[0] ||
+          Q[1][i] < m_DimMin[1] || Q[1][i] >= m_DimMax[1] ||
+          Q[2][i] < m_DimMin[2] || Q[2][i] >= m_DimMax[2])
+        continue;
+      if (std::sqrt(Q[0][i] * Q[0][i] + Q[1][i] * Q[1][i] +
+                    Q[2][i] * Q[2][i]) < m_AbsMin)
+        continue;
+
+      coord_t *point = coords + nKept * nd;
+      std::copy(Coord.begin(), Coord.end(), point);
+      point[0] = Q[0][i];
+      point[1] = Q[1][i];
+      point[2] = Q[2][i];
+      double s = signal[j];
+      double err = errSq[j];
+      if (elastic) {
+        if (m_isLorentzCorrected) {
+          double kdash = x[j] / (2 * M_PI);
+          double correct = m_SinThetaSq * kdash * kdash * kdash * kdash;
+          s *= correct;
+          err *= (correct * correct);
+        }
+      } else {
+        point[3] = E_tr;
+      }
+      signal[nKept] = s;
+      errSq[nKept] = err;
+      ++nKept;
+    }
+  }
+  return nKept;
+}
+
+/** Calculate Q for a run of points, as calcMatrixCoord() does for one, without
+ * checking the limits.
+ * @param x -- n energy transfers, or modules of the momentum in elastic case
+ * @param n -- the number of points
+ * @param Q -- set to the n coordinates of Q along each direction
+ */
+void MDTransfQ3D::calcQBlock(const double *x, size_t n,
+                             coord_t (*Q)[COORDS_BLOCK_SIZE]) const {
+  // Negating every component gives exactly the same numbers as negating q
+  const double sign = convention == "Crystallography" ? -1.0 : 1.0;
+  const double *const rot = m_RotMat.data();
+  if (m_Emode == Kernel::DeltaEMode::Elastic) {
+    for (size_t j = 0; j < n; ++j) {
+      const double qx = sign * (-m_ex * x[j]);
+      const double qy = sign * (-m_ey * x[j]);
+      const double qz = sign * ((1 - m_ez) * x[j]);
+      Q[0][j] = static_cast<coord_t>(rot[0] * qx + rot[1] * qy + rot[2] * qz);
+      Q[1][j] = static_cast<coord_t>(rot[3] * qx + rot[4] * qy + rot[5] * qz);
+      Q[2][j] = static_cast<coord_t>(rot[6] * qx + rot[7] * qy + rot[8] * qz);
+    }
+  } else {
+    const double eSign = m_Emode == Kernel::DeltaEMode::Direct ? -1.0 : 1.0;
+    for (size_t j = 0; j < n; ++j) {
+      const double k_tr =
+          sqrt((m_Ei + eSign * x[j]) /
+               PhysicalConstants::E_mev_toNeutronWavenumberSq);
+      const double qx = sign * (-m_ex * k_tr);
+      const double qy = sign * (-m_ey * k_tr);
+      const double qz = sign * (m_Ki - m_ez * k_tr);
+      Q[0][j] = static_cast<coord_t>(rot[0] * qx + rot[1] * qy + rot[2] * qz);
+      Q[1][j] = static_cast<coord_t>(rot[3] * qx + rot[4] * qy + rot[5] * qz);
+      Q[2][j] = static_cast<coord_t>(rot[6] * qx + rot[7] * qy + rot[8] * qz);
+    }
+  }
+}
+
 std::vector<double> MDTransfQ3D::getExtremumPoints(const double xMin,
                                                    const double xMax,
                                                    size_t det_num) const {
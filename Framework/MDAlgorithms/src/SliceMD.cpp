@@ -6,10 +6,15 @@
 #include "MantidGeometry/MDGeometry/MDImplicitFunction.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/EnabledWhenProperty.h"
+#include "MantidKernel/Memory.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/ThreadScheduler.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::Geometry;
@@ -48,6 +53,16 @@ void SliceMD::init() {
       "  The amount of memory (in MB) to allocate to the in-memory cache.\n"
       "  If not specified, a default of 40% of free physical memory is used.");
 
+  declareProperty(
+      "StreamToFile", false,
+      "If OutputFilename is specified to use a file back end:\n"
+      "  Stream the events of the slice to the file in batches of output "
+      "boxes, so that the output need not fit in memory. The events are kept "
+      "in a scratch file next to the output meanwhile, and Memory limits the "
+      "batches.");
+  setPropertySettings("StreamToFile", make_unique<EnabledWhenProperty>(
+                                          "OutputFilename", IS_NOT_DEFAULT));
+
   declareProperty("TakeMaxRecursionDepthFromInput", true,
                   "Copy the maximum recursion depth from the input workspace.");
 
@@ -63,6 +78,120 @@ void SliceMD::init() {
 
   setPropertyGroup("OutputFilename", "File Back-End");
   setPropertyGroup("Memory", "File Back-End");
+  setPropertyGroup("StreamToFile", "File Back-End");
+}
+
+namespace {
+//----------------------------------------------------------------------------------------------
+/** Events sorted into buckets on a scratch file, which is removed afterwards.
+ * Each bucket is filled in memory a chunk at a time, and the full chunks are
+ * appended to the file, so the buckets can be read back one after another.
+ */
+template <typename MDE> class EventBuckets {
+public:
+  /// Where a chunk of a bucket is on the file
+  struct Chunk {
+    uint64_t position;
+    size_t numEvents;
+  };
+
+  /**
+   * @param filename :: the scratch file, which is overwritten
+   * @param numBuckets :: the number of buckets
+   * @param chunkSize :: the number of events to write to the file at a time
+   */
+  EventBuckets(const std::string &filename, const size_t numBuckets,
+               const size_t chunkSize)
+      : m_filename(filename), m_chunkSize(chunkSize), m_buffers(numBuckets),
+        m_chunks(numBuckets), m_numColumns(0), m_fileSize(0), m_numEvents(0) {
+    m_file.open(filename, std::ios::in | std::ios::out | std::ios::binary |
+                              std::ios::trunc);
+    if (!m_file)
+      throw std::runtime_error("Can not open the scratch file " + filename);
+  }
+
+  ~EventBuckets() {
+    m_file.close();
+    std::remove(m_filename.c_str());
+  }
+
+  /// Add an event to a bucket, writing out the chunk if it is full
+  void add(const size_t bucket, const MDE &event) {
+    std::vector<MDE> &buffer = m_buffers[bucket];
+    if (buffer.empty())
+      buffer.reserve(m_chunkSize);
+    buffer.push_back(event);
+    if (buffer.size() >= m_chunkSize)
+      writeChunk(bucket);
+  }
+
+  /// Write out the part-filled chunks and free their memory
+  void flush() {
+    for (size_t bucket = 0; bucket < m_buffers.size(); ++bucket) {
+      if (!m_buffers[bucket].empty())
+        writeChunk(bucket);
+      std::vector<MDE>().swap(m_buffers[bucket]);
+    }
+    m_file.flush();
+  }
+
+  /// @return the number of events in all the buckets
+  uint64_t getNumEvents() const { return m_numEvents; }
+
+  /// @return the number of events in a bucket
+  uint64_t getNumEvents(const size_t bucket) const {
+    uint64_t numEvents = 0;
+    for (const auto &chunk : m_chunks[bucket])
+      numEvents += chunk.numEvents;
+    return numEvents;
+  }
+
+  /// @return the chunks of a bucket, in the order they were written
+  const std::vector<Chunk> &getChunks(const size_t bucket) const {
+    return m_chunks[bucket];
+  }
+
+  /// Read the events of a chunk, appending them to a vector
+  void readChunk(const Chunk &chunk, std::vector<MDE> &events) {
+    m_data.resize(chunk.numEvents * m_numColumns);
+    m_file.seekg(static_cast<std::streamoff>(chunk.position * sizeof(coord_t)));
+    m_file.read(reinterpret_cast<char *>(m_data.data()),
+                static_cast<std::streamsize>(m_data.size() * sizeof(coord_t)));
+    if (!m_file)
+      throw std::runtime_error("Can not read the scratch file " + m_filename);
+    MDE::dataToEvents(m_data, events, false);
+  }
+
+private:
+  void writeChunk(const size_t bucket) {
+    std::vector<MDE> &buffer = m_buffers[bucket];
+    double totalSignal(0), totalErrSq(0);
+    MDE::eventsToData(buffer, m_data, m_numColumns, totalSignal, totalErrSq);
+    m_file.seekp(static_cast<std::streamoff>(m_fileSize * sizeof(coord_t)));
+    m_file.write(reinterpret_cast<const char *>(m_data.data()),
+                 static_cast<std::streamsize>(m_data.size() * sizeof(coord_t)));
+    if (!m_file)
+      throw std::runtime_error("Can not write the scratch file " + m_filename);
+    m_chunks[bucket].push_back(Chunk{m_fileSize, buffer.size()});
+    m_fileSize += m_data.size();
+    m_numEvents += buffer.size();
+    buffer.clear();
+  }
+
+  const std::string m_filename;
+  const size_t m_chunkSize;
+  std::fstream m_file;
+  /// The chunk being filled of each bucket
+  std::vector<std::vector<MDE>> m_buffers;
+  /// The chunks written of each bucket
+  std::vector<std::vector<Chunk>> m_chunks;
+  /// Events converted to or from the file
+  std::vector<coord_t> m_data;
+  size_t m_numColumns;
+  /// Size of the file in coordinates
+  uint64_t m_fileSize;
+  uint64_t m_numEvents;
+};
 }
 
 //----------------------------------------------------------------------------------------------
@@ -147,6 +276,10 @@ void SliceMD::slice(typename MDEventWorkspace<MDE, nd>::sptr ws) {
 
   // --- File back end ? ----------------
   std::string filename = getProperty("OutputFilename");
+  const bool streamToFile = getProperty("StreamToFile");
+  if (streamToFile && filename.empty())
+    throw std::invalid_argument(
+        "StreamToFile needs an OutputFilename for the file back end.");
   if (!filename.empty()) {
 
     // First save to the NXS file
@@ -185,77 +318,84 @@ void SliceMD::slice(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   if (fileBackedWS)
     API::IMDNode::sortObjByID(boxes);
 
-  auto prog = make_unique<Progress>(this, 0.0, 1.0, boxes.size());
-
-  // The root of the output workspace
-  MDBoxBase<OMDE, ond> *outRootBox = outWS->getBox();
-
   // if target workspace has events, we should count them as added
   uint64_t totalAdded = outWS->getNEvents();
-  uint64_t numSinceSplit = 0;
-
-  // Go through every box for this chunk.
-  // PARALLEL_FOR_IF( !bc->isFileBacked() )
-  for (int i = 0; i < int(boxes.size()); i++) {
-    MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
-    // Perform the binning in this separate method.
-    if (box && !box->getIsMasked()) {
-      // An array to hold the rotated/transformed coordinates
-      coord_t outCenter[ond];
-
-      const std::vector<MDE> &events = box->getConstEvents();
 
-      for (auto it = events.cbegin(); it != events.cend(); ++it) {
-        // Cache the center of the event (again for speed)
-        const coord_t *inCenter = it->getCenter();
-
-        if (function->isPointContained(inCenter)) {
-          // Now transform to the output dimensions
-          m_transformFromOriginal->apply(inCenter, outCenter);
-
-          // Create the event
-          OMDE newEvent(it->getSignal(), it->getErrorSquared(), outCenter);
-          // Copy extra data, if any
-          copyEvent(*it, newEvent);
-          // Add it to the workspace
-          if (outRootBox->addEvent(newEvent))
-            numSinceSplit++;
+  if (streamToFile) {
+    totalAdded += this->streamSlice<MDE, nd, OMDE, ond>(
+        boxes, *function, *outWS, filename + ".scratch");
+  } else {
+    auto prog = make_unique<Progress>(this, 0.0, 1.0, boxes.size());
+
+    // The root of the output workspace
+    MDBoxBase<OMDE, ond> *outRootBox = outWS->getBox();
+
+    uint64_t numSinceSplit = 0;
+
+    // Go through every box for this chunk.
+    // PARALLEL_FOR_IF( !bc->isFileBacked() )
+    for (int i = 0; i < int(boxes.size()); i++) {
+      MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
+      // Perform the binning in this separate method.
+      if (box && !box->getIsMasked()) {
+        // An array to hold the rotated/transformed coordinates
+        coord_t outCenter[ond];
+
+        const std::vector<MDE> &events = box->getConstEvents();
+
+        for (auto it = events.cbegin(); it != events.cend(); ++it) {
+          // Cache the center of the event (again for speed)
+          const coord_t *inCenter = it->getCenter();
+
+          if (function->isPointContained(inCenter)) {
+            // Now transform to the output dimensions
+            m_transformFromOriginal->apply(inCenter, outCenter);
+
+            // Create the event
+            OMDE newEvent(it->getSignal(), it->getErrorSquared(), outCenter);
+            // Copy extra data, if any
+            copyEvent(*it, newEvent);
+            // Add it to the workspace
+            if (outRootBox->addEvent(newEvent))
+              numSinceSplit++;
+          }
         }
-      }
-      box->releaseEvents();
-
-      // Ask BC if one needs to split boxes
-      if (obc->shouldSplitBoxes(totalAdded, numSinceSplit, lastNumBoxes))
-      // if (numSinceSplit > 20000000 || (i == int(boxes.size()-1)))
-      {
-        // This splits up all the boxes according to split thresholds and sizes.
-        Kernel::ThreadScheduler *ts = new ThreadSchedulerFIFO();
-        ThreadPool tp(ts);
-        outWS->splitAllIfNeeded(ts);
-        tp.joinAll();
-        // Accumulate stats
-        totalAdded += numSinceSplit;
-        numSinceSplit = 0;
-        lastNumBoxes = obc->getTotalNumMDBoxes();
-        // Progress reporting
-        if (!fileBackedWS)
-          prog->report(i);
-      }
-      if (fileBackedWS) {
-        if (!(i % 10))
-          prog->report(i);
-      }
-    } // is box
+        box->releaseEvents();
+
+        // Ask BC if one needs to split boxes
+        if (obc->shouldSplitBoxes(totalAdded, numSinceSplit, lastNumBoxes))
+        // if (numSinceSplit > 20000000 || (i == int(boxes.size()-1)))
+        {
+          // This splits up all the boxes according to split thresholds and
+          // sizes.
+          Kernel::ThreadScheduler *ts = new ThreadSchedulerFIFO();
+          ThreadPool tp(ts);
+          outWS->splitAllIfNeeded(ts);
+          tp.joinAll();
+          // Accumulate stats
+          totalAdded += numSinceSplit;
+          numSinceSplit = 0;
+          lastNumBoxes = obc->getTotalNumMDBoxes();
+          // Progress reporting
+          if (!fileBackedWS)
+            prog->report(i);
+        }
+        if (fileBackedWS) {
+          if (!(i % 10))
+            prog->report(i);
+        }
+      } // is box
 
-  } // for each box in the vector
-  prog->report();
+    } // for each box in the vector
+    prog->report();
 
-  outWS->splitAllIfNeeded(nullptr);
-  // Refresh all cache.
-  outWS->refreshCache();
+    outWS->splitAllIfNeeded(nullptr);
+    // Refresh all cache.
+    outWS->refreshCache();
 
-  // Account for events that were added after the last split
-  totalAdded += numSinceSplit;
+    // Account for events that were added after the last split
+    totalAdded += numSinceSplit;
+  }
   g_log.notice() << totalAdded << " " << OMDE::getTypeName()
                  << "s added to the output workspace.\n";
 
@@ -288,6 +428,128 @@ void SliceMD::slice(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   this->setProperty("OutputWorkspace", outEvent);
 }
 
+//----------------------------------------------------------------------------------------------
+/** Add the events of the slice to a file-backed output workspace within a
+ * bounded memory, so that the output need not fit in memory.
+ *
+ * The input boxes are read once, in the order given, and the events in the
+ * slice are transformed and sorted into buckets of neighbouring top-level
+ * output boxes on a scratch file. The buckets are then appended to the output
+ * in box order, in batches within the Memory property. Each output box is
+ * filled by one batch and written once by the DiskBuffer, unless its bucket
+ * alone is larger than a batch.
+ *
+ * @param boxes :: the input boxes touching the slice
+ * @param function :: defines which events are in the slice
+ * @param outWS :: the file-backed output workspace, split at the top level
+ * @param scratchFilename :: file to keep the transformed events in meanwhile
+ * @return the number of events added to the output
+ */
+template <typename MDE, size_t nd, typename OMDE, size_t ond>
+uint64_t SliceMD::streamSlice(const std::vector<API::IMDNode *> &boxes,
+                              MDImplicitFunction &function,
+                              MDEventWorkspace<OMDE, ond> &outWS,
+                              const std::string &scratchFilename) {
+  // Half the memory holds the buckets being filled, or the batch being added,
+  // and the other half the copy of the batch sorted into boxes. The default
+  // is 40% of the free physical memory.
+  const int memoryMB = getProperty("Memory");
+  const uint64_t memory =
+      memoryMB > 0
+          ? static_cast<uint64_t>(memoryMB) * 1024 * 1024
+          : static_cast<uint64_t>(MemoryStats().availMem()) * 1024 / 10 * 4;
+  const uint64_t batchSize =
+      std::max(uint64_t(1024), memory / 2 / sizeof(OMDE));
+
+  // All the events of the boxes touching the slice may be in it
+  uint64_t maxEvents = 0;
+  for (const auto box : boxes)
+    maxEvents += box->getNPoints();
+
+  // The top-level boxes, numbered as the children of the root box
+  MDBoxBase<OMDE, ond> *outRootBox = outWS.getBox();
+  uint64_t numTopBoxes = 1;
+  uint64_t topSplit[ond];
+  uint64_t topStride[ond];
+  for (size_t od = 0; od < ond; od++) {
+    topSplit[od] = m_binDimensions[od]->getNBins();
+    topStride[od] = numTopBoxes;
+    numTopBoxes *= topSplit[od];
+  }
+  // Several buckets to a batch, so that few buckets are split between batches
+  const uint64_t numBuckets =
+      std::min(numTopBoxes, 4 * (maxEvents / batchSize + 1));
+  const uint64_t chunkSize =
+      std::max(uint64_t(1024), batchSize / numBuckets);
+  EventBuckets<OMDE> buckets(scratchFilename, static_cast<size_t>(numBuckets),
+                             static_cast<size_t>(chunkSize));
+
+  // Progress is by the bytes of events read, then written
+  Progress readProg(this, 0.0, 0.5,
+                    std::max(uint64_t(1), maxEvents * sizeof(MDE)));
+  for (auto node : boxes) {
+    MDBox<MDE, nd> *box = dynamic_cast<MDBox<MDE, nd> *>(node);
+    if (box && !box->getIsMasked()) {
+      coord_t outCenter[ond];
+      const std::vector<MDE> &events = box->getConstEvents();
+      for (const auto &event : events) {
+        const coord_t *inCenter = event.getCenter();
+        if (!function.isPointContained(inCenter))
+          continue;
+        m_transformFromOriginal->apply(inCenter, outCenter);
+        OMDE newEvent(event.getSignal(), event.getErrorSquared(), outCenter);
+        copyEvent(event, newEvent);
+
+        uint64_t topIndex = 0;
+        for (size_t od = 0; od < ond; od++) {
+          const auto &extents = outRootBox->getExtents(od);
+          const double fraction =
+              (outCenter[od] - extents.getMin()) / extents.getSize();
+          const auto index = static_cast<uint64_t>(std::max(
+              0.0, std::min(fraction * static_cast<double>(topSplit[od]),
+                            static_cast<double>(topSplit[od] - 1))));
+          topIndex += index * topStride[od];
+        }
+        buckets.add(static_cast<size_t>(topIndex * numBuckets / numTopBoxes),
+                    newEvent);
+      }
+      box->releaseEvents();
+    }
+    readProg.reportIncrement(
+        static_cast<size_t>(node->getNPoints() * sizeof(MDE)));
+  }
+  buckets.flush();
+
+  Progress writeProg(
+      this, 0.5, 1.0,
+      std::max(uint64_t(1), buckets.getNumEvents() * sizeof(OMDE)));
+  std::vector<OMDE> batch;
+  batch.reserve(static_cast<size_t>(
+      std::min(batchSize + chunkSize, buckets.getNumEvents())));
+  auto addBatch = [&]() {
+    // Splits the boxes the batch takes over the threshold, and leaves the
+    // boxes it fills to the DiskBuffer to write
+    outWS.appendEvents(batch);
+    writeProg.reportIncrement(static_cast<size_t>(batch.size() * sizeof(OMDE)));
+    batch.clear();
+  };
+  for (size_t bucket = 0; bucket < numBuckets; ++bucket) {
+    // A bucket which fits in a batch is not split between two
+    if (!batch.empty() &&
+        batch.size() + buckets.getNumEvents(bucket) > batchSize)
+      addBatch();
+    for (const auto &chunk : buckets.getChunks(bucket)) {
+      buckets.readChunk(chunk, batch);
+      if (batch.size() >= batchSize)
+        addBatch();
+    }
+  }
+  if (!batch.empty())
+    addBatch();
+
+  return buckets.getNumEvents();
+}
+
 //----------------------------------------------------------------------------------------------
 /// Helper method
 template <typename MDE, size_t nd>
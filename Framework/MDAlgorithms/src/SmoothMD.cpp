@@ -3,12 +3,12 @@
 #include "MantidAPI/IMDHistoWorkspace.h"
 #include "MantidAPI/IMDIterator.h"
 #include "MantidAPI/Progress.h"
-#include "MantidDataObjects/MDHistoWorkspaceIterator.h"
 #include "MantidKernel/ArrayBoundedValidator.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/CompositeValidator.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/make_unique.h"
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PropertyWithValue.h"
 #include <boost/bind.hpp>
@@ -16,6 +16,10 @@
 #include <boost/make_shared.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/tuple/tuple.hpp>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_fft_real.h>
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <map>
 #include <numeric>
@@ -27,7 +31,6 @@
 
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
-using namespace Mantid::DataObjects;
 
 // Typedef for width vector
 using WidthVector = std::vector<double>;
@@ -60,6 +63,125 @@ SmoothFunctionMap makeFunctionMap(Mantid::MDAlgorithms::SmoothMD *instance) {
       {"Gaussian", boost::bind(&Mantid::MDAlgorithms::SmoothMD::gaussianSmooth,
                                instance, _1, _2, _3)}};
 }
+
+/// Cost of an FFT of a number of points, relative to a multiply and add
+size_t fftCost(const size_t size) {
+  size_t log2Size = 0;
+  while ((size_t(1) << log2Size) < size)
+    ++log2Size;
+  return 4 * size * std::max(log2Size, size_t(1));
+}
+
+/**
+ * Number of points of the FFTs correlating a line with a kernel: the
+ * smallest power of two long enough that the kernel, wrapped around, never
+ * reaches a point of the line from another
+ * @param length : number of points of the line
+ * @param kernelSize : number of elements of the kernel
+ * @return the number of points
+ */
+size_t fftSize(const size_t length, const size_t kernelSize) {
+  size_t size = 2;
+  while (size < length + std::min(length, kernelSize))
+    size *= 2;
+  return size;
+}
+
+/**
+ * Whether correlating a line with a kernel by FFT, at a forward and inverse
+ * transform per line, costs less than doing it directly.
+ * @param length : number of points of the line
+ * @param kernelSize : number of elements of the kernel
+ * @return true if the FFT is cheaper
+ */
+bool isFFTCheaper(const size_t length, const size_t kernelSize) {
+  return 2 * fftCost(fftSize(length, kernelSize)) <
+         length * std::min(kernelSize, 2 * length - 1);
+}
+
+/**
+ * Correlate a line with a kernel centred on each of its points, leaving out
+ * the parts of the kernel beyond the ends of the line
+ * @param line : values along the line
+ * @param kernel : the kernel, centred on its middle element
+ * @param smoothed : the correlated values, the length of the line
+ */
+void correlateDirect(const std::vector<double> &line,
+                     const KernelVector &kernel,
+                     std::vector<double> &smoothed) {
+  const int length = static_cast<int>(line.size());
+  const int kernelSize = static_cast<int>(kernel.size());
+  const int centre = kernelSize / 2;
+  for (int i = 0; i < length; ++i) {
+    const int first = std::max(0, centre - i);
+    const int last = std::min(kernelSize, length + centre - i);
+    double sum = 0;
+    for (int j = first; j < last; ++j) {
+      sum += line[i + j - centre] * kernel[j];
+    }
+    smoothed[i] = sum;
+  }
+}
+
+/**
+ * Correlates lines of a fixed length with a kernel by FFT: the transform of
+ * the line, padded with zeroes, is multiplied by that of the kernel.
+ */
+class LineCorrelator {
+public:
+  /**
+   * @param length : number of points of the lines
+   * @param kernel : the kernel, centred on its middle element
+   */
+  LineCorrelator(const size_t length, const KernelVector &kernel)
+      : m_length(length), m_size(fftSize(length, kernel.size())),
+        m_kernel(m_size, 0.0), m_buffer(m_size) {
+    // The element of the kernel multiplying the point j after the centre
+    // goes at -j, wrapped around. Elements further away than the length of
+    // the line never meet it.
+    const auto centre = static_cast<ptrdiff_t>(kernel.size() / 2);
+    const auto maxOffset = static_cast<ptrdiff_t>(length) - 1;
+    const auto size = static_cast<ptrdiff_t>(m_size);
+    for (ptrdiff_t j = 0; j < static_cast<ptrdiff_t>(kernel.size()); ++j) {
+      const ptrdiff_t offset = centre - j;
+      if (std::abs(offset) <= maxOffset)
+        m_kernel[(offset + size) % size] = kernel[j];
+    }
+    gsl_fft_real_radix2_transform(m_kernel.data(), 1, m_size);
+  }
+
+  /**
+   * @param line : values along the line, all finite
+   * @param smoothed : the correlated values, the length of the line
+   */
+  void correlate(const std::vector<double> &line,
+                 std::vector<double> &smoothed) {
+    std::copy(line.cbegin(), line.cend(), m_buffer.begin());
+    std::fill(m_buffer.begin() + m_length, m_buffer.end(), 0.0);
+    gsl_fft_real_radix2_transform(m_buffer.data(), 1, m_size);
+    // The half-complex transforms hold the real parts from 0 to size/2 and
+    // the imaginary parts from size-1 down to size/2+1
+    const size_t half = m_size / 2;
+    m_buffer[0] *= m_kernel[0];
+    m_buffer[half] *= m_kernel[half];
+    for (size_t k = 1; k < half; ++k) {
+      const double re = m_buffer[k];
+      const double im = m_buffer[m_size - k];
+      m_buffer[k] = re * m_kernel[k] - im * m_kernel[m_size - k];
+      m_buffer[m_size - k] = re * m_kernel[m_size - k] + im * m_kernel[k];
+    }
+    gsl_fft_halfcomplex_radix2_inverse(m_buffer.data(), 1, m_size);
+    std::copy(m_buffer.cbegin(), m_buffer.cbegin() + m_length,
+              smoothed.begin());
+  }
+
+private:
+  const size_t m_length;
+  const size_t m_size;
+  /// Transform of the kernel
+  std::vector<double> m_kernel;
+  std::vector<double> m_buffer;
+};
 }
 
 namespace Mantid {
@@ -164,7 +286,8 @@ const std::string SmoothMD::summary() const {
 
 /**
  * Hat function smoothing. All weights even. Hat function boundaries beyond
- * width.
+ * width. The hat function is separable, so the mean is taken by summing over
+ * the width in each dimension in turn.
  * @param toSmooth : Workspace to smooth
  * @param widthVector : Width vector
  * @param weightingWS : Weighting workspace (optional)
@@ -174,92 +297,14 @@ IMDHistoWorkspace_sptr
 SmoothMD::hatSmooth(IMDHistoWorkspace_const_sptr toSmooth,
                     const WidthVector &widthVector,
                     OptionalIMDHistoWorkspace_const_sptr weightingWS) {
-
-  const bool useWeights = weightingWS.is_initialized();
-  uint64_t nPoints = toSmooth->getNPoints();
-  Progress progress(this, 0.0, 1.0, size_t(double(nPoints) * 1.1));
-  // Create the output workspace.
-  IMDHistoWorkspace_sptr outWS(toSmooth->clone());
-  progress.reportIncrement(
-      size_t(double(nPoints) * 0.1)); // Report ~10% progress
-
-  const int nThreads = Mantid::API::FrameworkManager::Instance()
-                           .getNumOMPThreads(); // NThreads to Request
-
-  auto iterators = toSmooth->createIterators(nThreads, nullptr);
-
-  PARALLEL_FOR_NO_WSP_CHECK()
-  for (int it = 0; it < int(iterators.size()); ++it) { // NOLINT
-
-    PARALLEL_START_INTERUPT_REGION
-    auto iterator =
-        dynamic_cast<MDHistoWorkspaceIterator *>(iterators[it].get());
-
-    if (!iterator) {
-      throw std::logic_error(
-          "Failed to cast IMDIterator to MDHistoWorkspaceIterator");
-    }
-
-    do {
-      // Gets all vertex-touching neighbours
-      size_t iteratorIndex = iterator->getLinearIndex();
-
-      if (useWeights) {
-
-        // Check that we could measure here.
-        if ((*weightingWS)->getSignalAt(iteratorIndex) == 0) {
-
-          outWS->setSignalAt(iteratorIndex,
-                             std::numeric_limits<double>::quiet_NaN());
-          outWS->setErrorSquaredAt(iteratorIndex,
-                                   std::numeric_limits<double>::quiet_NaN());
-
-          continue; // Skip we couldn't measure here.
-        }
-      }
-
-      // Explicitly cast the doubles to int
-      // We've already checked in the validator that the doubles we have are odd
-      // integer values and well below max int
-      std::vector<int> widthVectorInt;
-      widthVectorInt.reserve(widthVector.size());
-      for (auto const widthEntry : widthVector) {
-        widthVectorInt.push_back(static_cast<int>(widthEntry));
-      }
-
-      std::vector<size_t> neighbourIndexes =
-          iterator->findNeighbourIndexesByWidth(widthVectorInt);
-
-      size_t nNeighbours = neighbourIndexes.size();
-      double sumSignal = iterator->getSignal();
-      double sumSqError = iterator->getError();
-      for (auto neighbourIndex : neighbourIndexes) {
-        if (useWeights) {
-          if ((*weightingWS)->getSignalAt(neighbourIndex) == 0) {
-            // Nothing measured here. We cannot use that neighbouring point.
-            nNeighbours -= 1;
-            continue;
-          }
-        }
-        sumSignal += toSmooth->getSignalAt(neighbourIndex);
-        double error = toSmooth->getErrorAt(neighbourIndex);
-        sumSqError += (error * error);
-      }
-
-      // Calculate the mean
-      outWS->setSignalAt(iteratorIndex, sumSignal / double(nNeighbours + 1));
-      // Calculate the sample variance
-      outWS->setErrorSquaredAt(iteratorIndex,
-                               sumSqError / double(nNeighbours + 1));
-
-      progress.report();
-
-    } while (iterator->next());
-    PARALLEL_END_INTERUPT_REGION
+  // We've already checked in the validator that the widths are odd integer
+  // values and well below max int
+  std::vector<KernelVector> hat_kernels;
+  hat_kernels.reserve(widthVector.size());
+  for (const auto width : widthVector) {
+    hat_kernels.emplace_back(static_cast<size_t>(width), 1.0);
   }
-  PARALLEL_CHECK_INTERUPT_REGION
-
-  return outWS;
+  return separableSmooth(toSmooth, hat_kernels, weightingWS, false);
 }
 
 /**
@@ -277,107 +322,149 @@ IMDHistoWorkspace_sptr
 SmoothMD::gaussianSmooth(IMDHistoWorkspace_const_sptr toSmooth,
                          const WidthVector &widthVector,
                          OptionalIMDHistoWorkspace_const_sptr weightingWS) {
-
-  const bool useWeights = weightingWS.is_initialized();
-  uint64_t nPoints = toSmooth->getNPoints();
-  Progress progress(this, 0.0, 1.0, size_t(double(nPoints) * 1.1));
-  // Create the output workspace
-  IMDHistoWorkspace_sptr outWS(toSmooth->clone().release());
-  // Create a temporary workspace
-  IMDHistoWorkspace_sptr tempWS(toSmooth->clone().release());
-  progress.reportIncrement(
-      size_t(double(nPoints) * 0.1)); // Report ~10% progress
-
-  // Create a kernel for each dimension and
+  // Create a kernel for each dimension
   std::vector<KernelVector> gaussian_kernels;
   gaussian_kernels.reserve(widthVector.size());
   for (const auto width : widthVector) {
     gaussian_kernels.push_back(gaussianKernel(width));
   }
+  return separableSmooth(toSmooth, gaussian_kernels, weightingWS, true);
+}
+
+/**
+ * Smoothing by a kernel which is the product of a 1D kernel for each
+ * dimension.
+ *
+ * The smoothed signal is the sum of the kernel times the signal over the
+ * valid voxels, divided by the sum of the kernel over them, so that the
+ * kernel is renormalised where it overlaps the edges of the workspace or
+ * voxels with no weight. The three sums are separable, so they are made by
+ * a 1D pass along each dimension in turn, directly or by FFT, whichever is
+ * cheaper for the length of the kernel. Voxels with no weight are set to NaN.
+ *
+ * @param toSmooth : Workspace to smooth
+ * @param kernels : Kernel for each dimension, centred on its middle element
+ * @param weightingWS : Weighting workspace (optional)
+ * @param isWeightedMean : whether the error squared is that of the weighted
+ * mean (divided by the square of the sum of the kernel) or the sample
+ * variance of the hat function (divided by the sum of the kernel)
+ * @return Smoothed MDHistoWorkspace
+ */
+IMDHistoWorkspace_sptr
+SmoothMD::separableSmooth(IMDHistoWorkspace_const_sptr toSmooth,
+                          const std::vector<KernelVector> &kernels,
+                          OptionalIMDHistoWorkspace_const_sptr weightingWS,
+                          const bool isWeightedMean) {
+
+  const bool useWeights = weightingWS.is_initialized();
+  const size_t nPoints = toSmooth->getNPoints();
+  Progress progress(this, 0.0, 1.0, kernels.size() + 2);
+
+  // Check that we could measure here.
+  auto isMeasured = [&](const size_t index) {
+    return !useWeights || (*weightingWS)->getSignalAt(index) != 0;
+  };
+
+  // The sums of the kernel times the signal, of the kernel, and of the kernel
+  // squared times the error squared, so far, over the voxels measured
+  std::vector<double> sumSignal(nPoints, 0.0);
+  std::vector<double> sumKernel(nPoints, 0.0);
+  std::vector<double> sumSquareError(nPoints, 0.0);
+  const signal_t *signal = toSmooth->getSignalArray();
+  const signal_t *errorSquared = toSmooth->getErrorSquaredArray();
+  for (size_t i = 0; i < nPoints; ++i) {
+    if (isMeasured(i)) {
+      sumSignal[i] = signal[i];
+      sumKernel[i] = 1.0;
+      sumSquareError[i] = errorSquared[i];
+    }
+  }
+  progress.report();
 
   const int nThreads = Mantid::API::FrameworkManager::Instance()
                            .getNumOMPThreads(); // NThreads to Request
 
-  auto read_ws = outWS;
-  auto write_ws = tempWS;
-  for (size_t dimension_number = 0; dimension_number < widthVector.size();
+  // Voxels along a dimension are this far apart
+  size_t stride = 1;
+  for (size_t dimension_number = 0; dimension_number < kernels.size();
        ++dimension_number) {
-
-    auto iterators = toSmooth->createIterators(nThreads, nullptr);
-
-    // Alternately write to each workspace
-    if (dimension_number % 2 == 0) {
-      read_ws = outWS;
-      write_ws = tempWS;
-    } else {
-      read_ws = tempWS;
-      write_ws = outWS;
-    }
-
+    const size_t length = toSmooth->getDimension(dimension_number)->getNBins();
+    const size_t nLines = nPoints / length;
+    const KernelVector &kernel = kernels[dimension_number];
+    KernelVector squareKernel(kernel.size());
+    std::transform(kernel.cbegin(), kernel.cend(), squareKernel.begin(),
+                   [](const double k) { return k * k; });
+    const bool useFFT = isFFTCheaper(length, kernel.size());
+
+    // Each thread takes a run of lines, with buffers of its own
+    const int nChunks =
+        static_cast<int>(std::min(nLines, static_cast<size_t>(nThreads)));
     PARALLEL_FOR_NO_WSP_CHECK()
-    for (int it = 0; it < int(iterators.size()); ++it) { // NOLINT
+    for (int chunk = 0; chunk < nChunks; ++chunk) { // NOLINT
 
       PARALLEL_START_INTERUPT_REGION
-      auto iterator =
-          dynamic_cast<MDHistoWorkspaceIterator *>(iterators[it].get());
-      if (!iterator) {
-        throw std::logic_error(
-            "Failed to cast IMDIterator to MDHistoWorkspaceIterator");
+      std::unique_ptr<LineCorrelator> correlator, squareCorrelator;
+      if (useFFT) {
+        correlator = Kernel::make_unique<LineCorrelator>(length, kernel);
+        squareCorrelator =
+            Kernel::make_unique<LineCorrelator>(length, squareKernel);
+      }
+      std::vector<double> line(length);
+      std::vector<double> smoothed(length);
+
+      // Smooth the values along one line, in place
+      auto smoothLine = [&](std::vector<double> &values, const size_t first,
+                            const KernelVector &lineKernel,
+                            LineCorrelator *lineCorrelator) {
+        for (size_t i = 0; i < length; ++i)
+          line[i] = values[first + i * stride];
+        // A NaN or infinity would spread along the whole line in the FFT
+        if (lineCorrelator &&
+            std::all_of(line.cbegin(), line.cend(),
+                        [](const double x) { return std::isfinite(x); }))
+          lineCorrelator->correlate(line, smoothed);
+        else
+          correlateDirect(line, lineKernel, smoothed);
+        for (size_t i = 0; i < length; ++i)
+          values[first + i * stride] = smoothed[i];
+      };
+
+      const size_t begin = nLines * chunk / nChunks;
+      const size_t end = nLines * (chunk + 1) / nChunks;
+      for (size_t lineNumber = begin; lineNumber < end; ++lineNumber) {
+        // The voxel at the start of the line
+        const size_t first = (lineNumber / stride) * stride * length +
+                             lineNumber % stride;
+        smoothLine(sumSignal, first, kernel, correlator.get());
+        smoothLine(sumKernel, first, kernel, correlator.get());
+        smoothLine(sumSquareError, first, squareKernel,
+                   squareCorrelator.get());
       }
-
-      do {
-
-        // Gets linear index at current position
-        size_t iteratorIndex = iterator->getLinearIndex();
-
-        if (useWeights) {
-
-          // Check that we could measure here.
-          if ((*weightingWS)->getSignalAt(iteratorIndex) == 0) {
-
-            write_ws->setSignalAt(iteratorIndex,
-                                  std::numeric_limits<double>::quiet_NaN());
-            write_ws->setErrorSquaredAt(
-                iteratorIndex, std::numeric_limits<double>::quiet_NaN());
-
-            continue; // Skip we couldn't measure here.
-          }
-        }
-
-        std::pair<std::vector<size_t>, std::vector<bool>> indexesAndValidity =
-            iterator->findNeighbourIndexesByWidth1D(
-                static_cast<int>(gaussian_kernels[dimension_number].size()),
-                static_cast<int>(dimension_number));
-        std::vector<size_t> neighbourIndexes = std::get<0>(indexesAndValidity);
-        std::vector<bool> indexValidity = std::get<1>(indexesAndValidity);
-        auto normalised_kernel = renormaliseKernel(
-            gaussian_kernels[dimension_number], indexValidity);
-
-        // Convolve signal with kernel
-        double sumSignal = 0;
-        double sumSquareError = 0;
-        double error = 0;
-        for (size_t i = 0; i < neighbourIndexes.size(); ++i) {
-          if (indexValidity[i]) {
-            sumSignal += read_ws->getSignalAt(neighbourIndexes[i]) *
-                         normalised_kernel[i];
-            error =
-                read_ws->getErrorAt(neighbourIndexes[i]) * normalised_kernel[i];
-            sumSquareError += error * error;
-          }
-
-          write_ws->setSignalAt(iteratorIndex, sumSignal);
-          write_ws->setErrorSquaredAt(iteratorIndex, sumSquareError);
-        }
-        progress.report();
-
-      } while (iterator->next());
       PARALLEL_END_INTERUPT_REGION
     }
     PARALLEL_CHECK_INTERUPT_REGION
+
+    stride *= length;
+    progress.report();
   }
 
-  return write_ws;
+  // Create the output workspace
+  IMDHistoWorkspace_sptr outWS(toSmooth->clone().release());
+  for (size_t i = 0; i < nPoints; ++i) {
+    if (!isMeasured(i)) {
+      outWS->setSignalAt(i, std::numeric_limits<double>::quiet_NaN());
+      outWS->setErrorSquaredAt(i, std::numeric_limits<double>::quiet_NaN());
+      continue; // Skip we couldn't measure here.
+    }
+    const double norm = sumKernel[i];
+    outWS->setSignalAt(i, sumSignal[i] / norm);
+    outWS->setErrorSquaredAt(i, isWeightedMean
+                                    ? sumSquareError[i] / (norm * norm)
+                                    : sumSquareError[i] / norm);
+  }
+  progress.report();
+
+  return outWS;
 }
 
 //----------------------------------------------------------------------------------------------
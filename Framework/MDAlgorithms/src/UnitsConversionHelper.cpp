@@ -2,6 +2,7 @@
 #include "MantidAPI/NumericAxis.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/Strings.h"
+#include <algorithm>
 #include <cmath>
 
 namespace Mantid {
@@ -332,6 +333,40 @@ double UnitsConversionHelper::convertUnits(double val) const {
         "updateConversion: unknown type of conversion requested");
   }
 }
+
+/** Convert a range of values, as convertUnits(double) does one at a time
+ * @param first :: the first value to convert
+ * @param last :: one past the last value to convert
+ * @param result :: where to write the converted values, which may be first
+ */
+void UnitsConversionHelper::convertUnits(const double *first,
+                                         const double *last,
+                                         double *result) const {
+  switch (m_UnitCnvrsn) {
+  case (CnvrtToMD::ConvertNo): {
+    if (result != first)
+      std::copy(first, last, result);
+    return;
+  }
+  case (CnvrtToMD::ConvertFast): {
+    for (; first != last; ++first, ++result)
+      *result = m_Factor * std::pow(*first, m_Power);
+    return;
+  }
+  case (CnvrtToMD::ConvertFromTOF): {
+    m_TargetUnit->batchFromTOF(first, last, result);
+    return;
+  }
+  case (CnvrtToMD::ConvertByTOF): {
+    m_SourceWSUnit->batchToTOF(first, last, result);
+    m_TargetUnit->batchFromTOF(result, result + (last - first), result);
+    return;
+  }
+  default:
+    throw std::runtime_error(
+        "updateConversion: unknown type of conversion requested");
+  }
+}
 // copy constructor;
 UnitsConversionHelper::UnitsConversionHelper(
     const UnitsConversionHelper &another) {
@@ -284,6 +284,98 @@ public:
     TS_ASSERT_EQUALS(2 * in_ws->getNEvents(), out_ws->getNEvents());
   }
 
+  void test_algorithm_success_append_incremental() {
+    auto sim_alg = Mantid::API::AlgorithmManager::Instance().create(
+        "CreateSimulationWorkspace");
+    sim_alg->initialize();
+    sim_alg->setPropertyValue("Instrument", "MAR");
+    sim_alg->setPropertyValue("BinParams", "-3,1,3");
+    sim_alg->setPropertyValue("UnitX", "DeltaE");
+    sim_alg->setPropertyValue("OutputWorkspace", "data_source_1");
+    sim_alg->execute();
+
+    sim_alg->setPropertyValue("OutputWorkspace", "data_source_2");
+    sim_alg->execute();
+
+    auto log_alg =
+        Mantid::API::AlgorithmManager::Instance().create("AddSampleLog");
+    log_alg->initialize();
+    log_alg->setProperty("Workspace", "data_source_1");
+    log_alg->setPropertyValue("LogName", "Ei");
+    log_alg->setPropertyValue("LogText", "3.0");
+    log_alg->setPropertyValue("LogType", "Number");
+    log_alg->execute();
+
+    log_alg->setProperty("Workspace", "data_source_2");
+    log_alg->execute();
+
+    auto create_alg =
+        Mantid::API::AlgorithmManager::Instance().create("CreateMD");
+    create_alg->setRethrows(true);
+    create_alg->initialize();
+    create_alg->setPropertyValue("OutputWorkspace", "md_sample_workspace");
+    create_alg->setPropertyValue("DataSources", "data_source_1");
+    create_alg->setPropertyValue("Alatt", "1,1,1");
+    create_alg->setPropertyValue("Angdeg", "90,90,90");
+    create_alg->setPropertyValue("Efix", "12.0");
+    create_alg->setPropertyValue("u", "1,0,0");
+    create_alg->setPropertyValue("v", "0,1,0");
+    create_alg->execute();
+    IMDEventWorkspace_sptr in_ws =
+        boost::dynamic_pointer_cast<IMDEventWorkspace>(
+            AnalysisDataService::Instance().retrieve("md_sample_workspace"));
+    const uint64_t numEvents = in_ws->getNEvents();
+    const uint16_t numExperiments = in_ws->getNumExperimentInfo();
+
+    // The same data under another name lie within the extents of the first
+    for (int i = 0; i < 2; ++i) {
+      AccumulateMD acc_alg;
+      acc_alg.initialize();
+      acc_alg.setPropertyValue("InputWorkspace", "md_sample_workspace");
+      acc_alg.setPropertyValue("OutputWorkspace", "md_sample_workspace");
+      acc_alg.setPropertyValue("DataSources",
+                               "data_source_1,data_source_2,data_source_3");
+      acc_alg.setPropertyValue("Alatt", "1,1,1");
+      acc_alg.setPropertyValue("Angdeg", "90,90,90");
+      acc_alg.setPropertyValue("EFix", "12.0");
+      acc_alg.setPropertyValue("u", "1,0,0");
+      acc_alg.setPropertyValue("v", "0,1,0");
+      acc_alg.setProperty("Incremental", true);
+      TS_ASSERT_THROWS_NOTHING(acc_alg.execute());
+      IMDEventWorkspace_sptr out_ws =
+          boost::dynamic_pointer_cast<IMDEventWorkspace>(
+              AnalysisDataService::Instance().retrieve("md_sample_workspace"));
+
+      // The events were added to the input workspace, only once, and its
+      // cached totals hold them
+      TS_ASSERT_EQUALS(out_ws, in_ws);
+      TS_ASSERT_EQUALS(out_ws->getNEvents(), 2 * numEvents);
+      TS_ASSERT_EQUALS(out_ws->getNumExperimentInfo(), 2 * numExperiments);
+      // The sources given are left alone, and only the new one that exists
+      // is recorded as appended
+      TS_ASSERT_EQUALS(acc_alg.getPropertyValue("DataSources"),
+                       "data_source_1,data_source_2,data_source_3");
+      TS_ASSERT_EQUALS(acc_alg.getPropertyValue("AppendedDataSources"),
+                       i == 0 ? "data_source_2" : "");
+    }
+
+    // Appending in place to another output workspace is refused
+    AccumulateMD acc_alg;
+    acc_alg.setRethrows(true);
+    acc_alg.initialize();
+    acc_alg.setPropertyValue("InputWorkspace", "md_sample_workspace");
+    acc_alg.setPropertyValue("OutputWorkspace", "md_other_workspace");
+    acc_alg.setPropertyValue("DataSources", "data_source_2");
+    acc_alg.setPropertyValue("Alatt", "1,1,1");
+    acc_alg.setPropertyValue("Angdeg", "90,90,90");
+    acc_alg.setPropertyValue("u", "1,0,0");
+    acc_alg.setPropertyValue("v", "0,1,0");
+    acc_alg.setProperty("Incremental", true);
+    TS_ASSERT_THROWS(acc_alg.execute(), std::runtime_error);
+    TS_ASSERT_EQUALS(in_ws->getNEvents(), 2 * numEvents);
+    TS_ASSERT(!AnalysisDataService::Instance().doesExist("md_other_workspace"));
+  }
+
   void test_algorithm_success_clean() {
 
     auto sim_alg = Mantid::API::AlgorithmManager::Instance().create(
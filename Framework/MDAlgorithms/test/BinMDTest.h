@@ -572,6 +572,87 @@ public:
                       true /* Flip sign of Y basis vector*/);
   }
 
+  /** Boxes within a single bin add their cached totals. Check that gives the
+   * same as binning every event, for the same events in a deep box tree and
+   * in a shallow one, with rotated bins. */
+  void test_exec_whole_boxes_match_binning_events() {
+    const std::vector<std::string> names{"mdew_deep", "mdew_shallow"};
+    const std::vector<std::string> thresholds{"50", "100000"};
+    for (size_t i = 0; i < names.size(); i++) {
+      FrameworkManager::Instance().exec(
+          "CreateMDWorkspace", 16, "Dimensions", "2", "Extents",
+          "-10,10,-10,10", "Names", "x,y", "Units", "m,m", "SplitInto", "4",
+          "SplitThreshold", thresholds[i].c_str(), "MaxRecursionDepth", "20",
+          "OutputWorkspace", names[i].c_str());
+      FrameworkManager::Instance().exec("FakeMDEventData", 6, "InputWorkspace",
+                                        names[i].c_str(), "UniformParams",
+                                        "20000", "RandomSeed", "1234");
+      FrameworkManager::Instance().exec(
+          "BinMD", 20, "InputWorkspace", names[i].c_str(), "OutputWorkspace",
+          (names[i] + "_binned").c_str(), "AxisAligned", "0", "BasisVector0",
+          "rx,m, 0.98, 0.17", "BasisVector1", "ry,m, -.17, 0.98",
+          "ForceOrthogonal", "1", "Translation", "-10, -10", "OutputExtents",
+          "0,20, 0,20", "OutputBins", "10,10", "Parallel", "1");
+    }
+    auto deep = AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(
+        "mdew_deep_binned");
+    auto shallow =
+        AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(
+            "mdew_shallow_binned");
+    TS_ASSERT_EQUALS(deep->getNPoints(), 100);
+    double totalEvents = 0;
+    for (size_t i = 0; i < deep->getNPoints(); i++) {
+      TS_ASSERT_DELTA(deep->getSignalAt(i), shallow->getSignalAt(i), 1e-8);
+      TS_ASSERT_DELTA(deep->getNumEventsAt(i), shallow->getNumEventsAt(i),
+                      1e-8);
+      totalEvents += deep->getNumEventsAt(i);
+    }
+    TS_ASSERT_LESS_THAN(0.0, totalEvents);
+    for (const auto &name : names) {
+      AnalysisDataService::Instance().remove(name);
+      AnalysisDataService::Instance().remove(name + "_binned");
+    }
+  }
+
+  void test_exec_Morton_layout_matches_box_tree() {
+    FrameworkManager::Instance().exec(
+        "CreateMDWorkspace", 16, "Dimensions", "3", "Extents",
+        "-10,10,-10,10,-10,10", "Names", "x,y,z", "Units", "m,m,m",
+        "SplitInto", "4", "SplitThreshold", "50", "MaxRecursionDepth", "20",
+        "OutputWorkspace", "mdew_morton");
+    FrameworkManager::Instance().exec("FakeMDEventData", 6, "InputWorkspace",
+                                      "mdew_morton", "UniformParams", "20000",
+                                      "RandomSeed", "1234");
+    const std::vector<std::string> layouts{"0", "1"};
+    for (const auto &useLayout : layouts)
+      FrameworkManager::Instance().exec(
+          "BinMD", 14, "InputWorkspace", "mdew_morton", "OutputWorkspace",
+          ("mdew_morton_binned" + useLayout).c_str(), "AxisAligned", "1",
+          "AlignedDim0", "x, -7, 9, 13", "AlignedDim1", "z, -10, 10, 7",
+          "Parallel", "1", "UseMortonLayout", useLayout.c_str());
+    auto tree = AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(
+        "mdew_morton_binned0");
+    auto layout = AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(
+        "mdew_morton_binned1");
+    TS_ASSERT_EQUALS(layout->getNPoints(), 13 * 7);
+    double totalEvents = 0;
+    for (size_t i = 0; i < tree->getNPoints(); i++) {
+      TS_ASSERT_DELTA(layout->getSignalAt(i), tree->getSignalAt(i), 1e-8);
+      TS_ASSERT_DELTA(layout->getErrorAt(i), tree->getErrorAt(i), 1e-8);
+      TS_ASSERT_DELTA(layout->getNumEventsAt(i), tree->getNumEventsAt(i),
+                      1e-8);
+      totalEvents += layout->getNumEventsAt(i);
+    }
+    TS_ASSERT_LESS_THAN(0.0, totalEvents);
+    // The layout does not change the workspace
+    auto mdew = AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>(
+        "mdew_morton");
+    TS_ASSERT_EQUALS(mdew->getNPoints(), 20000);
+    for (const auto &name :
+         {"mdew_morton", "mdew_morton_binned0", "mdew_morton_binned1"})
+      AnalysisDataService::Instance().remove(name);
+  }
+
   //---------------------------------------------------------------------------------------------
   /** Check that two MDHistos have the same values .
    *
@@ -163,6 +163,55 @@ public:
                      0, errorSq, 2.e-8);
   }
 
+  void test_calcMatrixCoords_matches_calcMatrixCoord() {
+    MDTransfQ3D Q3DTransf;
+    MDWSDescription WSDescr(5);
+    std::vector<std::string> dimPropNames(2, "T");
+    dimPropNames[1] = "Ei";
+    WSDescr.buildFromMatrixWS(ws2D, Q3DTransf.transfID(),
+                              DeltaEMode::asString(DeltaEMode::Elastic),
+                              dimPropNames);
+    WSDescr.m_PreprDetTable =
+        WorkspaceCreationHelper::buildPreprocessedDetectorsWorkspace(ws2D);
+    WSDescr.setLorentsCorr(true);
+    // limits which drop some of the points
+    WSDescr.setMinMax(std::vector<double>{-2, -2, -2, 0, 0},
+                      std::vector<double>{2, 2, 2, 100, 100});
+    Q3DTransf.initialize(WSDescr);
+
+    std::vector<coord_t> coord(5);
+    TS_ASSERT(Q3DTransf.calcGenericVariables(coord, 5));
+    TS_ASSERT(Q3DTransf.calcYDepCoordinates(coord, 1));
+
+    // more points than are worked out together
+    const size_t n = 600;
+    std::vector<double> x(n), signal(n, 2), errorSq(n, 3);
+    std::vector<coord_t> expectedCoords;
+    std::vector<double> expectedSignal, expectedErrorSq;
+    for (size_t i = 0; i < n; ++i) {
+      x[i] = 0.01 * static_cast<double>(i);
+      double s(2), err(3);
+      if (!Q3DTransf.calcMatrixCoord(x[i], coord, s, err))
+        continue;
+      expectedCoords.insert(expectedCoords.end(), coord.begin(), coord.end());
+      expectedSignal.push_back(s);
+      expectedErrorSq.push_back(err);
+    }
+    TS_ASSERT(expectedSignal.size() > 0);
+    TS_ASSERT(expectedSignal.size() < n);
+
+    std::vector<coord_t> coords(5 * n);
+    const size_t nKept = Q3DTransf.calcMatrixCoords(
+        x.data(), signal.data(), errorSq.data(), n, coord, coords.data());
+    TS_ASSERT_EQUALS(nKept, expectedSignal.size());
+    coords.resize(5 * nKept);
+    TS_ASSERT_EQUALS(coords, expectedCoords);
+    signal.resize(nKept);
+    errorSq.resize(nKept);
+    TS_ASSERT_EQUALS(signal, expectedSignal);
+    TS_ASSERT_EQUALS(errorSq, expectedErrorSq);
+  }
+
   MDTransfQ3DTest() {
 
     ws2D = WorkspaceCreationHelper::
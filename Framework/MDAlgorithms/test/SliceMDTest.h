@@ -132,6 +132,7 @@ public:
     doTestPropertyExistance("TakeMaxRecursionDepthFromInput");
     doTestPropertyExistance("Memory");
     doTestPropertyExistance("OutputFilename");
+    doTestPropertyExistance("StreamToFile");
   }
 
   void execute_slice(const std::string &name1, const std::string &name2,
@@ -139,7 +140,7 @@ public:
                      const uint64_t expectedNumPoints,
                      const size_t expectedNumDims, bool willFail,
                      const std::string &OutputFilename,
-                     IMDEventWorkspace_sptr in_ws) {
+                     IMDEventWorkspace_sptr in_ws, bool streamToFile = false) {
     SliceMD alg;
     TS_ASSERT_THROWS_NOTHING(alg.initialize())
     TS_ASSERT(alg.isInitialized())
@@ -157,6 +158,7 @@ public:
         alg.setPropertyValue("OutputWorkspace", "SliceMDTest_outWS"));
     TS_ASSERT_THROWS_NOTHING(
         alg.setPropertyValue("OutputFilename", OutputFilename));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("StreamToFile", streamToFile));
 
     TS_ASSERT_THROWS_NOTHING(alg.execute();)
 
@@ -205,7 +207,8 @@ public:
                     const std::string &name3, const std::string &name4,
                     const uint64_t expectedNumPoints,
                     const size_t expectedNumDims, bool willFail = false,
-                    std::string OutputFilename = "") {
+                    std::string OutputFilename = "",
+                    bool streamToFile = false) {
 
     Mantid::Geometry::QSample frame;
     IMDEventWorkspace_sptr in_ws =
@@ -217,7 +220,8 @@ public:
     AnalysisDataService::Instance().addOrReplace("SliceMDTest_ws", in_ws);
 
     execute_slice(name1, name2, name3, name4, expectedNumPoints,
-                  expectedNumDims, willFail, OutputFilename, in_ws);
+                  expectedNumDims, willFail, OutputFilename, in_ws,
+                  streamToFile);
   }
 
   void test_exec_3D_lean() {
@@ -266,6 +270,29 @@ public:
                                 false /*WillFail*/, "SliceMDTest_output.nxs");
   }
 
+  void test_exec_3D_streamToFile() {
+    do_test_exec<MDEvent<3>, 3>("Axis0,2.0,8.0, 3", "Axis1,2.0,8.0, 3",
+                                "Axis2,2.0,8.0, 3", "",
+                                6 * 6 * 6 /*# of events*/, 3 /*dims*/,
+                                false /*WillFail*/, "SliceMDTest_output.nxs",
+                                true /*StreamToFile*/);
+  }
+
+  void test_exec_2D_lean_streamToFile() {
+    do_test_exec<MDLeanEvent<3>, 3>("Axis0,2.0,8.0, 3", "Axis1,2.0,8.0, 3", "",
+                                    "", 6 * 6 * 10 /*# of events*/, 2 /*dims*/,
+                                    false /*WillFail*/,
+                                    "SliceMDTest_output.nxs",
+                                    true /*StreamToFile*/);
+  }
+
+  void test_streamToFile_needs_OutputFilename() {
+    do_test_exec<MDEvent<3>, 3>("Axis0,2.0,8.0, 3", "Axis1,2.0,8.0, 3",
+                                "Axis2,2.0,8.0, 3", "", 0 /*# of events*/,
+                                3 /*dims*/, true /*WillFail*/, "",
+                                true /*StreamToFile*/);
+  }
+
   void test_exec_with_masked_ws() {
     Mantid::Geometry::QSample frame;
     IMDEventWorkspace_sptr in_ws =
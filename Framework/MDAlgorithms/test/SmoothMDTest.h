@@ -480,6 +480,73 @@ public:
       TS_ASSERT_DELTA(expected_error[i], out->getErrorAt(i), 0.001);
     }
   }
+
+  void test_smooth_gaussian_with_normalization_guidance() {
+    auto toSmooth = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        0 /*signal*/, 1 /*numDims*/, 5 /*numBins*/);
+    auto normWs = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        1 /*signal*/, 1 /*numDims*/, 5 /*numBins*/);
+    const std::vector<double> signal{1, 2, 100, 4, 5};
+    for (size_t i = 0; i < signal.size(); ++i) {
+      toSmooth->setSignalAt(i, signal[i]);
+    }
+    normWs->setSignalAt(2, 0);
+
+    SmoothMD alg;
+    alg.setChild(true);
+    alg.initialize();
+    alg.setProperty("WidthVector", WidthVector(1, 1));
+    alg.setProperty("InputWorkspace", toSmooth);
+    alg.setProperty("InputNormalizationWorkspace", normWs);
+    alg.setProperty("Function", "Gaussian");
+    alg.setPropertyValue("OutputWorkspace", "dummy");
+    alg.execute();
+    IMDHistoWorkspace_sptr out = alg.getProperty("OutputWorkspace");
+
+    // The kernel is renormalised over the measured neighbours only
+    const auto kernel = Mantid::MDAlgorithms::gaussianKernel(1);
+    TS_ASSERT_EQUALS(3, kernel.size());
+    const double side = kernel[0];
+    const double centre = kernel[1];
+    TS_ASSERT_DELTA((side * 1 + centre * 2) / (side + centre),
+                    out->getSignalAt(1), 1e-12);
+    TS_ASSERT_DELTA((centre * 4 + side * 5) / (side + centre),
+                    out->getSignalAt(3), 1e-12);
+    TS_ASSERT_DELTA((side * side + centre * centre) /
+                        ((side + centre) * (side + centre)),
+                    out->getErrorAt(1) * out->getErrorAt(1), 1e-12);
+    TS_ASSERT(std::isnan(out->getSignalAt(2)));
+    TS_ASSERT(std::isnan(out->getErrorAt(2)));
+  }
+
+  void test_smooth_gaussian_with_wide_kernel() {
+    // The kernel is long enough to be applied by FFT
+    auto toSmooth = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        2 /*signal*/, 1 /*numDims*/, 400 /*numBins*/);
+    auto normWs = MDEventsTestHelper::makeFakeMDHistoWorkspace(
+        1 /*signal*/, 1 /*numDims*/, 400 /*numBins*/);
+    toSmooth->setSignalAt(100, 1000);
+    normWs->setSignalAt(100, 0);
+
+    SmoothMD alg;
+    alg.setChild(true);
+    alg.initialize();
+    alg.setProperty("WidthVector", WidthVector(1, 200));
+    alg.setProperty("InputWorkspace", toSmooth);
+    alg.setProperty("InputNormalizationWorkspace", normWs);
+    alg.setProperty("Function", "Gaussian");
+    alg.setPropertyValue("OutputWorkspace", "dummy");
+    alg.execute();
+    IMDHistoWorkspace_sptr out = alg.getProperty("OutputWorkspace");
+
+    for (size_t i = 0; i < out->getNPoints(); ++i) {
+      if (i == 100) {
+        TS_ASSERT(std::isnan(out->getSignalAt(i)));
+      } else {
+        TS_ASSERT_DELTA(2, out->getSignalAt(i), 1e-10);
+      }
+    }
+  }
 };
 
 class SmoothMDTestPerformance : public CxxTest::TestSuite {